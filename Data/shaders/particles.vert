@@ -2,18 +2,26 @@
 
 layout(location = 0) in vec4 position;
 layout(location = 1) in vec2 UV;
-layout(location = 2) in float opacity;
-layout(location = 3) in mat4 mvp;
+layout(location = 2) in vec3 posSize;          // per-particle: world position and size
+layout(location = 3) in uint rotationOpacity;  // per-particle: packHalf2x16(rotation, opacity)
 
 out vec2 v_UV;
 out float v_opacity;
 
 uniform vec2 UV_offset = vec2(0,0);
+uniform mat4 proj;      // projection matrix
 
 void main()
 {
-    gl_Position = mvp * position;  // this mvp is per-particle
-    v_opacity = opacity;
+    vec2 rotOpacity = unpackHalf2x16(rotationOpacity);
+
+    // T * R * S, built here instead of streaming a whole mat4 per particle
+    float rcos = cos(rotOpacity.x) * posSize.z;
+    float rsin = sin(rotOpacity.x) * posSize.z;
+    vec2 world = mat2(rcos, rsin, -rsin, rcos) * position.xy + posSize.xy;
+
+    gl_Position = proj * vec4(world, 0, 1);
+    v_opacity = rotOpacity.y;
 
     v_UV = UV + UV_offset;
 }
@@ -26,14 +26,19 @@ struct InitData
     int bufferSize, align1;
 };
 
+// what the vertex shader needs to draw a particle, 16 bytes. It builds the matrix itself.
+struct Instance
+{
+    vec2 pos;               // world position, parent included
+    float size;
+    uint rotationOpacity;   // packHalf2x16(rotation, opacity)
+};
+
 // Particle data buffer
 layout(std430, binding = 0) buffer DataSSBO { Particle particles[]; };
 
-// Opacities buffer. Having it separate form matrices saves space (no padding)
-layout(std430, binding = 1) buffer OpacitiesSSBO { float opacities[]; };
-
-// Transform matrices buffer
-layout(std430, binding = 2) buffer MatrixSSBO { mat4 transforms[]; };
+// Instances buffer - read by the vertex shader as per-instance attributes
+layout(std430, binding = 1) buffer InstanceSSBO { Instance instances[]; };
 
 // Uniform block - represents array of particle groups to emit during this frame
 layout(std430, binding = 3) buffer InitDataUBO { InitData init[]; };
@@ -41,7 +46,6 @@ layout(std430, binding = 3) buffer InitDataUBO { InitData init[]; };
 
 uniform int initCount;  // amount of emissions to initialize
 
-uniform mat4 proj;      // projection matrix
 uniform float t;        // time
 uniform float dt;       // deltaTime
 uniform ivec2 range;    // init start and end
@@ -59,6 +63,9 @@ float urand(float seed) { return 2 * prand(seed) - 1.0; }
 // returns "progress" (0 to 1) between start and end of 'time'
 float lerpOpacity(float start, float end, float time) { return clamp((time - start) / (end-start), 0.0, 1.0); }
 
+// wraps rotation to 0 to 2pi, so it keeps its precision as a half
+float wrapRotation(float rotation) { return mod(rotation, 6.2831853); }
+
 void main()
 {
     // it's one-dimensional. Only need the x.
@@ -108,19 +115,14 @@ void main()
     particles[idx].time += dt;
     particles[idx].size *= step(particles[idx].time, particles[idx].lifetime);
 
-    // pre-calculate mvp matrix here, to make life easier for vertex shader
-    mat4 S = mat4( mat2(particles[idx].size) );
-    float rcos = cos(particles[idx].rotation);
-    float rsin = sin(particles[idx].rotation);
-    mat4 R = mat4( mat2(rcos, rsin, -rsin, rcos) );
-    mat4 T = mat4(1.0);  T[3] = vec4(particles[idx].pos + parentPos * isLocal, 0, 1);
+    // fade in and out
+    float opacity = lerpOpacity(0,                      particles[idx].fadeIn,   particles[idx].time) *
+                 (1-lerpOpacity(particles[idx].fadeOut, particles[idx].lifetime, particles[idx].time));
 
     // arrange them from oldest to newest for rendering. inverse deque, wooo
     int renderIndex = (int(idx) + (init[initIndex].bufferSize - oldest)) % init[initIndex].bufferSize;
-    transforms[renderIndex] = proj * T * R * S;
-
-    // fade in and out
-    opacities[renderIndex] = lerpOpacity(0,                      particles[idx].fadeIn,   particles[idx].time) *
-                          (1-lerpOpacity(particles[idx].fadeOut, particles[idx].lifetime, particles[idx].time));
+    instances[renderIndex].pos = particles[idx].pos + parentPos * isLocal;
+    instances[renderIndex].size = particles[idx].size;
+    instances[renderIndex].rotationOpacity = packHalf2x16(vec2(wrapRotation(particles[idx].rotation), opacity));
 }
 
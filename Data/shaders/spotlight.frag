@@ -4,26 +4,44 @@
 
 out vec4 pixel_color;
 
-layout(std430, binding = 13) buffer light_positions { vec4 positions[]; };
-layout(std430, binding = 14) buffer light_radii { float radii[]; };
-layout(std430, binding = 15) buffer light_strengths { float strengths[]; };
+// matches LightingSystem::LightRecord
+struct LightRecord
+{
+    vec2 pos;       // world space
+    float radius;   // world units
+    float strength;
+};
+
+layout(std430, binding = 11) buffer light_tiles { uvec2 tiles[]; };       // offset and count into tile_lights
+layout(std430, binding = 12) buffer light_tile_lists { uint tile_lights[]; };
+layout(std430, binding = 13) buffer light_records { LightRecord lights[]; };
 
 //uniform float ambient = 0.0;
-uniform int light_count = 0;
+uniform mat4 world_to_frag;         // world to gl_FragCoord
+uniform float radius_scale = 1.0;   // world units to pixels
+uniform int tile_size = 32;
+uniform ivec2 tile_count = ivec2(1, 1);
 
 void main()
 {
     pixel_color = vec4(0,0,0,1);
 
-    for (int i=0; i<light_count; ++i)
+    // only loop over the lights binned into this pixel's tile
+    ivec2 tile = min(ivec2(gl_FragCoord.xy) / tile_size, tile_count - 1);
+    uvec2 list = tiles[tile.y * tile_count.x + tile.x];
+
+    for (uint t=list.x; t<list.x+list.y; ++t)
     {
+        LightRecord light = lights[tile_lights[t]];
+
         // light-to-pixel vector
-        vec2 l2p = gl_FragCoord.xy - positions[i].xy;
+        vec2 l2p = gl_FragCoord.xy - (world_to_frag * vec4(light.pos, 0, 1)).xy;
 
         // calculate light strength at this pixel
-        float spot = (radii[i] * radii[i]) 
-                            / ( radii[i] * radii[i] + dot(l2p, l2p));
-        spot *= strengths[i];
+        float radius = light.radius * radius_scale;
+        float spot = (radius * radius) 
+                            / ( radius * radius + dot(l2p, l2p));
+        spot *= light.strength;
 
         // use it as transparency
         pixel_color.w = min( 1.0-clamp(spot, 0.0, 1.0), pixel_color.w);
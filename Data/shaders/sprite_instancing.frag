@@ -0,0 +1,17 @@
+#version 430 core
+
+out vec4 pixel_color;
+
+in vec2 v_UV;
+in vec4 v_Tint;
+in float v_Opacity;
+
+uniform sampler2D TextureSlot; // set by glActiveTexture() inside Texture::bind()
+
+// same as texture.frag, with the opacity and tint coming from the instance
+void main()
+{
+    pixel_color = texture(TextureSlot, v_UV);
+    pixel_color.w *= v_Opacity;
+    pixel_color += v_Tint * pixel_color.w;
+}
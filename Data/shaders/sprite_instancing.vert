@@ -0,0 +1,26 @@
+#version 430 core
+
+// per vertex - the texture's mesh
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 UV;
+
+// per instance - see SpriteInstance in SpriteBatcher.h
+layout(location = 2) in vec4 axisX;     // columns of the mvp matrix that a flat mesh uses
+layout(location = 3) in vec4 axisY;
+layout(location = 4) in vec4 origin;
+layout(location = 5) in vec4 tint;
+layout(location = 6) in vec3 uvOffsetOpacity;  // xy: UV offset, z: opacity
+
+out vec2 v_UV;
+out vec4 v_Tint;
+out float v_Opacity;
+
+void main()
+{
+    // same as mvp * vec4(position, 0, 1)
+    gl_Position = axisX * position.x + axisY * position.y + origin;
+
+    v_UV = UV + uvOffsetOpacity.xy;
+    v_Tint = tint;
+    v_Opacity = uvOffsetOpacity.z;
+}
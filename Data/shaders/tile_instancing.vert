@@ -2,7 +2,7 @@
 
 layout(location = 0) in vec4 position;
 layout(location = 1) in vec2 UV;
-layout(location = 2) in float tileID;
+layout(location = 2) in int tileID;
 
 out vec2 v_UV;
 
@@ -15,6 +15,7 @@ uniform vec2 stridex = vec2(0.0,0.0);
 uniform vec2 stridey = vec2(0.0,0.0);
 uniform int columns = 1;     // amt of columns in the spritesheet
 uniform int rowwidth = 10;   // row width of the tilemap
+uniform int firsttile = 0;   // index of the first tile drawn (gl_InstanceID doesn't include the base instance)
 
 // fun fact: unused uniforms are excluded when compiling. Unless they are initialized.
 
@@ -23,14 +24,15 @@ uniform mat4 mvp;
 
 void main()
 {
+    int tile = firsttile + gl_InstanceID;
+
     //           discard negative | tilemap position | individual tile offset 
-    gl_Position = step(0, tileID) * ( mvp * position + vec4(stridex,0,0) * (gl_InstanceID%rowwidth) + 
-                                                       vec4(stridey,0,0) * (gl_InstanceID/rowwidth) );
+    gl_Position = float(tileID >= 0) * ( mvp * position + vec4(stridex,0,0) * (tile%rowwidth) + 
+                                                       vec4(stridey,0,0) * (tile/rowwidth) );
 
     // calculate UV's for current letter instance
-    int frame = int(tileID);
-    // why tf does GLSL not receive ints thru buffer correctly??? 
-    // (or maybe I'm just fucking it up..)
+    // (ints have to be bound with glVertexAttribIPointer, or they arrive as floats)
+    int frame = tileID;
     int row = frame / columns;
     int col = frame % columns;
     vec2 UV_offset = vec2(UVsize.x * col, UVsize.y * row);
@@ -43,7 +43,7 @@ bool AssetLibrarySystem< AssetType >::s_ShowAssetLibraryList = false;
     {
         for ( auto& [ key, value ] : data.items() )
         {
-            Stream::PushDebugLocation( key + "." );
+            Stream::PushDebugLocation( key );
 
             // create and read the asset
             AssetType* asset = new AssetType();
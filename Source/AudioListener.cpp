@@ -58,6 +58,22 @@
     }
 
 
+    /// @brief  gets the position this AudioListener hears from
+    /// @return the position this AudioListener hears from, including the z offset
+    glm::vec3 AudioListener::GetPosition() const
+    {
+        glm::vec2 pos2 = m_Transform != nullptr ? m_Transform->GetTranslation() : glm::vec2( 0.0f, 0.0f );
+        return glm::vec3( pos2, m_ZOffset );
+    }
+
+    /// @brief  gets the modifier that adjusts how much sound attenuates at distance
+    /// @return the modifier that adjusts how much sound attenuates at distance
+    float AudioListener::GetRolloffScale() const
+    {
+        return m_RolloffScale;
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: methods
 //-----------------------------------------------------------------------------
@@ -48,6 +48,15 @@ public: // accessors
     void SetZOffset( float zOffset );
 
 
+    /// @brief  gets the position this AudioListener hears from
+    /// @return the position this AudioListener hears from, including the z offset
+    glm::vec3 GetPosition() const;
+
+    /// @brief  gets the modifier that adjusts how much sound attenuates at distance
+    /// @return the modifier that adjusts how much sound attenuates at distance
+    float GetRolloffScale() const;
+
+
 //-----------------------------------------------------------------------------
 public: //  methods
 //-----------------------------------------------------------------------------
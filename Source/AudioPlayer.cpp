@@ -51,35 +51,30 @@
         }
 
         // if not already playing a sound, start playing a new sound
-        m_Channel = m_Sound->Play(
-            m_ChannelGroup,
-            random( m_Volume - m_Volume * m_VolumeVariance, m_Volume + m_Volume * m_VolumeVariance ),
-            random( m_Pitch - m_Pitch * m_PitchVariance, m_Pitch + m_Pitch * m_PitchVariance ),
-            m_DefaultLoopCount
-        );
-
-        if ( m_Channel == nullptr )
-        {
-            return;
-        }
-
-        if ( m_IsSpatial )
-        {
-            m_Channel->setMode( FMOD_3D );
-            setSpatialAttributes();
-        }
+        Voice voice;
+        voice.M_Sound = m_Sound;
+        voice.M_Group = m_ChannelGroup;
+        voice.M_Priority = m_Priority;
+        voice.M_Volume = random( m_Volume - m_Volume * m_VolumeVariance, m_Volume + m_Volume * m_VolumeVariance );
+        voice.M_Pitch = random( m_Pitch - m_Pitch * m_PitchVariance, m_Pitch + m_Pitch * m_PitchVariance );
+        voice.M_LoopCount = m_DefaultLoopCount;
+        voice.M_Length = m_Sound->GetLength();
+        voice.M_IsSpatial = m_IsSpatial;
+        getSpatialAttributes( &voice.M_Position, &voice.M_Velocity );
 
         if ( m_AllowMultipleSounds )
         {
-            m_Channel = nullptr;
+            Audio()->GetVoices()->Play( voice );
             return;
         }
 
-        // tell the channel which Audioplayer it belongs to
-        m_Channel->setUserData( this );
+        // have the voice call this AudioPlayer's callbacks when it ends
+        voice.M_OnComplete = [ this ]()
+        {
+            onVoiceComplete();
+        };
 
-        // have the channel call the callback
-        m_Channel->setCallback( onFmodChannelCallback );
+        m_Voice = Audio()->GetVoices()->Play( voice );
     }
 
 
@@ -87,12 +82,10 @@
     /// @note   FULLY STOPS the channel, doesn't just pause it
     void AudioPlayer::Stop()
     {
-        if ( m_Channel == nullptr )
-        {
-            return;
-        }
-        m_Channel->stop();
-        m_Channel = nullptr;
+        // cleared first, so the sound complete callbacks can start a new sound
+        VoiceManager::Handle voice = m_Voice;
+        m_Voice = 0;
+        Audio()->GetVoices()->Stop( voice );
     }
 
 
@@ -137,7 +130,7 @@
     /// @return whether this AudioPlayer is currently playing anything
     bool AudioPlayer::GetIsPlaying() const
     {
-        return m_Channel != nullptr;
+        return Audio()->GetVoices()->GetIsPlaying( m_Voice );
     }
 
 
@@ -145,26 +138,14 @@
     /// @return the current time of the currently playing sound
     float AudioPlayer::GetTime() const
     {
-        if ( m_Channel == nullptr )
-        {
-            return 0.0f;
-        }
-
-        unsigned int time;
-        m_Channel->getPosition( &time, FMOD_TIMEUNIT_MS );
-        return (float)time / 1000;
+        return Audio()->GetVoices()->GetTime( m_Voice );
     }
 
     /// @brief  sets the current time of the currently playing sound
     /// @param  time    the current time of the currently playing sound
     void AudioPlayer::SetTime( float time )
     {
-        if ( m_Channel == nullptr )
-        {
-            return;
-        }
-
-        m_Channel->setPosition( (unsigned int)(time * 1000), FMOD_TIMEUNIT_MS );
+        Audio()->GetVoices()->SetTime( m_Voice, time );
     }
 
 
@@ -172,25 +153,14 @@
     /// @return whether this AudioPlayer is paused
     bool AudioPlayer::GetIsPaused() const
     {
-        if ( m_Channel == nullptr )
-        {
-            return true;
-        }
-
-        bool paused;
-        m_Channel->getPaused( &paused );
-        return paused;
+        return Audio()->GetVoices()->GetIsPaused( m_Voice );
     }
 
     /// @brief  Sets whether or not this AudioPlayer is paused
     /// @param  paused   whether to pause or unpause the AudioPlayer
     void AudioPlayer::SetIsPaused( bool paused )
     {
-        if ( m_Channel == nullptr )
-        {
-            return;
-        }
-        m_Channel->setPaused( paused );
+        Audio()->GetVoices()->SetIsPaused( m_Voice, paused );
     }
 
 
@@ -207,10 +177,7 @@
     {
         m_Volume = _volume;
 
-        if ( m_Channel != nullptr )
-        {
-            m_Channel->setVolume( m_Volume * ( m_Sound != nullptr ? m_Sound->GetVolume() : 1.0f ) );
-        }
+        Audio()->GetVoices()->SetVolume( m_Voice, m_Volume );
     }
 
 
@@ -227,10 +194,7 @@
     {
         m_Pitch = pitch;
 
-        if ( m_Channel != nullptr )
-        {
-            m_Channel->setPitch( m_Pitch );
-        }
+        Audio()->GetVoices()->SetPitch( m_Voice, m_Pitch );
     }
 
 
@@ -283,24 +247,14 @@
     /// @return the current loop count
     int AudioPlayer::GetLoopCount() const
     {
-        if ( m_Channel == nullptr )
-        {
-            return 0;
-        }
-        int loopCount;
-        m_Channel->getLoopCount( &loopCount );
-        return loopCount;
+        return Audio()->GetVoices()->GetLoopCount( m_Voice );
     }
 
     /// @brief  sets the current loop count
     /// @param  loopCount   the current loop count
     void AudioPlayer::SetLoopCount( int loopCount )
     {
-        if ( m_Channel == nullptr )
-        {
-            return;
-        }
-        m_Channel->setLoopCount( loopCount );
+        Audio()->GetVoices()->SetLoopCount( m_Voice, loopCount );
     }
 
 
@@ -309,20 +263,26 @@
     void AudioPlayer::SetIsSpatial( bool isSpatial )
     {
         m_IsSpatial = isSpatial;
-        if ( m_Channel == nullptr )
-        {
-            return;
-        }
 
-        if ( isSpatial )
-        {
-            m_Channel->setMode( FMOD_3D );
-            setSpatialAttributes();
-        }
-        else
-        {
-            m_Channel->setMode( FMOD_2D );
-        }
+        glm::vec2 position, velocity;
+        getSpatialAttributes( &position, &velocity );
+        Audio()->GetVoices()->SetSpatialAttributes( m_Voice, position, velocity );
+        Audio()->GetVoices()->SetIsSpatial( m_Voice, isSpatial );
+    }
+
+
+    /// @brief  gets the priority of this AudioPlayer's sounds
+    /// @return the priority of this AudioPlayer's sounds
+    int AudioPlayer::GetPriority() const
+    {
+        return m_Priority;
+    }
+
+    /// @brief  sets the priority of this AudioPlayer's sounds
+    /// @param  priority    higher priority sounds keep playing over lower priority sounds when there are too many
+    void AudioPlayer::SetPriority( int priority )
+    {
+        m_Priority = priority;
     }
 
 //-----------------------------------------------------------------------------
@@ -375,9 +335,11 @@
     /// @param  dt  the duration of the frame in seconds
     void AudioPlayer::OnUpdate( float dt )
     {
-        if ( m_IsSpatial && m_Channel != nullptr )
+        if ( m_IsSpatial && m_Voice != 0 )
         {
-            setSpatialAttributes();
+            glm::vec2 position, velocity;
+            getSpatialAttributes( &position, &velocity );
+            Audio()->GetVoices()->SetSpatialAttributes( m_Voice, position, velocity );
         }
     }
 
@@ -387,45 +349,16 @@
 //-----------------------------------------------------------------------------
 
 
-    /// @brief  callback called when an fmod channel finishes playing
-    /// @param  channelControl  the channel the callback is from
-    /// @param  controlType     identifier to distinguish between channel and channelgroup
-    /// @param  callbackType    the type of callback
-    /// @param  commandData1    first callback parameter
-    /// @param  commandData2    second callback parameter
-    FMOD_RESULT F_CALLBACK AudioPlayer::onFmodChannelCallback(
-        FMOD_CHANNELCONTROL* channelControl,
-        FMOD_CHANNELCONTROL_TYPE controlType,
-        FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType,
-        void* commandData1,
-        void* commandData2
-    )
-    {
-        if (
-            controlType != FMOD_CHANNELCONTROL_CHANNEL ||
-            callbackType != FMOD_CHANNELCONTROL_CALLBACK_END
-        ) // only handle callbacks for channels ending
-        {
-            return FMOD_OK;
-        }
-
-        // get the AudioPlayer that this channel started
-        AudioPlayer* self;
-        ((FMOD::Channel*)channelControl)->getUserData( (void**)&self );
-
-        if ( self == nullptr )
-        { // only handle callbacks that belong to an AudioPlayer
-            return FMOD_OK;
-        }
+    /// @brief  callback called when the current voice finishes playing
+    void AudioPlayer::onVoiceComplete()
+    {
+        // cleared first, so callbacks can start a new sound
+        m_Voice = 0;
 
-        for ( auto& [ key, callback ] : self->m_OnSoundCompleteCallbacks )
+        for ( auto& [ key, callback ] : m_OnSoundCompleteCallbacks )
         {
             callback();
         }
-
-        self->m_Channel = nullptr;
-
-        return FMOD_OK;
     }
 
 
@@ -448,16 +381,13 @@
     }
 
 
-    /// @brief  sets the spatial attributes of the current channel
-    void AudioPlayer::setSpatialAttributes()
+    /// @brief  gets the spatial attributes to play sounds at
+    /// @param  position    the position to play sounds at
+    /// @param  velocity    the velocity to play sounds at
+    void AudioPlayer::getSpatialAttributes( glm::vec2* position, glm::vec2* velocity ) const
     {
-        glm::vec2 pos2 = m_Transform != nullptr ? m_Transform->GetTranslation() : glm::vec2( 0.0f, 0.0f );
-        glm::vec2 vel2 = m_RigidBody != nullptr ? m_RigidBody->GetVelocity() : glm::vec2( 0.0f, 0.0f );
-
-        FMOD_VECTOR pos3 = { pos2.x, pos2.y, 0.0f };
-        FMOD_VECTOR vel3 = { vel2.x, vel2.y, 0.0f };
-
-        m_Channel->set3DAttributes( &pos3, &vel3 );
+        *position = m_Transform != nullptr ? m_Transform->GetTranslation() : glm::vec2( 0.0f, 0.0f );
+        *velocity = m_RigidBody != nullptr ? m_RigidBody->GetVelocity() : glm::vec2( 0.0f, 0.0f );
     }
 
 
@@ -498,6 +428,9 @@
 
         ImGui::InputInt( "Default Loop Count", &m_DefaultLoopCount, 1, 5 );
 
+        ImGui::InputInt( "Priority", &m_Priority, 1, 5 );
+        ImGui::SetItemTooltip( "higher priority sounds keep playing over lower priority sounds when there are too many" );
+
         int currentLoopCount = GetLoopCount();
         if ( ImGui::InputInt( "Current Loop Count", &currentLoopCount, 1, 5 ) )
         {
@@ -620,6 +553,13 @@
         Stream::Read( m_ChannelGroupName, data );
     }
 
+    /// @brief  reads the priority of this AudioPlayer's sounds
+    /// @param  data    the JSON data to read from
+    void AudioPlayer::readPriority( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_Priority, data );
+    }
+
 
 //-----------------------------------------------------------------------------
 // public: reading / writing
@@ -640,7 +580,8 @@
             { "PlayOnInit"         , &AudioPlayer::readPlayOnInit          },
             { "IsSpatial"          , &AudioPlayer::readIsSpatial           },
             { "AllowMultipleSounds", &AudioPlayer::readAllowMultipleSounds },
-            { "ChannelGroupName"   , &AudioPlayer::readChannelGroupName    }
+            { "ChannelGroupName"   , &AudioPlayer::readChannelGroupName    },
+            { "Priority"           , &AudioPlayer::readPriority            }
         };
 
         return (ReadMethodMap< ISerializable > const&)readMethods;
@@ -663,6 +604,7 @@
         data[ "IsSpatial"           ] = Stream::Write( m_IsSpatial           );
         data[ "AllowMultipleSounds" ] = Stream::Write( m_AllowMultipleSounds );
         data[ "ChannelGroupName"    ] = Stream::Write( m_ChannelGroupName    );
+        data[ "Priority"            ] = Stream::Write( m_Priority            );
 
         return data;
     }
@@ -699,7 +641,8 @@
         m_ChannelGroup    ( other.m_ChannelGroup     ),
         m_ChannelGroupName( other.m_ChannelGroupName ),
         m_PlayOnInit      ( other.m_PlayOnInit       ),
-        m_AllowMultipleSounds ( other.m_AllowMultipleSounds )
+        m_AllowMultipleSounds ( other.m_AllowMultipleSounds ),
+        m_Priority        ( other.m_Priority         )
     {}
 
 
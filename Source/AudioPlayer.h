@@ -12,6 +12,7 @@
 
 #include "AssetReference.h"
 #include "Sound.h"
+#include "VoiceManager.h"
 
 #include "ComponentReference.h"
 #include "Transform.h"
@@ -151,6 +152,15 @@ public: // accessors
     void SetIsSpatial( bool isSpatial );
 
 
+    /// @brief  gets the priority of this AudioPlayer's sounds
+    /// @return the priority of this AudioPlayer's sounds
+    int GetPriority() const;
+
+    /// @brief  sets the priority of this AudioPlayer's sounds
+    /// @param  priority    higher priority sounds keep playing over lower priority sounds when there are too many
+    void SetPriority( int priority );
+
+
 //-----------------------------------------------------------------------------
 public: // virtual override methods
 //-----------------------------------------------------------------------------
@@ -203,6 +213,10 @@ private: // members
     int m_DefaultLoopCount = 0;
 
 
+    /// @brief  higher priority sounds keep playing over lower priority sounds when there are too many
+    int m_Priority = 0;
+
+
     /// @brief  whether the sound exists in 3D space
     bool m_IsSpatial = false;
 
@@ -220,8 +234,8 @@ private: // members
     ComponentReference< RigidBody, false > m_RigidBody;
 
 
-    /// @brief  The channel currently being used by this AudioPlayer
-    FMOD::Channel* m_Channel = nullptr;
+    /// @brief  The voice currently being played by this AudioPlayer - 0 if none
+    VoiceManager::Handle m_Voice = 0;
 
     /// @brief  whether to stay paused when the window regains focus
     bool m_KeepPausedOnFocus = false;
@@ -236,27 +250,18 @@ private: // methods
 //-----------------------------------------------------------------------------
     
 
-    /// @brief  callback called when an fmod channel finishes playing
-    /// @param  channelControl  the channel the callback is from
-    /// @param  controlType     identifier to distinguish between channel and channelgroup
-    /// @param  callbackType    the type of callback
-    /// @param  commandData1    first callback parameter
-    /// @param  commandData2    second callback parameter
-    static FMOD_RESULT F_CALLBACK onFmodChannelCallback(
-        FMOD_CHANNELCONTROL* channelControl,
-        FMOD_CHANNELCONTROL_TYPE controlType,
-        FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType,
-        void* commandData1,
-        void* commandData2
-    );
+    /// @brief  callback called when the current voice finishes playing
+    void onVoiceComplete();
 
     /// @brief  callback to call when the window focus changes
     /// @param  focused whether the window is focused
     void onWindowFocusChangedCallback( bool focused );
 
 
-    /// @brief  sets the spatial attributes of the current channel
-    void setSpatialAttributes();
+    /// @brief  gets the spatial attributes to play sounds at
+    /// @param  position    the position to play sounds at
+    /// @param  velocity    the velocity to play sounds at
+    void getSpatialAttributes( glm::vec2* position, glm::vec2* velocity ) const;
 
 
 //-----------------------------------------------------------------------------
@@ -313,6 +318,10 @@ private: // reading
     /// @param  data    the JSON data to read from
     void readChannelGroupName( nlohmann::ordered_json const& data );
 
+    /// @brief  reads the priority of this AudioPlayer's sounds
+    /// @param  data    the JSON data to read from
+    void readPriority( nlohmann::ordered_json const& data );
+
 
 //-----------------------------------------------------------------------------
 public: // reading / writing
@@ -38,6 +38,14 @@
     }
 
 
+    /// @brief  gets the VoiceManager that decides which sounds get channels
+    /// @return the VoiceManager
+    VoiceManager* AudioSystem::GetVoices()
+    {
+        return &m_Voices;
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: methods
 //-----------------------------------------------------------------------------
@@ -183,6 +191,11 @@
         masterGroup->setVolume( m_Volume );
 
 
+        // real voices need FMOD channels to play on
+        m_Voices.SetBackend( std::make_unique< FmodVoiceBackend >() );
+        m_Voices.SetMaxRealVoices( std::min( m_Voices.GetMaxRealVoices(), m_MaxChannels ) );
+
+
         for ( AudioGroup& group : m_Groups )
         {
             group.Init( m_System );
@@ -192,6 +205,9 @@
     /// @brief  Gets called once before the Engine closes
     void AudioSystem::OnExit()
     {
+        // stops every voice while their channels still exist
+        m_Voices.SetBackend( std::make_unique< NullVoiceBackend >() );
+
         for ( AudioGroup& group : m_Groups )
         {
             group.Exit();
@@ -205,11 +221,17 @@
     /// @param  dt  the elapsed time in seconds since the previous frame
     void AudioSystem::OnUpdate( float dt )
     {
+        VoiceManager::Listener listener;
         if ( m_ActiveListener != nullptr )
         {
             m_ActiveListener->OnUpdate( dt );
+
+            listener.M_Position = m_ActiveListener->GetPosition();
+            listener.M_RolloffScale = m_ActiveListener->GetRolloffScale();
         }
 
+        m_Voices.Update( dt, m_ActiveListener != nullptr ? &listener : nullptr );
+
         m_System->update();
     }
 
@@ -238,6 +260,8 @@
 
             M_Group->setVolume( M_Volume );
             M_Group->setMute( M_Mute );
+
+            Audio()->GetVoices()->SetGroupMaxVoices( M_Group, M_MaxVoices );
         }
 
 
@@ -246,6 +270,7 @@
         {
             if ( M_Group != nullptr )
             {
+                Audio()->GetVoices()->SetGroupMaxVoices( M_Group, 0 );
                 M_Group->release();
             }
         }
@@ -277,6 +302,13 @@
                 changed = true;
             }
 
+            if ( ImGui::DragInt( "max voices", &M_MaxVoices, 0.05f, 0, INT_MAX ) )
+            {
+                Audio()->GetVoices()->SetGroupMaxVoices( M_Group, M_MaxVoices );
+                changed = true;
+            }
+            ImGui::SetItemTooltip( "the most sounds in this group that can play at once - quieter and lower priority sounds go virtual\n0 for no limit" );
+
             return changed;
         }
 
@@ -291,9 +323,10 @@
         ReadMethodMap< ISerializable > const& AudioSystem::AudioGroup::GetReadMethods() const
         {
             static ReadMethodMap< AudioGroup > const readMethods = {
-                { "Name"  , &AudioGroup::readName   },
-                { "Volume", &AudioGroup::readVolume },
-                { "Mute"  , &AudioGroup::readMute   }
+                { "Name"     , &AudioGroup::readName      },
+                { "Volume"   , &AudioGroup::readVolume    },
+                { "Mute"     , &AudioGroup::readMute      },
+                { "MaxVoices", &AudioGroup::readMaxVoices }
             };
 
             return (ReadMethodMap< ISerializable > const&)readMethods;
@@ -306,9 +339,10 @@
         {
             nlohmann::ordered_json json = nlohmann::ordered_json::object();
 
-            json[ "Name"   ] = Stream::Write( M_Name   );
-            json[ "Volume" ] = Stream::Write( M_Volume );
-            json[ "Mute"   ] = Stream::Write( M_Mute   );
+            json[ "Name"      ] = Stream::Write( M_Name      );
+            json[ "Volume"    ] = Stream::Write( M_Volume    );
+            json[ "Mute"      ] = Stream::Write( M_Mute      );
+            json[ "MaxVoices" ] = Stream::Write( M_MaxVoices );
 
             return json;
         }
@@ -341,6 +375,13 @@
             Stream::Read( M_Mute, data );
         }
 
+        /// @brief  reads the most sounds in this AudioGroup that can play at once
+        /// @param  data    the JSON data to read from
+        void AudioSystem::AudioGroup::readMaxVoices( nlohmann::ordered_json const& data )
+        {
+            Stream::Read( M_MaxVoices, data );
+        }
+
 
     //-----------------------------------------------------------------------------
 
@@ -531,6 +572,25 @@
         ImGui::DragInt( "max channels", &m_MaxChannels, 0.05f, 1, INT_MAX );
         ImGui::SetItemTooltip( "max channels will not update until the Engine restarts" );
 
+        int maxRealVoices = m_Voices.GetMaxRealVoices();
+        if ( ImGui::DragInt( "max real voices", &maxRealVoices, 0.05f, 1, m_MaxChannels ) )
+        {
+            m_Voices.SetMaxRealVoices( maxRealVoices );
+        }
+        ImGui::SetItemTooltip( "the most sounds that can play on channels at once - the rest play virtually until they're important enough" );
+
+        int maxVoices = m_Voices.GetMaxVoices();
+        if ( ImGui::DragInt( "max voices", &maxVoices, 0.05f, 1, INT_MAX ) )
+        {
+            m_Voices.SetMaxVoices( maxVoices );
+        }
+        ImGui::SetItemTooltip( "the most sounds that can be playing at once, real or virtual - the least important are stopped past this" );
+
+        ImGui::Text( "voices: %i (%i real)", m_Voices.GetVoiceCount(), m_Voices.GetRealVoiceCount() );
+        ImGui::Text( "dropped: %lli, stolen: %lli, realized: %lli",
+            m_Voices.GetDroppedCount(), m_Voices.GetStolenCount(), m_Voices.GetRealizedCount()
+        );
+
         if ( ImGui::DragFloat( "Master Volume", &m_Volume, 0.05f, 0.0f, INFINITY ) )
         {
             if ( m_System != nullptr )
@@ -571,6 +631,20 @@
         Stream::Read( m_MaxChannels, data );
     }
 
+    /// @brief  reads the most sounds that can play on real channels at once
+    /// @param  data    the JSON data to read from
+    void AudioSystem::readMaxRealVoices( nlohmann::ordered_json const& data )
+    {
+        m_Voices.SetMaxRealVoices( Stream::Read< int >( data ) );
+    }
+
+    /// @brief  reads the most sounds that can be playing at once, real or virtual
+    /// @param  data    the JSON data to read from
+    void AudioSystem::readMaxVoices( nlohmann::ordered_json const& data )
+    {
+        m_Voices.SetMaxVoices( Stream::Read< int >( data ) );
+    }
+
     /// @brief  reads the master volume of the AudioSystem
     /// @param  data    the JSON data to read from
     void AudioSystem::readVolume( nlohmann::ordered_json const& data )
@@ -596,9 +670,11 @@
     ReadMethodMap< ISerializable > const& AudioSystem::GetReadMethods() const
     {
         static ReadMethodMap< AudioSystem > const readMethods = {
-            { "MaxChannels", &AudioSystem::readMaxChannels },
-            { "Volume"     , &AudioSystem::readVolume      },
-            { "Groups"     , &AudioSystem::readGroups      }
+            { "MaxChannels"  , &AudioSystem::readMaxChannels   },
+            { "MaxRealVoices", &AudioSystem::readMaxRealVoices },
+            { "MaxVoices"    , &AudioSystem::readMaxVoices     },
+            { "Volume"       , &AudioSystem::readVolume        },
+            { "Groups"       , &AudioSystem::readGroups        }
         };
 
         return (ReadMethodMap< ISerializable > const&)readMethods;
@@ -611,9 +687,11 @@
     {
         nlohmann::ordered_json json;
 
-        json[ "MaxChannels" ] = Stream::Write( m_MaxChannels );
-        json[ "Volume"      ] = Stream::Write( m_Volume      );
-        json[ "Groups"      ] = Stream::WriteArray( m_Groups );
+        json[ "MaxChannels"   ] = Stream::Write( m_MaxChannels                );
+        json[ "MaxRealVoices" ] = Stream::Write( m_Voices.GetMaxRealVoices() );
+        json[ "MaxVoices"     ] = Stream::Write( m_Voices.GetMaxVoices()     );
+        json[ "Volume"        ] = Stream::Write( m_Volume                     );
+        json[ "Groups"        ] = Stream::WriteArray( m_Groups                );
 
         return json;
     }
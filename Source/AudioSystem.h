@@ -11,6 +11,8 @@
 #include "System.h"
 #include <fmod.hpp>
 
+#include "VoiceManager.h"
+
 
 class AudioListener;
 
@@ -33,6 +35,11 @@ public: // accessors
     AudioListener* GetActiveListener() const;
 
 
+    /// @brief  gets the VoiceManager that decides which sounds get channels
+    /// @return the VoiceManager
+    VoiceManager* GetVoices();
+
+
 //-----------------------------------------------------------------------------
 public: // methods
 //-----------------------------------------------------------------------------
@@ -109,6 +116,9 @@ private: // struct AudioGroup
         /// @brief  whether this AudioGroup is muted
         bool M_Mute = false;
 
+        /// @brief  the most sounds in this AudioGroup that can play at once - 0 for no limit
+        int M_MaxVoices = 0;
+
 
         /// @brief  the underlying FMOD ChannelGroup
         FMOD::ChannelGroup* M_Group = nullptr;
@@ -171,6 +181,10 @@ private: // struct AudioGroup
         /// @param  data    the JSON data to read from
         void readMute( nlohmann::ordered_json const& data );
 
+        /// @brief  reads the most sounds in this AudioGroup that can play at once
+        /// @param  data    the JSON data to read from
+        void readMaxVoices( nlohmann::ordered_json const& data );
+
 
     //-----------------------------------------------------------------------------
     };
@@ -200,6 +214,10 @@ private: // member variables
     std::vector< AudioGroup > m_Groups = {};
 
 
+    /// @brief  decides which of the sounds being played get channels
+    VoiceManager m_Voices;
+
+
 //-----------------------------------------------------------------------------
 private: // static methods
 //-----------------------------------------------------------------------------
@@ -247,6 +265,14 @@ private: // reading
     /// @param  data  the data to read from
     void readMaxChannels( nlohmann::ordered_json const& data );
 
+    /// @brief  reads the most sounds that can play on real channels at once
+    /// @param  data    the JSON data to read from
+    void readMaxRealVoices( nlohmann::ordered_json const& data );
+
+    /// @brief  reads the most sounds that can be playing at once, real or virtual
+    /// @param  data    the JSON data to read from
+    void readMaxVoices( nlohmann::ordered_json const& data );
+
     /// @brief  reads the master volume of the AudioSystem
     /// @param  data    the JSON data to read from
     void readVolume( nlohmann::ordered_json const& data );
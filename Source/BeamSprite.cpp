@@ -183,9 +183,10 @@
 
         ImGui::NewLine();
 
-        if ( ImGui::DragInt( "Layer", &m_Layer, 0.05f ) )
+        int layer = m_Layer;
+        if ( ImGui::DragInt( "Layer", &layer, 0.05f ) )
         {
-            SetLayer( m_Layer );
+            SetLayer( layer );
         }
 
         ImGui::NewLine();
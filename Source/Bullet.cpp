@@ -132,6 +132,15 @@
         return new Bullet( *this );
     }
 
+    /// @brief  resets this Bullet to a copy of another Bullet so that its Entity can be pooled
+    /// @param  other   the Bullet to copy
+    void Bullet::ResetTo( Component const& other )
+    {
+        Component::ResetTo( other );
+
+        m_Damage = static_cast< Bullet const& >( other ).m_Damage;
+    }
+
 
 //-----------------------------------------------------------------------------
 // private: copying
@@ -96,6 +96,15 @@ public: // copying
     /// @return the newly created clone of this RigidBody
     virtual Bullet* Clone() const override;
 
+    /// @brief  checks whether this Bullet can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a Bullet
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< Bullet >( other ); }
+
+    /// @brief  resets this Bullet to a copy of another Bullet so that its Entity can be pooled
+    /// @param  other   the Bullet to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
@@ -16,6 +16,7 @@
 #include "CircleCollider.h"
 
 #include "Health.h"
+#include "EntityPoolSystem.h"
 
 //-----------------------------------------------------------------------------
 // public: constructor / destructors
@@ -50,7 +51,7 @@
     {
         if (m_AoePulsePrefab)
         {
-            Entity* bullet = m_AoePulsePrefab->Clone();
+            Entity* bullet = EntityPools()->Spawn( m_AoePulsePrefab );
 
             // Sets the data within the bullet
             Transform* bulletTransform = bullet->GetComponent<Transform>();
@@ -146,6 +147,15 @@
         return new BulletAoe( *this );
     }
 
+    /// @brief  resets this BulletAoe to a copy of another BulletAoe so that its Entity can be pooled
+    /// @param  other   the BulletAoe to copy
+    void BulletAoe::ResetTo( Component const& other )
+    {
+        Bullet::ResetTo( other );
+
+        m_AoePulsePrefab = static_cast< BulletAoe const& >( other ).m_AoePulsePrefab;
+    }
+
 
 //-----------------------------------------------------------------------------
 // private: copying
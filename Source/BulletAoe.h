@@ -89,6 +89,15 @@ public: // copying
     /// @return the newly created clone of this RigidBody
     virtual BulletAoe* Clone() const override;
 
+    /// @brief  checks whether this BulletAoe can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a BulletAoe
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< BulletAoe >( other ); }
+
+    /// @brief  resets this BulletAoe to a copy of another BulletAoe so that its Entity can be pooled
+    /// @param  other   the BulletAoe to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
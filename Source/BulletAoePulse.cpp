@@ -35,24 +35,15 @@
     /// @brief Default constructor for the BulletAoePulse class.
     void BulletAoePulse::OnInit()
     {
-        for (EnemyBehavior const* enemy : Behaviors< EnemyBehavior >()->GetComponents())
-        {
-            /// Get the position of the turret
-            glm::vec2 turretPosition = GetEntity()->GetComponent<Transform>()->GetTranslation();
-
-            /// Get the position of the entity
-            glm::vec2 enemyPosition = enemy->GetTransform()->GetTranslation();
-
-            /// Calculate the direction from the turret to the entity
-            glm::vec2 offsetToEntity = enemyPosition - turretPosition;
+        /// Get the position of the turret
+        glm::vec2 turretPosition = GetEntity()->GetComponent<Transform>()->GetTranslation();
 
-            // check if the target is within range
-            float distanceSquared = glm::dot(offsetToEntity, offsetToEntity);
-            if (distanceSquared > m_Radius * m_Radius)
-            {
-                continue;
-            }
+        // damage every enemy within range
+        std::vector< EnemyBehavior* > enemies;
+        Behaviors< EnemyBehavior >()->QueryRadius(turretPosition, m_Radius, enemies);
 
+        for (EnemyBehavior const* enemy : enemies)
+        {
             Health* health = enemy->GetEntity()->GetComponent< Health >();
             if (health != nullptr)
             {
@@ -156,6 +147,17 @@
         return new BulletAoePulse( *this );
     }
 
+    /// @brief  resets this BulletAoePulse to a copy of another BulletAoePulse so that its Entity can be pooled
+    /// @param  other   the BulletAoePulse to copy
+    void BulletAoePulse::ResetTo( Component const& other )
+    {
+        Bullet::ResetTo( other );
+
+        BulletAoePulse const& pulse = static_cast< BulletAoePulse const& >( other );
+        m_Damage = pulse.m_Damage;
+        m_Radius = pulse.m_Radius;
+    }
+
 
 //-----------------------------------------------------------------------------
 // private: copying
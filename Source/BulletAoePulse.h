@@ -101,6 +101,15 @@ public: // copying
     /// @return the newly created clone of this RigidBody
     virtual BulletAoePulse* Clone() const override;
 
+    /// @brief  checks whether this BulletAoePulse can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a BulletAoePulse
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< BulletAoePulse >( other ); }
+
+    /// @brief  resets this BulletAoePulse to a copy of another BulletAoePulse so that its Entity can be pooled
+    /// @param  other   the BulletAoePulse to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
@@ -69,6 +69,55 @@
     }
 
 
+    /// @brief  gets whether this CircleCollider is swept along the path it moved each frame, so that it can't pass through things
+    /// @return whether this CircleCollider is swept
+    bool CircleCollider::GetIsSwept() const
+    {
+        return m_IsSwept;
+    }
+
+    /// @brief  sets whether this CircleCollider is swept along the path it moved each frame, so that it can't pass through things
+    /// @param  isSwept whether this CircleCollider should be swept
+    void CircleCollider::SetIsSwept( bool isSwept )
+    {
+        if ( isSwept == m_IsSwept )
+        {
+            return;
+        }
+
+        if ( m_Transform == nullptr )
+        {
+            m_IsSwept = isSwept;
+            return;
+        }
+
+        // the CollisionSystem sorts colliders when they're added, so re-add this one if it's already in there
+        Collisions()->RemoveCollider( this );
+        m_IsSwept = isSwept;
+        Collisions()->AddCollider( this );
+    }
+
+
+    /// @brief  gets where this CircleCollider's sweep starts from this frame
+    /// @return where this CircleCollider was at the end of the previous frame
+    glm::vec2 const& CircleCollider::GetSweepStart() const
+    {
+        return m_SweepStart;
+    }
+
+    /// @brief  starts this CircleCollider's next sweep from where it currently is
+    /// @note   call after teleporting a swept CircleCollider so that it doesn't collide with everything between
+    void CircleCollider::ResetSweep()
+    {
+        if ( m_Transform == nullptr )
+        {
+            return;
+        }
+
+        m_SweepStart = m_Transform->GetTranslation();
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: virtual overrides
 //-----------------------------------------------------------------------------
@@ -144,6 +193,12 @@
             m_HasChanged = true;
         }
 
+        bool isSwept = m_IsSwept;
+        if ( ImGui::Checkbox( "Is Swept", &isSwept ) )
+        {
+            SetIsSwept( isSwept );
+        }
+
         Collider::Inspector();
     }
 
@@ -158,6 +213,13 @@
     {
         m_Radius = data;
     }
+
+    /// @brief  Reads whether this CircleCollider is swept
+    /// @param  stream  The json data to read from
+    void CircleCollider::readIsSwept( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_IsSwept, data );
+    }
     
 
 //-----------------------------------------------------------------------------
@@ -171,6 +233,7 @@
     {
         static ReadMethodMap< CircleCollider > const readMethods = {
             { "Radius"             , &CircleCollider::readRadius              },
+            { "IsSwept"            , &CircleCollider::readIsSwept             },
             { "CollisionLayer"     , &CircleCollider::readCollisionLayer      },
             { "CollisionLayerFlags", &CircleCollider::readCollisionLayerFlags }
         };
@@ -187,6 +250,7 @@
         nlohmann::ordered_json data;
 
         data[ "Radius"              ] = Stream::Write( m_Radius                 );
+        data[ "IsSwept"             ] = Stream::Write( m_IsSwept                );
         data[ "CollisionLayer"      ] = Stream::Write( GetCollisionLayer()      );
         data[ "CollisionLayerFlags" ] = Stream::Write( GetCollisionLayerFlags() );
 
@@ -206,6 +270,19 @@
         return new CircleCollider( *this );
     }
 
+    /// @brief  resets this CircleCollider to a copy of another CircleCollider so that its Entity can be pooled
+    /// @param  other   the CircleCollider to copy
+    void CircleCollider::ResetTo( Component const& other )
+    {
+        Collider::ResetTo( other );
+
+        CircleCollider const& circle = static_cast< CircleCollider const& >( other );
+        m_Radius     = circle.m_Radius;
+        m_IsSwept    = circle.m_IsSwept;
+        m_HasChanged = false;
+        m_SweepStart = { 0.0f, 0.0f };
+    }
+
     
 //-----------------------------------------------------------------------------
 // private: copying
@@ -216,7 +293,8 @@
     /// @param  other   the collider to copy
     CircleCollider::CircleCollider( CircleCollider const& other ) :
         Collider( other ),
-        m_Radius( other.m_Radius )
+        m_Radius( other.m_Radius ),
+        m_IsSwept( other.m_IsSwept )
     {}
 
 
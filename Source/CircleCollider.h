@@ -47,6 +47,24 @@ public: // accessors
     void ClearHasChanged();
 
 
+    /// @brief  gets whether this CircleCollider is swept along the path it moved each frame, so that it can't pass through things
+    /// @return whether this CircleCollider is swept
+    bool GetIsSwept() const;
+
+    /// @brief  sets whether this CircleCollider is swept along the path it moved each frame, so that it can't pass through things
+    /// @param  isSwept whether this CircleCollider should be swept
+    void SetIsSwept( bool isSwept );
+
+
+    /// @brief  gets where this CircleCollider's sweep starts from this frame
+    /// @return where this CircleCollider was at the end of the previous frame
+    glm::vec2 const& GetSweepStart() const;
+
+    /// @brief  starts this CircleCollider's next sweep from where it currently is
+    /// @note   call after teleporting a swept CircleCollider so that it doesn't collide with everything between
+    void ResetSweep();
+
+
 //-----------------------------------------------------------------------------
 public: // virtual overrides
 //-----------------------------------------------------------------------------
@@ -75,6 +93,13 @@ private: // members
     /// @brief  whether this CircleCollider has changed and its position in the CollisionSystem needs to update
     bool m_HasChanged = false;
 
+
+    /// @brief  whether this CircleCollider is swept along the path it moved each frame
+    bool m_IsSwept = false;
+
+    /// @brief  where this CircleCollider was at the end of the previous frame
+    glm::vec2 m_SweepStart = { 0.0f, 0.0f };
+
     
 //-----------------------------------------------------------------------------
 public: // inspection
@@ -94,6 +119,10 @@ private: // reading
     /// @param  stream  The json data to read from
     void readRadius( nlohmann::ordered_json const& data );
 
+    /// @brief  Reads whether this CircleCollider is swept
+    /// @param  stream  The json data to read from
+    void readIsSwept( nlohmann::ordered_json const& data );
+
 
 //-----------------------------------------------------------------------------
 public: // reading / writing
@@ -119,6 +148,15 @@ public: // copying
     /// @return new clone of component
     virtual CircleCollider* Clone() const override;
 
+    /// @brief  checks whether this CircleCollider can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a CircleCollider
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< CircleCollider >( other ); }
+
+    /// @brief  resets this CircleCollider to a copy of another CircleCollider so that its Entity can be pooled
+    /// @param  other   the CircleCollider to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
@@ -79,7 +79,17 @@
     /// @param  layerId the collision layer to set
     void Collider::SetCollisionLayer( unsigned layerId )
     {
+        if ( layerId == m_CollisionLayerId )
+        {
+            return;
+        }
+
         m_CollisionLayerId = layerId;
+
+        for ( auto& [ id, callback ] : m_OnCollisionLayerChangedCallbacks )
+        {
+            callback();
+        }
     }
 
 
@@ -211,6 +221,34 @@
     }
 
 
+    /// @brief  adds a callback function to be called when this Collider's collision layer changes
+    /// @param  ownerId     the ID of the owner of the callback
+    /// @param  callback    the function to be called when the collision layer changes
+    /// @note   YOU MUST REMOVE THE CALLBACK WHEN YOU ARE DONE WITH IT
+    void Collider::AddOnCollisionLayerChangedCallback( unsigned ownerId, OnCollisionLayerChangedCallback callback )
+    {
+        m_OnCollisionLayerChangedCallbacks.push_back( { ownerId, std::move( callback ) } );
+    }
+
+    /// @brief  removes a callback function to be called when this Collider's collision layer changes
+    /// @param  ownerId the ID of the owner of the callback to remove
+    void Collider::RemoveOnCollisionLayerChangedCallback( unsigned ownerId )
+    {
+        auto it = std::find_if(
+            m_OnCollisionLayerChangedCallbacks.begin(),
+            m_OnCollisionLayerChangedCallbacks.end(),
+            [ ownerId ]( auto const& pair ) -> bool
+            {
+                return pair.first == ownerId;
+            }
+        );
+        if ( it != m_OnCollisionLayerChangedCallbacks.end() )
+        {
+            m_OnCollisionLayerChangedCallbacks.erase( it );
+        }
+    }
+
+
     /// @brief  calls all OnCollision callbacks attached to this Collider
     /// @param  other           the other entity this Collider collided with
     /// @param  collisionData   the collisionData of the collision
@@ -268,6 +306,30 @@
     }
 
 
+//-----------------------------------------------------------------------------
+// public: virtual override methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  resets the Collider part of this Component to a copy of another Collider
+    /// @param  other   the Collider to copy
+    /// @note   the callback lists are emptied rather than replaced, so they keep their memory
+    void Collider::ResetTo( Component const& other )
+    {
+        Component::ResetTo( other );
+
+        Collider const& collider = static_cast< Collider const& >( other );
+        m_CollisionLayerId    = collider.m_CollisionLayerId;
+        m_CollisionLayerFlags = collider.m_CollisionLayerFlags;
+
+        m_Contacts.clear();
+        m_OnCollisionCallbacks.clear();
+        m_OnCollisionEnterCallbacks.clear();
+        m_OnCollisionExitCallbacks.clear();
+        m_OnCollisionLayerChangedCallbacks.clear();
+    }
+
+
 //-----------------------------------------------------------------------------
 // private: methods
 //-----------------------------------------------------------------------------
@@ -313,7 +375,7 @@
             {
                 if ( ImGui::Selectable( collisionLayerNames[ i ].c_str(), m_CollisionLayerId == i ) )
                 {
-                    m_CollisionLayerId = i;
+                    SetCollisionLayer( i );
                 }
             }
             ImGui::EndCombo();
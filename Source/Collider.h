@@ -49,6 +49,9 @@ public: // types
     /// @param  collider        - the other Collider that this Collider collided with
     using OnCollisionStateChangeCallback = std::function< void ( Collider* collider ) >;
 
+    /// @brief  Callback called whenever this Collider's collision layer changes
+    using OnCollisionLayerChangedCallback = std::function< void () >;
+
     
 //-----------------------------------------------------------------------------
 protected: // constructor
@@ -154,6 +157,17 @@ public: // methods
     void RemoveOnCollisionExitCallback( unsigned ownerId );
 
 
+    /// @brief  adds a callback function to be called when this Collider's collision layer changes
+    /// @param  ownerId     the ID of the owner of the callback
+    /// @param  callback    the function to be called when the collision layer changes
+    /// @note   YOU MUST REMOVE THE CALLBACK WHEN YOU ARE DONE WITH IT
+    void AddOnCollisionLayerChangedCallback( unsigned ownerId, OnCollisionLayerChangedCallback callback );
+
+    /// @brief  removes a callback function to be called when this Collider's collision layer changes
+    /// @param  ownerId the ID of the owner of the callback to remove
+    void RemoveOnCollisionLayerChangedCallback( unsigned ownerId );
+
+
     /// @brief  calls all OnCollision callbacks attached to this Collider
     /// @param  other           the other entity this Collider collided with
     /// @param  collisionData   the collisionData of the collision
@@ -181,6 +195,11 @@ public: // virtual override methods
     virtual void DebugDraw() const = 0;
 
 
+    /// @brief  resets the Collider part of this Component to a copy of another Collider
+    /// @param  other   the Collider to copy
+    virtual void ResetTo( Component const& other ) override;
+
+
 //-----------------------------------------------------------------------------
 protected: // member variables
 //-----------------------------------------------------------------------------
@@ -216,6 +235,9 @@ protected: // member variables
     /// @brief  callbacks which get called whenever a collision ends
     std::vector< std::pair< unsigned, OnCollisionStateChangeCallback > > m_OnCollisionExitCallbacks = {};
 
+    /// @brief  callbacks which get called whenever the collision layer changes
+    std::vector< std::pair< unsigned, OnCollisionLayerChangedCallback > > m_OnCollisionLayerChangedCallbacks = {};
+
     
 //-----------------------------------------------------------------------------
 private: // methods
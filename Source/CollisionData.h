@@ -10,6 +10,8 @@
 
 #include "pch.h"
 
+#include "CollisionLayerFlags.h"
+
 class Collider;
 
 /// @struct CollisionData
@@ -25,6 +27,10 @@ struct CollisionData
     /// @brief How deep the collision penetrated
     float depth = 0.0f;
 
+    /// @brief  how far through the fixed frame the collision began, from 0 to 1
+    /// @note   only swept CircleColliders find collisions partway through a frame - everything else collides at 1
+    float timeOfImpact = 1.0f;
+
     /// @brief  negate operator
     /// @return a negated version of this CollisionData
     CollisionData operator -() const
@@ -57,4 +63,20 @@ struct RayCastHit
 
     /// @brief  implicit conversion to bool
     operator bool() const { return colliderHit != nullptr; }
-};
\ No newline at end of file
+};
+/// @struct RayCastQuery
+/// @brief  a ray to cast with CollisionSystem::RayCastBatch()
+struct RayCastQuery
+{
+    /// @brief  the origin of the ray
+    glm::vec2 origin = { 0.0f, 0.0f };
+
+    /// @brief  the direction of the ray - distances are measured in multiples of its length
+    glm::vec2 direction = { 1.0f, 0.0f };
+
+    /// @brief  the maximum distance of the ray
+    float maxDistance = 100.0f;
+
+    /// @brief  the layers for the ray to collide with
+    CollisionLayerFlags layers = (CollisionLayerFlags)-1;
+};
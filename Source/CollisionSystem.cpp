@@ -29,9 +29,35 @@
 #include "RenderSystem.h"
 
 #include "Engine.h"
+#include "ProfilerSystem.h"
+#include "JobSystem.h"
 
 #include "Inspection.h"
 
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+
+/// @brief  transforms a 2D point by a matrix, without the work of a full 4x4 multiply
+/// @param  matrix  the matrix to transform by - assumed to be a 2D affine transform
+/// @param  point   the point to transform
+/// @return the transformed point
+static glm::vec2 transformPoint2D( glm::mat4 const& matrix, glm::vec2 const& point )
+{
+    return glm::vec2( matrix[ 0 ] ) * point.x + glm::vec2( matrix[ 1 ] ) * point.y + glm::vec2( matrix[ 3 ] );
+}
+
+/// @brief  transforms a 2D direction by a matrix, without the work of a full 4x4 multiply
+/// @param  matrix      the matrix to transform by - assumed to be a 2D affine transform
+/// @param  direction   the direction to transform
+/// @return the transformed direction
+static glm::vec2 transformDirection2D( glm::mat4 const& matrix, glm::vec2 const& direction )
+{
+    return glm::vec2( matrix[ 0 ] ) * direction.x + glm::vec2( matrix[ 1 ] ) * direction.y;
+}
+
+
 //-----------------------------------------------------------------------------
 // public: methods
 //-----------------------------------------------------------------------------
@@ -41,6 +67,12 @@
     /// @param  circleCollider  the collider to add
     void CollisionSystem::AddCollider( CircleCollider* circleCollider )
     {
+        if ( circleCollider->GetIsSwept() )
+        {
+            m_SweptCircleColliders.push_back( circleCollider );
+            circleCollider->ResetSweep();
+        }
+
         if ( 2.0f * circleCollider->GetRadius() > m_GridSize )
         {
             m_LargeCircleColliders.push_back( circleCollider );
@@ -54,30 +86,43 @@
             return;
         }
 
-        glm::vec2 pos = circleCollider->GetTransform()->GetTranslation();
-        m_CircleCollidersGrid[ getGridCell( pos ) ].push_back( circleCollider );
+        insertIntoGrid( circleCollider );
     }
 
     /// @brief  removes a CircleCollider from the CollisionSystem
     /// @param  circleCollider  the collider to remove
     void CollisionSystem::RemoveCollider( CircleCollider* circleCollider )
     {
+        if ( circleCollider->GetIsSwept() )
+        {
+            std::erase( m_SweptCircleColliders, circleCollider );
+        }
+
         std::vector< CircleCollider* >* container = &m_LargeCircleColliders;
 
+        if ( circleCollider->GetHasChanged() )
+        {
+            updatePositionsInGrid();
+        }
+
         if ( 2.0f * circleCollider->GetRadius() <= m_GridSize )
         {
-            glm::vec2 pos = circleCollider->GetTransform()->GetTranslation();
+            glm::ivec2 cellPos = getGridCell( circleCollider->GetTransform()->GetTranslation() );
 
-            auto it = m_CircleCollidersGrid.find( getGridCell( pos ) );
-            if ( it == m_CircleCollidersGrid.end() )
+            if ( m_BroadPhase == BroadPhase::SpatialHash )
             {
-                Debug() << "ERROR: could not find cell to remove CircleCollider" << std::endl;
+                if ( m_CircleCollidersHashGrid.Remove( cellPos, circleCollider ) == false )
+                {
+                    Debug() << "ERROR: could not find CircleCollider to remove" << std::endl;
+                }
                 return;
             }
 
-            if ( circleCollider->GetHasChanged() )
+            auto it = m_CircleCollidersGrid.find( cellPos );
+            if ( it == m_CircleCollidersGrid.end() )
             {
-                updatePositionsInGrid();
+                Debug() << "ERROR: could not find cell to remove CircleCollider" << std::endl;
+                return;
             }
 
             container = &it->second;
@@ -149,47 +194,489 @@
     /// @return RayCastHit struct containing information about the result of the raycast
     RayCastHit CollisionSystem::RayCast( glm::vec2 const& origin, glm::vec2 const& direction, float maxDistance, CollisionLayerFlags layers ) const
     {
+        RayCastQuery ray = { origin, direction, maxDistance, layers };
         RayCastHit hit;
-        hit.distance = maxDistance;
+        castRays( &ray, 1, &hit, nullptr );
+        return hit;
+    }
 
-        for ( CircleCollider* circleCollider : m_LargeCircleColliders )
+    /// @brief  casts many rays in the scene at once
+    /// @param  rays        the rays to cast
+    /// @param  rayCount    how many rays to cast
+    /// @param  hits        where to write the result of each ray - must have room for rayCount hits
+    /// @param  threadCount how many threads to split the rays between - the calling thread and JobSystem workers.
+    ///                     1 casts every ray on the calling thread
+    /// @note   cheaper than calling RayCast() once per ray, as each collider is visited once for the whole batch
+    void CollisionSystem::RayCastBatch( RayCastQuery const* rays, int rayCount, RayCastHit* hits, int threadCount ) const
+    {
+        // most grid cells along a ray are empty, so for big batches it's cheaper to find which cells are occupied up
+        // front than to look up every cell of every ray
+        GridOccupancy occupancy;
+        GridOccupancy const* occupancyUsed = nullptr;
+        if ( rayCount >= s_MinRaysForOccupancy && buildGridOccupancy( rays, rayCount, &occupancy ) )
         {
-            checkRayCircle( origin, direction, circleCollider, &hit, layers );
+            occupancyUsed = &occupancy;
         }
 
-        for ( TilemapCollider* tilemapCollider : m_TilemapColliders )
+        threadCount = std::clamp( threadCount, 1, std::max( rayCount / s_MinRaysPerThread, 1 ) );
+        if ( threadCount == 1 )
         {
-            checkRayTilemap( origin, direction, tilemapCollider, &hit, layers );
+            castRays( rays, rayCount, hits, occupancyUsed );
+            return;
         }
 
-        glm::vec2 gridOrigin = origin * m_GridSize;
-        checkRayUnitGrid(
-            gridOrigin, direction,
-            [ & ]( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis ) -> bool
+        // tile flags are rebuilt on demand, so make sure none of the jobs will try to rebuild them
+        for ( TilemapCollider const* tilemapCollider : m_TilemapColliders )
+        {
+            tilemapCollider->PrepareTileFlags();
+        }
+
+        int raysPerThread = ( rayCount + threadCount - 1 ) / threadCount;
+
+        std::vector< JobSystem::JobId > jobs;
+        jobs.reserve( threadCount - 1 );
+        for ( int first = raysPerThread; first < rayCount; first += raysPerThread )
+        {
+            int count = std::min( raysPerThread, rayCount - first );
+            jobs.push_back( Jobs()->Push( [ this, rays, hits, occupancyUsed, first, count ]()
+            {
+                castRays( rays + first, count, hits + first, occupancyUsed );
+            } ) );
+        }
+
+        // the calling thread takes the first chunk instead of waiting idle
+        castRays( rays, raysPerThread, hits, occupancyUsed );
+
+        for ( JobSystem::JobId job : jobs )
+        {
+            Jobs()->Wait( job );
+        }
+    }
+
+
+    /// @brief  runs the broad phase over the current scene with each BroadPhase backend and reports pairs tested per second
+    /// @note   collision callbacks are not called while benchmarking
+    void CollisionSystem::RunBroadPhaseBenchmark()
+    {
+        static constexpr int steps = 100;
+        static char const* broadPhaseNames[ (int)BroadPhase::_Count ] = { "SortedMap", "SpatialHash" };
+
+        BroadPhase originalBroadPhase = m_BroadPhase;
+        m_IsBenchmarking = true;
+
+        for ( int i = 0; i < (int)BroadPhase::_Count; ++i )
+        {
+            SetBroadPhase( (BroadPhase)i );
+
+            // warm up so both backends start with their cells allocated
+            updatePositionsInGrid();
+            checkCollisions();
+
+            m_PairsTested = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+
+            for ( int step = 0; step < steps; ++step )
+            {
+                updatePositionsInGrid();
+                checkCollisions();
+            }
+
+            double seconds = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start ).count();
+
+            m_BenchmarkMsPerStep[ i ] = seconds * 1000.0 / steps;
+            m_BenchmarkPairsPerSecond[ i ] = seconds > 0.0 ? m_PairsTested / seconds : 0.0;
+
+            Debug() << "BroadPhase benchmark (" << broadPhaseNames[ i ] << "): " <<
+                m_PairsTested / steps << " pairs/step, " <<
+                m_BenchmarkMsPerStep[ i ] << " ms/step, " <<
+                m_BenchmarkPairsPerSecond[ i ] << " pairs/s" << std::endl;
+        }
+
+        m_IsBenchmarking = false;
+        m_PairsTested = 0;
+        SetBroadPhase( originalBroadPhase );
+    }
+
+
+    /// @brief  measures circle vs tilemap checks per second against every TilemapCollider in the scene, using the
+    ///         precomputed tile flags and the previous neighbor-scanning implementation
+    void CollisionSystem::RunTilemapBenchmark()
+    {
+        static constexpr int checkCount = 200000;
+
+        if ( m_TilemapColliders.empty() )
+        {
+            Debug() << "Tilemap benchmark: there are no TilemapColliders in the scene" << std::endl;
+            return;
+        }
+
+        for ( TilemapCollider const* tilemapCollider : m_TilemapColliders )
+        {
+            Tilemap< int > const* tilemap = tilemapCollider->GetTilemap();
+            if ( tilemap == nullptr || tilemapCollider->GetTransform() == nullptr )
+            {
+                continue;
+            }
+
+            // circles the size of typical enemies and bullets, scattered over the whole tilemap
+            std::mt19937 random( 0 );
+            glm::vec2 tileSize = glm::abs( tilemap->GetTileScale() * tilemapCollider->GetTransform()->GetScale() );
+            std::uniform_real_distribution< float > randomX( 0.0f, (float)tilemap->GetDimensions().x );
+            std::uniform_real_distribution< float > randomY( 0.0f, (float)tilemap->GetDimensions().y );
+            std::uniform_real_distribution< float > randomRadius( 0.1f * tileSize.x, 1.5f * tileSize.x );
+
+            std::vector< glm::vec3 > circles( checkCount );
+            for ( glm::vec3& circle : circles )
+            {
+                glm::vec2 pos = tilemap->GetTilemapToWorldMatrix() * glm::vec4( randomX( random ), randomY( random ), 0.0f, 1.0f );
+                circle = glm::vec3( pos, randomRadius( random ) );
+            }
+
+            // make sure the flags are built before timing
+            tilemapCollider->PrepareTileFlags();
+
+            auto runChecks = [ & ]( auto checkFunction, int* collisionCount, float* depthSum ) -> double
             {
-                if ( distance * m_GridSize >= hit.distance + m_GridSize )
+                *collisionCount = 0;
+                *depthSum = 0.0f;
+                auto start = std::chrono::high_resolution_clock::now();
+                for ( glm::vec3 const& circle : circles )
                 {
-                    return true;
+                    CollisionData collisionData;
+                    if ( checkFunction( glm::vec2( circle ), circle.z, tilemapCollider, &collisionData ) )
+                    {
+                        ++*collisionCount;
+                        *depthSum += collisionData.depth;
+                    }
                 }
+                return std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start ).count();
+            };
+
+            int neighborCollisions, flagCollisions;
+            float neighborDepth, flagDepth;
+            double neighborSeconds = runChecks( &checkCircleTilemapByNeighbors, &neighborCollisions, &neighborDepth );
+            double flagSeconds     = runChecks( &checkCircleTilemap           , &flagCollisions    , &flagDepth     );
+
+            Debug() << "Tilemap benchmark (\"" << tilemapCollider->GetEntity()->GetName() << "\", " <<
+                tilemap->GetDimensions().x << "x" << tilemap->GetDimensions().y << " tiles, " << checkCount << " circles): " <<
+                checkCount / neighborSeconds << " checks/s scanning neighbors, " <<
+                checkCount / flagSeconds << " checks/s with tile flags (" << neighborSeconds / flagSeconds << "x), " <<
+                flagCollisions << " collisions - " <<
+                ( neighborCollisions == flagCollisions && std::abs( neighborDepth - flagDepth ) <= 0.001f * std::abs( neighborDepth ) ? "results match" : "RESULTS DIFFER" ) <<
+                std::endl;
+        }
+    }
+
+
+    /// @brief  fires fast projectiles through the current scene and compares sweeping them against checking them at
+    ///         several steps per frame, reporting how many pass through what they should have hit and what each costs
+    void CollisionSystem::RunSweepBenchmark()
+    {
+        static constexpr int projectileCount = 2000;
+        static constexpr int frameCount = 30;
+        static constexpr int stepCounts[] = { 1, 2, 4, 8 };
+        static constexpr int methodCount = (int)std::size( stepCounts ) + 1;
+
+        // the size and speed of a fast bullet
+        static constexpr float projectileRadius = 0.1f;
+        static constexpr float projectileSpeed = 90.0f;
+
+        // fire the projectiles across the area covered by the scene's colliders
+        glm::vec2 boundsMin = glm::vec2( INFINITY );
+        glm::vec2 boundsMax = glm::vec2( -INFINITY );
+        auto includeInBounds = [ & ]( glm::vec2 const& pos )
+        {
+            boundsMin = glm::min( boundsMin, pos );
+            boundsMax = glm::max( boundsMax, pos );
+        };
+
+        for ( TilemapCollider const* tilemapCollider : m_TilemapColliders )
+        {
+            Tilemap< int > const* tilemap = tilemapCollider->GetTilemap();
+            if ( tilemap != nullptr )
+            {
+                includeInBounds( transformPoint2D( tilemap->GetTilemapToWorldMatrix(), glm::vec2( 0.0f ) ) );
+                includeInBounds( transformPoint2D( tilemap->GetTilemapToWorldMatrix(), tilemap->GetDimensions() ) );
+            }
+        }
+        for ( CircleCollider const* collider : m_LargeCircleColliders )
+        {
+            includeInBounds( collider->GetTransform()->GetTranslation() );
+        }
+        forEachGridCollider(
+            [ & ]( CircleCollider const* collider )
+            {
+                includeInBounds( collider->GetTransform()->GetTranslation() );
+            }
+        );
+
+        if ( boundsMin.x >= boundsMax.x || boundsMin.y >= boundsMax.y )
+        {
+            Debug() << "Sweep benchmark: there are not enough colliders in the scene" << std::endl;
+            return;
+        }
+
+        // a stand-in for the projectiles that collides with every layer
+        CircleCollider probe;
+        probe.SetRadius( projectileRadius );
+        probe.SetCollisionLayerFlags( (CollisionLayerFlags)-1 );
+
+        float frameDistance = projectileSpeed * GameEngine()->GetFixedFrameDuration();
+
+        std::mt19937 random( 0 );
+        std::uniform_real_distribution< float > randomX( boundsMin.x, boundsMax.x );
+        std::uniform_real_distribution< float > randomY( boundsMin.y, boundsMax.y );
+        std::uniform_real_distribution< float > randomAngle( 0.0f, glm::two_pi< float >() );
+
+        struct Projectile
+        {
+            glm::vec2 M_Start;
+            glm::vec2 M_Direction;
+        };
+        std::vector< Projectile > projectiles;
+        projectiles.reserve( projectileCount );
+        for ( int attempts = 0; (int)projectiles.size() < projectileCount && attempts < projectileCount * 100; ++attempts )
+        {
+            glm::vec2 start = { randomX( random ), randomY( random ) };
+            float angle = randomAngle( random );
+
+            // projectiles that spawn inside something would hit it no matter how they're checked
+            if ( findOverlap( &probe, start ) == nullptr )
+            {
+                projectiles.push_back( { start, glm::vec2( std::cos( angle ), std::sin( angle ) ) } );
+            }
+        }
+
+
+        // how far each projectile got before it first hit something using each method - the last method is sweeping
+        std::vector< float > firstHitDistances( projectiles.size() * methodCount, INFINITY );
+        double methodMs[ methodCount ] = {};
+
+        for ( int method = 0; method < methodCount; ++method )
+        {
+            bool isSwept = method == methodCount - 1;
+            int stepCount = isSwept ? 1 : stepCounts[ method ];
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for ( int i = 0; i < (int)projectiles.size(); ++i )
+            {
+                Projectile const& projectile = projectiles[ i ];
+                float& firstHitDistance = firstHitDistances[ i * methodCount + method ];
 
-                auto it = m_CircleCollidersGrid.find( cellPos );
-                if ( it == m_CircleCollidersGrid.end() )
+                for ( int frame = 0; frame < frameCount && firstHitDistance == INFINITY; ++frame )
                 {
-                    return false;
+                    glm::vec2 frameStart = projectile.M_Start + projectile.M_Direction * ( frameDistance * frame );
+
+                    if ( isSwept )
+                    {
+                        RayCastHit hit;
+                        hit.distance = frameDistance;
+                        sweepCircle( &probe, frameStart, projectile.M_Direction, &hit );
+                        if ( hit.colliderHit != nullptr )
+                        {
+                            firstHitDistance = frameDistance * frame + hit.distance;
+                        }
+                        continue;
+                    }
+
+                    for ( int step = 1; step <= stepCount && firstHitDistance == INFINITY; ++step )
+                    {
+                        float distance = frameDistance * ( frame + (float)step / stepCount );
+                        if ( findOverlap( &probe, projectile.M_Start + projectile.M_Direction * distance ) != nullptr )
+                        {
+                            firstHitDistance = distance;
+                        }
+                    }
                 }
+            }
+            methodMs[ method ] = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+        }
+
+
+        // what one step of the whole broad phase costs in this scene, which multi-stepping pays for every step
+        static constexpr int broadPhaseSteps = 20;
+        m_IsBenchmarking = true;
+        updatePositionsInGrid();
+        auto broadPhaseStart = std::chrono::high_resolution_clock::now();
+        for ( int step = 0; step < broadPhaseSteps; ++step )
+        {
+            updatePositionsInGrid();
+            checkCollisions();
+        }
+        double broadPhaseMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - broadPhaseStart ).count() / broadPhaseSteps;
+        m_IsBenchmarking = false;
+        m_PairsTested = 0;
+
+
+        Debug() << "Sweep benchmark (" << projectiles.size() << " projectiles, " << frameCount << " frames, " <<
+            frameDistance << " units per frame, " << broadPhaseMs << " ms per broad phase step):" << std::endl;
+
+        for ( int method = 0; method < methodCount; ++method )
+        {
+            bool isSwept = method == methodCount - 1;
+            int stepCount = isSwept ? 1 : stepCounts[ method ];
+
+            // sweeping finds exactly where each path first hits something, so a projectile that wasn't caught within
+            // one step of there passed through whatever it should have hit
+            float stepDistance = frameDistance / stepCount;
+            int hitCount = 0;
+            int tunnelledCount = 0;
+            for ( int i = 0; i < (int)projectiles.size(); ++i )
+            {
+                float firstHitDistance = firstHitDistances[ i * methodCount + method ];
+                float sweptHitDistance = firstHitDistances[ i * methodCount + methodCount - 1 ];
+                hitCount += firstHitDistance != INFINITY;
+                tunnelledCount += sweptHitDistance != INFINITY && firstHitDistance > sweptHitDistance + stepDistance + 0.001f;
+            }
+
+            double queryUs = methodMs[ method ] * 1000.0 / ( (double)projectiles.size() * frameCount );
+            Debug() << "    " << ( isSwept ? "swept, 1 step" : std::to_string( stepCount ) + " steps" ) << ": " <<
+                hitCount << " hits, " << tunnelledCount << " tunnelled, " <<
+                queryUs << " us per projectile per frame, ~" <<
+                stepCount * broadPhaseMs + methodMs[ method ] / frameCount << " ms per frame including the broad phase" << std::endl;
+        }
+    }
+
+
+    /// @brief  casts 10k rays per frame across the current scene's tilemaps, one at a time and in batches, and
+    ///         reports rays cast per second
+    void CollisionSystem::RunRayCastBenchmark()
+    {
+        static constexpr int rayCount = 10000;
+        static constexpr int frameCount = 20;
+        static constexpr float rayLength = 20.0f;
+
+        // cast the rays across the area covered by the scene's tilemaps
+        glm::vec2 boundsMin = glm::vec2( INFINITY );
+        glm::vec2 boundsMax = glm::vec2( -INFINITY );
+        for ( TilemapCollider const* tilemapCollider : m_TilemapColliders )
+        {
+            Tilemap< int > const* tilemap = tilemapCollider->GetTilemap();
+            if ( tilemap == nullptr )
+            {
+                continue;
+            }
+
+            glm::vec2 corners[] = {
+                transformPoint2D( tilemap->GetTilemapToWorldMatrix(), glm::vec2( 0.0f ) ),
+                transformPoint2D( tilemap->GetTilemapToWorldMatrix(), tilemap->GetDimensions() )
+            };
+            for ( glm::vec2 const& corner : corners )
+            {
+                boundsMin = glm::min( boundsMin, corner );
+                boundsMax = glm::max( boundsMax, corner );
+            }
+        }
+
+        if ( boundsMin.x >= boundsMax.x || boundsMin.y >= boundsMax.y )
+        {
+            Debug() << "RayCast benchmark: there are no tilemaps in the scene" << std::endl;
+            return;
+        }
+
+        std::mt19937 random( 0 );
+        std::uniform_real_distribution< float > randomX( boundsMin.x, boundsMax.x );
+        std::uniform_real_distribution< float > randomY( boundsMin.y, boundsMax.y );
+        std::uniform_real_distribution< float > randomAngle( 0.0f, glm::two_pi< float >() );
+
+        std::vector< RayCastQuery > rays( rayCount * frameCount );
+        for ( RayCastQuery& ray : rays )
+        {
+            float angle = randomAngle( random );
+            ray.origin = { randomX( random ), randomY( random ) };
+            ray.direction = glm::vec2( std::cos( angle ), std::sin( angle ) );
+            ray.maxDistance = rayLength;
+        }
+
+        // every JobSystem worker, plus the calling thread
+        int threadCount = Jobs()->GetWorkerCount() + 1;
+
+        static constexpr int methodCount = 3;
+        static char const* methodNames[ methodCount ] = { "RayCast", "RayCastBatch, 1 thread", "RayCastBatch, " };
+        std::vector< RayCastHit > hits[ methodCount ];
+        double methodSeconds[ methodCount ] = {};
+        for ( int method = 0; method < methodCount; ++method )
+        {
+            hits[ method ].resize( rays.size() );
 
-                for ( CircleCollider* collider : it->second )
+            auto start = std::chrono::high_resolution_clock::now();
+            for ( int frame = 0; frame < frameCount; ++frame )
+            {
+                RayCastQuery const* frameRays = rays.data() + frame * rayCount;
+                RayCastHit* frameHits = hits[ method ].data() + frame * rayCount;
+
+                if ( method == 0 )
+                {
+                    for ( int i = 0; i < rayCount; ++i )
+                    {
+                        frameHits[ i ] = RayCast( frameRays[ i ].origin, frameRays[ i ].direction, frameRays[ i ].maxDistance, frameRays[ i ].layers );
+                    }
+                }
+                else
                 {
-                    checkRayCircle( origin, direction, collider, &hit, layers );
+                    RayCastBatch( frameRays, rayCount, frameHits, method == 1 ? 1 : threadCount );
                 }
+            }
+            methodSeconds[ method ] = std::chrono::duration< double >( std::chrono::high_resolution_clock::now() - start ).count();
+        }
 
-                return false;
+        Debug() << "RayCast benchmark (" << rayCount << " rays per frame, " << frameCount << " frames, " <<
+            m_TilemapColliders.size() << " tilemaps, " << rayLength << " units per ray):" << std::endl;
+
+        for ( int method = 0; method < methodCount; ++method )
+        {
+            int hitCount = 0;
+            int mismatchCount = 0;
+            for ( int i = 0; i < (int)rays.size(); ++i )
+            {
+                RayCastHit const& hit = hits[ method ][ i ];
+                RayCastHit const& reference = hits[ 0 ][ i ];
+                hitCount += (bool)hit;
+                mismatchCount += hit.colliderHit != reference.colliderHit || hit.distance != reference.distance;
+            }
+
+            Debug() << "    " << methodNames[ method ] << ( method == 2 ? std::to_string( threadCount ) + " threads" : "" ) << ": " <<
+                methodSeconds[ method ] * 1000.0 / frameCount << " ms per frame, " <<
+                rays.size() / methodSeconds[ method ] << " rays/s, " <<
+                hitCount << " hits, " << mismatchCount << " differ from RayCast" << std::endl;
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  sets which BroadPhase backend to use, moving all grid colliders into it
+    /// @param  broadPhase  the BroadPhase backend to use
+    void CollisionSystem::SetBroadPhase( BroadPhase broadPhase )
+    {
+        if ( broadPhase == m_BroadPhase )
+        {
+            return;
+        }
+
+        std::vector< CircleCollider* > colliders;
+        forEachGridCollider(
+            [ &colliders ]( CircleCollider* collider )
+            {
+                colliders.push_back( collider );
             }
         );
 
-        return hit;
+        m_CircleCollidersGrid.clear();
+        m_CircleCollidersHashGrid.Clear();
+
+        m_BroadPhase = broadPhase;
+
+        for ( CircleCollider* collider : colliders )
+        {
+            insertIntoGrid( collider );
+        }
     }
 
+
 //-----------------------------------------------------------------------------
 // public: virtual override methods
 //-----------------------------------------------------------------------------
@@ -197,6 +684,15 @@
     /// @brief  Gets called once every simulation frame. Use this function for anything that affects the simulation.
     void CollisionSystem::OnFixedUpdate()
     {
+        m_PairsTested = 0;
+
+        // sweep first, so that the swept colliders are stopped where they hit something before the overlap checks run
+        if ( m_SweptCircleColliders.empty() == false )
+        {
+            updatePositionsInGrid();
+            sweepColliders();
+        }
+
         for ( int i = 0; i < m_CollisionSteps; ++i )
         {
             updatePositionsInGrid();
@@ -204,6 +700,10 @@
         }
 
         removeOutdatedContacts();
+
+        resetSweeps();
+
+        m_PairsTestedLastFrame = m_PairsTested;
     }
 
     /// @brief  creates the debug window for the CollisionSystem
@@ -234,6 +734,57 @@
 
         ImGui::DragInt( "collision steps", &m_CollisionSteps, 0.05f, 1, INT_MAX );
 
+        ImGui::NewLine();
+
+        static char const* broadPhaseNames[ (int)BroadPhase::_Count ] = { "SortedMap", "SpatialHash" };
+        if ( ImGui::BeginCombo( "broad phase", broadPhaseNames[ (int)m_BroadPhase ] ) )
+        {
+            for ( int i = 0; i < (int)BroadPhase::_Count; ++i )
+            {
+                bool isSelected = (int)m_BroadPhase == i;
+                if ( ImGui::Selectable( broadPhaseNames[ i ], isSelected ) )
+                {
+                    SetBroadPhase( (BroadPhase)i );
+                }
+
+                if ( isSelected )
+                {
+                    ImGui::SetItemDefaultFocus();
+                }
+            }
+
+            ImGui::EndCombo();
+        }
+
+        ImGui::Text( "pairs tested last frame: %i", m_PairsTestedLastFrame );
+        ImGui::Text( "swept colliders: %i, hit last frame: %i", (int)m_SweptCircleColliders.size(), m_SweptHitsLastFrame );
+        ImGui::Text(
+            "occupied cells: %i",
+            m_BroadPhase == BroadPhase::SpatialHash ? m_CircleCollidersHashGrid.GetCellCount() : (int)m_CircleCollidersGrid.size()
+        );
+
+        if ( ImGui::Button( "Run Broad Phase Benchmark" ) )
+        {
+            RunBroadPhaseBenchmark();
+        }
+        for ( int i = 0; i < (int)BroadPhase::_Count; ++i )
+        {
+            ImGui::Text(
+                "%s: %.3f ms/step, %.0f pairs/s",
+                broadPhaseNames[ i ], m_BenchmarkMsPerStep[ i ], m_BenchmarkPairsPerSecond[ i ]
+            );
+        }
+
+        if ( ImGui::Button( "Run Sweep Benchmark" ) )
+        {
+            RunSweepBenchmark();
+        }
+
+        if ( ImGui::Button( "Run RayCast Benchmark" ) )
+        {
+            RunRayCastBenchmark();
+        }
+
         ImGui::End();
 
         debugDrawColliders();
@@ -258,19 +809,20 @@
             circleCollider->DebugDraw();
         }
 
-        for ( auto& [ cellPos, colliders ] : m_CircleCollidersGrid )
-        {
-            for ( CircleCollider* circleCollider : colliders )
+        forEachGridCollider(
+            []( CircleCollider* circleCollider )
             {
                 circleCollider->DebugDraw();
             }
-        }
+        );
     }
 
 
     /// @brief Checks and handles all Collisions
     void CollisionSystem::checkCollisions()
     {
+        PROFILE_FUNCTION();
+
         // check collisions between large circle colliders and each other
         checkCollisions( &m_LargeCircleColliders );
 
@@ -278,15 +830,110 @@
         checkCollisions( &m_LargeCircleColliders, &m_TilemapColliders );
 
 
-        // check large circle colliders against grid
-        for ( CircleCollider* collider : m_LargeCircleColliders )
+        if ( m_BroadPhase == BroadPhase::SpatialHash )
         {
-            glm::vec2 pos = collider->GetTransform()->GetTranslation();
+            checkSpatialHashGridCollisions();
+        }
+        else
+        {
+            checkSortedMapGridCollisions();
+        }
+    }
 
-            glm::ivec2 minCell = getGridCell( pos - glm::vec2( collider->GetRadius() + m_GridSize ) );
-            glm::ivec2 maxCell = getGridCell( pos + glm::vec2( collider->GetRadius() + m_GridSize ) );
 
-            // for each row the collider overlaps
+    /// @brief  checks collisions between Colliders of the same type in a container
+    /// @tparam ColliderType    the Type of collider to check collisions between
+    /// @param  colliders       the container of the Colliders to check between
+    template < class ColliderType >
+    void CollisionSystem::checkCollisions( std::vector< ColliderType* >* colliders )
+    {
+        for ( int i = 0; i < colliders->size(); ++i )
+        {
+            ColliderType* colliderA = (*colliders)[ i ];
+
+            for ( int j = i + 1; j < colliders->size(); ++j )
+            {
+                ColliderType* colliderB = (*colliders)[ j ];
+
+                checkCollision( colliderA, colliderB );
+            }
+        }
+    }
+
+
+    /// @brief  checks and updates collision between Colliders in two containters
+    /// @tparam ColliderAType   the type of the first Collider
+    /// @tparam ColliderBType   the type of the second Collider
+    /// @param  collidersA      the first container of Colliders
+    /// @param  collidersB      the second container of Colliders
+    template < class ColliderAType, class ColliderBType >
+    void CollisionSystem::checkCollisions( std::vector< ColliderAType* >* collidersA, std::vector< ColliderBType* >* collidersB )
+    {
+        for ( ColliderAType* colliderA : *collidersA )
+        {
+            for ( ColliderBType* colliderB : *collidersB )
+            {
+                checkCollision( colliderA, colliderB );
+            }
+        }
+    }
+
+
+    
+    /// @brief  checks and updates collision between two collider of any known type
+    /// @tparam ColliderAType   the type of the first Collider
+    /// @tparam ColliderBType   the type of the second Collider
+    /// @param  colliderA       the first Collider
+    /// @param  colliderB       the second Collider
+    template < class ColliderAType, class ColliderBType >
+    void CollisionSystem::checkCollision( ColliderAType* colliderA, ColliderBType* colliderB )
+    {
+        bool aCollidesB = colliderA->GetCollisionLayerFlags().Includes( colliderB->GetCollisionLayer() );
+        bool bCollidesA = colliderB->GetCollisionLayerFlags().Includes( colliderA->GetCollisionLayer() );
+
+        // if neither Collider can collide with the other based on flags, return
+        if ( !(aCollidesB || bCollidesA) )
+        {
+            return;
+        }
+
+        ++m_PairsTested;
+
+        if ( m_IsBenchmarking )
+        {
+            checkCollision( colliderA, colliderB, nullptr );
+            return;
+        }
+
+        CollisionData collisionData = CollisionData();
+
+        // check the collision
+        bool needCollisionData = (aCollidesB && colliderA->HasOnCollisionCallbacks()) || (bCollidesA && colliderB->HasOnCollisionCallbacks());
+
+        bool touching = checkCollision( colliderA, colliderB, needCollisionData ? &collisionData : nullptr );
+
+
+        if ( touching == false )
+        {
+            return;
+        }
+
+        handleCollision( colliderA, colliderB, aCollidesB, bCollidesA, collisionData );
+    }
+
+
+    /// @brief  checks the small CircleColliders in the SortedMap grid
+    void CollisionSystem::checkSortedMapGridCollisions()
+    {
+        // check large circle colliders against grid
+        for ( CircleCollider* collider : m_LargeCircleColliders )
+        {
+            glm::vec2 pos = collider->GetTransform()->GetTranslation();
+
+            glm::ivec2 minCell = getGridCell( pos - glm::vec2( collider->GetRadius() + m_GridSize ) );
+            glm::ivec2 maxCell = getGridCell( pos + glm::vec2( collider->GetRadius() + m_GridSize ) );
+
+            // for each row the collider overlaps
             for ( glm::ivec2 cell = minCell; cell.y <= maxCell.y; ++cell.y )
             {
                 // find start of the row
@@ -349,9 +996,92 @@
     }
 
 
+    /// @brief  checks the small CircleColliders in the SpatialHash grid
+    void CollisionSystem::checkSpatialHashGridCollisions()
+    {
+        // check large circle colliders against grid
+        for ( CircleCollider* collider : m_LargeCircleColliders )
+        {
+            glm::vec2 pos = collider->GetTransform()->GetTranslation();
+
+            glm::ivec2 minCell = getGridCell( pos - glm::vec2( collider->GetRadius() + m_GridSize ) );
+            glm::ivec2 maxCell = getGridCell( pos + glm::vec2( collider->GetRadius() + m_GridSize ) );
+
+            // if the collider spans more cells than are occupied, it's cheaper to walk the occupied cells
+            glm::ivec2 span = maxCell - minCell + glm::ivec2( 1 );
+            if ( (long long)span.x * span.y > m_CircleCollidersHashGrid.GetCellCount() )
+            {
+                for ( auto& cell : m_CircleCollidersHashGrid )
+                {
+                    if (
+                        cell.position.x < minCell.x || cell.position.x > maxCell.x ||
+                        cell.position.y < minCell.y || cell.position.y > maxCell.y
+                    )
+                    {
+                        continue;
+                    }
+
+                    for ( CircleCollider* colliderB : cell.values )
+                    {
+                        checkCollision( collider, colliderB );
+                    }
+                }
+                continue;
+            }
+
+            for ( glm::ivec2 cell = minCell; cell.y <= maxCell.y; ++cell.y )
+            {
+                for ( cell.x = minCell.x; cell.x <= maxCell.x; ++cell.x )
+                {
+                    std::vector< CircleCollider* >* colliders = m_CircleCollidersHashGrid.Find( cell );
+                    if ( colliders == nullptr )
+                    {
+                        continue;
+                    }
+
+                    for ( CircleCollider* colliderB : *colliders )
+                    {
+                        checkCollision( collider, colliderB );
+                    }
+                }
+            }
+        }
+
+
+        // only check neighbors to the right and above so that each pair of cells is only visited once
+        static glm::ivec2 const neighborOffsets[] = {
+            glm::ivec2(  1, 0 ),
+            glm::ivec2( -1, 1 ),
+            glm::ivec2(  0, 1 ),
+            glm::ivec2(  1, 1 )
+        };
+
+        // loop through each cell with colliders in it
+        for ( auto& cell : m_CircleCollidersHashGrid )
+        {
+            // check collisions between multiple colliders in this cell
+            checkCollisions( &cell.values );
+
+            // check small circle colliders against tilemap colliders
+            checkCollisions( &cell.values, &m_TilemapColliders );
+
+            for ( glm::ivec2 const& offset : neighborOffsets )
+            {
+                std::vector< CircleCollider* >* neighbor = m_CircleCollidersHashGrid.Find( cell.position + offset );
+                if ( neighbor != nullptr )
+                {
+                    checkCollisions( &cell.values, neighbor );
+                }
+            }
+        }
+    }
+
+
     /// @brief  removes outdated contacts from all colliders
     void CollisionSystem::removeOutdatedContacts()
     {
+        PROFILE_FUNCTION();
+
         for ( CircleCollider* collider : m_LargeCircleColliders )
         {
             collider->RemoveOutdatedContacts();
@@ -362,18 +1092,287 @@
             collider->RemoveOutdatedContacts();
         }
 
-        for ( auto& [ cellPos, colliders ] : m_CircleCollidersGrid )
-        {
-            for ( CircleCollider* collider : colliders )
+        forEachGridCollider(
+            []( CircleCollider* collider )
             {
                 collider->RemoveOutdatedContacts();
             }
+        );
+    }
+
+
+    /// @brief  casts a range of rays, visiting each collider once for the whole range
+    /// @param  rays        the rays to cast
+    /// @param  rayCount    how many rays to cast
+    /// @param  hits        where to write the result of each ray
+    /// @param  occupancy   which grid cells the rays can skip without looking them up, or nullptr to look up every cell
+    void CollisionSystem::castRays( RayCastQuery const* rays, int rayCount, RayCastHit* hits, GridOccupancy const* occupancy ) const
+    {
+        for ( int i = 0; i < rayCount; ++i )
+        {
+            hits[ i ] = RayCastHit();
+            hits[ i ].distance = rays[ i ].maxDistance;
+        }
+
+        // loop over the rays inside the loop over the colliders, so that each collider's data is only brought into the
+        // cache once for the whole batch
+        for ( CircleCollider* circleCollider : m_LargeCircleColliders )
+        {
+            for ( int i = 0; i < rayCount; ++i )
+            {
+                checkRayCircle( rays[ i ].origin, rays[ i ].direction, circleCollider, &hits[ i ], rays[ i ].layers );
+            }
+        }
+
+        for ( TilemapCollider* tilemapCollider : m_TilemapColliders )
+        {
+            for ( int i = 0; i < rayCount; ++i )
+            {
+                checkRayTilemap( rays[ i ].origin, rays[ i ].direction, tilemapCollider, &hits[ i ], rays[ i ].layers );
+            }
+        }
+
+        // colliders in the grid are no wider than a cell, so a ray can only hit ones centered in or next to the cells it
+        // passes through
+        for ( int i = 0; i < rayCount; ++i )
+        {
+            RayCastQuery const& ray = rays[ i ];
+            RayCastHit* hit = &hits[ i ];
+            forEachGridColliderAlongPath(
+                ray.origin, ray.direction, 1, hit->distance,
+                [ &ray, hit ]( CircleCollider* collider )
+                {
+                    checkRayCircle( ray.origin, ray.direction, collider, hit, ray.layers );
+                },
+                occupancy
+            );
         }
     }
 
 
+    /// @brief  sweeps each swept CircleCollider along the path it moved since the previous frame, stopping it at the
+    ///         first thing it hits
+    void CollisionSystem::sweepColliders()
+    {
+        PROFILE_FUNCTION();
+
+        // how far short of a hit swept colliders stop, so that the overlap checks don't find the same collision again
+        static constexpr float skinWidth = 0.001f;
+
+        m_SweptHitsLastFrame = 0;
+
+        // collision callbacks can remove colliders, so don't hold onto an iterator
+        for ( int i = 0; i < (int)m_SweptCircleColliders.size(); ++i )
+        {
+            CircleCollider* collider = m_SweptCircleColliders[ i ];
+            Transform* transform = collider->GetTransform();
+
+            glm::vec2 start = collider->GetSweepStart();
+            glm::vec2 path = transform->GetTranslation() - start;
+            float length = glm::length( path );
+            if ( length == 0.0f )
+            {
+                continue;
+            }
+
+            glm::vec2 direction = path / length;
+
+            RayCastHit hit;
+            hit.distance = length;
+            sweepCircle( collider, start, direction, &hit );
+            if ( hit.colliderHit == nullptr )
+            {
+                continue;
+            }
+
+            ++m_SweptHitsLastFrame;
+
+            transform->SetTranslation( start + direction * std::max( hit.distance - skinWidth, 0.0f ) );
+
+            CollisionData collisionData;
+            collisionData.position = hit.position;
+            collisionData.normal = hit.normal;
+            collisionData.depth = 0.0f;
+            collisionData.timeOfImpact = hit.distance / length;
+
+            handleCollision(
+                collider, hit.colliderHit,
+                collider->GetCollisionLayerFlags().Includes( hit.colliderHit->GetCollisionLayer() ),
+                hit.colliderHit->GetCollisionLayerFlags().Includes( collider->GetCollisionLayer() ),
+                collisionData
+            );
+        }
+    }
+
+    /// @brief  starts the next sweep of each swept CircleCollider from where it is now
+    void CollisionSystem::resetSweeps()
+    {
+        for ( CircleCollider* collider : m_SweptCircleColliders )
+        {
+            collider->ResetSweep();
+        }
+    }
+
+
+    /// @brief  finds the first thing a circle hits while moving in a straight line through the scene
+    /// @param  collider    the collider being swept - used for its radius and collision layers, and is never hit itself
+    /// @param  start       where the circle starts
+    /// @param  direction   the normalized direction the circle moves in
+    /// @param  hit         the hit to fill out. distance must already be set to how far the circle moves
+    /// @note   everything other than the swept circle is treated as stationary
+    void CollisionSystem::sweepCircle( CircleCollider const* collider, glm::vec2 const& start, glm::vec2 const& direction, RayCastHit* hit ) const
+    {
+        float radius = collider->GetRadius();
+
+        auto canCollide = [ collider ]( Collider const* other ) -> bool
+        {
+            return other != collider && (
+                collider->GetCollisionLayerFlags().Includes( other->GetCollisionLayer() ) ||
+                other->GetCollisionLayerFlags().Includes( collider->GetCollisionLayer() )
+            );
+        };
+
+        auto sweepAgainstCircle = [ & ]( CircleCollider* other )
+        {
+            if ( canCollide( other ) == false )
+            {
+                return;
+            }
+
+            glm::vec2 otherPos = other->GetTransform()->GetTranslation();
+            if ( sweepCirclePoint( start, direction, radius + other->GetRadius(), otherPos, &hit->distance ) == false )
+            {
+                return;
+            }
+
+            glm::vec2 impactPos = start + direction * hit->distance;
+            hit->colliderHit = other;
+            hit->normal = glm::normalize( impactPos - otherPos );
+            hit->position = impactPos - hit->normal * radius;
+        };
+
+
+        for ( TilemapCollider* tilemapCollider : m_TilemapColliders )
+        {
+            if ( canCollide( tilemapCollider ) )
+            {
+                sweepCircleTilemap( start, direction, radius, tilemapCollider, hit );
+            }
+        }
+
+        for ( CircleCollider* other : m_LargeCircleColliders )
+        {
+            sweepAgainstCircle( other );
+        }
+
+
+        // colliders in the grid are no wider than a cell, so anything the circle can hit while its center is in a
+        // cell is centered no more than this many cells away from it
+        int reach = (int)std::ceil( radius / m_GridSize + 0.5f );
+        forEachGridColliderAlongPath( start, direction, reach, hit->distance, sweepAgainstCircle, nullptr );
+    }
+
+    /// @brief  checks whether a circle overlaps anything in the scene
+    /// @param  collider    the collider being checked - used for its radius and collision layers, and is never hit itself
+    /// @param  pos         the position of the circle
+    /// @return the first collider the circle overlaps, or nullptr if it doesn't overlap anything
+    Collider* CollisionSystem::findOverlap( CircleCollider const* collider, glm::vec2 const& pos ) const
+    {
+        float radius = collider->GetRadius();
+
+        auto canCollide = [ collider ]( Collider const* other ) -> bool
+        {
+            return other != collider && (
+                collider->GetCollisionLayerFlags().Includes( other->GetCollisionLayer() ) ||
+                other->GetCollisionLayerFlags().Includes( collider->GetCollisionLayer() )
+            );
+        };
+
+        auto overlapsCircle = [ & ]( CircleCollider const* other ) -> bool
+        {
+            glm::vec2 offset = other->GetTransform()->GetTranslation() - pos;
+            float minDistance = radius + other->GetRadius();
+            return canCollide( other ) && glm::dot( offset, offset ) < minDistance * minDistance;
+        };
+
+        for ( TilemapCollider* tilemapCollider : m_TilemapColliders )
+        {
+            if ( canCollide( tilemapCollider ) && checkCircleTilemap( pos, radius, tilemapCollider, nullptr ) )
+            {
+                return tilemapCollider;
+            }
+        }
+
+        for ( CircleCollider* other : m_LargeCircleColliders )
+        {
+            if ( overlapsCircle( other ) )
+            {
+                return other;
+            }
+        }
+
+        int reach = (int)std::ceil( radius / m_GridSize + 0.5f );
+        glm::ivec2 cellPos = getGridCell( pos );
+        for ( glm::ivec2 cell = cellPos - reach; cell.y <= cellPos.y + reach; ++cell.y )
+        {
+            for ( cell.x = cellPos.x - reach; cell.x <= cellPos.x + reach; ++cell.x )
+            {
+                std::vector< CircleCollider* > const* colliders = findGridCell( cell );
+                if ( colliders == nullptr )
+                {
+                    continue;
+                }
+
+                for ( CircleCollider* other : *colliders )
+                {
+                    if ( overlapsCircle( other ) )
+                    {
+                        return other;
+                    }
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+
     /// @brief  updates the position of each Collider in the grid, if necessary
     void CollisionSystem::updatePositionsInGrid()
+    {
+        PROFILE_FUNCTION();
+
+        if ( m_BroadPhase == BroadPhase::SpatialHash )
+        {
+            updateSpatialHashGridPositions();
+        }
+        else
+        {
+            updateSortedMapGridPositions();
+        }
+
+        // move colliders that are now small enough to be in the grid into the grid
+        std::erase_if(
+            m_LargeCircleColliders,
+            [ this ]( CircleCollider* collider ) -> bool
+            {
+                collider->ClearHasChanged();
+
+                if ( 2.0f * collider->GetRadius() > m_GridSize )
+                {
+                    return false;
+                }
+
+                insertIntoGrid( collider );
+
+                return true;
+            }
+        );
+    }
+
+
+    /// @brief  updates the position of each Collider in the SortedMap grid
+    void CollisionSystem::updateSortedMapGridPositions()
     {
         std::map< glm::ivec2, std::vector< CircleCollider* > > newCells = {};
 
@@ -434,114 +1433,287 @@
 
         // move new cells into the grid
         m_CircleCollidersGrid.insert( newCells.begin(), newCells.end() );
+    }
 
-        
-        // move colliders that are now small enough to be in the grid into the grid
-        std::erase_if(
-            m_LargeCircleColliders,
-            [ this ]( CircleCollider* collider ) -> bool
-            {
-                collider->ClearHasChanged();
 
-                if ( 2.0f * collider->GetRadius() > m_GridSize )
+    /// @brief  updates the position of each Collider in the SpatialHash grid
+    void CollisionSystem::updateSpatialHashGridPositions()
+    {
+        for ( auto& cell : m_CircleCollidersHashGrid )
+        {
+            // conditionally remove colliders from each cell
+            std::erase_if(
+                cell.values,
+                [ & ]( CircleCollider* collider ) -> bool
                 {
+                    // don't remove colliders that haven't changed
+                    if ( collider->GetHasChanged() == false )
+                    {
+                        return false;
+                    }
+
+                    collider->ClearHasChanged();
+
+                    // move colliders that've grown larger than the grid size to the large colliders array
+                    if ( 2.0f * collider->GetRadius() > m_GridSize )
+                    {
+                        m_LargeCircleColliders.push_back( collider );
+                        return true;
+                    }
+
+                    // queue colliders that've moved into a different cell to move once we're done iterating
+                    glm::ivec2 newCell = getGridCell( collider->GetTransform()->GetTranslation() );
+                    if ( newCell != cell.position )
+                    {
+                        m_PendingGridMoves.push_back( { collider, newCell } );
+                        return true;
+                    }
+
                     return false;
                 }
+            );
+        }
 
-                glm::vec2 pos = collider->GetTransform()->GetTranslation();
-                m_CircleCollidersGrid[ getGridCell( pos ) ].push_back( collider );
+        // insert before removing empty cells so that cells which are emptied and refilled in the same step are kept
+        for ( auto const& [ collider, cellPos ] : m_PendingGridMoves )
+        {
+            m_CircleCollidersHashGrid.Insert( cellPos, collider );
+        }
+        m_PendingGridMoves.clear();
 
-                return true;
-            }
-        );
+        m_CircleCollidersHashGrid.RemoveEmptyCells();
     }
 
 
-    /// @brief  gets the collision grid cell of a given world pos
-    /// @param  worldPos    the world position to get the grid cell of
-    /// @return the grid cell position containing the world pos
-    glm::ivec2 CollisionSystem::getGridCell( glm::vec2 const& worldPos ) const
+    /// @brief  inserts a small CircleCollider into the active grid
+    /// @param  circleCollider  the collider to insert
+    void CollisionSystem::insertIntoGrid( CircleCollider* circleCollider )
     {
-        return glm::ivec2( worldPos / m_GridSize );
-    }
+        glm::ivec2 cellPos = getGridCell( circleCollider->GetTransform()->GetTranslation() );
 
+        if ( m_BroadPhase == BroadPhase::SpatialHash )
+        {
+            m_CircleCollidersHashGrid.Insert( cellPos, circleCollider );
+        }
+        else
+        {
+            m_CircleCollidersGrid[ cellPos ].push_back( circleCollider );
+        }
+    }
 
-//-----------------------------------------------------------------------------
-// private: static methods
-//-----------------------------------------------------------------------------
+    /// @brief  finds the colliders in a cell of the active grid
+    /// @param  cellPos the cell to find
+    /// @return the colliders in the cell, or nullptr if the cell is empty
+    std::vector< CircleCollider* > const* CollisionSystem::findGridCell( glm::ivec2 const& cellPos ) const
+    {
+        if ( m_BroadPhase == BroadPhase::SpatialHash )
+        {
+            return m_CircleCollidersHashGrid.Find( cellPos );
+        }
 
-    
+        auto it = m_CircleCollidersGrid.find( cellPos );
+        return it == m_CircleCollidersGrid.end() ? nullptr : &it->second;
+    }
 
-    /// @brief  checks collisions between Colliders of the same type in a container
-    /// @tparam ColliderType    the Type of collider to check collisions between
-    /// @param  colliders       the container of the Colliders to check between
-    template < class ColliderType >
-    void CollisionSystem::checkCollisions( std::vector< ColliderType* >* colliders )
+    /// @brief  calls a function on every CircleCollider in the active grid
+    /// @tparam FunctionType    the type of the function to call
+    /// @param  function        the function to call on each collider
+    template < typename FunctionType >
+    void CollisionSystem::forEachGridCollider( FunctionType function )
     {
-        for ( int i = 0; i < colliders->size(); ++i )
+        if ( m_BroadPhase == BroadPhase::SpatialHash )
         {
-            ColliderType* colliderA = (*colliders)[ i ];
-
-            for ( int j = i + 1; j < colliders->size(); ++j )
+            for ( auto& cell : m_CircleCollidersHashGrid )
             {
-                ColliderType* colliderB = (*colliders)[ j ];
+                for ( CircleCollider* collider : cell.values )
+                {
+                    function( collider );
+                }
+            }
+            return;
+        }
 
-                checkCollision( colliderA, colliderB );
+        for ( auto& [ cellPos, colliders ] : m_CircleCollidersGrid )
+        {
+            for ( CircleCollider* collider : colliders )
+            {
+                function( collider );
             }
         }
     }
 
 
-    /// @brief  checks and updates collision between Colliders in two containters
-    /// @tparam ColliderAType   the type of the first Collider
-    /// @tparam ColliderBType   the type of the second Collider
-    /// @param  collidersA      the first container of Colliders
-    /// @param  collidersB      the second container of Colliders
-    template < class ColliderAType, class ColliderBType >
-    void CollisionSystem::checkCollisions( std::vector< ColliderAType* >* collidersA, std::vector< ColliderBType* >* collidersB )
+    /// @brief  calls a function on the CircleColliders in the active grid near a path, in the order the path reaches them
+    /// @tparam FunctionType    the type of the function to call
+    /// @param  start           the start of the path in world space
+    /// @param  direction       the direction of the path - distances are measured in multiples of its length
+    /// @param  reach           how many cells around each cell the path passes through to visit
+    /// @param  maxDistance     how far along the path to go. re-read at each cell, so the function may shorten it
+    /// @param  function        the function to call on each collider
+    /// @param  occupancy       which cells can be skipped without looking them up, or nullptr to look up every cell
+    template < typename FunctionType >
+    void CollisionSystem::forEachGridColliderAlongPath(
+        glm::vec2 const& start, glm::vec2 const& direction, int reach, float const& maxDistance,
+        FunctionType function, GridOccupancy const* occupancy
+    ) const
     {
-        for ( ColliderAType* colliderA : *collidersA )
+        auto visitCell = [ & ]( int x, int y )
         {
-            for ( ColliderBType* colliderB : *collidersB )
+            if ( occupancy != nullptr && occupancy->MayBeOccupied( { x, y } ) == false )
             {
-                checkCollision( colliderA, colliderB );
+                return;
+            }
+
+            // the walk uses floored cells, while the grid truncates towards zero
+            std::vector< CircleCollider* > const* colliders = findGridCell( {
+                x < 0 ? x + 1 : x,
+                y < 0 ? y + 1 : y
+            } );
+            if ( colliders == nullptr )
+            {
+                return;
+            }
+
+            for ( CircleCollider* collider : *colliders )
+            {
+                function( collider );
+            }
+        };
+
+        glm::vec2 gridStart = start / m_GridSize;
+        glm::ivec2 startCell = glm::floor( gridStart );
+        for ( int y = startCell.y - reach; y <= startCell.y + reach; ++y )
+        {
+            for ( int x = startCell.x - reach; x <= startCell.x + reach; ++x )
+            {
+                visitCell( x, y );
             }
         }
-    }
 
+        // each step moves one cell along one axis, so only the leading edge of the cells around the path is new
+        checkRayUnitGrid(
+            gridStart, direction / m_GridSize,
+            [ & ]( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis ) -> bool
+            {
+                if ( distance > maxDistance )
+                {
+                    return true;
+                }
 
-    
-    /// @brief  checks and updates collision between two collider of any known type
-    /// @tparam ColliderAType   the type of the first Collider
-    /// @tparam ColliderBType   the type of the second Collider
-    /// @param  colliderA       the first Collider
-    /// @param  colliderB       the second Collider
-    template < class ColliderAType, class ColliderBType >
-    void CollisionSystem::checkCollision( ColliderAType* colliderA, ColliderBType* colliderB )
+                int otherAxis = !stepAxis;
+                glm::ivec2 edgeCell = cellPos;
+                edgeCell[ stepAxis ] += stepDir[ stepAxis ] * reach;
+                for ( edgeCell[ otherAxis ] = cellPos[ otherAxis ] - reach; edgeCell[ otherAxis ] <= cellPos[ otherAxis ] + reach; ++edgeCell[ otherAxis ] )
+                {
+                    visitCell( edgeCell.x, edgeCell.y );
+                }
+
+                return false;
+            }
+        );
+    }
+
+    /// @brief  marks which cells of the active grid are occupied within the area a batch of rays can reach
+    /// @param  rays        the rays in the batch
+    /// @param  rayCount    how many rays are in the batch
+    /// @param  occupancy   the occupancy to fill out
+    /// @return whether the area was small enough to fill out the occupancy
+    bool CollisionSystem::buildGridOccupancy( RayCastQuery const* rays, int rayCount, GridOccupancy* occupancy ) const
     {
-        bool aCollidesB = colliderA->GetCollisionLayerFlags().Includes( colliderB->GetCollisionLayer() );
-        bool bCollidesA = colliderB->GetCollisionLayerFlags().Includes( colliderA->GetCollisionLayer() );
+        glm::vec2 boundsMin = glm::vec2( INFINITY );
+        glm::vec2 boundsMax = glm::vec2( -INFINITY );
+        for ( int i = 0; i < rayCount; ++i )
+        {
+            glm::vec2 end = rays[ i ].origin + rays[ i ].direction * rays[ i ].maxDistance;
+            boundsMin = glm::min( boundsMin, glm::min( rays[ i ].origin, end ) );
+            boundsMax = glm::max( boundsMax, glm::max( rays[ i ].origin, end ) );
+        }
 
-        // if neither Collider can collide with the other based on flags, return
-        if ( !(aCollidesB || bCollidesA) )
+        // leave room for the cells next to the ones the rays pass through
+        glm::vec2 minCell = glm::floor( boundsMin / m_GridSize ) - 1.0f;
+        glm::vec2 maxCell = glm::floor( boundsMax / m_GridSize ) + 1.0f;
+        glm::vec2 size = maxCell - minCell + 1.0f;
+        float cellCount = size.x * size.y;
+        if ( std::isfinite( cellCount ) == false || cellCount > s_MaxOccupancyCells )
+        {
+            return false;
+        }
+
+        occupancy->M_Min = glm::ivec2( minCell );
+        occupancy->M_Size = glm::ivec2( size );
+        occupancy->M_Bits.assign( ( occupancy->M_Size.x * occupancy->M_Size.y + 63 ) / 64, 0 );
+
+        // the grid truncates towards zero, so cell 0 covers two floored cells
+        auto markCell = [ occupancy ]( glm::ivec2 const& cellPos )
+        {
+            glm::ivec2 first = { cellPos.x > 0 ? cellPos.x : cellPos.x - 1, cellPos.y > 0 ? cellPos.y : cellPos.y - 1 };
+            glm::ivec2 last  = { cellPos.x < 0 ? cellPos.x - 1 : cellPos.x, cellPos.y < 0 ? cellPos.y - 1 : cellPos.y };
+
+            glm::ivec2 floored;
+            for ( floored.y = first.y; floored.y <= last.y; ++floored.y )
+            {
+                for ( floored.x = first.x; floored.x <= last.x; ++floored.x )
+                {
+                    glm::ivec2 local = floored - occupancy->M_Min;
+                    if ( local.x < 0 || local.y < 0 || local.x >= occupancy->M_Size.x || local.y >= occupancy->M_Size.y )
+                    {
+                        continue;
+                    }
+
+                    int bit = local.y * occupancy->M_Size.x + local.x;
+                    occupancy->M_Bits[ bit / 64 ] |= (uint64_t)1 << ( bit % 64 );
+                }
+            }
+        };
+
+        if ( m_BroadPhase == BroadPhase::SpatialHash )
+        {
+            for ( auto const& cell : m_CircleCollidersHashGrid )
+            {
+                if ( cell.values.empty() == false )
+                {
+                    markCell( cell.position );
+                }
+            }
+        }
+        else
         {
-            return;
+            for ( auto const& [ cellPos, colliders ] : m_CircleCollidersGrid )
+            {
+                if ( colliders.empty() == false )
+                {
+                    markCell( cellPos );
+                }
+            }
         }
 
-        CollisionData collisionData = CollisionData();
+        return true;
+    }
 
-        // check the collision
-        bool needCollisionData = (aCollidesB && colliderA->HasOnCollisionCallbacks()) || (bCollidesA && colliderB->HasOnCollisionCallbacks());
 
-        bool touching = checkCollision( colliderA, colliderB, needCollisionData ? &collisionData : nullptr );
+    /// @brief  gets the collision grid cell of a given world pos
+    /// @param  worldPos    the world position to get the grid cell of
+    /// @return the grid cell position containing the world pos
+    glm::ivec2 CollisionSystem::getGridCell( glm::vec2 const& worldPos ) const
+    {
+        return glm::ivec2( worldPos / m_GridSize );
+    }
 
 
-        if ( touching == false )
-        {
-            return;
-        }
+//-----------------------------------------------------------------------------
+// private: static methods
+//-----------------------------------------------------------------------------
+
+    
 
-        // handle callbacks
+    /// @brief  calls the collision callbacks of two touching Colliders and adds them to each other's contacts
+    /// @param  colliderA       the first Collider
+    /// @param  colliderB       the second Collider
+    /// @param  aCollidesB      whether the first Collider's layer flags include the second Collider
+    /// @param  bCollidesA      whether the second Collider's layer flags include the first Collider
+    /// @param  collisionData   information about the collision, from the perspective of the first Collider
+    void CollisionSystem::handleCollision( Collider* colliderA, Collider* colliderB, bool aCollidesB, bool bCollidesA, CollisionData const& collisionData )
+    {
         if ( aCollidesB )
         {
             colliderA->CallOnCollisionCallbacks( colliderB, collisionData );
@@ -702,6 +1874,107 @@
     /// @param  collisionData   pointer to where to store additional data about the collision
     /// @return whether or not the two colliders are colliding
     bool CollisionSystem::checkCollision( CircleCollider const* circleCollider, TilemapCollider const* tilemapCollider, CollisionData* collisionData )
+    {
+        return checkCircleTilemap( circleCollider->GetTransform()->GetTranslation(), circleCollider->GetRadius(), tilemapCollider, collisionData );
+    }
+
+
+    /// @brief  checks a circle against a tilemap collider
+    /// @param  circlePos       the position of the circle in world space
+    /// @param  circleRadius    the radius of the circle in world space
+    /// @param  tilemapCollider the tilemap collider
+    /// @param  collisionData   pointer to where to store additional data about the collision
+    /// @return whether or not the circle and tilemap are colliding
+    bool CollisionSystem::checkCircleTilemap( glm::vec2 circlePos, float circleRadius, TilemapCollider const* tilemapCollider, CollisionData* collisionData )
+    {
+        if ( tilemapCollider->GetTransform() == nullptr )
+        {
+            return false;
+        }
+
+
+        Tilemap< int > const* tilemap = (tilemapCollider)->GetTilemap();
+        if ( tilemap == nullptr )
+        {
+            return false;
+        }
+
+        glm::mat4 const& worldToTile = tilemap->GetWorldToTilemapMatrix();
+        glm::mat4 const& tileToWorld = tilemap->GetTilemapToWorldMatrix();
+        glm::vec2 tileSize = tilemap->GetTileScale() * tilemapCollider->GetTransform()->GetScale();
+
+        float radius = circleRadius / tileSize.x;
+
+        if ( std::abs( tileSize.x ) != std::abs( tileSize.y ) )
+        {
+            Debug() << "WARNING: Tilemap must be uniformly scaled for collisions to work" << std::endl;
+            return false;
+        }
+
+        glm::vec2 pos = transformPoint2D( worldToTile, circlePos );
+        glm::vec2 extents = glm::vec2( radius, radius );
+        glm::ivec2 minTile = glm::ivec2( std::floor( pos.x - extents.x ), std::floor( pos.y - extents.y ) );
+        glm::ivec2 maxTile = glm::ivec2( std::floor( pos.x + extents.x ), std::floor( pos.y + extents.y ) );
+
+        minTile.x = std::max( minTile.x, 0 );
+        minTile.y = std::max( minTile.y, 0 );
+
+        glm::ivec2 const& dimensions = tilemap->GetDimensions();
+
+        maxTile.x = std::min( maxTile.x, dimensions.x - 1 );
+        maxTile.y = std::min( maxTile.y, dimensions.y - 1 );
+
+        if (
+            minTile.x >= dimensions.x || maxTile.x < 0 ||
+            minTile.y >= dimensions.y || maxTile.y < 0
+        )
+        {
+            return false;
+        }
+
+
+        // which tiles are solid and which of their edges are enabled is kept up to date by the TilemapCollider
+        tilemapCollider->PrepareTileFlags();
+
+        bool collision = false;
+
+        glm::ivec2 tilePos;
+        for ( tilePos.y = minTile.y; tilePos.y <= maxTile.y; ++tilePos.y )
+        {
+            for ( tilePos.x = minTile.x; tilePos.x <= maxTile.x; ++tilePos.x )
+            {
+                uint8_t flags = tilemapCollider->GetTileFlags( tilePos );
+                if ( ( flags & TilemapCollider::s_TileSolid ) == 0 )
+                {
+                    continue;
+                }
+
+                if ( checkCircleAABB( pos, radius, tilePos, tilePos + glm::ivec2( 1, 1 ), collisionData, flags & TilemapCollider::s_TileEdges ) )
+                {
+                    collision = true;
+                }
+            }
+        }
+
+        if ( collisionData )
+        {
+            collisionData->normal = transformDirection2D( tileToWorld, collisionData->normal );
+            collisionData->position = transformPoint2D( tileToWorld, collisionData->position );
+        }
+
+        return collision;
+
+    }
+
+
+    /// @brief  checks a circle against a tilemap collider by scanning the neighbors of every overlapped tile
+    /// @param  circlePos       the position of the circle in world space
+    /// @param  circleRadius    the radius of the circle in world space
+    /// @param  tilemapCollider the tilemap collider
+    /// @param  collisionData   pointer to where to store additional data about the collision
+    /// @return whether or not the circle and tilemap are colliding
+    /// @note   the implementation from before tile flags were precomputed - only kept as a baseline for RunTilemapBenchmark()
+    bool CollisionSystem::checkCircleTilemapByNeighbors( glm::vec2 circlePos, float circleRadius, TilemapCollider const* tilemapCollider, CollisionData* collisionData )
     {
         if ( tilemapCollider->GetTransform() == nullptr )
         {
@@ -719,8 +1992,8 @@
         glm::mat4 const& tileToWorld = tilemap->GetTilemapToWorldMatrix();
         glm::vec2 tileSize = tilemap->GetTileScale() * tilemapCollider->GetTransform()->GetScale();
 
-        glm::vec2 pos = circleCollider->GetTransform()->GetTranslation();
-        float radius = circleCollider->GetRadius() / tileSize.x;
+        glm::vec2 pos = circlePos;
+        float radius = circleRadius / tileSize.x;
 
         if ( std::abs( tileSize.x ) != std::abs( tileSize.y ) )
         {
@@ -995,6 +2268,255 @@
 
 
 
+    /// @brief  sweeps a circle against a tilemap collider, walking the tiles along its path
+    /// @param  start           the start of the sweep in world space
+    /// @param  direction       the normalized direction of the sweep in world space
+    /// @param  circleRadius    the radius of the circle in world space
+    /// @param  tilemapCollider the tilemap collider
+    /// @param  hit             the current best hit, to be overridden if the circle hits the tilemap sooner
+    /// @return whether the circle hits the tilemap sooner than the current best hit
+    /// @note   tiles the circle already overlaps at the start of the sweep are ignored
+    bool CollisionSystem::sweepCircleTilemap( glm::vec2 const& start, glm::vec2 const& direction, float circleRadius, TilemapCollider* tilemapCollider, RayCastHit* hit )
+    {
+        if ( tilemapCollider->GetTransform() == nullptr )
+        {
+            return false;
+        }
+
+        Tilemap< int > const* tilemap = tilemapCollider->GetTilemap();
+        if ( tilemap == nullptr )
+        {
+            return false;
+        }
+
+        glm::vec2 tileSize = tilemap->GetTileScale() * tilemapCollider->GetTransform()->GetScale();
+        if ( std::abs( tileSize.x ) != std::abs( tileSize.y ) )
+        {
+            return false;
+        }
+
+        // the transform is linear, so distances along the sweep are the same in tile space as in world space
+        glm::mat4 const& worldToTile = tilemap->GetWorldToTilemapMatrix();
+        glm::vec2 tileStart = transformPoint2D( worldToTile, start );
+        glm::vec2 tileDirection = transformDirection2D( worldToTile, direction );
+        float radius = circleRadius / std::abs( tileSize.x );
+
+        glm::ivec2 const& dimensions = tilemap->GetDimensions();
+
+        // skip tilemaps the sweep doesn't come near
+        glm::vec2 tileEnd = tileStart + tileDirection * hit->distance;
+        glm::vec2 sweepMin = glm::min( tileStart, tileEnd ) - radius;
+        glm::vec2 sweepMax = glm::max( tileStart, tileEnd ) + radius;
+        if ( sweepMax.x < 0.0f || sweepMax.y < 0.0f || sweepMin.x > dimensions.x || sweepMin.y > dimensions.y )
+        {
+            return false;
+        }
+
+        tilemapCollider->PrepareTileFlags();
+
+        float distance = hit->distance;
+        glm::vec2 normal;
+        glm::ivec2 hitTile = { -1, -1 };
+
+        // anything the circle can hit while its center is in a tile is no more than this many tiles away from it
+        int reach = std::max( (int)std::ceil( radius ), 1 );
+
+        // walk the tiles the center passes through, only checking the tiles that weren't near the previous one
+        glm::ivec2 previousCell;
+        bool hasPreviousCell = false;
+        auto sweepTilesAround = [ & ]( glm::ivec2 const& cellPos )
+        {
+            glm::ivec2 minTile = glm::max( cellPos - reach, glm::ivec2( 0 ) );
+            glm::ivec2 maxTile = glm::min( cellPos + reach, dimensions - 1 );
+
+            glm::ivec2 tilePos;
+            for ( tilePos.y = minTile.y; tilePos.y <= maxTile.y; ++tilePos.y )
+            {
+                for ( tilePos.x = minTile.x; tilePos.x <= maxTile.x; ++tilePos.x )
+                {
+                    if ( hasPreviousCell && std::abs( tilePos.x - previousCell.x ) <= reach && std::abs( tilePos.y - previousCell.y ) <= reach )
+                    {
+                        continue;
+                    }
+
+                    uint8_t flags = tilemapCollider->GetTileFlags( tilePos );
+                    if ( ( flags & TilemapCollider::s_TileSolid ) == 0 )
+                    {
+                        continue;
+                    }
+
+                    if ( sweepCircleAABB( tileStart, tileDirection, radius, tilePos, tilePos + glm::ivec2( 1, 1 ), flags & TilemapCollider::s_TileEdges, &distance, &normal ) )
+                    {
+                        hitTile = tilePos;
+                    }
+                }
+            }
+
+            previousCell = cellPos;
+            hasPreviousCell = true;
+        };
+
+        sweepTilesAround( glm::floor( tileStart ) );
+        checkRayUnitGrid(
+            tileStart, tileDirection,
+            [ & ]( glm::ivec2 cellPos, float cellDistance, glm::ivec2 stepDir, int stepAxis ) -> bool
+            {
+                if ( cellDistance > distance )
+                {
+                    return true;
+                }
+
+                sweepTilesAround( cellPos );
+                return false;
+            }
+        );
+
+        if ( hitTile.x < 0 )
+        {
+            return false;
+        }
+
+        glm::vec2 impactPos = start + direction * distance;
+
+        hit->distance = distance;
+        hit->colliderHit = tilemapCollider;
+        hit->normal = glm::normalize( transformDirection2D( tilemap->GetTilemapToWorldMatrix(), normal ) );
+        hit->position = impactPos - hit->normal * circleRadius;
+        hit->tilePos = hitTile;
+
+        return true;
+    }
+
+    /// @brief  helper function which sweeps a circle against an AABB
+    /// @param  start           the start of the sweep
+    /// @param  direction       the direction of the sweep - distances are measured in multiples of its length
+    /// @param  circleRadius    the radius of the circle
+    /// @param  aabbMin         the min pos of the AABB
+    /// @param  aabbMax         the max pos of the AABB
+    /// @param  enabledEdges    flags of which edges of the AABB are enabled
+    /// @param  distance        how far the circle can move before it hits something else - shortened if it hits the AABB first
+    /// @param  normal          where to store the normal of the hit
+    /// @return whether the circle hits the AABB before it moves the given distance
+    bool CollisionSystem::sweepCircleAABB(
+        glm::vec2 const& start, glm::vec2 const& direction, float circleRadius,
+        glm::vec2 const& aabbMin, glm::vec2 const& aabbMax, int enabledEdges,
+        float* distance, glm::vec2* normal
+    )
+    {
+        // the circle can only reach tiles with no open edges by starting inside them
+        if ( enabledEdges == 0 )
+        {
+            return false;
+        }
+
+        // leave circles that start overlapping the AABB to the overlap checks
+        glm::vec2 closest = glm::clamp( start, aabbMin, aabbMax );
+        if ( glm::dot( start - closest, start - closest ) < circleRadius * circleRadius )
+        {
+            return false;
+        }
+
+        bool isHit = false;
+
+        // the edges the circle moves towards, pushed out by its radius
+        for ( int axis = 0; axis < 2; ++axis )
+        {
+            if ( direction[ axis ] == 0.0f )
+            {
+                continue;
+            }
+
+            bool movingPositive = direction[ axis ] > 0.0f;
+            int edge = axis == 0 ? ( movingPositive ? s_EdgeLeft : s_EdgeRight ) : ( movingPositive ? s_EdgeDown : s_EdgeUp );
+            if ( ( enabledEdges & edge ) == 0 )
+            {
+                continue;
+            }
+
+            float plane = movingPositive ? aabbMin[ axis ] - circleRadius : aabbMax[ axis ] + circleRadius;
+            float t = ( plane - start[ axis ] ) / direction[ axis ];
+            if ( t < 0.0f || t >= *distance )
+            {
+                continue;
+            }
+
+            float across = start[ !axis ] + direction[ !axis ] * t;
+            if ( across < aabbMin[ !axis ] || across > aabbMax[ !axis ] )
+            {
+                continue;
+            }
+
+            *distance = t;
+            *normal = glm::vec2( 0.0f );
+            ( *normal )[ axis ] = movingPositive ? -1.0f : 1.0f;
+            isHit = true;
+        }
+
+        // corners only stick out where both of their edges are enabled
+        glm::vec2 const corners[ 4 ] = { aabbMin, { aabbMax.x, aabbMin.y }, { aabbMin.x, aabbMax.y }, aabbMax };
+        int const cornerEdges[ 4 ] = {
+            s_EdgeLeft  | s_EdgeDown,
+            s_EdgeRight | s_EdgeDown,
+            s_EdgeLeft  | s_EdgeUp,
+            s_EdgeRight | s_EdgeUp
+        };
+        for ( int i = 0; i < 4; ++i )
+        {
+            if ( ( enabledEdges & cornerEdges[ i ] ) != cornerEdges[ i ] )
+            {
+                continue;
+            }
+
+            if ( sweepCirclePoint( start, direction, circleRadius, corners[ i ], distance ) )
+            {
+                *normal = glm::normalize( start + direction * *distance - corners[ i ] );
+                isHit = true;
+            }
+        }
+
+        return isHit;
+    }
+
+    /// @brief  helper function which sweeps a circle against a point
+    /// @param  start           the start of the sweep
+    /// @param  direction       the direction of the sweep - distances are measured in multiples of its length
+    /// @param  circleRadius    the radius of the circle
+    /// @param  point           the point to sweep against
+    /// @param  distance        how far the circle can move before it hits something else - shortened if it hits the point first
+    /// @return whether the circle hits the point before it moves the given distance
+    /// @note   a circle that starts over the point never hits it
+    bool CollisionSystem::sweepCirclePoint( glm::vec2 const& start, glm::vec2 const& direction, float circleRadius, glm::vec2 const& point, float* distance )
+    {
+        glm::vec2 offset = start - point;
+
+        // quadratic coefficients, with b halved
+        float a = glm::dot( direction, direction );
+        float b = glm::dot( direction, offset );
+        float c = glm::dot( offset, offset ) - circleRadius * circleRadius;
+
+        // starting over the point, or moving away from it
+        if ( c <= 0.0f || b >= 0.0f )
+        {
+            return false;
+        }
+
+        float radical = b * b - a * c;
+        if ( radical < 0.0f )
+        {
+            return false;
+        }
+
+        float t = ( -b - std::sqrt( radical ) ) / a;
+        if ( t >= *distance )
+        {
+            return false;
+        }
+
+        *distance = t;
+        return true;
+    }
+
+
     /// @brief  checks if a raycast hits a Circle
     /// @param  rayOrigin       the origin of the cast ray
     /// @param  rayDirection    the direction of the cast ray
@@ -1054,18 +2576,27 @@
         glm::mat4 const& worldToTile = tilemap->GetWorldToTilemapMatrix();
 
         // convert to tilemap space
-        glm::vec2 tilePos = worldToTile * glm::vec4( rayOrigin, 0, 1 );
-        glm::vec2 tileVel = worldToTile * glm::vec4( rayDirection, 0, 0 );
+        glm::vec2 tilePos = transformPoint2D( worldToTile, rayOrigin );
+        glm::vec2 tileVel = transformDirection2D( worldToTile, rayDirection );
+
+        glm::ivec2 dimensions = tilemap->GetDimensions();
+
+        // skip tilemaps the ray doesn't come near
+        glm::vec2 tileEnd = tilePos + tileVel * rayCastHit->distance;
+        glm::vec2 rayMin = glm::min( tilePos, tileEnd );
+        glm::vec2 rayMax = glm::max( tilePos, tileEnd );
+        if ( rayMax.x < 0.0f || rayMax.y < 0.0f || rayMin.x > dimensions.x || rayMin.y > dimensions.y )
+        {
+            return;
+        }
 
+        tilemapCollider->PrepareTileFlags();
 
+        // the transform is linear, so distances along the ray are the same in tile space as in world space
         checkRayUnitGrid(
             tilePos, tileVel,
-            [ rayOrigin, rayDirection, tilemapCollider, rayCastHit ]( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis ) -> bool
+            [ rayOrigin, rayDirection, tilemapCollider, rayCastHit, dimensions ]( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis ) -> bool
             {
-                Tilemap<int> const* tilemap = tilemapCollider->GetTilemap();
-
-                distance *= tilemap->GetTileScale().x;
-
                 if ( distance >= rayCastHit->distance )
                 {
                     return true;
@@ -1073,20 +2604,20 @@
 
                 // ensure within bounds of tilemap
                 if (
-                    cellPos.x < 0 || cellPos.x >= tilemap->GetDimensions().x ||
-                    cellPos.y < 0 || cellPos.y >= tilemap->GetDimensions().y
+                    cellPos.x < 0 || cellPos.x >= dimensions.x ||
+                    cellPos.y < 0 || cellPos.y >= dimensions.y
                 )
                 {
                     return (
                         ( cellPos.x < 0 && stepDir.x <= 0 ) ||
                         ( cellPos.y < 0 && stepDir.y <= 0 ) ||
-                        ( cellPos.x >= tilemap->GetDimensions().x && stepDir.x >= 0 ) ||
-                        ( cellPos.y >= tilemap->GetDimensions().y && stepDir.y >= 0 )
+                        ( cellPos.x >= dimensions.x && stepDir.x >= 0 ) ||
+                        ( cellPos.y >= dimensions.y && stepDir.y >= 0 )
                     );
                 }
                 
                 // check tile at current position
-                if ( tilemap->GetTile( cellPos ) >= 0 )
+                if ( tilemapCollider->GetTileFlags( cellPos ) & TilemapCollider::s_TileSolid )
                 {
                     rayCastHit->distance = distance;
                     rayCastHit->colliderHit = tilemapCollider;
@@ -1183,17 +2714,15 @@
 
 
     /// @brief  checks if a ray hits a unit grid
+    /// @tparam CallbackType        the type of the callback, called as bool( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis )
     /// @param  rayOrigin           the origin of the ray in grid space
     /// @param  rayDirection        the direction of the ray in grid space
     /// @param  gridCellCallback    callback that returns true when the ray should stop. argument is the current cell of the grid the ray is in.
-    void CollisionSystem::checkRayUnitGrid(
-        glm::vec2 const& rayOrigin,
-        glm::vec2 const& rayDirection,
-        std::function< bool ( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis ) > gridCellCallback
-    )
+    template < typename CallbackType >
+    void CollisionSystem::checkRayUnitGrid( glm::vec2 const& rayOrigin, glm::vec2 const& rayDirection, CallbackType gridCellCallback )
     {
 
-        glm::ivec2 tile = rayOrigin;
+        glm::ivec2 tile = glm::floor( rayOrigin );
 
         // direction of the step in each axis
         glm::ivec2 stepDir = {
@@ -1201,6 +2730,12 @@
             rayDirection.y > 0 ? 1 : ( rayDirection.y < 0 ? -1 : 0 )
         };
 
+        // a ray that doesn't move never leaves its cell
+        if ( stepDir.x == 0 && stepDir.y == 0 )
+        {
+            return;
+        }
+
         // length of the step in each axis
         glm::vec2 deltaT = {
             rayDirection.x == 0 ? INFINITY : 1 / std::abs( rayDirection.x ),
@@ -1212,9 +2747,9 @@
         if ( stepDir.x == 1 ) { t.x = 1 - t.x; }
         if ( stepDir.y == 1 ) { t.y = 1 - t.y; }
 
-        // can't just multiply because sometimes deltaT is infinity
-        t.x = t.x == 0 ? 0 : t.x * deltaT.x;
-        t.y = t.y == 0 ? 0 : t.y * deltaT.y;
+        // can't just multiply because deltaT is infinity on an axis the ray doesn't move along
+        t.x = stepDir.x == 0 ? INFINITY : t.x * deltaT.x;
+        t.y = stepDir.y == 0 ? INFINITY : t.y * deltaT.y;
 
         // loop until max distance reached
         while ( true )
@@ -1268,6 +2803,20 @@
     {
         Stream::Read( m_GridSize, data );
     }
+
+    /// @brief  reads which BroadPhase backend to use
+    /// @param  data    the json data to read from
+    void CollisionSystem::readBroadPhase( nlohmann::ordered_json const& data )
+    {
+        int broadPhase = Stream::Read< int >( data );
+        if ( broadPhase < 0 || broadPhase >= (int)BroadPhase::_Count )
+        {
+            Debug() << "WARNING: unknown BroadPhase " << broadPhase << ", using SpatialHash" << std::endl;
+            broadPhase = (int)BroadPhase::SpatialHash;
+        }
+
+        m_BroadPhase = (BroadPhase)broadPhase;
+    }
     
 //-----------------------------------------------------------------------------
 // public: reading / writing
@@ -1281,7 +2830,8 @@
         static ReadMethodMap< CollisionSystem > const readMethods = {
             { "CollisionLayerNames", &CollisionSystem::readCollisionLayerNames },
             { "CollisionSteps"     , &CollisionSystem::readCollisionSteps      },
-            { "GridSize"           , &CollisionSystem::readGridSize            }
+            { "GridSize"           , &CollisionSystem::readGridSize            },
+            { "BroadPhase"         , &CollisionSystem::readBroadPhase          }
         };
 
         return (ReadMethodMap< ISerializable > const&)readMethods;
@@ -1297,6 +2847,7 @@
         json[ "CollisionLayerNames" ] = Stream::Write( m_CollisionLayerNames );
         json[ "CollisionSteps"      ] = Stream::Write( m_CollisionSteps      );
         json[ "GridSize"            ] = Stream::Write( m_GridSize            );
+        json[ "BroadPhase"          ] = (int)m_BroadPhase;
 
         return json;
     }
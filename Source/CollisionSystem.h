@@ -17,6 +17,7 @@
 
     #include "CollisionData.h"
     #include "CollisionLayerFlags.h"
+    #include "SpatialHashGrid.h"
 
 //-----------------------------------------------------------------------------
 // Forward references:
@@ -49,6 +50,55 @@
 /// @brief  responsible for checking collsisions between all Colliders
 class CollisionSystem : public System
 {
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  which data structure the broad phase uses to store small CircleColliders
+    enum class BroadPhase
+    {
+        SortedMap,
+        SpatialHash,
+        _Count
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  which cells of the grid are occupied within an area, so that batches of rays can skip empty cells
+    ///         without looking them up
+    struct GridOccupancy
+    {
+        /// @brief  the first cell of the area, in floored cell coordinates
+        glm::ivec2 M_Min = { 0, 0 };
+
+        /// @brief  how many cells wide and tall the area is
+        glm::ivec2 M_Size = { 0, 0 };
+
+        /// @brief  one bit per cell of the area, row by row
+        std::vector< uint64_t > M_Bits = {};
+
+        /// @brief  checks whether a cell could contain any colliders
+        /// @param  cellPos the cell to check, in floored cell coordinates
+        /// @return false if the cell is known to be empty
+        bool MayBeOccupied( glm::ivec2 const& cellPos ) const
+        {
+            glm::ivec2 local = cellPos - M_Min;
+            if ( local.x < 0 || local.y < 0 || local.x >= M_Size.x || local.y >= M_Size.y )
+            {
+                return true;
+            }
+
+            int bit = local.y * M_Size.x + local.x;
+            return ( M_Bits[ bit / 64 ] >> ( bit % 64 ) ) & 1;
+        }
+    };
+
+
 //-----------------------------------------------------------------------------
 public: // methods
 //-----------------------------------------------------------------------------
@@ -90,6 +140,32 @@ public: // methods
     /// @return RayCastHit struct containing information about the result of the raycast
     RayCastHit RayCast( glm::vec2 const& origin, glm::vec2 const& direction, float maxDistance = 100.0f, CollisionLayerFlags layers = (CollisionLayerFlags)-1 ) const;
 
+    /// @brief  casts many rays in the scene at once
+    /// @param  rays        the rays to cast
+    /// @param  rayCount    how many rays to cast
+    /// @param  hits        where to write the result of each ray - must have room for rayCount hits
+    /// @param  threadCount how many threads to split the rays between - the calling thread and JobSystem workers.
+    ///                     1 casts every ray on the calling thread
+    /// @note   cheaper than calling RayCast() once per ray, as each collider is visited once for the whole batch
+    void RayCastBatch( RayCastQuery const* rays, int rayCount, RayCastHit* hits, int threadCount = 1 ) const;
+
+
+    /// @brief  runs the broad phase over the current scene with each BroadPhase backend and reports pairs tested per second
+    /// @note   collision callbacks are not called while benchmarking
+    void RunBroadPhaseBenchmark();
+
+    /// @brief  measures circle vs tilemap checks per second against every TilemapCollider in the scene, using the
+    ///         precomputed tile flags and the previous neighbor-scanning implementation
+    void RunTilemapBenchmark();
+
+    /// @brief  fires fast projectiles through the current scene and compares sweeping them against checking them at
+    ///         several steps per frame, reporting how many pass through what they should have hit and what each costs
+    void RunSweepBenchmark();
+
+    /// @brief  casts 10k rays per frame across the current scene's tilemaps, one at a time and in batches, and
+    ///         reports rays cast per second
+    void RunRayCastBenchmark();
+
 
 //-----------------------------------------------------------------------------
 public: // accessors
@@ -101,6 +177,15 @@ public: // accessors
     std::vector< std::string > const& GetLayerNames() const { return m_CollisionLayerNames; }
 
 
+    /// @brief  gets which BroadPhase backend is in use
+    /// @return which BroadPhase backend is in use
+    BroadPhase GetBroadPhase() const { return m_BroadPhase; }
+
+    /// @brief  sets which BroadPhase backend to use, moving all grid colliders into it
+    /// @param  broadPhase  the BroadPhase backend to use
+    void SetBroadPhase( BroadPhase broadPhase );
+
+
 //-----------------------------------------------------------------------------
 private: // virtual override methods
 //-----------------------------------------------------------------------------
@@ -130,9 +215,19 @@ private: // members
     float m_GridSize = 1.0f;
 
 
-    /// @brief  grid containing CircleColliders
+    /// @brief  which BroadPhase backend is in use
+    BroadPhase m_BroadPhase = BroadPhase::SpatialHash;
+
+
+    /// @brief  grid containing CircleColliders, used by the SortedMap broad phase
     std::map< glm::ivec2, std::vector< CircleCollider* > > m_CircleCollidersGrid = {};
 
+    /// @brief  grid containing CircleColliders, used by the SpatialHash broad phase
+    SpatialHashGrid< CircleCollider* > m_CircleCollidersHashGrid = {};
+
+    /// @brief  colliders queued to move to a new cell of m_CircleCollidersHashGrid
+    std::vector< std::pair< CircleCollider*, glm::ivec2 > > m_PendingGridMoves = {};
+
 
     /// @brief  all TilemapColliders in the Scene
     std::vector< TilemapCollider* > m_TilemapColliders = {};
@@ -140,6 +235,19 @@ private: // members
     /// @brief  all CircleColliders larger than the grid size in the scene
     std::vector< CircleCollider* > m_LargeCircleColliders = {};
 
+    /// @brief  all swept CircleColliders in the scene - these are also in the grid or m_LargeCircleColliders
+    std::vector< CircleCollider* > m_SweptCircleColliders = {};
+
+
+    /// @brief  RayCastBatch() doesn't give a thread fewer rays than this, so small batches aren't slowed down by handing out jobs
+    static constexpr int s_MinRaysPerThread = 256;
+
+    /// @brief  RayCastBatch() only finds which grid cells are occupied for batches of at least this many rays
+    static constexpr int s_MinRaysForOccupancy = 64;
+
+    /// @brief  the largest area, in cells, that RayCastBatch() will find which grid cells are occupied in
+    static constexpr float s_MaxOccupancyCells = 16.0f * 1024.0f * 1024.0f;
+
 
     /// @brief  bit flags for which edges of an AABB are enabled
     static constexpr int s_EdgeLeft  = 0b0001;
@@ -148,6 +256,25 @@ private: // members
     static constexpr int s_EdgeUp    = 0b1000;
     static constexpr int s_EdgeAll   = 0b1111;
 
+
+    /// @brief  the number of collider pairs that have been tested since the last reset
+    int m_PairsTested = 0;
+
+    /// @brief  the number of collider pairs tested during the previous fixed frame
+    int m_PairsTestedLastFrame = 0;
+
+    /// @brief  the number of swept CircleColliders that hit something partway through the previous fixed frame
+    int m_SweptHitsLastFrame = 0;
+
+    /// @brief  when set, pairs are tested but collision callbacks and contacts are skipped
+    bool m_IsBenchmarking = false;
+
+    /// @brief  pairs tested per second by each BroadPhase in the most recent benchmark
+    double m_BenchmarkPairsPerSecond[ (int)BroadPhase::_Count ] = {};
+
+    /// @brief  milliseconds per step of each BroadPhase in the most recent benchmark
+    double m_BenchmarkMsPerStep[ (int)BroadPhase::_Count ] = {};
+
     
 //-----------------------------------------------------------------------------
 private: // methods
@@ -161,14 +288,119 @@ private: // methods
     /// @brief  Checks and handles all Collisions
     void checkCollisions();
 
+    /// @brief  checks collisions between Colliders of the same type in a container
+    /// @tparam ColliderType    the Type of collider to check collisions between
+    /// @param  colliders       the container of the Colliders to check between
+    template < class ColliderType >
+    void checkCollisions( std::vector< ColliderType* >* colliders );
+
+
+    /// @brief  checks and updates collision between Colliders in two containters
+    /// @tparam ColliderAType   the type of the first Collider
+    /// @tparam ColliderBType   the type of the second Collider
+    /// @param  collidersA      the first container of Colliders
+    /// @param  collidersB      the second container of Colliders
+    template < class ColliderAType, class ColliderBType >
+    void checkCollisions( std::vector< ColliderAType* >* collidersA, std::vector< ColliderBType* >* collidersB );
+
+
+
+    /// @brief  checks and updates collision between two collider of any known type
+    /// @tparam ColliderAType   the type of the first Collider
+    /// @tparam ColliderBType   the type of the second Collider
+    /// @param  colliderA       the first Collider
+    /// @param  colliderB       the second Collider
+    template < class ColliderAType, class ColliderBType >
+    void checkCollision( ColliderAType* colliderA, ColliderBType* colliderB );
+
 
     /// @brief  removes outdated contacts from all colliders
     void removeOutdatedContacts();
 
 
+    /// @brief  sweeps each swept CircleCollider along the path it moved since the previous frame, stopping it at the
+    ///         first thing it hits
+    void sweepColliders();
+
+    /// @brief  starts the next sweep of each swept CircleCollider from where it is now
+    void resetSweeps();
+
+    /// @brief  finds the first thing a circle hits while moving in a straight line through the scene
+    /// @param  collider    the collider being swept - used for its radius and collision layers, and is never hit itself
+    /// @param  start       where the circle starts
+    /// @param  direction   the normalized direction the circle moves in
+    /// @param  hit         the hit to fill out. distance must already be set to how far the circle moves
+    /// @note   everything other than the swept circle is treated as stationary
+    void sweepCircle( CircleCollider const* collider, glm::vec2 const& start, glm::vec2 const& direction, RayCastHit* hit ) const;
+
+    /// @brief  checks whether a circle overlaps anything in the scene
+    /// @param  collider    the collider being checked - used for its radius and collision layers, and is never hit itself
+    /// @param  pos         the position of the circle
+    /// @return the first collider the circle overlaps, or nullptr if it doesn't overlap anything
+    Collider* findOverlap( CircleCollider const* collider, glm::vec2 const& pos ) const;
+
+
+    /// @brief  casts a range of rays, visiting each collider once for the whole range
+    /// @param  rays        the rays to cast
+    /// @param  rayCount    how many rays to cast
+    /// @param  hits        where to write the result of each ray
+    /// @param  occupancy   which grid cells the rays can skip without looking them up, or nullptr to look up every cell
+    void castRays( RayCastQuery const* rays, int rayCount, RayCastHit* hits, GridOccupancy const* occupancy ) const;
+
+    /// @brief  marks which cells of the active grid are occupied within the area a batch of rays can reach
+    /// @param  rays        the rays in the batch
+    /// @param  rayCount    how many rays are in the batch
+    /// @param  occupancy   the occupancy to fill out
+    /// @return whether the area was small enough to fill out the occupancy
+    bool buildGridOccupancy( RayCastQuery const* rays, int rayCount, GridOccupancy* occupancy ) const;
+
+
+    /// @brief  checks the small CircleColliders in the SortedMap grid
+    void checkSortedMapGridCollisions();
+
+    /// @brief  checks the small CircleColliders in the SpatialHash grid
+    void checkSpatialHashGridCollisions();
+
+
     /// @brief  updates the position of each Collider in the grid, if necessary
     void updatePositionsInGrid();
 
+    /// @brief  updates the position of each Collider in the SortedMap grid
+    void updateSortedMapGridPositions();
+
+    /// @brief  updates the position of each Collider in the SpatialHash grid
+    void updateSpatialHashGridPositions();
+
+
+    /// @brief  inserts a small CircleCollider into the active grid
+    /// @param  circleCollider  the collider to insert
+    void insertIntoGrid( CircleCollider* circleCollider );
+
+    /// @brief  finds the colliders in a cell of the active grid
+    /// @param  cellPos the cell to find
+    /// @return the colliders in the cell, or nullptr if the cell is empty
+    std::vector< CircleCollider* > const* findGridCell( glm::ivec2 const& cellPos ) const;
+
+    /// @brief  calls a function on every CircleCollider in the active grid
+    /// @tparam FunctionType    the type of the function to call
+    /// @param  function        the function to call on each collider
+    template < typename FunctionType >
+    void forEachGridCollider( FunctionType function );
+
+    /// @brief  calls a function on the CircleColliders in the active grid near a path, in the order the path reaches them
+    /// @tparam FunctionType    the type of the function to call
+    /// @param  start           the start of the path in world space
+    /// @param  direction       the direction of the path - distances are measured in multiples of its length
+    /// @param  reach           how many cells around each cell the path passes through to visit
+    /// @param  maxDistance     how far along the path to go. re-read at each cell, so the function may shorten it
+    /// @param  function        the function to call on each collider
+    /// @param  occupancy       which cells can be skipped without looking them up, or nullptr to look up every cell
+    template < typename FunctionType >
+    void forEachGridColliderAlongPath(
+        glm::vec2 const& start, glm::vec2 const& direction, int reach, float const& maxDistance,
+        FunctionType function, GridOccupancy const* occupancy
+    ) const;
+
 
     /// @brief  gets the collision grid cell of a given world pos
     /// @param  worldPos    the world position to get the grid cell of
@@ -182,30 +414,14 @@ private: // static methods
 
 
 
-    /// @brief  checks collisions between Colliders of the same type in a container
-    /// @tparam ColliderType    the Type of collider to check collisions between
-    /// @param  colliders       the container of the Colliders to check between
-    template < class ColliderType >
-    static void checkCollisions( std::vector< ColliderType* >* colliders );
 
-
-    /// @brief  checks and updates collision between Colliders in two containters
-    /// @tparam ColliderAType   the type of the first Collider
-    /// @tparam ColliderBType   the type of the second Collider
-    /// @param  collidersA      the first container of Colliders
-    /// @param  collidersB      the second container of Colliders
-    template < class ColliderAType, class ColliderBType >
-    static void checkCollisions( std::vector< ColliderAType* >* collidersA, std::vector< ColliderBType* >* collidersB );
-
-
-
-    /// @brief  checks and updates collision between two collider of any known type
-    /// @tparam ColliderAType   the type of the first Collider
-    /// @tparam ColliderBType   the type of the second Collider
+    /// @brief  calls the collision callbacks of two touching Colliders and adds them to each other's contacts
     /// @param  colliderA       the first Collider
     /// @param  colliderB       the second Collider
-    template < class ColliderAType, class ColliderBType >
-    static void checkCollision( ColliderAType* colliderA, ColliderBType* colliderB );
+    /// @param  aCollidesB      whether the first Collider's layer flags include the second Collider
+    /// @param  bCollidesA      whether the second Collider's layer flags include the first Collider
+    /// @param  collisionData   information about the collision, from the perspective of the first Collider
+    static void handleCollision( Collider* colliderA, Collider* colliderB, bool aCollidesB, bool bCollidesA, CollisionData const& collisionData );
 
 
     /// @brief  checks a collision between two circle colliders
@@ -222,6 +438,23 @@ private: // static methods
     /// @return whether or not the two colliders are colliding
     static bool checkCollision( CircleCollider const* circleCollider, TilemapCollider const* tilemapCollider, CollisionData* collisionData );
 
+    /// @brief  checks a circle against a tilemap collider
+    /// @param  circlePos       the position of the circle in world space
+    /// @param  circleRadius    the radius of the circle in world space
+    /// @param  tilemapCollider the tilemap collider
+    /// @param  collisionData   pointer to where to store additional data about the collision
+    /// @return whether or not the circle and tilemap are colliding
+    static bool checkCircleTilemap( glm::vec2 circlePos, float circleRadius, TilemapCollider const* tilemapCollider, CollisionData* collisionData );
+
+    /// @brief  checks a circle against a tilemap collider by scanning the neighbors of every overlapped tile
+    /// @param  circlePos       the position of the circle in world space
+    /// @param  circleRadius    the radius of the circle in world space
+    /// @param  tilemapCollider the tilemap collider
+    /// @param  collisionData   pointer to where to store additional data about the collision
+    /// @return whether or not the circle and tilemap are colliding
+    /// @note   the implementation from before tile flags were precomputed - only kept as a baseline for RunTilemapBenchmark()
+    static bool checkCircleTilemapByNeighbors( glm::vec2 circlePos, float circleRadius, TilemapCollider const* tilemapCollider, CollisionData* collisionData );
+
 
     /// @brief  helper function which checks a circle against an AABB
     /// @param  circlePos       the position of the circle
@@ -248,6 +481,43 @@ private: // static methods
     static bool checkCirclePoint( glm::vec2 const& circlePos, float circleRadius, glm::vec2 const& point, CollisionData* collisionData );
 
 
+    /// @brief  sweeps a circle against a tilemap collider, walking the tiles along its path
+    /// @param  start           the start of the sweep in world space
+    /// @param  direction       the normalized direction of the sweep in world space
+    /// @param  circleRadius    the radius of the circle in world space
+    /// @param  tilemapCollider the tilemap collider
+    /// @param  hit             the current best hit, to be overridden if the circle hits the tilemap sooner
+    /// @return whether the circle hits the tilemap sooner than the current best hit
+    /// @note   tiles the circle already overlaps at the start of the sweep are ignored
+    static bool sweepCircleTilemap( glm::vec2 const& start, glm::vec2 const& direction, float circleRadius, TilemapCollider* tilemapCollider, RayCastHit* hit );
+
+    /// @brief  helper function which sweeps a circle against an AABB
+    /// @param  start           the start of the sweep
+    /// @param  direction       the direction of the sweep - distances are measured in multiples of its length
+    /// @param  circleRadius    the radius of the circle
+    /// @param  aabbMin         the min pos of the AABB
+    /// @param  aabbMax         the max pos of the AABB
+    /// @param  enabledEdges    flags of which edges of the AABB are enabled
+    /// @param  distance        how far the circle can move before it hits something else - shortened if it hits the AABB first
+    /// @param  normal          where to store the normal of the hit
+    /// @return whether the circle hits the AABB before it moves the given distance
+    static bool sweepCircleAABB(
+        glm::vec2 const& start, glm::vec2 const& direction, float circleRadius,
+        glm::vec2 const& aabbMin, glm::vec2 const& aabbMax, int enabledEdges,
+        float* distance, glm::vec2* normal
+    );
+
+    /// @brief  helper function which sweeps a circle against a point
+    /// @param  start           the start of the sweep
+    /// @param  direction       the direction of the sweep - distances are measured in multiples of its length
+    /// @param  circleRadius    the radius of the circle
+    /// @param  point           the point to sweep against
+    /// @param  distance        how far the circle can move before it hits something else - shortened if it hits the point first
+    /// @return whether the circle hits the point before it moves the given distance
+    /// @note   a circle that starts over the point never hits it
+    static bool sweepCirclePoint( glm::vec2 const& start, glm::vec2 const& direction, float circleRadius, glm::vec2 const& point, float* distance );
+
+
     /// @brief  checks if a raycast hits a Circle
     /// @param  rayOrigin       the origin of the cast ray
     /// @param  rayDirection    the direction of the cast ray
@@ -266,14 +536,12 @@ private: // static methods
 
 
     /// @brief  checks if a ray hits a unit grid
+    /// @tparam CallbackType        the type of the callback, called as bool( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis )
     /// @param  rayOrigin           the origin of the ray in grid space
     /// @param  rayDirection        the direction of the ray in grid space
     /// @param  gridCellCallback    callback that returns true when the ray should stop
-    static void checkRayUnitGrid(
-        glm::vec2 const& rayOrigin,
-        glm::vec2 const& rayDirection,
-        std::function< bool ( glm::ivec2 cellPos, float distance, glm::ivec2 stepDir, int stepAxis ) > gridCellCallback
-    );
+    template < typename CallbackType >
+    static void checkRayUnitGrid( glm::vec2 const& rayOrigin, glm::vec2 const& rayDirection, CallbackType gridCellCallback );
 
 
 //-----------------------------------------------------------------------------
@@ -293,6 +561,10 @@ private: // reading
     /// @param  data    the json data to read from
     void readGridSize( nlohmann::ordered_json const& data );
 
+    /// @brief  reads which BroadPhase backend to use
+    /// @param  data    the json data to read from
+    void readBroadPhase( nlohmann::ordered_json const& data );
+
     
 //-----------------------------------------------------------------------------
 public: // reading / writing
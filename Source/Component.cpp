@@ -33,6 +33,20 @@
     {}
 
 
+//-----------------------------------------------------------------------------
+// public: virtual methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  resets this Component to a copy of another Component of the same type
+    /// @param  other   the Component to copy
+    /// @note   keeps this Component's Entity, but gets a new Id like the copy-constructor does
+    void Component::ResetTo( Component const& other )
+    {
+        m_Id = GetUniqueId();
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: accessors
 //-----------------------------------------------------------------------------
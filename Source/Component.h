@@ -74,6 +74,20 @@ public: // virtual methods
     virtual Component* Clone() const = 0;
 
 
+    /// @brief  checks whether this Component can be reset to a copy of another Component, without changing anything
+    /// @param  other   the Component that would be copied (usually the matching Component of this Entity's archetype)
+    /// @return whether ResetTo( other ) is supported - Entities with Components that don't support it aren't pooled
+    virtual bool CanResetTo( Component const& other ) const { return false; }
+
+    /// @brief  resets this Component to a copy of another Component of the same type, member by member, so that
+    ///         its Entity can be recycled by the EntityPoolSystem instead of deleted and re-cloned
+    /// @param  other   the Component to copy
+    /// @note   only call this after CanResetTo( other ) returned true
+    /// @note   overrides must call their base class's ResetTo, the same way copy constructors chain,
+    ///         and should clear containers rather than replace them so that they keep their memory
+    virtual void ResetTo( Component const& other );
+
+
 //-----------------------------------------------------------------------------
 public: // Accessors
 //-----------------------------------------------------------------------------
@@ -110,6 +124,23 @@ public: // engine methods
     void BaseComponentInspector();
 
 
+//-----------------------------------------------------------------------------
+protected: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  helper for CanResetTo() - checks that this Component and the other are both exactly a ComponentType
+    /// @tparam ComponentType   the type whose ResetTo() would be used
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a ComponentType
+    /// @note   derived Components that don't override ResetTo() would only be partially reset, so they don't match
+    template < class ComponentType >
+    bool isExactType( Component const& other ) const
+    {
+        return typeid( *this ) == typeid( ComponentType ) && typeid( other ) == typeid( ComponentType );
+    }
+
+
 //-----------------------------------------------------------------------------
 private: // member variables
 //-----------------------------------------------------------------------------
@@ -13,7 +13,10 @@
 #include "System.h"
 #include "Component.h"
 #include "Entity.h"
+#include "Transform.h"
+#include "Collider.h"
 
+#include "SpatialIndex.h"
 #include "Inspection.h"
 
 
@@ -40,6 +43,11 @@ public: // accessors
     void AddComponent( ComponentType* component )
     {
         m_Components.push_back( component );
+
+        if ( m_SpatialIndex != nullptr )
+        {
+            addToSpatialIndex( component );
+        }
     }
 
     /// @brief  removes a component to the ComponentSystem
@@ -47,6 +55,115 @@ public: // accessors
     void RemoveComponent( ComponentType* component )
     {
         m_Components.erase( std::find( m_Components.begin(), m_Components.end(), component ) );
+
+        if ( m_SpatialIndex != nullptr )
+        {
+            removeFromSpatialIndex( component );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+public: // spatial queries
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts tracking the positions of this System's components so that they can be spatially queried
+    /// @param  cellSize    the size of each cell of the spatial index
+    /// @note   queries enable the index automatically if it hasn't been enabled yet
+    void EnableSpatialIndex( float cellSize = 1.0f )
+    {
+        if ( m_SpatialIndex != nullptr )
+        {
+            for ( ComponentType* component : m_Components )
+            {
+                removeFromSpatialIndex( component );
+            }
+        }
+
+        m_SpatialIndex.reset( new SpatialIndex< ComponentType* >( cellSize ) );
+        for ( ComponentType* component : m_Components )
+        {
+            addToSpatialIndex( component );
+        }
+    }
+
+    /// @brief  gets this System's spatial index
+    /// @return the spatial index, or nullptr if it isn't enabled
+    SpatialIndex< ComponentType* > const* GetSpatialIndex() const
+    {
+        return m_SpatialIndex.get();
+    }
+
+    /// @brief  sets the radius a component covers in spatial queries
+    /// @param  component   the component to set the radius of
+    /// @param  radius      the radius the component covers
+    void SetSpatialRadius( ComponentType* component, float radius )
+    {
+        if ( m_SpatialIndex == nullptr )
+        {
+            EnableSpatialIndex();
+        }
+
+        m_SpatialIndex->SetRadius( component, radius );
+    }
+
+    /// @brief  finds all components whose radius overlaps a query circle
+    /// @param  center  the center of the query circle
+    /// @param  radius  the radius of the query circle
+    /// @param  results vector to append the found components to (in no particular order)
+    /// @param  layers  which collision layers to include (components without a Collider only match all layers)
+    void QueryRadius(
+        glm::vec2 const& center, float radius,
+        std::vector< ComponentType* >& results,
+        CollisionLayerFlags layers = SpatialIndex< ComponentType* >::AllLayers
+    )
+    {
+        if ( m_SpatialIndex == nullptr )
+        {
+            EnableSpatialIndex();
+        }
+
+        m_SpatialIndex->QueryRadius( center, radius, results, layers );
+    }
+
+    /// @brief  finds the component nearest to a point
+    /// @param  center          the point to search from
+    /// @param  maxDistance     the maximum distance to search (extended by each component's radius)
+    /// @param  layers          which collision layers to include (components without a Collider only match all layers)
+    /// @return the nearest component, or nullptr if none found
+    ComponentType* QueryNearest(
+        glm::vec2 const& center, float maxDistance = INFINITY,
+        CollisionLayerFlags layers = SpatialIndex< ComponentType* >::AllLayers
+    )
+    {
+        if ( m_SpatialIndex == nullptr )
+        {
+            EnableSpatialIndex();
+        }
+
+        return m_SpatialIndex->QueryNearest( center, maxDistance, layers );
+    }
+
+    /// @brief  finds the k components nearest to a point
+    /// @param  center          the point to search from
+    /// @param  k               the maximum number of components to find
+    /// @param  results         vector to append the found components to, nearest first
+    /// @param  maxDistance     the maximum distance to search (extended by each component's radius)
+    /// @param  layers          which collision layers to include (components without a Collider only match all layers)
+    void QueryKNearest(
+        glm::vec2 const& center, int k,
+        std::vector< ComponentType* >& results,
+        float maxDistance = INFINITY,
+        CollisionLayerFlags layers = SpatialIndex< ComponentType* >::AllLayers
+    )
+    {
+        if ( m_SpatialIndex == nullptr )
+        {
+            EnableSpatialIndex();
+        }
+
+        m_SpatialIndex->QueryKNearest( center, k, results, maxDistance, layers );
     }
 
     
@@ -63,6 +180,14 @@ private: // inspection
 
         if ( ImGui::Begin( componentName.c_str(), &windowOpen ) )
         {
+            if ( m_SpatialIndex != nullptr )
+            {
+                ImGui::Text(
+                    "Spatial index: %i components in %i cells (cell size %.2f)",
+                    m_SpatialIndex->GetCount(), m_SpatialIndex->GetCellCount(), m_SpatialIndex->GetCellSize()
+                );
+            }
+
             for ( ComponentType* component : m_Components )
             {
                 ImGui::PushID( component->GetId() );
@@ -91,12 +216,122 @@ private: // members
     /// @brief  the components this System is keeping track of
     std::vector< ComponentType* > m_Components = {};
 
+    /// @brief  index of the components' positions, or nullptr if spatial queries aren't used
+    std::unique_ptr< SpatialIndex< ComponentType* > > m_SpatialIndex = nullptr;
+
+
+//-----------------------------------------------------------------------------
+private: // helper methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  adds a component to the spatial index and keeps it in sync with its Transform
+    /// @param  component   the component to add
+    void addToSpatialIndex( ComponentType* component )
+    {
+        Transform* transform = component->GetEntity()->template GetComponent< Transform >();
+        if ( transform == nullptr )
+        {
+            return;
+        }
+
+        Collider* collider = component->GetEntity()->template GetComponent< Collider >();
+        m_SpatialIndex->Insert(
+            component,
+            transform->GetTranslation(),
+            0.0f,
+            collider != nullptr ? collider->GetCollisionLayer() : SpatialIndex< ComponentType* >::NoLayer
+        );
+
+        transform->AddOnTransformChangedCallback( GetId(), [ this, component, transform ]()
+        {
+            m_SpatialIndex->Move( component, transform->GetTranslation() );
+        } );
+
+        if ( collider != nullptr )
+        {
+            collider->AddOnCollisionLayerChangedCallback( GetId(), [ this, component, collider ]()
+            {
+                m_SpatialIndex->SetLayer( component, collider->GetCollisionLayer() );
+            } );
+        }
+    }
+
+    /// @brief  removes a component from the spatial index
+    /// @param  component   the component to remove
+    void removeFromSpatialIndex( ComponentType* component )
+    {
+        Transform* transform = component->GetEntity()->template GetComponent< Transform >();
+        if ( transform != nullptr )
+        {
+            transform->RemoveOnTransformChangedCallback( GetId() );
+        }
+
+        Collider* collider = component->GetEntity()->template GetComponent< Collider >();
+        if ( collider != nullptr )
+        {
+            collider->RemoveOnCollisionLayerChangedCallback( GetId() );
+        }
+
+        m_SpatialIndex->Remove( component );
+    }
+
+
+//-----------------------------------------------------------------------------
+protected: // reading / writing
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  reads the cell size of the spatial index, enabling it
+    /// @param  data    the JSON data to read from
+    /// @note   derived Systems that override GetReadMethods should add this under "SpatialIndexCellSize"
+    void readSpatialIndexCellSize( nlohmann::ordered_json const& data )
+    {
+        EnableSpatialIndex( Stream::Read< float >( data ) );
+    }
+
+    /// @brief  writes the cell size of the spatial index, if it's enabled
+    /// @param  json    the JSON data to write to
+    /// @note   derived Systems that override Write should call this
+    void writeSpatialIndexCellSize( nlohmann::ordered_json* json ) const
+    {
+        if ( m_SpatialIndex != nullptr )
+        {
+            ( *json )[ "SpatialIndexCellSize" ] = m_SpatialIndex->GetCellSize();
+        }
+    }
+
 
 //-----------------------------------------------------------------------------
-private: // reading
+public: // reading / writing
 //-----------------------------------------------------------------------------
 
 
+    /// @brief  gets this System's read methods
+    /// @return this System's read methods
+    /// @note   derived Systems that override this should chain to readSpatialIndexCellSize
+    virtual ReadMethodMap< ISerializable > const& GetReadMethods() const override
+    {
+        static ReadMethodMap< ComponentSystem< ComponentType > > const readMethods = {
+            { "SpatialIndexCellSize", &ComponentSystem< ComponentType >::readSpatialIndexCellSize }
+        };
+
+        return (ReadMethodMap< ISerializable > const&)readMethods;
+    }
+
+    /// @brief  writes this System to json
+    /// @return the written json data
+    /// @note   derived Systems that override this should chain to writeSpatialIndexCellSize
+    virtual nlohmann::ordered_json Write() const override
+    {
+        nlohmann::ordered_json json = nlohmann::ordered_json::object();
+
+        writeSpatialIndexCellSize( &json );
+
+        return json;
+    }
+
+
 //-----------------------------------------------------------------------------
 protected: // constructor
 //-----------------------------------------------------------------------------
@@ -0,0 +1,42 @@
+/// @file       ComponentTypeTable.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      gives every Component type a small integer ID, and caches which types derive from which
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "ComponentTypeTable.h"
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the ID of a type, giving it one if it doesn't have one yet
+    /// @param  type    the type to get the ID of
+    /// @return the ID of the type
+    int ComponentTypeTable::GetId( std::type_index const& type )
+    {
+        std::lock_guard< std::mutex > lock( s_IdsMutex );
+
+        return s_Ids.try_emplace( type, (int)s_Ids.size() ).first->second;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: static members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the ID of every type that has one
+    std::unordered_map< std::type_index, int > ComponentTypeTable::s_Ids;
+
+    /// @brief  guards s_Ids, since Entities may be read off the main thread
+    std::mutex ComponentTypeTable::s_IdsMutex;
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+/// @file       ComponentTypeTable.h
+/// @author     Oblivion Owls Inc
+/// @brief      gives every Component type a small integer ID, and caches which types derive from which
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+class Component;
+
+
+/// @brief  gives every Component type a small integer ID, and caches which types derive from which
+/// @note   IDs are handed out in the order types are first seen, so they aren't stable between runs - don't save them
+class ComponentTypeTable
+{
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the ID of a type, giving it one if it doesn't have one yet
+    /// @param  type    the type to get the ID of
+    /// @return the ID of the type
+    static int GetId( std::type_index const& type );
+
+    /// @brief  gets the ID of a type - only the first call for each type has to look it up
+    /// @tparam Type    the type to get the ID of
+    /// @return the ID of the type
+    template < typename Type >
+    static int GetId()
+    {
+        static int const id = GetId( typeid( Type ) );
+        return id;
+    }
+
+
+    /// @brief  checks whether a type of Component derives from (or is) another type
+    /// @tparam BaseType    the type to check against
+    /// @param  typeId      the ID of the type of the Component
+    /// @param  component   a Component of that type - only inspected the first time each pair of types is checked
+    /// @return whether the Component's type derives from BaseType
+    /// @note   the cache isn't locked, so only check from the main thread
+    template < typename BaseType >
+    static bool IsDerived( int typeId, Component const* component )
+    {
+        static std::vector< signed char > isDerived;
+
+        if ( typeId >= (int)isDerived.size() )
+        {
+            isDerived.resize( typeId + 1, -1 );
+        }
+
+        if ( isDerived[ typeId ] == -1 )
+        {
+            isDerived[ typeId ] = dynamic_cast< BaseType const* >( component ) != nullptr;
+        }
+
+        return isDerived[ typeId ] != 0;
+    }
+
+
+//-----------------------------------------------------------------------------
+private: // static members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the ID of every type that has one
+    static std::unordered_map< std::type_index, int > s_Ids;
+
+    /// @brief  guards s_Ids, since Entities may be read off the main thread
+    static std::mutex s_IdsMutex;
+
+
+//-----------------------------------------------------------------------------
+};
@@ -15,37 +15,38 @@
 #include "Console.h"
 #include "InputSystem.h"
 #include "CheatSystem.h"
+#include "CollisionSystem.h"
+#include "PathfindSystem.h"
+#include "TurretBehavior.h"
+#include "ProfilerSystem.h"
+#include "SceneSystem.h"
+#include "RenderSystem.h"
+#include "Tilemap.h"
+#include "EntitySystem.h"
+#include "CpuParticleBuffer.h"
+#include "LightBinner.h"
+#include "VoiceManager.h"
+#include "RigidBodySystem.h"
 
 //-----------------------------------------------------------------------------
 // public: methods
 //-----------------------------------------------------------------------------
 
-    /// @brief Adds a log to the console 
-    /// @param log  - A string to add to the console
+    /// @brief Adds a log to the console, dropping the oldest log once the console is full
+    /// @param log  - A complete line to add to the console
     void DebugConsole::AddLog(const std::string& log) 
     {
-        static std::string lastLog;
+        std::lock_guard< std::mutex > lock(m_ItemsMutex);
 
-        // Check if the log ends with a newline
-        if (!log.empty() && (log.back() == '\n' || log.back() == '\r')) 
+        if (m_Items.size() < s_MaxItems)
         {
-            // If lastLog is not empty, append it to the log before pushing.
-            if (!lastLog.empty()) 
-            {
-                m_Items.push_back(lastLog + log);
-                lastLog.clear(); // Clear lastLog since it's now pushed
-            }
-            else 
-            {
-                // Directly push the log if lastLog is empty.
-                m_Items.push_back(log);
-            }
-        }
-        else 
-        {
-            // Append the log to lastLog if it doesn't end with a newline.
-            lastLog += log;
+            m_Items.push_back(log);
+            return;
         }
+
+        // reuse the oldest line's storage
+        m_Items[m_FirstItem].assign(log);
+        m_FirstItem = (m_FirstItem + 1) % s_MaxItems;
     }
 
     /// @brief Shows the console window
@@ -122,8 +123,11 @@
                 ImGui::LogToClipboard();
             }
 
-            for (const std::string& item : m_Items) 
+            std::lock_guard< std::mutex > lock(m_ItemsMutex);
+            for (size_t i = 0; i < m_Items.size(); ++i) 
             {
+                const std::string& item = m_Items[(m_FirstItem + i) % m_Items.size()];
+
                 // If you don't have a filter, remove this conditional
                 if (!m_Filter.PassFilter(item.c_str()))
                     continue;
@@ -239,12 +243,39 @@
         m_ConsoleCommandsMap.emplace("InfiniteLaserMiningSpeed", std::bind(&CheatSystem::InfiniteLaserMiningSpeed, Cheats()));
         m_ConsoleCommandsMap.emplace("UnlockAllTurrets", std::bind(&CheatSystem::UnlockAllTurrets, Cheats()));
         m_ConsoleCommandsMap.emplace("ToggleLight", std::bind(&CheatSystem::ToggleLighting, Cheats()));
+
+        // benchmarks
+        m_ConsoleCommandsMap.emplace("BenchmarkBroadPhase", std::bind(&CollisionSystem::RunBroadPhaseBenchmark, Collisions()));
+        m_ConsoleCommandsMap.emplace("BenchmarkTilemapCollisions", std::bind(&CollisionSystem::RunTilemapBenchmark, Collisions()));
+        m_ConsoleCommandsMap.emplace("BenchmarkSweptCollisions", std::bind(&CollisionSystem::RunSweepBenchmark, Collisions()));
+        m_ConsoleCommandsMap.emplace("BenchmarkRayCasts", std::bind(&CollisionSystem::RunRayCastBenchmark, Collisions()));
+        m_ConsoleCommandsMap.emplace("BenchmarkTilemapStorage", &TilemapBase::RunStorageBenchmark);
+        m_ConsoleCommandsMap.emplace("BenchmarkPathfinding", std::bind(&PathfindSystem::RunBenchmark, Pathfinder()));
+        m_ConsoleCommandsMap.emplace("BenchmarkSpatialQueries", &TurretBehavior::RunTargetingBenchmark);
+        m_ConsoleCommandsMap.emplace("BenchmarkGetComponent", std::bind(&EntitySystem::RunComponentLookupBenchmark, Entities()));
+        m_ConsoleCommandsMap.emplace("BenchmarkSceneLoading", std::bind(&SceneSystem::RunLoadBenchmark, Scenes()));
+        m_ConsoleCommandsMap.emplace("BenchmarkDeserialization", std::bind(&SceneSystem::RunDeserializationBenchmark, Scenes()));
+        m_ConsoleCommandsMap.emplace("BenchmarkSceneSwitch", std::bind(&SceneSystem::RunSceneSwitchBenchmark, Scenes()));
+        m_ConsoleCommandsMap.emplace("BenchmarkLogging", []() { Log()->RunBenchmark(); });
+        m_ConsoleCommandsMap.emplace("BenchmarkSpriteBatching", std::bind(&RenderSystem::RunBatchingBenchmark, Renderer()));
+        m_ConsoleCommandsMap.emplace("BenchmarkCpuParticles", &CpuParticleBuffer::RunBenchmark);
+        m_ConsoleCommandsMap.emplace("BenchmarkLightBinning", &LightBinner::RunBenchmark);
+        m_ConsoleCommandsMap.emplace("BenchmarkVoices", &VoiceManager::RunBenchmark);
+        m_ConsoleCommandsMap.emplace("BenchmarkRigidBodies", std::bind(&RigidBodySystem::RunBenchmark, RigidBodies()));
+
+        // scenes
+        m_ConsoleCommandsMap.emplace("CookScenes", std::bind(&SceneSystem::CookAllScenes, Scenes()));
+
+        // profiling
+        m_ConsoleCommandsMap.emplace("ExportProfilerTrace", []() { Profiler()->ExportTrace(); });
     }
 
     /// @brief Clears the console log
     void DebugConsole::ClearLog()
     {
+        std::lock_guard< std::mutex > lock(m_ItemsMutex);
 	    m_Items.clear();
+        m_FirstItem = 0;
     }
 
     /// @brief Calls a Command given a string
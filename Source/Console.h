@@ -16,6 +16,7 @@
 #include "DebugSystem.h"
 #include <string>
 #include <map>
+#include <mutex>
 
 
 /// @brief The DebugConsole class is a singleton that provides a console for debugging
@@ -26,8 +27,9 @@ class DebugConsole: public ISerializable
 public: // methods
 //-----------------------------------------------------------------------------
     
-    /// @brief Adds a log to the console
-    /// @param log - A string to add to the console
+    /// @brief Adds a log to the console, dropping the oldest log once the console is full
+    /// @param log - A complete line to add to the console
+    /// @note  called from the Logger's writer thread
     void AddLog(std::string const& log);
 
     /// @brief Shows the console window
@@ -48,6 +50,13 @@ private: // types
     /// @brief Functor for the cheats
     using CheatFunction = std::function< void() >;
 
+//-----------------------------------------------------------------------------
+private: // constants
+//-----------------------------------------------------------------------------
+
+    /// @brief The most lines the console keeps before dropping the oldest
+    static constexpr size_t s_MaxItems = 2048;
+
 //-----------------------------------------------------------------------------
 private: // members
 //-----------------------------------------------------------------------------
@@ -58,9 +67,15 @@ private: // members
     /// @brief  the buffer for the console
     std::string m_Buffer;
 
-    /// @brief The list of items in the console
+    /// @brief The lines in the console - a ring buffer once it reaches s_MaxItems
     std::vector<std::string> m_Items;
 
+    /// @brief The index of the oldest line in m_Items
+    size_t m_FirstItem = 0;
+
+    /// @brief Guards m_Items against the Logger's writer thread
+    std::mutex m_ItemsMutex;
+
     /// @brief A map of cheat codes.
     std::unordered_map<std::string, CheatFunction> m_ConsoleCommandsMap;
 
@@ -553,19 +553,11 @@
             return false;
         }
 
-        for (Generator* generator : Behaviors< Generator >()->GetComponents())
-        {
-            float distance = glm::distance(
-                generator->GetTransform()->GetTranslation(),
-                m_TargetPos
-            );
-            if (distance <= generator->GetPowerRadius())
-            {
-                return true;
-            }
-        }
+        // Generators are indexed with their power radius, so any result means the target is powered
+        std::vector< Generator* > generators;
+        Behaviors< Generator >()->QueryRadius( m_TargetPos, 0.0f, generators );
 
-        return false;
+        return generators.empty() == false;
     }
 
     /// @brief  palces the currently selected building
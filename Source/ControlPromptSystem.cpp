@@ -94,7 +94,7 @@
             return;
         }
 
-        Stream::PushDebugLocation( m_PromptMappingFilepath + "::" );
+        Stream::PushDebugLocation( m_PromptMappingFilepath, "::" );
 
         Stream::Read( m_MappingInfo, Stream::ParseFromFile( m_PromptMappingFilepath ) );
 
@@ -0,0 +1,494 @@
+/// @file       CookedScene.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      compact binary form of a scene JSON file, read straight out of a memory mapping
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "CookedScene.h"
+
+#include "DebugSystem.h"
+#include "Stream.h"
+
+//-----------------------------------------------------------------------------
+// benchmark helpers
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  bytes currently allocated through MeasuredAllocator
+    static size_t s_MeasuredBytes = 0;
+
+    /// @brief  the most bytes allocated through MeasuredAllocator at once since it was last reset
+    static size_t s_MeasuredPeakBytes = 0;
+
+
+    /// @brief  allocator which tracks how much memory is allocated through it
+    /// @tparam ValueType   the type to allocate
+    template < typename ValueType >
+    struct MeasuredAllocator
+    {
+        using value_type = ValueType;
+
+        MeasuredAllocator() = default;
+
+        template < typename OtherType >
+        MeasuredAllocator( MeasuredAllocator< OtherType > const& ) {}
+
+        ValueType* allocate( size_t count )
+        {
+            s_MeasuredBytes += count * sizeof( ValueType );
+            s_MeasuredPeakBytes = std::max( s_MeasuredPeakBytes, s_MeasuredBytes );
+            return std::allocator< ValueType >().allocate( count );
+        }
+
+        void deallocate( ValueType* pointer, size_t count )
+        {
+            s_MeasuredBytes -= count * sizeof( ValueType );
+            std::allocator< ValueType >().deallocate( pointer, count );
+        }
+
+        template < typename OtherType >
+        bool operator ==( MeasuredAllocator< OtherType > const& ) const { return true; }
+    };
+
+
+    /// @brief  JSON type which tracks how much memory its objects and arrays take up
+    /// @note   strings still use the default allocator, so long string payloads aren't counted
+    using MeasuredJson = nlohmann::basic_json<
+        nlohmann::ordered_map, std::vector, std::string, bool, std::int64_t, std::uint64_t, double, MeasuredAllocator
+    >;
+
+
+//-----------------------------------------------------------------------------
+// public: static methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  converts a scene JSON file to a cooked scene file
+    /// @param  sourcePath  the JSON file to cook
+    /// @param  cookedPath  the cooked file to write
+    /// @return whether the file was successfully cooked
+    bool CookedScene::Cook( std::string const& sourcePath, std::string const& cookedPath )
+    {
+        return Cook( Stream::ParseFromFile( sourcePath ), sourcePath, cookedPath );
+    }
+
+    /// @brief  cooks already-parsed scene JSON
+    /// @param  json        the parsed contents of the source file
+    /// @param  sourcePath  the JSON file the data was parsed from
+    /// @param  cookedPath  the cooked file to write
+    /// @return whether the file was successfully cooked
+    bool CookedScene::Cook( nlohmann::ordered_json const& json, std::string const& sourcePath, std::string const& cookedPath )
+    {
+        Header header;
+        if ( stampSource( sourcePath, &header ) == false )
+        {
+            Debug() << "WARNING: unable to cook scene \"" << sourcePath << "\" - file not found" << std::endl;
+            return false;
+        }
+
+        if ( json.is_object() == false )
+        {
+            Debug() << "WARNING: unable to cook scene \"" << sourcePath << "\" - expected a JSON object" << std::endl;
+            return false;
+        }
+
+        std::vector< uint8_t > buffer;
+        buffer.reserve( 1 << 16 );
+
+        auto writeValue = [ &buffer ]( auto const& value )
+        {
+            uint8_t const* bytes = reinterpret_cast< uint8_t const* >( &value );
+            buffer.insert( buffer.end(), bytes, bytes + sizeof( value ) );
+        };
+
+        auto writeString = [ &buffer, &writeValue ]( std::string const& string )
+        {
+            writeValue( (uint32_t)string.size() );
+            buffer.insert( buffer.end(), string.begin(), string.end() );
+        };
+
+        auto writeElement = [ &buffer, &writeValue, &writeString ]( std::string const& key, nlohmann::ordered_json const& value )
+        {
+            writeString( key );
+
+            // reserve the length, encode straight into the buffer, then patch the length in
+            size_t lengthOffset = buffer.size();
+            writeValue( (uint32_t)0 );
+            nlohmann::ordered_json::to_cbor( value, buffer );
+            uint32_t length = (uint32_t)( buffer.size() - lengthOffset - sizeof( uint32_t ) );
+            std::memcpy( buffer.data() + lengthOffset, &length, sizeof( length ) );
+        };
+
+        header.M_SectionCount = (uint32_t)json.size();
+        writeValue( header );
+
+        for ( auto const& [ name, section ] : json.items() )
+        {
+            writeString( name );
+
+            if ( section.is_object() )
+            {
+                writeValue( SectionKind::Object );
+                writeValue( (uint32_t)section.size() );
+                for ( auto const& [ key, value ] : section.items() )
+                {
+                    writeElement( key, value );
+                }
+            }
+            else if ( section.is_array() )
+            {
+                writeValue( SectionKind::Array );
+                writeValue( (uint32_t)section.size() );
+                for ( nlohmann::ordered_json const& value : section )
+                {
+                    writeElement( "", value );
+                }
+            }
+            else
+            {
+                writeValue( SectionKind::Value );
+                writeValue( (uint32_t)1 );
+                writeElement( "", section );
+            }
+        }
+
+        std::ofstream file( cookedPath, std::ios::binary | std::ios::trunc );
+        if ( file.is_open() == false )
+        {
+            Debug() << "WARNING: unable to open file \"" << cookedPath << "\" to write cooked scene" << std::endl;
+            return false;
+        }
+        file.write( reinterpret_cast< char const* >( buffer.data() ), buffer.size() );
+
+        return file.good();
+    }
+
+
+    /// @brief  checks whether a cooked file exists and was cooked from the current version of its source
+    /// @param  sourcePath  the JSON file the cooked file was cooked from
+    /// @param  cookedPath  the cooked file
+    /// @return whether the cooked file is up to date
+    bool CookedScene::IsUpToDate( std::string const& sourcePath, std::string const& cookedPath )
+    {
+        Header source;
+        if ( stampSource( sourcePath, &source ) == false )
+        {
+            return false;
+        }
+
+        std::ifstream file( cookedPath, std::ios::binary );
+        Header cooked;
+        if ( file.read( reinterpret_cast< char* >( &cooked ), sizeof( cooked ) ).good() == false )
+        {
+            return false;
+        }
+
+        return (
+            std::memcmp( cooked.M_Magic, source.M_Magic, sizeof( cooked.M_Magic ) ) == 0 &&
+            cooked.M_Version == source.M_Version &&
+            cooked.M_SourceSize == source.M_SourceSize &&
+            cooked.M_SourceTime == source.M_SourceTime
+        );
+    }
+
+
+    /// @brief  decodes the data of an element
+    /// @param  data    the data of the element
+    /// @return the decoded JSON, or a discarded value if the data is invalid
+    nlohmann::ordered_json CookedScene::ParseElement( std::span< uint8_t const > data )
+    {
+        return nlohmann::ordered_json::from_cbor( data.data(), data.data() + data.size(), true, false );
+    }
+
+
+    /// @brief  measures how long a scene takes to parse from JSON and to decode from its cooked file, and the peak
+    ///         memory held by the parsed JSON in each case (cooking the scene first if needed)
+    /// @param  sourcePath  the JSON file of the scene
+    /// @param  cookedPath  the cooked file of the scene
+    /// @note   only measures parsing / decoding - reading the parsed data into the scene is the same either way
+    void CookedScene::Benchmark( std::string const& sourcePath, std::string const& cookedPath )
+    {
+        if ( IsUpToDate( sourcePath, cookedPath ) == false && Cook( sourcePath, cookedPath ) == false )
+        {
+            return;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        constexpr int iterations = 5;
+
+        // parse the whole JSON document, like the JSON loading path does
+        double jsonMs = INFINITY;
+        s_MeasuredBytes = 0;
+        s_MeasuredPeakBytes = 0;
+        for ( int i = 0; i < iterations; ++i )
+        {
+            Clock::time_point start = Clock::now();
+            {
+                std::ifstream file( sourcePath );
+                MeasuredJson json = MeasuredJson::parse( file, nullptr, false );
+            }
+            jsonMs = std::min( jsonMs, std::chrono::duration< double, std::milli >( Clock::now() - start ).count() );
+        }
+        size_t jsonPeak = s_MeasuredPeakBytes;
+
+        // map the cooked file and decode one element at a time, like the cooked loading path does
+        double cookedMs = INFINITY;
+        size_t cookedSize = 0;
+        s_MeasuredBytes = 0;
+        s_MeasuredPeakBytes = 0;
+        for ( int i = 0; i < iterations; ++i )
+        {
+            Clock::time_point start = Clock::now();
+            {
+                CookedScene cooked;
+                cooked.Open( sourcePath, cookedPath );
+                cookedSize = cooked.GetSize();
+
+                std::string_view name;
+                SectionKind kind;
+                uint32_t count;
+                while ( cooked.NextSection( &name, &kind, &count ) )
+                {
+                    std::string_view key;
+                    std::span< uint8_t const > data;
+                    while ( cooked.NextElement( &key, &data ) )
+                    {
+                        MeasuredJson json = MeasuredJson::from_cbor( data.data(), data.data() + data.size(), true, false );
+                    }
+                }
+            }
+            cookedMs = std::min( cookedMs, std::chrono::duration< double, std::milli >( Clock::now() - start ).count() );
+        }
+        size_t cookedPeak = s_MeasuredPeakBytes;
+
+        Debug() << std::filesystem::path( sourcePath ).filename().string() << ":" << std::endl
+            << "    JSON:   " << std::filesystem::file_size( sourcePath ) / 1024 << " KiB, " << jsonMs << " ms, peak " << jsonPeak / 1024 << " KiB" << std::endl
+            << "    cooked: " << cookedSize / 1024 << " KiB, " << cookedMs << " ms, peak " << cookedPeak / 1024 << " KiB" << std::endl;
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  maps a cooked file for reading
+    /// @param  sourcePath  the JSON file the cooked file was cooked from
+    /// @param  cookedPath  the cooked file
+    /// @return whether the cooked file was opened - fails if it is missing, invalid, or out of date
+    bool CookedScene::Open( std::string const& sourcePath, std::string const& cookedPath )
+    {
+        Close();
+
+        Header source;
+        if ( stampSource( sourcePath, &source ) == false || m_File.Open( cookedPath ) == false )
+        {
+            return false;
+        }
+
+        Header cooked;
+        if (
+            read( &cooked ) == false ||
+            std::memcmp( cooked.M_Magic, source.M_Magic, sizeof( cooked.M_Magic ) ) != 0 ||
+            cooked.M_Version != source.M_Version ||
+            cooked.M_SourceSize != source.M_SourceSize ||
+            cooked.M_SourceTime != source.M_SourceTime
+        )
+        {
+            Close();
+            return false;
+        }
+
+        m_RemainingSections = cooked.M_SectionCount;
+        return true;
+    }
+
+    /// @brief  unmaps the cooked file
+    void CookedScene::Close()
+    {
+        m_File.Close();
+        m_Offset = 0;
+        m_RemainingSections = 0;
+        m_RemainingElements = 0;
+    }
+
+
+    /// @brief  checks that every section and element of the opened file can be read and decoded, without keeping
+    ///         any of the decoded data, so that a bad file can be rejected before anything is loaded from it
+    /// @return whether the whole file is valid
+    /// @note   call right after Open - leaves the file positioned before its first section again
+    bool CookedScene::Validate()
+    {
+        size_t const startOffset = m_Offset;
+        uint32_t const sectionCount = m_RemainingSections;
+
+        bool isValid = true;
+        uint32_t sectionsRead = 0;
+        std::string_view name;
+        SectionKind kind;
+        uint32_t elementCount;
+        while ( isValid && NextSection( &name, &kind, &elementCount ) )
+        {
+            ++sectionsRead;
+            isValid = kind == SectionKind::Value || kind == SectionKind::Object || kind == SectionKind::Array;
+
+            uint32_t elementsRead = 0;
+            std::string_view key;
+            std::span< uint8_t const > data;
+            while ( isValid && NextElement( &key, &data ) )
+            {
+                ++elementsRead;
+
+                // parses the CBOR without building any JSON from it
+                nlohmann::detail::json_sax_acceptor< nlohmann::ordered_json > acceptor;
+                isValid = nlohmann::ordered_json::sax_parse(
+                    data.data(), data.data() + data.size(), &acceptor, nlohmann::ordered_json::input_format_t::cbor, true
+                );
+            }
+
+            // a truncated section stops early
+            isValid = isValid && elementsRead == elementCount;
+        }
+        isValid = isValid && sectionsRead == sectionCount;
+
+        m_Offset = startOffset;
+        m_RemainingSections = sectionCount;
+        m_RemainingElements = 0;
+        return isValid;
+    }
+
+
+    /// @brief  advances to the next section, skipping any unread elements of the current section
+    /// @param  name            out: the name of the section
+    /// @param  kind            out: how the section's elements map back to JSON
+    /// @param  elementCount    out: how many elements the section has
+    /// @return whether there was another section
+    bool CookedScene::NextSection( std::string_view* name, SectionKind* kind, uint32_t* elementCount )
+    {
+        std::string_view key;
+        std::span< uint8_t const > data;
+        while ( m_RemainingElements > 0 )
+        {
+            if ( NextElement( &key, &data ) == false )
+            {
+                return false;
+            }
+        }
+
+        if ( m_RemainingSections == 0 )
+        {
+            return false;
+        }
+
+        std::span< uint8_t const > nameBytes;
+        if ( readBlock( &nameBytes ) == false || read( kind ) == false || read( elementCount ) == false )
+        {
+            Debug() << "WARNING: cooked scene is truncated" << std::endl;
+            m_RemainingSections = 0;
+            return false;
+        }
+
+        *name = std::string_view( reinterpret_cast< char const* >( nameBytes.data() ), nameBytes.size() );
+
+        --m_RemainingSections;
+        m_RemainingElements = *elementCount;
+        return true;
+    }
+
+    /// @brief  advances to the next element of the current section
+    /// @param  key     out: the key of the element (empty for Array and Value sections)
+    /// @param  data    out: the data of the element - points into the mapped file
+    /// @return whether there was another element in the section
+    bool CookedScene::NextElement( std::string_view* key, std::span< uint8_t const >* data )
+    {
+        if ( m_RemainingElements == 0 )
+        {
+            return false;
+        }
+
+        std::span< uint8_t const > keyBytes;
+        if ( readBlock( &keyBytes ) == false || readBlock( data ) == false )
+        {
+            Debug() << "WARNING: cooked scene is truncated" << std::endl;
+            m_RemainingElements = 0;
+            m_RemainingSections = 0;
+            return false;
+        }
+
+        *key = std::string_view( reinterpret_cast< char const* >( keyBytes.data() ), keyBytes.size() );
+
+        --m_RemainingElements;
+        return true;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the size and last write time of a source file
+    /// @param  sourcePath  the source file
+    /// @param  header      the header to store the size and time in
+    /// @return whether the source file exists
+    bool CookedScene::stampSource( std::string const& sourcePath, Header* header )
+    {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size( sourcePath, error );
+        if ( error )
+        {
+            return false;
+        }
+
+        std::filesystem::file_time_type time = std::filesystem::last_write_time( sourcePath, error );
+        if ( error )
+        {
+            return false;
+        }
+
+        header->M_SourceSize = (uint64_t)size;
+        header->M_SourceTime = (int64_t)time.time_since_epoch().count();
+        return true;
+    }
+
+
+    /// @brief  reads a value from the mapped file
+    /// @tparam ValueType   the type of value to read
+    /// @param  value       out: the value read
+    /// @return whether there was enough data left to read the value
+    template < typename ValueType >
+    bool CookedScene::read( ValueType* value )
+    {
+        if ( m_File.GetSize() - m_Offset < sizeof( ValueType ) )
+        {
+            return false;
+        }
+
+        // values aren't aligned in the file, so copy them out rather than casting
+        std::memcpy( value, m_File.GetData() + m_Offset, sizeof( ValueType ) );
+        m_Offset += sizeof( ValueType );
+        return true;
+    }
+
+    /// @brief  reads a length-prefixed block of bytes from the mapped file
+    /// @param  bytes   out: the bytes read - points into the mapped file
+    /// @return whether there was enough data left to read the block
+    bool CookedScene::readBlock( std::span< uint8_t const >* bytes )
+    {
+        uint32_t length;
+        if ( read( &length ) == false || m_File.GetSize() - m_Offset < length )
+        {
+            return false;
+        }
+
+        *bytes = std::span< uint8_t const >( m_File.GetData() + m_Offset, length );
+        m_Offset += length;
+        return true;
+    }
+
+
+//-----------------------------------------------------------------------------
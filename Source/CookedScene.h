@@ -0,0 +1,209 @@
+/// @file       CookedScene.h
+/// @author     Oblivion Owls Inc
+/// @brief      compact binary form of a scene JSON file, read straight out of a memory mapping
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include "MappedFile.h"
+
+#include <span>
+
+
+/// @brief  compact binary form of a scene JSON file, read straight out of a memory mapping
+/// @note   JSON stays the authoring format - cooked files are derived from it and are ignored once it changes.
+///
+///         Layout (little endian):
+///             Header
+///             for each top level key of the source JSON, in order:
+///                 uint32 nameLength, name
+///                 uint8  SectionKind
+///                 uint32 elementCount
+///                 for each element (each child of an Object or Array section, or the whole value of a Value section):
+///                     uint32 keyLength, key   (empty for Array and Value sections)
+///                     uint32 dataLength, data (CBOR encoding of the element)
+///
+///         Splitting each section into separately encoded elements lets the loader decode one Entity or asset library
+///         at a time, rather than holding the whole scene's JSON in memory at once.
+class CookedScene
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how a section's elements map back to JSON
+    enum class SectionKind : uint8_t
+    {
+        Value  = 0, /// @brief  the section has a single unnamed element holding its whole value
+        Object = 1, /// @brief  each element is a named member of an object
+        Array  = 2  /// @brief  each element is an entry of an array
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // static methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  converts a scene JSON file to a cooked scene file
+    /// @param  sourcePath  the JSON file to cook
+    /// @param  cookedPath  the cooked file to write
+    /// @return whether the file was successfully cooked
+    static bool Cook( std::string const& sourcePath, std::string const& cookedPath );
+
+    /// @brief  cooks already-parsed scene JSON
+    /// @param  json        the parsed contents of the source file
+    /// @param  sourcePath  the JSON file the data was parsed from
+    /// @param  cookedPath  the cooked file to write
+    /// @return whether the file was successfully cooked
+    static bool Cook( nlohmann::ordered_json const& json, std::string const& sourcePath, std::string const& cookedPath );
+
+    /// @brief  checks whether a cooked file exists and was cooked from the current version of its source
+    /// @param  sourcePath  the JSON file the cooked file was cooked from
+    /// @param  cookedPath  the cooked file
+    /// @return whether the cooked file is up to date
+    static bool IsUpToDate( std::string const& sourcePath, std::string const& cookedPath );
+
+    /// @brief  decodes the data of an element
+    /// @param  data    the data of the element
+    /// @return the decoded JSON, or a discarded value if the data is invalid
+    static nlohmann::ordered_json ParseElement( std::span< uint8_t const > data );
+
+
+    /// @brief  measures how long a scene takes to parse from JSON and to decode from its cooked file, and the peak
+    ///         memory held by the parsed JSON in each case (cooking the scene first if needed)
+    /// @param  sourcePath  the JSON file of the scene
+    /// @param  cookedPath  the cooked file of the scene
+    /// @note   only measures parsing / decoding - reading the parsed data into the scene is the same either way
+    static void Benchmark( std::string const& sourcePath, std::string const& cookedPath );
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  maps a cooked file for reading
+    /// @param  sourcePath  the JSON file the cooked file was cooked from
+    /// @param  cookedPath  the cooked file
+    /// @return whether the cooked file was opened - fails if it is missing, invalid, or out of date
+    bool Open( std::string const& sourcePath, std::string const& cookedPath );
+
+    /// @brief  unmaps the cooked file
+    void Close();
+
+
+    /// @brief  checks that every section and element of the opened file can be read and decoded, without keeping
+    ///         any of the decoded data, so that a bad file can be rejected before anything is loaded from it
+    /// @return whether the whole file is valid
+    /// @note   call right after Open - leaves the file positioned before its first section again
+    bool Validate();
+
+
+    /// @brief  advances to the next section, skipping any unread elements of the current section
+    /// @param  name            out: the name of the section
+    /// @param  kind            out: how the section's elements map back to JSON
+    /// @param  elementCount    out: how many elements the section has
+    /// @return whether there was another section
+    bool NextSection( std::string_view* name, SectionKind* kind, uint32_t* elementCount );
+
+    /// @brief  advances to the next element of the current section
+    /// @param  key     out: the key of the element (empty for Array and Value sections)
+    /// @param  data    out: the data of the element - points into the mapped file
+    /// @return whether there was another element in the section
+    bool NextElement( std::string_view* key, std::span< uint8_t const >* data );
+
+
+    /// @brief  gets the size of the open cooked file
+    /// @return the size of the open cooked file in bytes
+    size_t GetSize() const { return m_File.GetSize(); }
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the header at the start of every cooked file
+    struct Header
+    {
+        /// @brief  identifies the file as a cooked scene
+        char M_Magic[ 4 ] = { 'O', 'W', 'L', 'S' };
+
+        /// @brief  the version of the cooked format
+        uint32_t M_Version = s_Version;
+
+        /// @brief  the size of the source file when it was cooked
+        uint64_t M_SourceSize = 0;
+
+        /// @brief  the last write time of the source file when it was cooked
+        int64_t M_SourceTime = 0;
+
+        /// @brief  how many sections the file contains
+        uint32_t M_SectionCount = 0;
+
+        /// @brief  unused
+        uint32_t M_Padding = 0;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the current version of the cooked format - bump this whenever the layout changes
+    static constexpr uint32_t s_Version = 1;
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the mapped cooked file
+    MappedFile m_File;
+
+    /// @brief  the read position in the mapped file
+    size_t m_Offset = 0;
+
+    /// @brief  how many sections haven't been read yet
+    uint32_t m_RemainingSections = 0;
+
+    /// @brief  how many elements of the current section haven't been read yet
+    uint32_t m_RemainingElements = 0;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the size and last write time of a source file
+    /// @param  sourcePath  the source file
+    /// @param  header      the header to store the size and time in
+    /// @return whether the source file exists
+    static bool stampSource( std::string const& sourcePath, Header* header );
+
+
+    /// @brief  reads a value from the mapped file
+    /// @tparam ValueType   the type of value to read
+    /// @param  value       out: the value read
+    /// @return whether there was enough data left to read the value
+    template < typename ValueType >
+    bool read( ValueType* value );
+
+    /// @brief  reads a length-prefixed block of bytes from the mapped file
+    /// @param  bytes   out: the bytes read - points into the mapped file
+    /// @return whether there was enough data left to read the block
+    bool readBlock( std::span< uint8_t const >* bytes );
+
+
+//-----------------------------------------------------------------------------
+};
@@ -0,0 +1,472 @@
+/// @file       CpuParticleBuffer.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      simulates an Emitter's particles on the CPU, the same way particles_compute.glsl does on the GPU
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "CpuParticleBuffer.h"
+
+#include "JobSystem.h"
+#include "DebugSystem.h"
+
+#include <xmmintrin.h>
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  resizes the buffer, keeping the particles that still fit and zeroing any new ones
+    /// @param  bufferSize  how many particles the buffer holds
+    void CpuParticleBuffer::Resize( int bufferSize )
+    {
+        m_BufferSize = std::max( bufferSize, 0 );
+
+        // pad to a multiple of 4 so the vectorized update never needs a scalar tail.
+        // (padding particles are zeroed too, so they never become visible)
+        size_t paddedSize = ( m_BufferSize + 3 ) & ~3;
+        for ( std::vector< float >* field : {
+            &m_PosX, &m_PosY, &m_VelX, &m_VelY, &m_AccX, &m_AccY,
+            &m_Size, &m_Rotation, &m_Drag, &m_Lifetime, &m_Time, &m_FadeIn, &m_FadeOut, &m_SizePerSec
+        } )
+        {
+            field->resize( paddedSize, 0.0f );
+        }
+    }
+
+    /// @brief  removes every particle, keeping the memory so that the next Resize doesn't reallocate
+    void CpuParticleBuffer::Clear()
+    {
+        m_BufferSize = 0;
+        m_LastParams = StepParams();
+        for ( std::vector< float >* field : {
+            &m_PosX, &m_PosY, &m_VelX, &m_VelY, &m_AccX, &m_AccY,
+            &m_Size, &m_Rotation, &m_Drag, &m_Lifetime, &m_Time, &m_FadeIn, &m_FadeOut, &m_SizePerSec
+        } )
+        {
+            field->clear();
+        }
+    }
+
+    /// @brief  emits and advances the particles - one dispatch of particles_compute.glsl
+    /// @param  init    how to initialize emitted particles
+    /// @param  params  the uniforms of the dispatch
+    void CpuParticleBuffer::Step( ParticleSystem::EmitData const& init, StepParams const& params )
+    {
+        m_LastParams = params;
+
+        emit( init, params );
+
+        float dt = params.M_Dt;
+        if ( m_IsVectorized )
+        {
+            forEachChunk( (int)m_PosX.size(), [ this, dt ]( int begin, int end ) { integrateVectorized( dt, begin, end ); } );
+        }
+        else
+        {
+            forEachChunk( (int)m_PosX.size(), [ this, dt ]( int begin, int end ) { integrateScalar( dt, begin, end ); } );
+        }
+    }
+
+    /// @brief  writes the instance of each particle, ordered from oldest to newest, like the shader does
+    /// @param  instances   where to write the instances - must hold GetBufferSize() of them
+    /// @note   uses the uniforms of the last Step
+    void CpuParticleBuffer::WriteInstances( ParticleSystem::Instance* instances ) const
+    {
+        if ( m_IsVectorized )
+        {
+            forEachChunk( m_BufferSize, [ & ]( int begin, int end ) { writeInstancesVectorized( instances, begin, end ); } );
+        }
+        else
+        {
+            forEachChunk( m_BufferSize, [ & ]( int begin, int end ) { writeInstancesScalar( instances, begin, end ); } );
+        }
+    }
+
+
+    /// @brief  gets a particle in the same layout the shader stores it in
+    /// @param  index   the index of the particle
+    /// @return the particle
+    ParticleSystem::Particle CpuParticleBuffer::GetParticle( int index ) const
+    {
+        ParticleSystem::Particle particle = {};
+
+        particle.pos = { m_PosX[ index ], m_PosY[ index ] };
+        particle.vel = { m_VelX[ index ], m_VelY[ index ] };
+        particle.acc = { m_AccX[ index ], m_AccY[ index ] };
+        particle.size = m_Size[ index ];
+        particle.rotation = m_Rotation[ index ];
+        particle.drag = m_Drag[ index ];
+        particle.lifetime = m_Lifetime[ index ];
+        particle.time = m_Time[ index ];
+        particle.fadeIn = m_FadeIn[ index ];
+        particle.fadeOut = m_FadeOut[ index ];
+        particle.sizePerSec = m_SizePerSec[ index ];
+
+        return particle;
+    }
+
+
+    /// @brief  logs how many particles per millisecond are simulated with and without SSE and worker threads
+    void CpuParticleBuffer::RunBenchmark()
+    {
+        using Clock = std::chrono::high_resolution_clock;
+        static constexpr int particleCount = 1 << 20;
+        static constexpr int warmupStepCount = 120;
+        static constexpr int stepCount = 30;
+        static constexpr float dt = 1.0f / 60.0f;
+
+        // particles live for 2 seconds, so after the warmup every particle of the buffer is alive
+        ParticleSystem::EmitData init = {};
+        init.acceleration = { 0.0f, -1.0f };
+        init.speed = 1.0f;
+        init.speed_spread = 0.5f;
+        init.dir_spread = 3.14f;
+        init.size = 0.2f;
+        init.size_spread = 0.1f;
+        init.rotation_spread = 3.14f;
+        init.fadeInDuration = 0.2f;
+        init.fadeOutDuration = 0.5f;
+        init.lifetime = 2.0f;
+        init.sizePerSec = -0.05f;
+        init.bufferSize = particleCount;
+
+        std::vector< ParticleSystem::Instance > instances( particleCount );
+
+        struct Variant
+        {
+            char const* M_Name;
+            bool M_IsVectorized;
+            bool M_IsParallel;
+        };
+        Variant const variants[] = {
+            { "scalar, main thread", false, false },
+            { "SSE, main thread",    true,  false },
+            { "SSE, JobSystem",      true,  true  }
+        };
+
+        Debug() << "CPU particle benchmark (" << particleCount << " particles, " << stepCount << " steps, "
+            << Jobs()->GetWorkerCount() << " workers):" << std::endl;
+
+        std::vector< glm::vec3 > reference;
+        for ( Variant const& variant : variants )
+        {
+            CpuParticleBuffer buffer;
+            buffer.SetIsVectorized( variant.M_IsVectorized );
+            buffer.SetIsParallel( variant.M_IsParallel );
+            buffer.Resize( particleCount );
+
+            // the first step zeroes the buffer, like an Emitter's first dispatch
+            StepParams params;
+            params.M_Dt = dt;
+            params.M_Range = { 0, particleCount };
+            buffer.Step( init, params );
+
+            int emitCount = particleCount / warmupStepCount;
+            int current = 0;
+            double stepMs = 0.0;
+            double writeMs = 0.0;
+            for ( int step = 0; step < warmupStepCount + stepCount; ++step )
+            {
+                if ( current + emitCount > particleCount )
+                {
+                    current = 0;
+                }
+                params.M_Time += dt;
+                params.M_Oldest = current;
+                params.M_Range = { current, current + emitCount };
+                current += emitCount;
+
+                Clock::time_point start = Clock::now();
+                buffer.Step( init, params );
+                Clock::time_point stepped = Clock::now();
+                if ( step < warmupStepCount )
+                {
+                    continue;
+                }
+                buffer.WriteInstances( instances.data() );
+                Clock::time_point written = Clock::now();
+
+                stepMs += std::chrono::duration< double, std::milli >( stepped - start ).count();
+                writeMs += std::chrono::duration< double, std::milli >( written - stepped ).count();
+            }
+
+            // compare against the scalar path, which mirrors the shader line by line
+            bool isReference = reference.empty();
+            reference.resize( particleCount );
+
+            float largestDifference = 0.0f;
+            for ( int i = 0; i < particleCount; ++i )
+            {
+                ParticleSystem::Particle particle = buffer.GetParticle( i );
+                glm::vec3 state = glm::vec3( particle.pos, particle.size );
+                if ( isReference )
+                {
+                    reference[ i ] = state;
+                    continue;
+                }
+
+                glm::vec3 difference = glm::abs( state - reference[ i ] );
+                largestDifference = std::max( { largestDifference, difference.x, difference.y, difference.z } );
+            }
+
+            Debug() << "    " << variant.M_Name << ": "
+                << particleCount / ( stepMs / stepCount ) << " particles/ms stepped, "
+                << particleCount / ( writeMs / stepCount ) << " particles/ms written, "
+                << "largest difference from scalar " << largestDifference << std::endl;
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  initializes the particles in the range of a Step
+    /// @param  init    how to initialize the particles
+    /// @param  params  the uniforms of the Step
+    void CpuParticleBuffer::emit( ParticleSystem::EmitData const& init, StepParams const& params )
+    {
+        int first = std::max( params.M_Range.x, 0 );
+        int last = std::min( params.M_Range.y, m_BufferSize );
+
+        float isGlobal = params.M_IsLocal ? 0.0f : 1.0f;
+
+        // 'zinit' will be 0 if range covers the entire buffer
+        float zinit = params.M_Range.y - params.M_Range.x <= m_BufferSize - 1 ? 1.0f : 0.0f;
+
+        for ( int i = first; i < last; ++i )
+        {
+            auto urand = [ & ]( float seed ) -> float { return 2.0f * prand( i, seed, params.M_Time ) - 1.0f; };
+
+            // pre-randomize
+            glm::vec2 posSpread = glm::vec2( init.pos_spread.x * urand( 1.0f ), init.pos_spread.y * urand( 2.0f ) );
+            float direction = init.direction + init.dir_spread * urand( 3.0f );
+            float speed = init.speed + init.speed_spread * urand( 4.0f );
+
+            glm::vec2 vel = zinit * ( glm::vec2( std::cos( direction ), std::sin( direction ) ) * speed );
+            glm::vec2 pos = zinit * ( isGlobal * params.M_ParentPos + init.offset + posSpread + init.startAhead * vel );
+            glm::vec2 acc = zinit * ( init.acceleration + init.dirAcc * vel );
+
+            m_VelX[ i ] = vel.x;
+            m_VelY[ i ] = vel.y;
+            m_PosX[ i ] = pos.x;
+            m_PosY[ i ] = pos.y;
+            m_Size[ i ] = zinit * ( init.size - init.size_spread * prand( i, 5.0f, params.M_Time ) );
+            m_Rotation[ i ] = zinit * ( init.rotation + init.rotation_spread * urand( 6.0f ) );
+            m_AccX[ i ] = acc.x;
+            m_AccY[ i ] = acc.y;
+            m_Lifetime[ i ] = zinit * init.lifetime;
+            m_FadeIn[ i ] = zinit * init.fadeInDuration;
+            m_FadeOut[ i ] = zinit * m_Lifetime[ i ] - init.fadeOutDuration;
+            m_Time[ i ] = 0.0f;
+            m_SizePerSec[ i ] = zinit * init.sizePerSec;
+            m_Drag[ i ] = 0.0f;
+        }
+    }
+
+
+    /// @brief  advances a range of particles, 4 at a time
+    /// @param  dt      how long to advance the particles by
+    /// @param  begin   the first particle to advance - a multiple of 4
+    /// @param  end     one past the last particle to advance - a multiple of 4
+    void CpuParticleBuffer::integrateVectorized( float dt, int begin, int end )
+    {
+        __m128 const dt4 = _mm_set1_ps( dt );
+        __m128 const one = _mm_set1_ps( 1.0f );
+        __m128 const zero = _mm_setzero_ps();
+
+        for ( int i = begin; i < end; i += 4 )
+        {
+            // apply the uh.. derivatives
+            __m128 dragFactor = _mm_sub_ps( one, _mm_mul_ps( _mm_loadu_ps( &m_Drag[ i ] ), dt4 ) );
+
+            __m128 velX = _mm_mul_ps( _mm_loadu_ps( &m_VelX[ i ] ), dragFactor );
+            __m128 velY = _mm_mul_ps( _mm_loadu_ps( &m_VelY[ i ] ), dragFactor );
+            velX = _mm_add_ps( velX, _mm_mul_ps( _mm_loadu_ps( &m_AccX[ i ] ), dt4 ) );
+            velY = _mm_add_ps( velY, _mm_mul_ps( _mm_loadu_ps( &m_AccY[ i ] ), dt4 ) );
+            _mm_storeu_ps( &m_VelX[ i ], velX );
+            _mm_storeu_ps( &m_VelY[ i ], velY );
+
+            _mm_storeu_ps( &m_PosX[ i ], _mm_add_ps( _mm_loadu_ps( &m_PosX[ i ] ), _mm_mul_ps( velX, dt4 ) ) );
+            _mm_storeu_ps( &m_PosY[ i ], _mm_add_ps( _mm_loadu_ps( &m_PosY[ i ] ), _mm_mul_ps( velY, dt4 ) ) );
+
+            // only grow particles that are still alive
+            __m128 size = _mm_loadu_ps( &m_Size[ i ] );
+            __m128 growth = _mm_mul_ps( _mm_loadu_ps( &m_SizePerSec[ i ] ), dt4 );
+            size = _mm_add_ps( size, _mm_and_ps( _mm_cmpge_ps( size, zero ), growth ) );
+
+            // "destroy" (just set size to 0) when time runs out
+            __m128 time = _mm_add_ps( _mm_loadu_ps( &m_Time[ i ] ), dt4 );
+            size = _mm_and_ps( _mm_cmpge_ps( _mm_loadu_ps( &m_Lifetime[ i ] ), time ), size );
+
+            _mm_storeu_ps( &m_Time[ i ], time );
+            _mm_storeu_ps( &m_Size[ i ], size );
+        }
+    }
+
+    /// @brief  advances a range of particles, one at a time
+    /// @param  dt      how long to advance the particles by
+    /// @param  begin   the first particle to advance
+    /// @param  end     one past the last particle to advance
+    void CpuParticleBuffer::integrateScalar( float dt, int begin, int end )
+    {
+        for ( int i = begin; i < end; ++i )
+        {
+            // apply the uh.. derivatives
+            m_VelX[ i ] *= 1.0f - m_Drag[ i ] * dt;
+            m_VelY[ i ] *= 1.0f - m_Drag[ i ] * dt;
+            m_VelX[ i ] += m_AccX[ i ] * dt;
+            m_VelY[ i ] += m_AccY[ i ] * dt;
+            m_PosX[ i ] += m_VelX[ i ] * dt;
+            m_PosY[ i ] += m_VelY[ i ] * dt;
+            m_Size[ i ] += ( m_Size[ i ] >= 0.0f ? 1.0f : 0.0f ) * m_SizePerSec[ i ] * dt;
+
+            // "destroy" (just set size to 0) when time runs out
+            m_Time[ i ] += dt;
+            m_Size[ i ] = m_Lifetime[ i ] >= m_Time[ i ] ? m_Size[ i ] : 0.0f;
+        }
+    }
+
+
+    /// @brief  writes the instances of a range of particles, computing 4 at a time
+    /// @param  instances   where to write the instances
+    /// @param  begin       the first particle to write - a multiple of 4
+    /// @param  end         one past the last particle to write
+    void CpuParticleBuffer::writeInstancesVectorized( ParticleSystem::Instance* instances, int begin, int end ) const
+    {
+        __m128 const one = _mm_set1_ps( 1.0f );
+        __m128 const zero = _mm_setzero_ps();
+
+        glm::vec2 offset = m_LastParams.M_ParentPos * ( m_LastParams.M_IsLocal ? 1.0f : 0.0f );
+        __m128 const offsetX = _mm_set1_ps( offset.x );
+        __m128 const offsetY = _mm_set1_ps( offset.y );
+
+        int i = begin;
+        for ( ; i + 4 <= end; i += 4 )
+        {
+            // fade in and out
+            __m128 time = _mm_loadu_ps( &m_Time[ i ] );
+            __m128 fadeOut = _mm_loadu_ps( &m_FadeOut[ i ] );
+            __m128 fadeIn = _mm_div_ps( time, _mm_loadu_ps( &m_FadeIn[ i ] ) );
+            __m128 fadeOutProgress = _mm_div_ps( _mm_sub_ps( time, fadeOut ), _mm_sub_ps( _mm_loadu_ps( &m_Lifetime[ i ] ), fadeOut ) );
+            fadeIn = _mm_min_ps( _mm_max_ps( fadeIn, zero ), one );
+            fadeOutProgress = _mm_min_ps( _mm_max_ps( fadeOutProgress, zero ), one );
+
+            float opacity[ 4 ], x[ 4 ], y[ 4 ];
+            _mm_storeu_ps( opacity, _mm_mul_ps( fadeIn, _mm_sub_ps( one, fadeOutProgress ) ) );
+            _mm_storeu_ps( x, _mm_add_ps( _mm_loadu_ps( &m_PosX[ i ] ), offsetX ) );
+            _mm_storeu_ps( y, _mm_add_ps( _mm_loadu_ps( &m_PosY[ i ] ), offsetY ) );
+
+            for ( int lane = 0; lane < 4; ++lane )
+            {
+                int index = i + lane;
+
+                // arrange them from oldest to newest for rendering
+                ParticleSystem::Instance& instance = instances[ ( index + ( m_BufferSize - m_LastParams.M_Oldest ) ) % m_BufferSize ];
+                instance.pos = { x[ lane ], y[ lane ] };
+                instance.size = m_Size[ index ];
+                instance.rotationOpacity = packRotationOpacity( m_Rotation[ index ], opacity[ lane ] );
+            }
+        }
+
+        writeInstancesScalar( instances, i, end );
+    }
+
+    /// @brief  writes the instances of a range of particles, one at a time
+    /// @param  instances   where to write the instances
+    /// @param  begin       the first particle to write
+    /// @param  end         one past the last particle to write
+    void CpuParticleBuffer::writeInstancesScalar( ParticleSystem::Instance* instances, int begin, int end ) const
+    {
+        float isLocal = m_LastParams.M_IsLocal ? 1.0f : 0.0f;
+
+        for ( int i = begin; i < end; ++i )
+        {
+            // fade in and out
+            float opacity = lerpOpacity( 0.0f, m_FadeIn[ i ], m_Time[ i ] ) *
+                     ( 1.0f - lerpOpacity( m_FadeOut[ i ], m_Lifetime[ i ], m_Time[ i ] ) );
+
+            // arrange them from oldest to newest for rendering. inverse deque, wooo
+            ParticleSystem::Instance& instance = instances[ ( i + ( m_BufferSize - m_LastParams.M_Oldest ) ) % m_BufferSize ];
+            instance.pos = glm::vec2( m_PosX[ i ], m_PosY[ i ] ) + m_LastParams.M_ParentPos * isLocal;
+            instance.size = m_Size[ i ];
+            instance.rotationOpacity = packRotationOpacity( m_Rotation[ i ], opacity );
+        }
+    }
+
+    /// @brief  packs a particle's rotation and opacity the way the shader does
+    /// @param  rotation    the rotation of the particle
+    /// @param  opacity     the opacity of the particle
+    /// @return the rotation (wrapped to 0 to 2pi) and opacity, as two halves
+    unsigned int CpuParticleBuffer::packRotationOpacity( float rotation, float opacity )
+    {
+        // GLSL's mod, so the rotation keeps its precision as a half
+        static constexpr float twoPi = 6.2831853f;
+        float wrapped = rotation - twoPi * std::floor( rotation / twoPi );
+        return glm::packHalf2x16( glm::vec2( wrapped, opacity ) );
+    }
+
+
+    /// @brief  calls a function on chunks of a range of particles, on the JobSystem if the buffer is parallel
+    /// @tparam Function    void( int begin, int end )
+    /// @param  count       how many particles to split into chunks
+    /// @param  function    the function to call on each chunk
+    template < typename Function >
+    void CpuParticleBuffer::forEachChunk( int count, Function const& function ) const
+    {
+        if ( m_IsParallel == false || count <= s_ChunkSize )
+        {
+            function( 0, count );
+            return;
+        }
+
+        std::vector< JobSystem::JobId > jobs;
+        for ( int begin = s_ChunkSize; begin < count; begin += s_ChunkSize )
+        {
+            int end = std::min( begin + s_ChunkSize, count );
+            jobs.push_back( Jobs()->Push( [ &function, begin, end ]() { function( begin, end ); } ) );
+        }
+
+        // the calling thread takes the first chunk instead of waiting idle
+        function( 0, s_ChunkSize );
+
+        for ( JobSystem::JobId job : jobs )
+        {
+            Jobs()->Wait( job );
+        }
+    }
+
+
+    /// @brief  the positive random number the shader gives a particle (0 to 1)
+    /// @param  index   the index of the particle
+    /// @param  seed    which of the particle's random numbers to get
+    /// @param  time    the total time simulated so far
+    /// @return the random number
+    float CpuParticleBuffer::prand( int index, float seed, float time )
+    {
+        float value = std::sin( ( (float)index + 242.9f + seed ) * ( time - std::floor( time ) ) ) * 43758.5453f;
+        return value - std::floor( value );
+    }
+
+    /// @brief  the progress from start to end of time, clamped to 0 to 1 - lerpOpacity in the shader
+    /// @param  start   when the progress starts
+    /// @param  end     when the progress ends
+    /// @param  time    the current time
+    /// @return the progress
+    /// @note   clamps the same way the vectorized path does, so 0 / 0 comes out as 0
+    float CpuParticleBuffer::lerpOpacity( float start, float end, float time )
+    {
+        float progress = ( time - start ) / ( end - start );
+        progress = progress > 0.0f ? progress : 0.0f;
+        return progress < 1.0f ? progress : 1.0f;
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,197 @@
+/// @file       CpuParticleBuffer.h
+/// @author     Oblivion Owls Inc
+/// @brief      simulates an Emitter's particles on the CPU, the same way particles_compute.glsl does on the GPU
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include "ParticleSystem.h"
+
+
+/// @brief  simulates an Emitter's particles on the CPU, the same way particles_compute.glsl does on the GPU
+/// @note   each field of the particles gets its own array, so the update runs on 4 particles at a time with SSE,
+///         and large buffers are split into chunks that run in parallel on the JobSystem
+/// @note   a CpuParticleBuffer never touches the GPU, so particles can be simulated and checked without a rendering context
+class CpuParticleBuffer
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the uniforms of one dispatch of particles_compute.glsl
+    struct StepParams
+    {
+        /// @brief  how long to advance the particles by
+        float M_Dt = 0.0f;
+
+        /// @brief  the total time simulated so far - seeds the random numbers of emitted particles
+        float M_Time = 0.0f;
+
+        /// @brief  the particles to emit, from first to one past last - ( -1, -1 ) to emit nothing
+        /// @note   a range covering the whole buffer zeroes every particle instead
+        glm::ivec2 M_Range = { -1, -1 };
+
+        /// @brief  the index of the oldest particle, which is drawn first
+        int M_Oldest = 0;
+
+        /// @brief  the position of the emitting Entity
+        glm::vec2 M_ParentPos = { 0.0f, 0.0f };
+
+        /// @brief  whether particles follow the emitting Entity instead of being left where they were emitted
+        bool M_IsLocal = false;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  resizes the buffer, keeping the particles that still fit and zeroing any new ones
+    /// @param  bufferSize  how many particles the buffer holds
+    void Resize( int bufferSize );
+
+    /// @brief  removes every particle, keeping the memory so that the next Resize doesn't reallocate
+    void Clear();
+
+    /// @brief  emits and advances the particles - one dispatch of particles_compute.glsl
+    /// @param  init    how to initialize emitted particles
+    /// @param  params  the uniforms of the dispatch
+    void Step( ParticleSystem::EmitData const& init, StepParams const& params );
+
+    /// @brief  writes the instance of each particle, ordered from oldest to newest, like the shader does
+    /// @param  instances   where to write the instances - must hold GetBufferSize() of them
+    /// @note   uses the uniforms of the last Step
+    void WriteInstances( ParticleSystem::Instance* instances ) const;
+
+
+    /// @brief  gets a particle in the same layout the shader stores it in
+    /// @param  index   the index of the particle
+    /// @return the particle
+    ParticleSystem::Particle GetParticle( int index ) const;
+
+
+    /// @brief  logs how many particles per millisecond are simulated with and without SSE and worker threads
+    static void RunBenchmark();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets how many particles the buffer holds
+    /// @return how many particles the buffer holds
+    int GetBufferSize() const { return m_BufferSize; }
+
+
+    /// @brief  sets whether to update 4 particles at a time with SSE
+    /// @param  isVectorized    whether to use SSE - the scalar path mirrors the shader line by line, as a reference
+    void SetIsVectorized( bool isVectorized ) { m_IsVectorized = isVectorized; }
+
+    /// @brief  sets whether to split large buffers into chunks that run on the JobSystem
+    /// @param  isParallel  whether to use worker threads
+    void SetIsParallel( bool isParallel ) { m_IsParallel = isParallel; }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how many particles each job updates - a multiple of 4 so chunks line up with SSE
+    static constexpr int s_ChunkSize = 16384;
+
+
+    /// @brief  how many particles the buffer holds
+    int m_BufferSize = 0;
+
+    /// @brief  whether to update 4 particles at a time with SSE
+    bool m_IsVectorized = true;
+
+    /// @brief  whether to split large buffers into chunks that run on the JobSystem
+    bool m_IsParallel = true;
+
+    /// @brief  the uniforms of the last Step, which WriteInstances uses like the shader does
+    StepParams m_LastParams;
+
+
+    /// @brief  the fields of the particles, each padded to a multiple of 4
+    std::vector< float > m_PosX, m_PosY, m_VelX, m_VelY, m_AccX, m_AccY;
+    std::vector< float > m_Size, m_Rotation, m_Drag, m_Lifetime, m_Time, m_FadeIn, m_FadeOut, m_SizePerSec;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  initializes the particles in the range of a Step
+    /// @param  init    how to initialize the particles
+    /// @param  params  the uniforms of the Step
+    void emit( ParticleSystem::EmitData const& init, StepParams const& params );
+
+
+    /// @brief  advances a range of particles, 4 at a time
+    /// @param  dt      how long to advance the particles by
+    /// @param  begin   the first particle to advance - a multiple of 4
+    /// @param  end     one past the last particle to advance - a multiple of 4
+    void integrateVectorized( float dt, int begin, int end );
+
+    /// @brief  advances a range of particles, one at a time
+    /// @param  dt      how long to advance the particles by
+    /// @param  begin   the first particle to advance
+    /// @param  end     one past the last particle to advance
+    void integrateScalar( float dt, int begin, int end );
+
+
+    /// @brief  writes the instances of a range of particles, computing 4 at a time
+    /// @param  instances   where to write the instances
+    /// @param  begin       the first particle to write - a multiple of 4
+    /// @param  end         one past the last particle to write
+    void writeInstancesVectorized( ParticleSystem::Instance* instances, int begin, int end ) const;
+
+    /// @brief  writes the instances of a range of particles, one at a time
+    /// @param  instances   where to write the instances
+    /// @param  begin       the first particle to write
+    /// @param  end         one past the last particle to write
+    void writeInstancesScalar( ParticleSystem::Instance* instances, int begin, int end ) const;
+
+    /// @brief  packs a particle's rotation and opacity the way the shader does
+    /// @param  rotation    the rotation of the particle
+    /// @param  opacity     the opacity of the particle
+    /// @return the rotation (wrapped to 0 to 2pi) and opacity, as two halves
+    static unsigned int packRotationOpacity( float rotation, float opacity );
+
+
+    /// @brief  calls a function on chunks of a range of particles, on the JobSystem if the buffer is parallel
+    /// @tparam Function    void( int begin, int end )
+    /// @param  count       how many particles to split into chunks
+    /// @param  function    the function to call on each chunk
+    template < typename Function >
+    void forEachChunk( int count, Function const& function ) const;
+
+
+    /// @brief  the positive random number the shader gives a particle (0 to 1)
+    /// @param  index   the index of the particle
+    /// @param  seed    which of the particle's random numbers to get
+    /// @param  time    the total time simulated so far
+    /// @return the random number
+    static float prand( int index, float seed, float time );
+
+    /// @brief  the progress from start to end of time, clamped to 0 to 1 - lerpOpacity in the shader
+    /// @param  start   when the progress starts
+    /// @param  end     when the progress ends
+    /// @param  time    the current time
+    /// @return the progress
+    static float lerpOpacity( float start, float end, float time );
+
+
+//-----------------------------------------------------------------------------
+};
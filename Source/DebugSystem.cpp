@@ -85,6 +85,9 @@ void DebugSystem::SetupImGuiConfigPath()
 /// @brief Perform initialization.
 void DebugSystem::OnInit()
 {
+    // the console is created here on the main thread; the Logger's writer thread forwards lines to it from now on
+    Log()->SetConsole(Console());
+
     _window = PlatformSystem::GetInstance()->GetWindowHandle();
     // Setup ImGui context
     IMGUI_CHECKVERSION();
@@ -615,6 +618,8 @@ void DebugSystem::OnExit()
     ImPlot::DestroyContext();
     ImGui::DestroyContext();
 
+    Log()->Flush();
+    Log()->SetConsole(nullptr);
     Console()->ClearLog();
 }
 
@@ -715,10 +720,6 @@ void DebugSystem::ImguiStartFrame()
     ImGui::NewFrame();
 }
 
-void DebugSystem::WritetoConsole(const std::string& message)
-{
-    Console()->AddLog(message);
-}
 //-----------------------------------------------------------------------------
 // private: reading
 //-----------------------------------------------------------------------------
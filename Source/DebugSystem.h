@@ -20,6 +20,7 @@
 #include "basics.h"
 #include "System.h"
 #include "Console.h"
+#include "Logger.h"
 
 #include "PlayBar.h"
 
@@ -95,19 +96,12 @@ public: // DebugStream
    
     /// @brief Wrapper to write to the DebugStream
     /// @param message - the message to write to the DebugStream
+    /// @note  formatting happens on the calling thread - the Logger writes each completed line in the background
     template <typename Type>
     void Write(const Type& value)
     {
-		std::ostringstream oss;
-		oss << value;
-
-        #ifndef NDEBUG  // only write to the Console in Debug mode
-        std::cout << oss.str();
-        #endif
-
-		Stream::WriteToTraceLog(oss.str());
-        WritetoConsole(oss.str());
-	}
+        Log()->Append(value);
+    }
 
 //-----------------------------------------------------------------------------
 private: // Members
@@ -213,8 +207,6 @@ private: // methods
     /// @brief Sets up the ImGui configuration path
     void SetupImGuiConfigPath();
 
-    /// @brief Writes to the Console
-    void WritetoConsole(const std::string& message);
 //-----------------------------------------------------------------------------
 private: // reading
 //-----------------------------------------------------------------------------
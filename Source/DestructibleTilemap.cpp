@@ -242,9 +242,10 @@
 
         std::vector< float > tileHealths( tileCount );
 
+        std::vector< int > tiles = m_Tilemap->GetTilemap();
         for ( int i = 0; i < tileCount; ++i )
         {
-            tileHealths[ i ] = GetMaxHealth( m_Tilemap->GetTilemap()[ i ] );
+            tileHealths[ i ] = GetMaxHealth( tiles[ i ] );
         }
 
         m_HealthTilemap->SetDimensions( dimensions );
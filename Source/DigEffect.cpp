@@ -20,6 +20,7 @@
 #include "TilemapSprite.h"   // callback
 #include "EmitterSprite.h"   // emitter texture/frame
 #include "EntitySystem.h"	 // spawn entity
+#include "EntityPoolSystem.h" // recycled spawns
 #include "Transform.h"	     // (and set its position)
 #include "AudioPlayer.h"	 // block breaking
 #include "Texture.h"
@@ -165,7 +166,7 @@ void DigEffect::spawnTemp(Tilemap< int >* tilemap, glm::ivec2 const& tilePos, in
 	glm::vec2 pos = tilemap->TileCoordToWorldPos(tilePos);
 
 	// spawn from archetype at broken tile pos
-	Entity* temp = m_Archetype->Clone();
+	Entity* temp = EntityPools()->Spawn( m_Archetype );
 	temp->GetComponent<Transform>()->SetTranslation(pos);
 
 	// set emitter's texture and frame
@@ -79,7 +79,7 @@ void DoomsDay::OnFixedUpdate()
         if (distance <= m_LoseDistance && m_HasLost == false)
         {
             Events()->BroadcastEvent< std::string >(m_LossEventName);
-            Debug() << "Event Emitted: " << m_LossEventName << std::endl;
+            LOG_VERBOSE << "Event Emitted: " << m_LossEventName << std::endl;
             
             for (DoomsDay* doomsday : Behaviors< DoomsDay >()->GetComponents())
             {
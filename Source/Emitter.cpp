@@ -35,13 +35,45 @@ Emitter::Emitter(const Emitter& other) : Component(other),
     m_PPS(other.m_PPS),
     m_Continuous(other.m_Continuous),
     m_Delay(other.m_Delay),
-    m_BufferSize(other.m_BufferSize)
+    m_BufferSize(other.m_BufferSize),
+    m_IsSimulatedOnCpu(other.m_IsSimulatedOnCpu)
 {}
 
 
 /// @return     A copy of this emitter
 Component* Emitter::Clone() const { return new Emitter(*this); }
 
+/// @brief  resets this Emitter to a copy of another Emitter so that its Entity can be pooled.
+///         The CPU particle arrays are emptied rather than freed, so they don't reallocate next time.
+/// @param  other   the Emitter to copy
+void Emitter::ResetTo( Component const& other )
+{
+    Component::ResetTo( other );
+
+    Emitter const& emitter = static_cast< Emitter const& >( other );
+    m_Init = emitter.m_Init;
+    m_PPS = emitter.m_PPS;
+    m_Continuous = emitter.m_Continuous;
+    m_Delay = emitter.m_Delay;
+    m_BufferSize = emitter.m_BufferSize;
+    m_IsSimulatedOnCpu = emitter.m_IsSimulatedOnCpu;
+
+    // runtime state, as a copy starts out. (GL buffers were already deleted by OnExit)
+    m_IsLocal = false;
+    m_DelayTimer = 0.0f;
+    m_CurrentIndex = 0;
+    m_Zinit = true;
+    m_WasSimulatedOnCpu = false;
+    m_WGcount = 0;
+    m_ParticleCount = 0.0f;
+    m_DataSSBO = 0;
+    m_InstanceSSBO = 0;
+    m_AllocatedSize = 0;
+    m_CpuParticles.Clear();
+    m_CpuInstances.clear();
+    m_Urange = m_Uoldest = m_UparentPos = m_Ulocal = -1;
+}
+
 
 /// @brief    Destructor: calls OnExit if needed
 Emitter::~Emitter()
@@ -63,17 +95,19 @@ void Emitter::OnInit()
     Particles()->AddEmitter(this);
 
     // create/init buffers
-    glGenBuffers(1, &m_MatSSBO);
     glGenBuffers(1, &m_DataSSBO);
-    glGenBuffers(1, &m_OpacitySSBO);
+    glGenBuffers(1, &m_InstanceSSBO);
     resizeBuffers();
 
-    // uniform locations
+    // uniform locations (no compute shader when particles are simulated on the CPU only)
     Shader* cs = Renderer()->GetShader("pCompute");
-    m_Urange = cs->GetUniformID("range");
-    m_Uoldest = cs->GetUniformID("oldest");
-    m_UparentPos = cs->GetUniformID("parentPos");
-    m_Ulocal = cs->GetUniformID("local");
+    if (cs)
+    {
+        m_Urange = cs->GetUniformID("range");
+        m_Uoldest = cs->GetUniformID("oldest");
+        m_UparentPos = cs->GetUniformID("parentPos");
+        m_Ulocal = cs->GetUniformID("local");
+    }
 
     // parent transform
     m_Transform.Init( GetEntity() );
@@ -87,12 +121,12 @@ void Emitter::OnExit()
 {
     Particles()->RemoveEmitter(this);
     glDeleteBuffers(1, &m_DataSSBO);
-    glDeleteBuffers(1, &m_MatSSBO);
-    glDeleteBuffers(1, &m_OpacitySSBO);
+    glDeleteBuffers(1, &m_InstanceSSBO);
 
     m_Transform.Exit();
 
     m_DataSSBO = 0;  // for destructor
+    m_AllocatedSize = 0;
 }
 
 
@@ -108,25 +142,18 @@ void Emitter::OnExit()
 /// @param dt       Deltatime
 void Emitter::Update(float dt)
 {
-    // bind individual buffers
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_DataSSBO);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_OpacitySSBO);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_MatSSBO);
-
-    // zero-init the buffer (by setting range to whole size)
-    if (m_Zinit)
+    // zero-init the buffer (by setting range to whole size). Also needed when
+    // switching between GPU and CPU, since the other side's buffer is stale.
+    if (m_Zinit || m_WasSimulatedOnCpu != GetIsSimulatedOnCpu())
     {
         m_Zinit = false;
-        glUniform2i(m_Urange, 0, m_BufferSize);
-        glDispatchCompute(m_WGcount, 1, 1);
+        m_WasSimulatedOnCpu = GetIsSimulatedOnCpu();
+        dispatch(dt, glm::ivec2(0, m_BufferSize), m_CurrentIndex);
 
         return;
     }
 
-    glUniform1i(m_Ulocal, int(m_IsLocal));
-    if (m_Transform)
-        glUniform2fv(m_UparentPos, 1, &m_Transform->GetTranslation().x);
-    else
+    if (!m_Transform)
     {
         m_Transform.Init(GetEntity());
         if (!m_Transform)
@@ -151,7 +178,7 @@ void Emitter::Update(float dt)
             else
             {
                 // delay time not reached: no emitting. Just update
-                glDispatchCompute(m_WGcount, 1, 1);
+                dispatch(dt, glm::ivec2(-1, -1), m_CurrentIndex);
 
                 return;
             }
@@ -164,7 +191,8 @@ void Emitter::Update(float dt)
     int count = (int)m_ParticleCount;
     m_ParticleCount -= glm::floor(m_ParticleCount);
 
-    glUniform1i(m_Uoldest, m_CurrentIndex);
+    int oldest = m_CurrentIndex;
+    glm::ivec2 range(-1, -1); // (nothing to emit this time)
 
     if (count && count <= m_BufferSize)
     {
@@ -172,15 +200,31 @@ void Emitter::Update(float dt)
         if (m_CurrentIndex + count > m_BufferSize)
             m_CurrentIndex = 0;
 
-        glUniform2i(m_Urange, m_CurrentIndex, m_CurrentIndex+count);
+        range = glm::ivec2(m_CurrentIndex, m_CurrentIndex+count);
 
         m_CurrentIndex += count;
     }
-    else
-        glUniform2i(m_Urange, -1, -1); // (nothing to emit this time)
 
-    
-    glDispatchCompute(m_WGcount, 1, 1);
+    dispatch(dt, range, oldest);
+}
+
+
+/// @brief   Sends the instances of CPU-simulated particles
+///          to the buffers EmitterSprite draws from. Called once per frame.
+void Emitter::UploadCpuParticles()
+{
+    // not stepped since the last resize
+    if (m_CpuParticles.GetBufferSize() != m_BufferSize)
+        return;
+
+    m_CpuInstances.resize(m_BufferSize);
+    m_CpuParticles.WriteInstances(m_CpuInstances.data());
+
+    // plain array buffer as far as the vertex shader is concerned
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceSSBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(ParticleSystem::Instance) * m_BufferSize, 
+                    m_CpuInstances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 
@@ -196,6 +240,7 @@ void Emitter::Inspector()
     bool initChanged = false;
 
     ImGui::Checkbox("Local translation", &m_IsLocal);
+    ImGui::Checkbox("Simulate on CPU", &m_IsSimulatedOnCpu);
     ImGui::Checkbox("Continuous", &m_Continuous);
     if (!m_Continuous)
     {
@@ -261,32 +306,96 @@ void Emitter::Inspector()
 //              Helpers
 //-----------------------------------------------------------------------------
 
-/// @brief   (re)allocates buffers based on m_BufferSize.
+/// @brief   (re)allocates buffers based on m_BufferSize, keeping the particles
+///          that still fit. Only new particles are zeroed.
 void Emitter::resizeBuffers()
 {
     // ensure buffer size is multiple of 128
     m_BufferSize = int(std::ceil(m_BufferSize / 128.0f) * 128);
     m_Init.bufferSize = m_BufferSize;
     m_WGcount = m_BufferSize / Particles()->GetWorkGroupSize();
+    m_CurrentIndex = std::min(m_CurrentIndex, m_BufferSize);
+
+    // all bound as array buffers, which exist without compute shader support
+
+    // raw data buffer. Stash the particles that still fit, since glBufferData
+    // throws the old contents away. (buffer IDs stay the same for EmitterSprite's VAO)
+    const GLsizeiptr particleSize = sizeof(ParticleSystem::Particle);
+    int keptCount = std::min(m_AllocatedSize, m_BufferSize);
+    unsigned int stash = 0;
+    if (keptCount)
+    {
+        glGenBuffers(1, &stash);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, stash);
+        glBufferData(GL_COPY_WRITE_BUFFER, particleSize * keptCount, NULL, GL_STREAM_COPY);
+        glBindBuffer(GL_COPY_READ_BUFFER, m_DataSSBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, particleSize * keptCount);
+    }
 
-    // raw data buffer
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_DataSSBO);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, (sizeof(ParticleSystem::Particle)) * 
-                                            m_BufferSize, NULL, GL_STREAM_DRAW);
+    // zero only the new particles (size 0 = dead). FFS, NULL DOES NOT ZERO-INIT!!!
+    std::vector<ParticleSystem::Particle> emptiness(m_BufferSize - keptCount);
+    glBindBuffer(GL_ARRAY_BUFFER, m_DataSSBO);
+    glBufferData(GL_ARRAY_BUFFER, particleSize * m_BufferSize, NULL, GL_STREAM_DRAW);
+    if (!emptiness.empty())
+        glBufferSubData(GL_ARRAY_BUFFER, particleSize * keptCount, 
+                        particleSize * emptiness.size(), &emptiness[0]);
 
-    // opacities buffer
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_OpacitySSBO);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(float) * 
-                    m_BufferSize, NULL, GL_STREAM_DRAW);
+    if (stash)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, stash);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_DataSSBO);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, particleSize * keptCount);
+        glDeleteBuffers(1, &stash);
+    }
+
+    // instances buffer - rewritten by every dispatch, so only zeroed for the first frame.
     // allow it to be read by vertex shader
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceSSBO);
+    std::vector<ParticleSystem::Instance> noInstances(m_BufferSize);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(ParticleSystem::Instance) * 
+                    m_BufferSize, &noInstances[0], GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // transform matrices buffer
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_MatSSBO);
-    std::vector<char> emptiness(sizeof(glm::mat4) * m_BufferSize);  // FFS, NULL DOES NOT ZERO-INIT!!! 
-    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::mat4) *      // Thanks for the headache, chatgpt...
-                    m_BufferSize, &emptiness[0], GL_STREAM_DRAW);
+    m_AllocatedSize = m_BufferSize;
+}
 
-    m_Zinit = true;
+
+/// @brief          Updates the particles, on the GPU or the CPU
+/// @param dt       Deltatime
+/// @param range    Particles to emit - (-1, -1) for none, whole buffer to zero it
+/// @param oldest   Index of the oldest particle
+void Emitter::dispatch(float dt, glm::ivec2 const& range, int oldest)
+{
+    glm::vec2 parentPos = m_Transform ? m_Transform->GetTranslation() : glm::vec2(0.0f);
+
+    if (GetIsSimulatedOnCpu())
+    {
+        if (m_CpuParticles.GetBufferSize() != m_BufferSize)
+            m_CpuParticles.Resize(m_BufferSize);
+
+        // same uniforms the compute shader gets
+        CpuParticleBuffer::StepParams params;
+        params.M_Dt = dt;
+        params.M_Time = Particles()->GetTime();
+        params.M_Range = range;
+        params.M_Oldest = oldest;
+        params.M_ParentPos = parentPos;
+        params.M_IsLocal = m_IsLocal;
+        m_CpuParticles.Step(m_Init, params);
+
+        return;
+    }
+
+    // bind individual buffers
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_DataSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_InstanceSSBO);
+
+    glUniform1i(m_Ulocal, int(m_IsLocal));
+    glUniform2fv(m_UparentPos, 1, &parentPos.x);
+    glUniform1i(m_Uoldest, oldest);
+    glUniform2i(m_Urange, range.x, range.y);
+
+    glDispatchCompute(m_WGcount, 1, 1);
 }
 
 
@@ -333,6 +442,14 @@ void Emitter::readMax(nlohmann::ordered_json const& data)
 }
 
 
+/// @brief          Reads in the boolean for simulating on the CPU
+/// @param  data    JSON data to read
+void Emitter::readSimulateOnCpu(nlohmann::ordered_json const& data)
+{
+    m_IsSimulatedOnCpu = Stream::Read< bool >(data);
+}
+
+
 /// @brief          Reads in the array that represents init data.
 /// @param  data    JSON data to read
 void Emitter::readData(nlohmann::ordered_json const& data)
@@ -367,7 +484,8 @@ ReadMethodMap< Emitter > const Emitter::s_ReadMethods = {
     {"Delay"     , &readDelay       },
     {"Max"       , &readMax         },
     {"EmitData"  , &readData        },
-    {"IsLocal"   , &readLocal       }
+    {"IsLocal"   , &readLocal       },
+    {"SimulateOnCpu", &readSimulateOnCpu }
 };
 
 
@@ -384,6 +502,7 @@ nlohmann::ordered_json Emitter::Write() const
     data["Max"] = m_BufferSize;
     data["Continuous"] = m_Continuous;
     data["IsLocal"] = m_IsLocal;
+    data["SimulateOnCpu"] = m_IsSimulatedOnCpu;
 
     // ordered consistently with ParticleSystem::EmitData
     nlohmann::ordered_json& emitData = data[ "EmitData" ];
@@ -10,6 +10,7 @@
 #include "ParticleSystem.h"
 #include "ComponentReference.h"
 #include "Transform.h"
+#include "CpuParticleBuffer.h"
 
 /// @brief  Emitter component - controls timing and behavior of particles
 class Emitter : public Component
@@ -26,6 +27,15 @@ public:
     /// @return   A copy of this emitter
     virtual Component* Clone() const override;
 
+    /// @brief  checks whether this Emitter can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a Emitter
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< Emitter >( other ); }
+
+    /// @brief  resets this Emitter to a copy of another Emitter so that its Entity can be pooled
+    /// @param  other   the Emitter to copy
+    virtual void ResetTo( Component const& other ) override;
+
     /// @brief    Destructor: calls OnExit if needed
     ~Emitter();
 
@@ -50,11 +60,8 @@ public:
     /// @return  Size of the particle buffer(s), which is also maximum particle count 
     __inline int GetBufferSize() const { return m_BufferSize; }
 
-    /// @return  ID of the shader storage buffer for matrices
-    __inline unsigned GetMatSSBO() const { return m_MatSSBO; }
-
-    /// @return  ID of the shader storage buffer for opacity values
-    __inline unsigned GetOpacitySSBO() const { return m_OpacitySSBO; }
+    /// @return  ID of the shader storage buffer for instances (ParticleSystem::Instance)
+    __inline unsigned GetInstanceSSBO() const { return m_InstanceSSBO; }
 
     /// @return  Emit data (particle system needs it)
     __inline ParticleSystem::EmitData const& GetEmitData() const { return m_Init; }
@@ -68,6 +75,16 @@ public:
     /// @param dt       Deltatime
     void Update(float dt);
 
+    /// @brief   Sends the instances of CPU-simulated particles
+    ///          to the buffers EmitterSprite draws from. Called once per frame.
+    void UploadCpuParticles();
+
+    /// @brief   Sets whether this emitter is simulated on the CPU instead of the compute shader
+    __inline void SetIsSimulatedOnCpu(bool isOnCpu) { m_IsSimulatedOnCpu = isOnCpu; }
+
+    /// @return  Whether this emitter is simulated on the CPU, by its own choice or globally
+    __inline bool GetIsSimulatedOnCpu() const { return m_IsSimulatedOnCpu || Particles()->GetIsSimulatingOnCpu(); }
+
 
 
 //-----------------------------------------------------------------------------
@@ -97,6 +114,8 @@ private:
     float m_DelayTimer = 0.0f;  /// @brief  Timer for the delay
     int m_CurrentIndex = 0;     /// @brief  Index to emit new particles at
     bool m_Zinit = true;        /// @brief  Init buffer to 0 when this is true
+    bool m_IsSimulatedOnCpu = false;    /// @brief  If true, skips the compute shader
+    bool m_WasSimulatedOnCpu = false;   /// @brief  Where the buffers were last updated
     
     /// @brief   Parent entity's transform
     ComponentReference<Transform> m_Transform;
@@ -115,11 +134,19 @@ private:
     ///          integer part of this number is used as amt of particles to emit
     float m_ParticleCount = 0.0f;
 
-    /// @brief   Shader storage buffers for particle data. Raw data, matrices,
-    ///          and opacities.
+    /// @brief   Shader storage buffers for particle data. Raw data and
+    ///          instances to draw.
     unsigned int m_DataSSBO = 0, 
-                 m_MatSSBO = 0, 
-                 m_OpacitySSBO = 0;
+                 m_InstanceSSBO = 0;
+
+    /// @brief   How many particles the buffers currently hold (0 before allocation)
+    int m_AllocatedSize = 0;
+
+    /// @brief   Particles, when simulated on the CPU
+    CpuParticleBuffer m_CpuParticles;
+
+    /// @brief   CPU-side copy of the instance buffer, when simulated on the CPU
+    std::vector<ParticleSystem::Instance> m_CpuInstances;
 
     /// @brief   Cached uniform locations
     unsigned int m_Urange = -1,
@@ -133,9 +160,16 @@ private:
 //-----------------------------------------------------------------------------
 private:
     
-    /// @brief   (re)allocates buffers based on m_BufferSize.
+    /// @brief   (re)allocates buffers based on m_BufferSize, keeping the particles
+    ///          that still fit. Only new particles are zeroed.
     void resizeBuffers();
 
+    /// @brief          Updates the particles, on the GPU or the CPU
+    /// @param dt       Deltatime
+    /// @param range    Particles to emit - (-1, -1) for none, whole buffer to zero it
+    /// @param oldest   Index of the oldest particle
+    void dispatch(float dt, glm::ivec2 const& range, int oldest);
+
 
 
 //-----------------------------------------------------------------------------
@@ -163,6 +197,10 @@ private:
     /// @param  data    JSON data to read
     void readMax(nlohmann::ordered_json const& data);
 
+    /// @brief          Reads in the boolean for simulating on the CPU
+    /// @param  data    JSON data to read
+    void readSimulateOnCpu(nlohmann::ordered_json const& data);
+
     /// @brief          Reads in the array of floats that represent init data.
     /// @param  data    JSON data to read
     void readData(nlohmann::ordered_json const& data);
@@ -15,6 +15,7 @@
 #include "ParticleSystem.h" // SSBO
 #include "RenderSystem.h"   // shader
 #include "Entity.h"         // parent
+#include "CameraSystem.h"   // projection matrix
 
 
 /// @brief          Default constructor
@@ -31,6 +32,16 @@ EmitterSprite::EmitterSprite(const EmitterSprite& other) :
 /// @return  Copy of this component
 EmitterSprite* EmitterSprite::Clone() const { return new EmitterSprite(*this); }
 
+/// @brief  resets this EmitterSprite to a copy of another EmitterSprite so that its Entity can be pooled
+/// @param  other   the EmitterSprite to copy
+void EmitterSprite::ResetTo( Component const& other )
+{
+    Sprite::ResetTo( other );
+
+    // the VAO was already deleted by OnExit
+    m_Emitter = nullptr;
+}
+
 /// @brief      Destructor: calls OnExit if needed
 EmitterSprite::~EmitterSprite()
 {
@@ -77,6 +88,7 @@ void EmitterSprite::Draw()
     glUniform4fv(sh->GetUniformID("tint"), 1, &m_Color[0]);
     glm::vec2 uv_offset = calcUVoffset();
     glUniform2f(sh->GetUniformID("UV_offset"), uv_offset.x, uv_offset.y);
+    glUniformMatrix4fv(sh->GetUniformID("proj"), 1, 0, &Cameras()->GetMat_WorldToClip()[0][0]);
 
     // Bind the texture and render instanced mesh using ParticleSystem's VAO
     glBindVertexArray(m_VAO);
@@ -115,28 +127,17 @@ void EmitterSprite::initInstancingStuff()
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
 
-    // Attributes linked to SSBO (per instance):
-    // Mesh opacity       (attribute 2, 1 float)
-    glBindBuffer(GL_ARRAY_BUFFER, m_Emitter->GetOpacitySSBO());
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), 0);
+    // Attributes linked to SSBO (per instance, ParticleSystem::Instance):
+    // Position and size  (attribute 2, 3 floats)
+    // Rotation, opacity  (attribute 3, 1 uint - two halves, unpacked by the shader)
+    using Instance = ParticleSystem::Instance;
+    glBindBuffer(GL_ARRAY_BUFFER, m_Emitter->GetInstanceSSBO());
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, pos));
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(Instance), (void*)offsetof(Instance, rotationOpacity));
     glVertexAttribDivisor(2, 1);
-    glEnableVertexAttribArray(2);
-    // Transform matrix   (attribute 3, occupies 4 attribute spaces - vec4 each)
-    glBindBuffer(GL_ARRAY_BUFFER, m_Emitter->GetMatSSBO());
-    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), 0);
-    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*) sizeof(glm::vec4));
-    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4)*2));
-    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4)*3));
     glVertexAttribDivisor(3, 1);
-    glVertexAttribDivisor(4, 1);
-    glVertexAttribDivisor(5, 1);
-    glVertexAttribDivisor(6, 1);
+    glEnableVertexAttribArray(2);
     glEnableVertexAttribArray(3);
-    glEnableVertexAttribArray(4);
-    glEnableVertexAttribArray(5);
-    glEnableVertexAttribArray(6);
-
-    // It's still declared as regular mat4 on the shader. Go figure.
 
     glBindVertexArray(0);
 
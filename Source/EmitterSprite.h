@@ -41,6 +41,15 @@ private:
     /// @return  Copy of this component
     virtual EmitterSprite* Clone() const override;
 
+    /// @brief  checks whether this EmitterSprite can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a EmitterSprite
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< EmitterSprite >( other ); }
+
+    /// @brief  resets this EmitterSprite to a copy of another EmitterSprite so that its Entity can be pooled
+    /// @param  other   the EmitterSprite to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 public:
     // from Sprite
@@ -23,6 +23,7 @@
 #include "AudioPlayer.h"
 #include "Health.h"
 #include "PathfindSystem.h"
+#include "EntityPoolSystem.h"
 
 //-----------------------------------------------------------------------------
 // public: constructor / destructor
@@ -154,7 +155,7 @@
     /// @brief What to do when the enemy dies.
     void EnemyBehavior::onDeath()
     {
-        m_RewardEntity = m_Reward->Clone();
+        m_RewardEntity = EntityPools()->Spawn( m_Reward );
 
         m_RewardEntity->GetComponent<Transform>()->SetTranslation(m_Transform->GetTranslation());
 
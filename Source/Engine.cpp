@@ -23,6 +23,8 @@
 #include "CollisionSystem.h"
 #include "InputSystem.h"
 #include "EntitySystem.h"
+#include "EntityPoolSystem.h"
+#include "ProfilerSystem.h"
 #include "CameraSystem.h"
 #include "TileInfoSystem.h"
 #include "EventSystem.h"
@@ -59,6 +61,7 @@
 #include "LightingSystem.h"
 #include "PathfindSystem.h"
 #include "ControlPromptSystem.h"
+#include "RigidBodySystem.h"
 
 
 //-----------------------------------------------------------------------------
@@ -221,6 +224,8 @@
     /// @brief  Updates the engine each frame
     void Engine::update()
     {
+        PROFILE_FRAME();
+
         double currentTime = glfwGetTime();
 
         // const int maxFrameTimes = 60;
@@ -264,6 +269,7 @@
                 GLFWwindow* window = PlatformSystem::GetInstance()->GetWindowHandle();
 
                 // Swap front and back buffers
+                PROFILE_SCOPE( "SwapBuffers" );
                 glfwSwapBuffers(window);
 
         // TODO: move the above code out of Engine and into its own System
@@ -273,12 +279,15 @@
     /// @param  dt  the amount of time the frame lasted
     void Engine::updateSystems( float dt )
     {
+        PROFILE_SCOPE( "Update" );
+
         m_currentMode = UpdateMode::update;
         ++m_FrameCount;
         for ( System * system : m_Systems )
         {
             if ( system->GetEnabled() )
             {
+                PROFILE_SCOPE( system->GetName().c_str() );
                 system->OnUpdate( dt );
             }
         }
@@ -287,12 +296,15 @@
     /// @brief  Calls all Systems' OnFixedUpdate function
     void Engine::fixedUpdateSystems()
     {
+        PROFILE_SCOPE( "FixedUpdate" );
+
         m_currentMode = UpdateMode::fixedUpdate;
         ++m_FixedFrameCount;
         for ( System * system : m_Systems )
         {
             if ( system->GetEnabled() )
             {
+                PROFILE_SCOPE( system->GetName().c_str() );
                 system->OnFixedUpdate();
             }
         }
@@ -350,7 +362,7 @@
                 continue;
             }
 
-            Stream::PushDebugLocation( key + "." );
+            Stream::PushDebugLocation( key );
            
             System* system = ( this->*addSystemMethod->second )(); // create and add the System to the Engine
             Stream::Read( system, value ); // have the System load itself
@@ -387,6 +399,8 @@
         { "DebugSystem"                           , &addSystem< DebugSystem         >                      },
         { "AudioSystem"                           , &addSystem< AudioSystem         >                      },
         { "EntitySystem"                          , &addSystem< EntitySystem        >                      },
+        { "EntityPoolSystem"                      , &addSystem< EntityPoolSystem    >                      },
+        { "ProfilerSystem"                        , &addSystem< ProfilerSystem      >                      },
         { "ParticleSystem"                        , &addSystem< ParticleSystem      >                      },
         { "CheatSystem"                           , &addSystem< CheatSystem         >                      },
         { "EventSystem"                           , &addSystem< EventSystem         >                      },
@@ -395,11 +409,11 @@
         { "LightingSystem"                        , &addSystem< LightingSystem      >                      },
         { "PathfindSystem"                        , &addSystem< PathfindSystem      >                      },
         { "ControlPromptSystem"                   , &addSystem< ControlPromptSystem >                      },
+        { "RigidBodySystem"                       , &addSystem< RigidBodySystem     >                      },
         { "TileInfoSystem"                        , &addSystem< TileInfoSystem      >                      },
         { "LightingSystem"                        , &addSystem< LightingSystem      >                      },
         { "PathfindSystem"                        , &addSystem< PathfindSystem      >                      },
 
-        { "BehaviorSystem<RigidBody>"             , &addSystem< BehaviorSystem< RigidBody              > > },
         { "BehaviorSystem<Behavior>"              , &addSystem< BehaviorSystem< Behavior               > > },
         { "BehaviorSystem<Animation>"             , &addSystem< BehaviorSystem< Animation              > > },
         { "BehaviorSystem<EffectAnimator>"        , &addSystem< BehaviorSystem< EffectAnimator         > > },
@@ -78,7 +78,7 @@
     {
         // You tried to add a component that already exists on this entity.
         // Check if the component already exists. 
-        if ( m_Components.find( component->GetType() ) != m_Components.end() )
+        if ( findComponent( ComponentTypeTable::GetId( component->GetType() ) ) != -1 )
         {
             Debug() << "WARNING: attempting to add a duplicate component to the Entity \"" << m_Name << "\"" << std::endl;
             return;
@@ -88,7 +88,7 @@
         component->SetEntity( this );
 
         // add it to the entity.
-        m_Components[ component->GetType() ] = component;
+        insertComponent( component );
     }
 
 
@@ -172,8 +172,8 @@
 
     
     /// @brief  gets all components in this Entity
-    /// @return the map of all components in this Entity
-    std::map< std::type_index, Component* >& Entity::getComponents()
+    /// @return all components in this Entity, sorted by type
+    std::vector< Entity::ComponentEntry > const& Entity::getComponents() const
     {
         return m_Components;
     }
@@ -339,6 +339,68 @@
         m_ComponentReferences.erase( componentReference );
     }
 
+
+    /// @brief  gets the archetype this Entity was spawned from by the EntityPoolSystem
+    /// @brief  FOR ENGINE USE ONLY - only call this if you're modifying core engine functionality
+    /// @return the archetype this Entity was spawned from (nullptr if not pooled)
+    Entity const* Entity::GetPoolArchetype() const
+    {
+        return m_PoolArchetype;
+    }
+
+    /// @brief  sets the archetype this Entity was spawned from by the EntityPoolSystem
+    /// @brief  FOR ENGINE USE ONLY - only call this if you're modifying core engine functionality
+    /// @param  archetype   the archetype this Entity was spawned from
+    void Entity::SetPoolArchetype( Entity const* archetype )
+    {
+        m_PoolArchetype = archetype;
+    }
+
+
+    /// @brief  resets this Entity and its Components to a copy of another Entity, reusing their memory
+    /// @brief  FOR ENGINE USE ONLY - only call this if you're modifying core engine functionality
+    /// @param  other   the Entity to copy (this Entity's archetype)
+    /// @return whether this Entity could be reset - if not, it should be deleted instead
+    bool Entity::ResetTo( Entity const& other )
+    {
+        // only childless Entities whose Components still match the archetype's can be reset
+        if (
+            m_IsInScene ||
+            m_Children.empty() == false || other.m_Children.empty() == false ||
+            m_Components.size() != other.m_Components.size()
+        )
+        {
+            return false;
+        }
+
+        // check every Component before resetting any, so that a failure doesn't leave this Entity half reset
+        auto otherComponent = other.m_Components.begin();
+        for ( auto const& [ type, component ] : m_Components )
+        {
+            if ( type != otherComponent->first || component->CanResetTo( *otherComponent->second ) == false )
+            {
+                return false;
+            }
+
+            ++otherComponent;
+        }
+
+        otherComponent = other.m_Components.begin();
+        for ( auto& [ type, component ] : m_Components )
+        {
+            component->ResetTo( *otherComponent->second );
+            ++otherComponent;
+        }
+
+        m_Name = other.m_Name;
+        m_Id = GetUniqueId();
+        m_Parent = nullptr;
+        m_NumDescendants = 0;
+        m_IsDestroyed = false;
+        m_SetParentOnInit = false;
+        return true;
+    }
+
     
 //-----------------------------------------------------------------------------
 // private: methods
@@ -429,6 +491,36 @@
     }
 
 
+    /// @brief  inserts a Component into m_Components, keeping it sorted
+    /// @param  component   the Component to insert - there mustn't already be one of its type
+    void Entity::insertComponent( Component* component )
+    {
+        // keep the order the components had when they were in a map, so they still init in the same order
+        auto position = std::lower_bound(
+            m_Components.begin(), m_Components.end(), component->GetType(),
+            []( ComponentEntry const& entry, std::type_index const& type ) { return entry.first < type; }
+        );
+        int index = (int)( position - m_Components.begin() );
+
+        m_Components.insert( position, { component->GetType(), component } );
+        m_ComponentTypeIds.insert( m_ComponentTypeIds.begin() + index, ComponentTypeTable::GetId( component->GetType() ) );
+    }
+
+    /// @brief  removes a Component from m_Components
+    /// @param  component   the Component to remove
+    void Entity::eraseComponent( Component* component )
+    {
+        int index = findComponent( ComponentTypeTable::GetId( component->GetType() ) );
+        if ( index == -1 )
+        {
+            return;
+        }
+
+        m_Components.erase( m_Components.begin() + index );
+        m_ComponentTypeIds.erase( m_ComponentTypeIds.begin() + index );
+    }
+
+
 //------------------------------------------------------------------------------
 // private: inspection
 //------------------------------------------------------------------------------
@@ -441,7 +533,7 @@
         {
             for ( auto& [ name, info ] : ComponentFactory::GetComponentTypes() )
             {
-                if ( m_Components.contains( info.first ) )
+                if ( findComponent( ComponentTypeTable::GetId( info.first ) ) != -1 )
                 {
                     continue;
                 }
@@ -485,7 +577,7 @@
         {
             if ( name.empty() == false )
             {
-                Debug() << "Renamed Entity " << m_Name << " to " << name << "\n";
+                LOG_VERBOSE << "Renamed Entity " << m_Name << " to " << name << "\n";
                 m_Name = name;
                 name.clear();
             }
@@ -580,7 +672,7 @@
             component->OnExit();
         }
 
-        m_Components.erase( component->GetType() );
+        eraseComponent( component );
         delete component;
     }
 
@@ -619,17 +711,17 @@
                 continue;
             }
 
-            // [] operator finds the key in the map, or creates it if it doesn't exist yet.
-            Component*& component = m_Components[ *type ];
-
-            // if the component doesn't exist yet, create and add it.
+            // find the component, or create and add it if it doesn't exist yet.
+            int index = findComponent( ComponentTypeTable::GetId( *type ) );
+            Component* component = index != -1 ? m_Components[ index ].second : nullptr;
             if ( component == nullptr )
             {
                 component = ComponentFactory::Create( key );
                 component->SetEntity( this );
+                insertComponent( component );
             }
 
-            Stream::PushDebugLocation( key + "." );
+            Stream::PushDebugLocation( key );
 
 			// Read in all the data for the component from the json.
 			Stream::Read( component, value );
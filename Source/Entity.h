@@ -16,6 +16,7 @@
 //-----------------------------------------------------------------------------
 #include "pch.h" 
 #include "Component.h"
+#include "ComponentTypeTable.h"
 #include "ISerializable.h"
 
 class EntityReference;
@@ -26,6 +27,15 @@ class ComponentReferenceBase;
 //-----------------------------------------------------------------------------
 class Entity : public ISerializable
 {
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a Component attached to an Entity, along with its type
+    using ComponentEntry = std::pair< std::type_index, Component* >;
+
+
 //-----------------------------------------------------------------------------
 public: // constructor / destructor
 //-----------------------------------------------------------------------------
@@ -93,8 +103,8 @@ public: // accessors
 
 
     /// @brief  gets all components in this Entity
-    /// @return the map of all components in this Entity
-    std::map< std::type_index, Component* >& getComponents();
+    /// @return all components in this Entity, sorted by type
+    std::vector< ComponentEntry > const& getComponents() const;
 
 
     /// @brief  gets whether this Entity is flagged for destruction
@@ -152,8 +162,12 @@ private: // member variables
     /// @brief  this Entity's name
     std::string m_Name = "";
 
-    /// @brief  containter of components attached to this Entity
-    std::map< std::type_index, Component* > m_Components = {};
+    /// @brief  the components attached to this Entity, sorted by type
+    /// @note   Entities only have a handful of Components, so a flat array beats a map
+    std::vector< ComponentEntry > m_Components = {};
+
+    /// @brief  the ComponentTypeTable ID of each Component in m_Components, so lookups compare ints instead of type_infos
+    std::vector< int > m_ComponentTypeIds = {};
 
     /// @brief  the ID of this Component
     unsigned m_Id = -1;
@@ -182,6 +196,10 @@ private: // member variables
     bool m_SetParentOnInit = false;
 
 
+    /// @brief  the archetype this Entity was spawned from by the EntityPoolSystem (nullptr if not pooled)
+    Entity const* m_PoolArchetype = nullptr;
+
+
     /// @brief  all of the ComponentReferences currently tracking this Entity
     std::set< ComponentReferenceBase* > m_ComponentReferences;
 
@@ -220,6 +238,24 @@ public: // engine methods
     void RemoveComponentReference( ComponentReferenceBase* componentReference ) noexcept;
 
 
+    /// @brief  gets the archetype this Entity was spawned from by the EntityPoolSystem
+    /// @brief  FOR ENGINE USE ONLY - only call this if you're modifying core engine functionality
+    /// @return the archetype this Entity was spawned from (nullptr if not pooled)
+    Entity const* GetPoolArchetype() const;
+
+    /// @brief  sets the archetype this Entity was spawned from by the EntityPoolSystem
+    /// @brief  FOR ENGINE USE ONLY - only call this if you're modifying core engine functionality
+    /// @param  archetype   the archetype this Entity was spawned from
+    void SetPoolArchetype( Entity const* archetype );
+
+
+    /// @brief  resets this Entity and its Components to a copy of another Entity, reusing their memory
+    /// @brief  FOR ENGINE USE ONLY - only call this if you're modifying core engine functionality
+    /// @param  other   the Entity to copy (this Entity's archetype)
+    /// @return whether this Entity could be reset - if not, it should be deleted instead
+    bool ResetTo( Entity const& other );
+
+
 //-----------------------------------------------------------------------------
 private: // methods
 //-----------------------------------------------------------------------------
@@ -244,6 +280,39 @@ private: // methods
     void propagateHeirachyChangeEvent( Entity* previousParent );
 
 
+    /// @brief  finds the Component of exactly the specified type
+    /// @param  typeId  the ComponentTypeTable ID of the type to find
+    /// @return the index of the Component in m_Components, or -1 if there isn't one
+    int findComponent( int typeId ) const
+    {
+        for ( int i = 0; i < (int)m_ComponentTypeIds.size(); ++i )
+        {
+            if ( m_ComponentTypeIds[ i ] == typeId )
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    /// @brief  inserts a Component into m_Components, keeping it sorted
+    /// @param  component   the Component to insert - there mustn't already be one of its type
+    void insertComponent( Component* component );
+
+    /// @brief  removes a Component from m_Components
+    /// @param  component   the Component to remove
+    void eraseComponent( Component* component );
+
+
+    /// @brief  casts a Component to a type it is known to derive from
+    /// @tparam ComponentType   the type to cast to
+    /// @param  component       the Component to cast
+    /// @return the cast Component
+    template < typename ComponentType >
+    static ComponentType const* castComponent( Component const* component );
+
+
 //-----------------------------------------------------------------------------
 public: // inspection
 //-----------------------------------------------------------------------------
@@ -344,19 +413,19 @@ public: // copying
     template < typename ComponentType >
     ComponentType const* Entity::GetComponent() const
     {
-        auto componentIterator = m_Components.find( typeid( ComponentType ) );
-        if ( componentIterator != m_Components.end() )
+        int typeId = ComponentTypeTable::GetId< ComponentType >();
+        int index = findComponent( typeId );
+        if ( index != -1 )
         {
-            return static_cast< ComponentType* >( componentIterator->second );
+            return castComponent< ComponentType >( m_Components[ index ].second );
         }
 
         // if exact type not found, fall back to searching for a derived type
-        for ( auto const& [ type, component ] : m_Components )
+        for ( int i = 0; i < (int)m_Components.size(); ++i )
         {
-            ComponentType const* found = dynamic_cast< ComponentType const* >( component );
-            if ( found != nullptr )
+            if ( ComponentTypeTable::IsDerived< ComponentType >( m_ComponentTypeIds[ i ], m_Components[ i ].second ) )
             {
-                return found;
+                return castComponent< ComponentType >( m_Components[ i ].second );
             }
         }
 
@@ -383,12 +452,11 @@ public: // copying
     {
 	    std::vector< ComponentType* > componentsOfType;
 
-	    for ( auto& [ type, component ] : m_Components ) 
+	    for ( int i = 0; i < (int)m_Components.size(); ++i ) 
 	    {
-            ComponentType* casted = dynamic_cast< ComponentType* >( component );
-		    if ( casted != nullptr )
+		    if ( ComponentTypeTable::IsDerived< ComponentType >( m_ComponentTypeIds[ i ], m_Components[ i ].second ) )
 		    {
-			    componentsOfType.push_back( casted );
+			    componentsOfType.push_back( const_cast< ComponentType* >( castComponent< ComponentType >( m_Components[ i ].second ) ) );
 		    }
 	    }
 
@@ -396,4 +464,23 @@ public: // copying
     }
 
 
+    /// @brief  casts a Component to a type it is known to derive from
+    /// @tparam ComponentType   the type to cast to
+    /// @param  component       the Component to cast
+    /// @return the cast Component
+    template < typename ComponentType >
+    ComponentType const* Entity::castComponent( Component const* component )
+    {
+        // interfaces that aren't Components still need a cross-cast
+        if constexpr ( std::is_base_of_v< Component, ComponentType > )
+        {
+            return static_cast< ComponentType const* >( component );
+        }
+        else
+        {
+            return dynamic_cast< ComponentType const* >( component );
+        }
+    }
+
+
 //-----------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,245 @@
+/// @file       EntityPoolSystem.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      System that recycles instances of archetypes instead of cloning and deleting them
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "EntityPoolSystem.h"
+
+#include "Entity.h"
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets a new instance of an archetype, recycling a pooled instance if one is available
+    /// @param  archetype   the archetype to get an instance of
+    /// @return the new instance (nullptr if archetype is nullptr)
+    Entity* EntityPoolSystem::Spawn( Entity const* archetype )
+    {
+        if ( archetype == nullptr )
+        {
+            return nullptr;
+        }
+
+        ArchetypePool& pool = m_Pools[ archetype ];
+
+        Entity* entity;
+        if ( pool.M_Instances.empty() == false )
+        {
+            entity = pool.M_Instances.back();
+            pool.M_Instances.pop_back();
+            ++pool.M_Hits;
+        }
+        else
+        {
+            entity = archetype->Clone();
+            ++pool.M_Misses;
+        }
+
+        entity->SetPoolArchetype( archetype );
+
+        ++pool.M_ActiveCount;
+        pool.M_HighWaterMark = std::max( pool.M_HighWaterMark, pool.M_ActiveCount );
+
+        return entity;
+    }
+
+
+    /// @brief  takes back an Entity which has just been removed from the Scene, so that it can be reused
+    /// @brief  FOR ENGINE USE ONLY - call this only if you're modifying core engine functionality
+    /// @param  entity  the Entity which was removed from the Scene
+    /// @return whether the Entity was pooled - if not, the caller is responsible for deleting it
+    bool EntityPoolSystem::Recycle( Entity* entity )
+    {
+        auto it = m_Pools.find( entity->GetPoolArchetype() );
+        if ( it == m_Pools.end() )
+        {
+            return false;
+        }
+
+        ArchetypePool& pool = it->second;
+        --pool.M_ActiveCount;
+
+        if (
+            m_PoolingEnabled == false ||
+            (int)pool.M_Instances.size() >= m_MaxPoolSize ||
+            entity->ResetTo( *it->first ) == false
+        )
+        {
+            ++pool.M_Discards;
+            return false;
+        }
+
+        pool.M_Instances.push_back( entity );
+        return true;
+    }
+
+
+    /// @brief  deletes all pooled Entities and resets the statistics
+    void EntityPoolSystem::Clear()
+    {
+        for ( auto& [ archetype, pool ] : m_Pools )
+        {
+            for ( Entity* entity : pool.M_Instances )
+            {
+                delete entity;
+            }
+        }
+
+        m_Pools.clear();
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: virtual override methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Gets called whenever a scene is exited
+    void EntityPoolSystem::OnSceneExit()
+    {
+        // archetypes belong to the scene, so their pools can't outlive it
+        Clear();
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: inspection
+//-----------------------------------------------------------------------------
+
+
+    /// @brief Gets Called by the Debug system to display debug information
+    void EntityPoolSystem::DebugWindow()
+    {
+        bool windowOpen = GetDebugEnabled();
+
+        if ( ImGui::Begin( "Entity Pools", &windowOpen ) )
+        {
+            ImGui::Checkbox( "Pooling Enabled", &m_PoolingEnabled );
+            ImGui::DragInt( "Max Pool Size", &m_MaxPoolSize, 1.0f, 0, INT_MAX );
+
+            if ( ImGui::Button( "Clear Pools" ) )
+            {
+                Clear();
+            }
+
+            if ( ImGui::BeginTable( "Pools", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg ) )
+            {
+                ImGui::TableSetupColumn( "Archetype" );
+                ImGui::TableSetupColumn( "Hits" );
+                ImGui::TableSetupColumn( "Misses" );
+                ImGui::TableSetupColumn( "Discards" );
+                ImGui::TableSetupColumn( "Active" );
+                ImGui::TableSetupColumn( "High Water" );
+                ImGui::TableSetupColumn( "Pooled" );
+                ImGui::TableHeadersRow();
+
+                for ( auto const& [ archetype, pool ] : m_Pools )
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted( archetype->GetName().c_str() );
+                    ImGui::TableNextColumn(); ImGui::Text( "%i", pool.M_Hits );
+                    ImGui::TableNextColumn(); ImGui::Text( "%i", pool.M_Misses );
+                    ImGui::TableNextColumn(); ImGui::Text( "%i", pool.M_Discards );
+                    ImGui::TableNextColumn(); ImGui::Text( "%i", pool.M_ActiveCount );
+                    ImGui::TableNextColumn(); ImGui::Text( "%i", pool.M_HighWaterMark );
+                    ImGui::TableNextColumn(); ImGui::Text( "%i", (int)pool.M_Instances.size() );
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+
+        SetDebugEnable( windowOpen );
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: reading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  reads whether removed Entities are pooled
+    /// @param  data    the JSON data to read from
+    void EntityPoolSystem::readPoolingEnabled( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_PoolingEnabled, data );
+    }
+
+    /// @brief  reads the maximum number of instances to keep pooled per archetype
+    /// @param  data    the JSON data to read from
+    void EntityPoolSystem::readMaxPoolSize( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_MaxPoolSize, data );
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: reading / writing
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets this System's read methods
+    /// @return this System's read methods
+    ReadMethodMap< ISerializable > const& EntityPoolSystem::GetReadMethods() const
+    {
+        static ReadMethodMap< EntityPoolSystem > const readMethods = {
+            { "PoolingEnabled", &EntityPoolSystem::readPoolingEnabled },
+            { "MaxPoolSize"   , &EntityPoolSystem::readMaxPoolSize    }
+        };
+
+        return (ReadMethodMap< ISerializable > const&)readMethods;
+    }
+
+
+    /// @brief  writes this EntityPoolSystem to JSON
+    /// @return the JSON data of this EntityPoolSystem
+    nlohmann::ordered_json EntityPoolSystem::Write() const
+    {
+        nlohmann::ordered_json json;
+
+        json[ "PoolingEnabled" ] = m_PoolingEnabled;
+        json[ "MaxPoolSize"    ] = m_MaxPoolSize;
+
+        return json;
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of EntityPoolSystem
+    /// @return the instance of the EntityPoolSystem
+    EntityPoolSystem* EntityPoolSystem::GetInstance()
+    {
+        static std::unique_ptr< EntityPoolSystem > s_Instance = nullptr;
+
+        if (s_Instance == nullptr )
+        {
+            s_Instance.reset(new EntityPoolSystem());
+        }
+        return s_Instance.get();
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Constructs the EntityPoolSystem
+    EntityPoolSystem::EntityPoolSystem() :
+        System( "EntityPoolSystem" )
+    {}
+
+
+//-----------------------------------------------------------------------------
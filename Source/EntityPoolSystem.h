@@ -0,0 +1,164 @@
+/// @file       EntityPoolSystem.h
+/// @author     Oblivion Owls Inc
+/// @brief      System that recycles instances of archetypes instead of cloning and deleting them
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+#include "System.h"
+
+
+class Entity;
+
+
+/// @brief  System that recycles instances of archetypes instead of cloning and deleting them
+/// @note   only childless Entities whose Components all support Component::CanResetTo() are pooled - anything
+///         else is still cloned and deleted as usual
+class EntityPoolSystem : public System
+{
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets a new instance of an archetype, recycling a pooled instance if one is available
+    /// @param  archetype   the archetype to get an instance of
+    /// @return the new instance (nullptr if archetype is nullptr)
+    Entity* Spawn( Entity const* archetype );
+
+
+    /// @brief  takes back an Entity which has just been removed from the Scene, so that it can be reused
+    /// @brief  FOR ENGINE USE ONLY - call this only if you're modifying core engine functionality
+    /// @param  entity  the Entity which was removed from the Scene
+    /// @return whether the Entity was pooled - if not, the caller is responsible for deleting it
+    bool Recycle( Entity* entity );
+
+
+    /// @brief  deletes all pooled Entities and resets the statistics
+    void Clear();
+
+
+//-----------------------------------------------------------------------------
+private: // virtual override methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Gets called whenever a scene is exited
+    virtual void OnSceneExit() override;
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the pool and statistics of a single archetype
+    struct ArchetypePool
+    {
+        /// @brief  the reset instances waiting to be reused
+        std::vector< Entity* > M_Instances = {};
+
+        /// @brief  how many spawns reused a pooled instance
+        int M_Hits = 0;
+
+        /// @brief  how many spawns had to clone the archetype
+        int M_Misses = 0;
+
+        /// @brief  how many removed instances couldn't be pooled and were deleted
+        int M_Discards = 0;
+
+        /// @brief  how many instances are currently spawned and not yet removed
+        int M_ActiveCount = 0;
+
+        /// @brief  the most instances that have been spawned at once
+        int M_HighWaterMark = 0;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the pools of each archetype
+    std::unordered_map< Entity const*, ArchetypePool > m_Pools = {};
+
+    /// @brief  whether removed Entities are pooled
+    bool m_PoolingEnabled = true;
+
+    /// @brief  the maximum number of instances to keep pooled per archetype
+    int m_MaxPoolSize = 256;
+
+
+//-----------------------------------------------------------------------------
+public: // inspection
+//-----------------------------------------------------------------------------
+
+
+    /// @brief Gets Called by the Debug system to display debug information
+    virtual void DebugWindow() override;
+
+
+//-----------------------------------------------------------------------------
+private: // reading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  reads whether removed Entities are pooled
+    /// @param  data    the JSON data to read from
+    void readPoolingEnabled( nlohmann::ordered_json const& data );
+
+    /// @brief  reads the maximum number of instances to keep pooled per archetype
+    /// @param  data    the JSON data to read from
+    void readMaxPoolSize( nlohmann::ordered_json const& data );
+
+
+//-----------------------------------------------------------------------------
+public: // reading / writing
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets this System's read methods
+    /// @return this System's read methods
+    virtual ReadMethodMap< ISerializable > const& GetReadMethods() const override;
+
+
+    /// @brief  writes this EntityPoolSystem to JSON
+    /// @return the JSON data of this EntityPoolSystem
+    virtual nlohmann::ordered_json Write() const override;
+
+
+//-----------------------------------------------------------------------------
+public: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of EntityPoolSystem
+    /// @return the instance of the EntityPoolSystem
+    static EntityPoolSystem* GetInstance();
+
+
+//-----------------------------------------------------------------------------
+private: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Constructs the EntityPoolSystem
+    EntityPoolSystem();
+
+    // Prevent copying
+    EntityPoolSystem( EntityPoolSystem const& ) = delete;
+    void operator =( EntityPoolSystem const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+/// @brief  shorthand function to get the EntityPoolSystem instance
+/// @return the EntityPoolSystem instance
+__inline EntityPoolSystem* EntityPools() { return EntityPoolSystem::GetInstance(); }
@@ -12,8 +12,17 @@
 #include "AssetLibrarySystem.h"
 #include "Entity.h"
 #include "Transform.h"
+#include "EntityPoolSystem.h"
 
 #include "DebugSystem.h"
+
+// for RunComponentLookupBenchmark()
+#include "Sprite.h"
+#include "TilemapSprite.h"
+#include "RigidBody.h"
+#include "CircleCollider.h"
+#include "Health.h"
+#include "AudioPlayer.h"
 //-----------------------------------------------------------------------------
 // public: methods
 //-----------------------------------------------------------------------------
@@ -73,6 +82,124 @@
     }
 
 
+    /// @brief  times Entity::GetComponent() hits, derived-type hits, and misses, against the map lookup and
+    ///         dynamic_cast scan it used to do, and writes the results to the log
+    void EntitySystem::RunComponentLookupBenchmark()
+    {
+        static constexpr int entityCount = 1000;
+        static constexpr int passCount = 1000;
+
+        // Entities shaped like the game's: everything has a Transform, most have a Sprite, and some have physics
+        std::mt19937 random( 0 );
+        std::vector< Entity* > entities( entityCount );
+        std::vector< std::map< std::type_index, Component* > > componentMaps( entityCount );
+        for ( int i = 0; i < entityCount; ++i )
+        {
+            Entity* entity = new Entity();
+            entity->AddComponent( new Transform() );
+            if ( random() % 4 != 0 )
+            {
+                entity->AddComponent( random() % 8 == 0 ? new TilemapSprite() : new Sprite() );
+            }
+            if ( random() % 2 == 0 )
+            {
+                entity->AddComponent( new RigidBody() );
+                entity->AddComponent( new CircleCollider() );
+            }
+            if ( random() % 3 == 0 )
+            {
+                entity->AddComponent( new Health() );
+            }
+
+            for ( auto const& [ type, component ] : entity->getComponents() )
+            {
+                componentMaps[ i ][ type ] = component;
+            }
+            entities[ i ] = entity;
+        }
+
+        // how GetComponent() used to look components up
+        auto mapLookup = []( auto const* tag, std::map< std::type_index, Component* > const& components )
+        {
+            using ComponentType = std::remove_cv_t< std::remove_pointer_t< decltype( tag ) > >;
+
+            auto componentIterator = components.find( typeid( ComponentType ) );
+            if ( componentIterator != components.end() )
+            {
+                return static_cast< ComponentType const* >( componentIterator->second );
+            }
+
+            for ( auto const& [ type, component ] : components )
+            {
+                ComponentType const* found = dynamic_cast< ComponentType const* >( component );
+                if ( found != nullptr )
+                {
+                    return found;
+                }
+            }
+
+            return (ComponentType const*)nullptr;
+        };
+
+        // times looking up one type of component on every Entity, both ways
+        std::stringstream results;
+        auto timeLookups = [ & ]( auto const* tag, char const* description )
+        {
+            using ComponentType = std::remove_cv_t< std::remove_pointer_t< decltype( tag ) > >;
+
+            int foundCount = 0;
+            int mismatchCount = 0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for ( int pass = 0; pass < passCount; ++pass )
+            {
+                for ( Entity const* entity : entities )
+                {
+                    foundCount += entity->GetComponent< ComponentType >() != nullptr;
+                }
+            }
+            double flatMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+            int mapFoundCount = 0;
+            start = std::chrono::high_resolution_clock::now();
+            for ( int pass = 0; pass < passCount; ++pass )
+            {
+                for ( auto const& components : componentMaps )
+                {
+                    mapFoundCount += mapLookup( tag, components ) != nullptr;
+                }
+            }
+            double mapMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+            for ( int i = 0; i < entityCount; ++i )
+            {
+                mismatchCount += entities[ i ]->GetComponent< ComponentType >() != mapLookup( tag, componentMaps[ i ] );
+            }
+
+            double lookupCount = (double)entityCount * passCount;
+            results << "    " << description << " (found on " << foundCount / passCount << " of " << entityCount << "): "
+                << flatMs * 1e6 / lookupCount << " ns per lookup, vs " << mapMs * 1e6 / lookupCount << " ns with a map";
+            if ( mismatchCount != 0 || foundCount != mapFoundCount )
+            {
+                results << " - WARNING: " << mismatchCount << " lookups disagree";
+            }
+            results << "\n";
+        };
+
+        timeLookups( (Transform const*)nullptr, "Transform, exact type" );
+        timeLookups( (Sprite const*)nullptr, "Sprite, exact or derived type" );
+        timeLookups( (Health const*)nullptr, "Health, mostly misses" );
+        timeLookups( (AudioPlayer const*)nullptr, "AudioPlayer, always misses" );
+
+        for ( Entity* entity : entities )
+        {
+            delete entity;
+        }
+
+        Debug() << "GetComponent benchmark (" << entityCount << " Entities, " << passCount << " passes):\n"
+            << results.str() << std::flush;
+    }
+
+
 //-----------------------------------------------------------------------------
 // private: virtual override methods
 //-----------------------------------------------------------------------------
@@ -167,9 +294,13 @@
         };
 
 
-        // get all the entities that need to be removed
-        std::vector< Entity* > entitiesToRemove;
-        std::copy_if( m_Entities.begin(), m_Entities.end(), std::back_inserter( entitiesToRemove ), isDestroyed );
+        // get all the entities that need to be removed (reusing the scratch vector to avoid allocating each frame)
+        m_EntitiesToRemove.clear();
+        std::copy_if( m_Entities.begin(), m_Entities.end(), std::back_inserter( m_EntitiesToRemove ), isDestroyed );
+        if ( m_EntitiesToRemove.empty() )
+        {
+            return;
+        }
 
         // remove the entities from the System
         m_Entities.erase(
@@ -182,21 +313,25 @@
         );
 
         // exit the entities
-        for ( Entity* entity : entitiesToRemove )
+        for ( Entity* entity : m_EntitiesToRemove )
         {
             entity->Exit();
         }
 
-        // delete the entities
-        for ( Entity* entity : entitiesToRemove )
+        // recycle or delete the entities
+        for ( Entity* entity : m_EntitiesToRemove )
         {
             if ( entity == SelectedEntity )
             {
                 SelectedEntity = nullptr;
             }
 
-            delete entity;
+            if ( EntityPools()->Recycle( entity ) == false )
+            {
+                delete entity;
+            }
         }
+        m_EntitiesToRemove.clear();
     }
 
 
@@ -221,15 +356,17 @@
             }
         }
 
-        // move the new Entities into a new vector, in case any component OnInit functions add more Entities to m_EntitiesToAdd
-        std::vector< Entity* > newEntities = std::move( m_EntitiesToAdd );
-        m_EntitiesToAdd.clear();
+        // swap the new Entities into a separate vector, in case any component OnInit functions add more Entities to m_EntitiesToAdd
+        // (swapping rather than moving lets both vectors keep their capacity between frames)
+        m_EntitiesToInit.clear();
+        std::swap( m_EntitiesToInit, m_EntitiesToAdd );
 
         // initialize the entities
-        for ( Entity* entity : newEntities )
+        for ( Entity* entity : m_EntitiesToInit )
         {
             entity->Init();
         }
+        m_EntitiesToInit.clear();
     }
 
 
@@ -614,12 +751,9 @@
             int i = 0;
             for ( nlohmann::ordered_json const& entityData : data )
             {
-                Stream::PushDebugLocation( "[ " + std::to_string( i ) + " ].");
+                Stream::PushDebugLocation( i );
 
-                Entity* entity = new Entity();
-                Stream::Read( entity, entityData );
-                m_Entities.push_back( entity );
-                addLoadedChildren( entity );
+                LoadEntity( entityData );
 
                 Stream::PopDebugLocation();
                 ++i;
@@ -629,12 +763,9 @@
         {
             for ( auto& [ name, entityData ] : data.items() )
             {
-                Stream::PushDebugLocation( name + "." );
+                Stream::PushDebugLocation( name );
 
-                Entity* entity = new Entity();
-                Stream::Read( entity, entityData );
-                m_Entities.push_back( entity );
-                addLoadedChildren( entity );
+                LoadEntity( entityData );
 
                 Stream::PopDebugLocation();
             }
@@ -645,6 +776,23 @@
             return;
         }
 
+        InitLoadedEntities();
+    }
+
+    /// @brief  loads a single top-level entity (and its children) of a scene, without initializing it
+    /// @param  data    the json object containing the entity data
+    /// @note   call InitLoadedEntities once every entity of the scene has been loaded
+    void EntitySystem::LoadEntity( nlohmann::ordered_json const& data )
+    {
+        Entity* entity = new Entity();
+        Stream::Read( entity, data );
+        m_Entities.push_back( entity );
+        addLoadedChildren( entity );
+    }
+
+    /// @brief  initializes all loaded entities once a scene has finished loading
+    void EntitySystem::InitLoadedEntities()
+    {
         for ( Entity* entity : m_Entities )
         {
             entity->Init();
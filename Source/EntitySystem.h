@@ -48,6 +48,11 @@ public: // methods
     void DisplayEntityHierarchy(std::vector<Entity *> EntityList, const std::string WindowName, bool DragAndDrop = true);
 
 
+    /// @brief  times Entity::GetComponent() hits, derived-type hits, and misses, against the map lookup and
+    ///         dynamic_cast scan it used to do, and writes the results to the log
+    void RunComponentLookupBenchmark();
+
+
 ///-----------------------------------------------------------------------------
 public: //Accessors
 ///-----------------------------------------------------------------------------
@@ -81,6 +86,12 @@ private: // member variables
     /// @brief  Enities queued to be added to the EntitySystem
     std::vector< Entity* > m_EntitiesToAdd = {};
 
+    /// @brief  scratch buffer of the Entities currently being initialized
+    std::vector< Entity* > m_EntitiesToInit = {};
+
+    /// @brief  scratch buffer of the Entities currently being removed
+    std::vector< Entity* > m_EntitiesToRemove = {};
+
 
     /// @brief  should the debug window be popped out
     bool m_PopOut = false;
@@ -162,6 +173,14 @@ public: // reading / writing
     /// @param  entityData  the json object containing the entity data
     void LoadEntities( nlohmann::ordered_json const& data );
 
+    /// @brief  loads a single top-level entity (and its children) of a scene, without initializing it
+    /// @param  data    the json object containing the entity data
+    /// @note   call InitLoadedEntities once every entity of the scene has been loaded
+    void LoadEntity( nlohmann::ordered_json const& data );
+
+    /// @brief  initializes all loaded entities once a scene has finished loading
+    void InitLoadedEntities();
+
 
     /// @brief  saves all of the entities in a scene
     /// @return the written json data
@@ -65,7 +65,7 @@ void EventEmitter::OnExit()
 void EventEmitter::EmitEvent(std::string EventName) const
 {
     Events()->BroadcastEvent< std::string >(EventName);
-    Debug() << "Event Emitted: " << EventName << std::endl;
+    LOG_VERBOSE << "Event Emitted: " << EventName << std::endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -47,6 +47,7 @@
     void Generator::OnInit()
     {
         Behaviors< Generator >()->AddComponent(this);
+        Behaviors< Generator >()->SetSpatialRadius(this, m_PowerRadius);
 
         m_Collider.SetOnConnectCallback( [ this ]()
         {
@@ -424,7 +425,10 @@
     /// @brief  inspector for generators
     void Generator::Inspector()
     {
-        ImGui::DragFloat( "Radius"      , &m_PowerRadius, 0.05f, 0.0f, INFINITY );
+        if ( ImGui::DragFloat( "Radius"      , &m_PowerRadius, 0.05f, 0.0f, INFINITY ) )
+        {
+            Behaviors< Generator >()->SetSpatialRadius( this, m_PowerRadius );
+        }
         ImGui::DragFloat( "Growth Speed", &m_RadiusSpeed, 0.05f, 0.0f, INFINITY );
         ImGui::DragFloat( "Reward Timer", &m_RewardTimer, 0.05f, 0.0f, INFINITY );
         ImGui::Separator();
@@ -86,7 +86,7 @@
                 if ( m_Health->GetHealth()->GetCurrent() <= 0 )
                 {
                     Events()->BroadcastEvent< std::string >(m_EventNameCutsceneLose);
-                    Debug() << "Event Emitted: " << m_EventNameCutsceneLose << std::endl;
+                    LOG_VERBOSE << "Event Emitted: " << m_EventNameCutsceneLose << std::endl;
                     m_AudioPlayer->SetSound(m_DeactivateSound);
                     m_AudioPlayer->Play();
                     //Destroy();
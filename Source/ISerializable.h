@@ -12,8 +12,127 @@
 template < typename T >
 using ReadMethod = void (T::*)( nlohmann::ordered_json const& json );
 
+/// @brief  table of the methods used to read each key of an object's json
+/// @tparam T   the type of object the methods read into
+/// @note   entries are sorted by the hash of their names, so a lookup is a binary search over hashes
+///         and a single string compare instead of a string compare at every node of a tree
+/// @note   the layout doesn't depend on T, since tables get cast to ReadMethodMap< ISerializable >
 template < typename T >
-using ReadMethodMap = std::map< std::string, ReadMethod< T > >;
+class ReadMethodMap
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a key and the method used to read it
+    struct Entry
+    {
+        /// @brief  the json key this entry reads
+        std::string M_Name;
+
+        /// @brief  the method used to read the key
+        ReadMethod< T > M_Method;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // constructors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructs an empty ReadMethodMap
+    ReadMethodMap() = default;
+
+    /// @brief  constructs a ReadMethodMap from a list of keys and the methods that read them
+    /// @param  entries the keys and methods to put in the table
+    ReadMethodMap( std::initializer_list< std::pair< std::string, ReadMethod< T > > > entries )
+    {
+        m_Entries.reserve( entries.size() );
+        for ( auto const& [ name, method ] : entries )
+        {
+            m_Entries.push_back( { name, method } );
+        }
+
+        std::sort( m_Entries.begin(), m_Entries.end(), []( Entry const& a, Entry const& b ) -> bool
+        {
+            uint64_t hashA = Hash( a.M_Name ), hashB = Hash( b.M_Name );
+            return hashA != hashB ? hashA < hashB : a.M_Name < b.M_Name;
+        } );
+
+        m_Hashes.reserve( m_Entries.size() );
+        for ( Entry const& entry : m_Entries )
+        {
+            m_Hashes.push_back( Hash( entry.M_Name ) );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  finds the entry for a key
+    /// @param  name    the key to find
+    /// @return the entry for the key, or end() if there isn't one
+    Entry const* find( std::string_view name ) const
+    {
+        uint64_t hash = Hash( name );
+        auto it = std::lower_bound( m_Hashes.begin(), m_Hashes.end(), hash );
+        for ( ; it != m_Hashes.end() && *it == hash; ++it )
+        {
+            Entry const& entry = m_Entries[ it - m_Hashes.begin() ];
+            if ( entry.M_Name == name )
+            {
+                return &entry;
+            }
+        }
+
+        return end();
+    }
+
+    /// @brief  gets the first entry, in hash order
+    /// @return the first entry
+    Entry const* begin() const { return m_Entries.data(); }
+
+    /// @brief  gets the end of the entries
+    /// @return one past the last entry
+    Entry const* end() const { return m_Entries.data() + m_Entries.size(); }
+
+    /// @brief  gets how many entries the table has
+    /// @return how many entries the table has
+    size_t size() const { return m_Entries.size(); }
+
+
+    /// @brief  hashes a key (FNV-1a)
+    /// @param  name    the key to hash
+    /// @return the hash of the key
+    static constexpr uint64_t Hash( std::string_view name )
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for ( char c : name )
+        {
+            hash = ( hash ^ (uint8_t)c ) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the hash of each entry's name, kept apart so the search only touches these
+    std::vector< uint64_t > m_Hashes;
+
+    /// @brief  the entries, in the same order as their hashes
+    std::vector< Entry > m_Entries;
+
+
+//-----------------------------------------------------------------------------
+};
 
 /// @brief  interface for all serializable objects
 class ISerializable
@@ -42,7 +42,7 @@
         if (m_EventCast != "")
         {
             Events()->BroadcastEvent< std::string >(m_EventCast);
-            Debug() << "Event Emitted: " << m_EventCast << std::endl;
+            LOG_VERBOSE << "Event Emitted: " << m_EventCast << std::endl;
         }
         for ( auto& [ ownerId, callback ] : m_OnInteractCallbacks )
         {
@@ -112,6 +112,7 @@
     void Interactable::SetInteractionRadius( float radius )
     {
         m_InteractionRadius = radius;
+        Components< Interactable >()->SetSpatialRadius( this, m_InteractionRadius );
     }
 
 
@@ -146,6 +147,7 @@
     void Interactable::OnInit()
     {
         Components< Interactable >()->AddComponent( this );
+        Components< Interactable >()->SetSpatialRadius( this, m_InteractionRadius );
 
         m_Transform.SetOnConnectCallback( [ this ]()
         {
@@ -243,7 +245,10 @@
     {
         ImGui::Checkbox( "Enabled", &m_Enabled );
 
-        ImGui::DragFloat( "Interaction Radius", &m_InteractionRadius, 0.05f, 0.0f, INFINITY );
+        if ( ImGui::DragFloat( "Interaction Radius", &m_InteractionRadius, 0.05f, 0.0f, INFINITY ) )
+        {
+            Components< Interactable >()->SetSpatialRadius( this, m_InteractionRadius );
+        }
 
         m_InteractAction.Inspect( "Interact Control Action" );
 
@@ -141,9 +141,13 @@
         }
         glm::vec2 const& pos = m_Transform->GetTranslation();
 
+        // Interactables are indexed with their interaction radius, so this finds every Interactable in range
+        std::vector< Interactable* > interactables;
+        Components< Interactable >()->QueryRadius( pos, 0.0f, interactables );
+
         Interactable* nearest = nullptr;
         float nearestSqrDist = INFINITY;
-        for ( Interactable* interactable : Components< Interactable >()->GetComponents() )
+        for ( Interactable* interactable : interactables )
         {
             if ( interactable->GetEnabled() == false || interactable->GetTransform() == nullptr )
             {
@@ -71,10 +71,19 @@
     /// @brief  gets called once per simulation frame
     void ItemCollector::OnFixedUpdate()
     {
-        for ( ItemComponent* item : Components< ItemComponent >()->GetComponents() )
+        glm::vec2 collectorPos = m_Transform->GetTranslation();
+
+        // only look at the items that are close enough to be collected or attracted
+        std::vector< ItemComponent* > items;
+        Components< ItemComponent >()->QueryRadius(
+            collectorPos,
+            std::max( m_CollectionRadius, m_AttractionRadius ),
+            items
+        );
+
+        for ( ItemComponent* item : items )
         {
             glm::vec2 itemPos = item->GetTransform()->GetTranslation();
-            glm::vec2 collectorPos = m_Transform->GetTranslation();
             glm::vec2 offset = collectorPos - itemPos;
             float distanceSquared = glm::dot( offset, offset );
 
@@ -205,6 +205,15 @@
         return new ItemComponent( *this );
     }
 
+    /// @brief  resets this ItemComponent to a copy of another ItemComponent so that its Entity can be pooled
+    /// @param  other   the ItemComponent to copy
+    void ItemComponent::ResetTo( Component const& other )
+    {
+        Component::ResetTo( other );
+
+        m_ItemStack = static_cast< ItemComponent const& >( other ).m_ItemStack;
+    }
+
 
 //-----------------------------------------------------------------------------
 // private: copying
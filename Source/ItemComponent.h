@@ -159,6 +159,15 @@ public: // copying
     /// @return the newly created clone of this ItemComponent
     virtual ItemComponent* Clone() const override;
 
+    /// @brief  checks whether this ItemComponent can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a ItemComponent
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< ItemComponent >( other ); }
+
+    /// @brief  resets this ItemComponent to a copy of another ItemComponent so that its Entity can be pooled
+    /// @param  other   the ItemComponent to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
@@ -0,0 +1,187 @@
+/// @file       JobSystem.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      small pool of worker threads that runs loading work in the background
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "JobSystem.h"
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  queues a job to run on a worker thread
+    /// @param  job the work to do
+    /// @return the ID of the job
+    JobSystem::JobId JobSystem::Push( std::function< void() > job )
+    {
+        JobId id;
+        {
+            std::lock_guard< std::mutex > lock( m_Mutex );
+
+            id = m_NextId++;
+            m_Queue.push_back( { id, std::move( job ) } );
+            m_Unfinished.insert( id );
+        }
+
+        m_JobPushed.notify_one();
+        return id;
+    }
+
+    /// @brief  moves a job to the front of the queue, if no worker has started it yet
+    /// @param  id  the ID of the job
+    void JobSystem::Prioritize( JobId id )
+    {
+        std::lock_guard< std::mutex > lock( m_Mutex );
+
+        auto it = std::find_if( m_Queue.begin(), m_Queue.end(), [ id ]( Job const& job ) -> bool
+        {
+            return job.M_Id == id;
+        } );
+        if ( it == m_Queue.end() || it == m_Queue.begin() )
+        {
+            return;
+        }
+
+        Job job = std::move( *it );
+        m_Queue.erase( it );
+        m_Queue.push_front( std::move( job ) );
+    }
+
+    /// @brief  blocks until a job has finished - if no worker has started it yet, runs it on this thread
+    /// @param  id  the ID of the job
+    void JobSystem::Wait( JobId id )
+    {
+        std::unique_lock< std::mutex > lock( m_Mutex );
+
+        auto it = std::find_if( m_Queue.begin(), m_Queue.end(), [ id ]( Job const& job ) -> bool
+        {
+            return job.M_Id == id;
+        } );
+        if ( it != m_Queue.end() )
+        {
+            std::function< void() > function = std::move( it->M_Function );
+            m_Queue.erase( it );
+            lock.unlock();
+
+            function();
+            finish( id );
+            return;
+        }
+
+        m_JobFinished.wait( lock, [ this, id ]() -> bool
+        {
+            return m_Unfinished.contains( id ) == false;
+        } );
+    }
+
+    /// @brief  checks whether a job has finished
+    /// @param  id  the ID of the job
+    /// @return whether the job has finished
+    bool JobSystem::IsDone( JobId id ) const
+    {
+        std::lock_guard< std::mutex > lock( m_Mutex );
+
+        return m_Unfinished.contains( id ) == false;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  runs a worker thread
+    void JobSystem::runWorker()
+    {
+        std::unique_lock< std::mutex > lock( m_Mutex );
+        while ( true )
+        {
+            m_JobPushed.wait( lock, [ this ]() -> bool
+            {
+                return m_Running == false || m_Queue.empty() == false;
+            } );
+            if ( m_Running == false )
+            {
+                return;
+            }
+
+            Job job = std::move( m_Queue.front() );
+            m_Queue.pop_front();
+            lock.unlock();
+
+            job.M_Function();
+            finish( job.M_Id );
+
+            lock.lock();
+        }
+    }
+
+    /// @brief  marks a job as finished and wakes anything waiting on it
+    /// @param  id  the ID of the job
+    void JobSystem::finish( JobId id )
+    {
+        {
+            std::lock_guard< std::mutex > lock( m_Mutex );
+            m_Unfinished.erase( id );
+        }
+
+        m_JobFinished.notify_all();
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of the JobSystem
+    /// @return the instance of the JobSystem
+    JobSystem* JobSystem::GetInstance()
+    {
+        static std::unique_ptr< JobSystem > s_Instance( new JobSystem() );
+        return s_Instance.get();
+    }
+
+    /// @brief  stops the workers once they finish their current jobs - jobs that haven't started are dropped
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard< std::mutex > lock( m_Mutex );
+            m_Running = false;
+        }
+        m_JobPushed.notify_all();
+
+        for ( std::thread& worker : m_Workers )
+        {
+            worker.join();
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts the worker threads
+    JobSystem::JobSystem()
+    {
+        // leave a core for the main thread
+        int workerCount = std::clamp( (int)std::thread::hardware_concurrency() - 1, 1, s_MaxWorkerCount );
+
+        m_Workers.reserve( workerCount );
+        for ( int i = 0; i < workerCount; ++i )
+        {
+            m_Workers.emplace_back( &JobSystem::runWorker, this );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
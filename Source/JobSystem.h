@@ -0,0 +1,169 @@
+/// @file       JobSystem.h
+/// @author     Oblivion Owls Inc
+/// @brief      small pool of worker threads that runs loading work in the background
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+
+
+/// @brief  small pool of worker threads that runs loading work (parsing scenes, decoding images) in the background
+/// @note   also used to split big batches (CPU particles, ray casts) across threads - the caller takes the first
+///         chunk itself and then waits on the rest
+/// @note   jobs start in the order they were pushed, unless one is moved to the front with Prioritize.
+///         Waiting on a job that no worker has started yet runs it on the waiting thread instead of blocking.
+/// @note   jobs must not touch the GPU or anything else that is only safe on the main thread
+class JobSystem
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  identifies a pushed job - never reused, so 0 can stand for "no job"
+    using JobId = uint64_t;
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  queues a job to run on a worker thread
+    /// @param  job the work to do
+    /// @return the ID of the job
+    JobId Push( std::function< void() > job );
+
+    /// @brief  moves a job to the front of the queue, if no worker has started it yet
+    /// @param  id  the ID of the job
+    void Prioritize( JobId id );
+
+    /// @brief  blocks until a job has finished - if no worker has started it yet, runs it on this thread
+    /// @param  id  the ID of the job
+    void Wait( JobId id );
+
+    /// @brief  checks whether a job has finished
+    /// @param  id  the ID of the job
+    /// @return whether the job has finished
+    bool IsDone( JobId id ) const;
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets how many worker threads the pool has
+    /// @return how many worker threads the pool has
+    int GetWorkerCount() const { return (int)m_Workers.size(); }
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a job that no worker has started yet
+    struct Job
+    {
+        /// @brief  the ID of the job
+        JobId M_Id;
+
+        /// @brief  the work to do
+        std::function< void() > M_Function;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the most workers the pool will start - loading is mostly bound by memory and disk past this
+    static constexpr int s_MaxWorkerCount = 4;
+
+
+    /// @brief  jobs that no worker has started yet, in the order they will start
+    std::deque< Job > m_Queue;
+
+    /// @brief  the IDs of jobs that are queued or running
+    std::unordered_set< JobId > m_Unfinished;
+
+    /// @brief  the ID the next pushed job will get
+    JobId m_NextId = 1;
+
+    /// @brief  whether the workers should keep running
+    bool m_Running = true;
+
+
+    /// @brief  guards everything above
+    mutable std::mutex m_Mutex;
+
+    /// @brief  signaled when a job is pushed, or when the workers should stop
+    std::condition_variable m_JobPushed;
+
+    /// @brief  signaled when a job finishes
+    std::condition_variable m_JobFinished;
+
+
+    /// @brief  the worker threads
+    std::vector< std::thread > m_Workers;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  runs a worker thread
+    void runWorker();
+
+    /// @brief  marks a job as finished and wakes anything waiting on it
+    /// @param  id  the ID of the job
+    void finish( JobId id );
+
+
+//-----------------------------------------------------------------------------
+public: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of the JobSystem
+    /// @return the instance of the JobSystem
+    static JobSystem* GetInstance();
+
+    /// @brief  stops the workers once they finish their current jobs - jobs that haven't started are dropped
+    ~JobSystem();
+
+
+//-----------------------------------------------------------------------------
+private: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts the worker threads
+    JobSystem();
+
+    // Prevent copying
+    JobSystem( JobSystem const& ) = delete;
+    void operator =( JobSystem const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+/// @brief  shorthand for getting the JobSystem
+/// @return the instance of the JobSystem
+__inline JobSystem* Jobs()
+{
+    return JobSystem::GetInstance();
+}
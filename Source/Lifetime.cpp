@@ -146,6 +146,15 @@
         return new Lifetime( *this );
     }
 
+    /// @brief  resets this Lifetime to a copy of another Lifetime so that its Entity can be pooled
+    /// @param  other   the Lifetime to copy
+    void Lifetime::ResetTo( Component const& other )
+    {
+        Behavior::ResetTo( other );
+
+        m_Lifetime = static_cast< Lifetime const& >( other ).m_Lifetime;
+    }
+
 
 //-----------------------------------------------------------------------------
 // private: copying
@@ -111,6 +111,15 @@ public: // copying
     /// @return the newly created clone of this Lifetime
     virtual Lifetime* Clone() const override;
 
+    /// @brief  checks whether this Lifetime can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a Lifetime
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< Lifetime >( other ); }
+
+    /// @brief  resets this Lifetime to a copy of another Lifetime so that its Entity can be pooled
+    /// @param  other   the Lifetime to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
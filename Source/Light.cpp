@@ -6,6 +6,7 @@
 
 #include "pch.h" // precompiled header has to be included first
 #include "LightingSystem.h" // + Light.h
+#include "ComponentReference.t.h"
 
 
 
@@ -13,6 +14,24 @@
 Light::Light() : Component(typeid(Light)) {}
 
 
+/// @brief   Copy constructor
+/// @param other  Light to copy
+Light::Light(Light const& other) : Component(other),
+    m_Offset(other.m_Offset),
+    m_Radius(other.m_Radius),
+    m_Strength(other.m_Strength)
+{}
+
+
+/// @return  World position: parent's translation (if it has a Transform) plus offset
+glm::vec2 Light::GetPosition() const
+{
+    if (m_Transform)
+        return m_Transform->GetTranslation() + m_Offset;
+    return m_Offset;
+}
+
+
 /// @brief   Clones this component
 Component* Light::Clone() const { return new Light(*this); }
 
@@ -22,17 +41,40 @@ Component* Light::Clone() const { return new Light(*this); }
 //-----------------------------------------------------------------------------
 
 /// @brief  Initialization: light adds itself to the lighting system
-void Light::OnInit() { Lights()->AddComponent(this); }
+void Light::OnInit()
+{
+    // the lighting system only re-reads lights that have moved
+    m_Transform.SetOnConnectCallback( [ this ]()
+    {
+        m_IsDirty = true;
+        m_Transform->AddOnTransformChangedCallback( GetId(), [ this ]() { m_IsDirty = true; } );
+    } );
+    m_Transform.SetOnDisconnectCallback( [ this ]()
+    {
+        m_IsDirty = true;
+        m_Transform->RemoveOnTransformChangedCallback( GetId() );
+    } );
+
+    m_Transform.Init(GetEntity());
+    Lights()->AddComponent(this);
+}
 
 /// @brief  Exit: light removes itself from lighting system
-void Light::OnExit() { Lights()->RemoveComponent(this); }
+void Light::OnExit()
+{
+    Lights()->RemoveComponent(this);
+    m_Transform.Exit();
+}
 
 /// @brief  Tweak properties in debug window
 void Light::Inspector()
 {
-    ImGui::DragFloat("Radius", &m_Radius, 0.01f, 0.0f, 20.0f);
-    ImGui::DragFloat("Strength", &m_Strength, 0.005f, 0.0f, 10.0f);
-    ImGui::DragFloat2("Offset", &m_Offset.x, 0.01f);
+    if (ImGui::DragFloat("Radius", &m_Radius, 0.01f, 0.0f, 20.0f))
+        m_IsDirty = true;
+    if (ImGui::DragFloat("Strength", &m_Strength, 0.005f, 0.0f, 10.0f))
+        m_IsDirty = true;
+    if (ImGui::DragFloat2("Offset", &m_Offset.x, 0.01f))
+        m_IsDirty = true;
 }
 
 
@@ -5,6 +5,8 @@
 /// @copyright  Copyright (c) 2024 Digipen Institute of Technology
 #pragma once
 #include "Component.h"
+#include "ComponentReference.h"
+#include "Transform.h"
 
 
 /// @brief       Light source.
@@ -14,6 +16,10 @@ public:
     /// @brief   Default constructor
     Light();
 
+    /// @brief   Copy constructor
+    /// @param other  Light to copy
+    Light(Light const& other);
+
     // Inherited via Component
     virtual Component * Clone() const override;
 
@@ -25,13 +31,13 @@ public:
 public:
 
     /// @brief  Sets the light radius
-    __inline void SetRadius(float r) { m_Radius = r; }
+    __inline void SetRadius(float r) { m_Radius = r; m_IsDirty = true; }
 
     /// @brief  Sets the strength/brightness of the light 
-    __inline void SetStrength(float s) { m_Strength = s; }
+    __inline void SetStrength(float s) { m_Strength = s; m_IsDirty = true; }
 
     /// @brief  Sets the position offset from parent entity
-    __inline void SetOffset(glm::vec2 offset) { m_Offset = offset; }
+    __inline void SetOffset(glm::vec2 offset) { m_Offset = offset; m_IsDirty = true; }
 
     /// @return  Light radius
     __inline float GetRadius() const { return m_Radius; }
@@ -42,6 +48,15 @@ public:
     /// @return  Position offset from parent entity
     __inline glm::vec2 GetOffset() const { return m_Offset; }
 
+    /// @return  World position: parent's translation (if it has a Transform) plus offset
+    glm::vec2 GetPosition() const;
+
+    /// @return  Whether the light moved or changed since the lighting system last read it
+    __inline bool GetIsDirty() const { return m_IsDirty; }
+
+    /// @brief   Called by the lighting system once it has read this light's changes
+    __inline void ClearDirty() { m_IsDirty = false; }
+
 
 
 //-----------------------------------------------------------------------------
@@ -74,6 +89,12 @@ private:
     // @brief   Stength (brightness) of the light
     float m_Strength = 0.8f;
 
+    /// @brief  Parent's transform, cached instead of looked up every frame
+    ComponentReference< Transform, false > m_Transform;
+
+    /// @brief  Whether the light moved or changed since the lighting system last read it
+    bool m_IsDirty = true;
+
 
 //-----------------------------------------------------------------------------
 //              Reading / Writing
@@ -0,0 +1,295 @@
+/// @file       LightBinner.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      splits the screen into tiles and lists which lights reach each tile
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "LightBinner.h"
+
+#include "DebugSystem.h"
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  bins lights into the tiles of the screen
+    /// @param  screenSize  the size of the screen, in pixels
+    /// @param  spots       the lights to bin - lights are referred to by their index in this list
+    void LightBinner::Bin( glm::ivec2 const& screenSize, std::vector< Spot > const& spots )
+    {
+        glm::ivec2 screen = glm::max( screenSize, glm::ivec2( 1 ) );
+        glm::vec2 screenMax = glm::vec2( screen );
+        m_TileCounts = ( screen + s_TileSize - 1 ) / s_TileSize;
+
+        // cull the lights too dim to show anywhere, then the ones whose range doesn't reach the screen
+        m_Ranges.resize( spots.size() );
+        std::vector< unsigned > bright;
+        bright.reserve( spots.size() );
+        for ( unsigned i = 0; i < (unsigned)spots.size(); ++i )
+        {
+            m_Ranges[ i ] = GetRange( spots[ i ] );
+            if ( m_Ranges[ i ] > 0.0f )
+            {
+                bright.push_back( i );
+            }
+        }
+        std::vector< unsigned > visible;
+        gatherLights( spots, bright.data(), bright.size(), glm::vec2( 0.0f ), screenMax, &visible );
+
+        // cull per block, then per tile within the block
+        m_Tiles.assign( m_TileCounts.x * m_TileCounts.y, glm::uvec2( 0 ) );
+        m_LightIndices.clear();
+        glm::ivec2 blockCounts = ( m_TileCounts + s_BlockSize - 1 ) / s_BlockSize;
+        for ( int blockY = 0; blockY < blockCounts.y; ++blockY )
+        {
+            for ( int blockX = 0; blockX < blockCounts.x; ++blockX )
+            {
+                glm::ivec2 firstTile = glm::ivec2( blockX, blockY ) * s_BlockSize;
+                glm::ivec2 lastTile = glm::min( firstTile + s_BlockSize, m_TileCounts ) - 1;
+                glm::vec2 blockMin = glm::vec2( firstTile * s_TileSize );
+                glm::vec2 blockMax = glm::min( glm::vec2( ( lastTile + 1 ) * s_TileSize ), screenMax );
+
+                m_BlockLights.clear();
+                gatherLights( spots, visible.data(), visible.size(), blockMin, blockMax, &m_BlockLights );
+                m_BlockLights.resize( cullLights( spots, m_BlockLights.data(), (unsigned)m_BlockLights.size(), blockMin, blockMax ) );
+                if ( m_BlockLights.empty() )
+                {
+                    continue;
+                }
+
+                for ( int y = firstTile.y; y <= lastTile.y; ++y )
+                {
+                    for ( int x = firstTile.x; x <= lastTile.x; ++x )
+                    {
+                        glm::vec2 tileMin = glm::vec2( x, y ) * (float)s_TileSize;
+                        glm::vec2 tileMax = glm::min( tileMin + (float)s_TileSize, screenMax );
+
+                        unsigned offset = (unsigned)m_LightIndices.size();
+                        gatherLights( spots, m_BlockLights.data(), m_BlockLights.size(), tileMin, tileMax, &m_LightIndices );
+                        unsigned count = cullLights( spots, m_LightIndices.data() + offset, (unsigned)m_LightIndices.size() - offset, tileMin, tileMax );
+                        m_LightIndices.resize( offset + count );
+
+                        m_Tiles[ y * m_TileCounts.x + x ] = { offset, count };
+                    }
+                }
+            }
+        }
+
+        std::vector< bool > isBinned( spots.size(), false );
+        for ( unsigned light : m_LightIndices )
+        {
+            isBinned[ light ] = true;
+        }
+        m_CulledCount = (int)std::count( isBinned.begin(), isBinned.end(), false );
+    }
+
+
+    /// @brief  gets how brightly a light lights a pixel, the way spotlight.frag does
+    /// @param  spot            the light
+    /// @param  distanceSquared the squared distance from the light to the pixel
+    /// @return the brightness, 0 to 1
+    float LightBinner::GetBrightness( Spot const& spot, float distanceSquared )
+    {
+        float radiusSquared = spot.M_Radius * spot.M_Radius;
+        if ( radiusSquared + distanceSquared <= 0.0f )
+        {
+            return 0.0f;
+        }
+
+        return std::clamp( spot.M_Strength * radiusSquared / ( radiusSquared + distanceSquared ), 0.0f, 1.0f );
+    }
+
+    /// @brief  gets how far a light reaches before it is too dim to show on an 8-bit target
+    /// @param  spot    the light
+    /// @return the distance past which the light no longer shows - 0 if it never shows
+    /// @note   spotlight.frag lights a pixel by strength * r^2 / ( r^2 + d^2 ), which never quite reaches 0
+    float LightBinner::GetRange( Spot const& spot )
+    {
+        // solve strength * r^2 / ( r^2 + d^2 ) = visible for d
+        float ratio = spot.M_Strength / s_VisibleBrightness - 1.0f;
+        if ( ratio <= 0.0f )
+        {
+            return 0.0f;
+        }
+
+        return std::abs( spot.M_Radius ) * std::sqrt( ratio );
+    }
+
+
+    /// @brief  logs how long binning 500 lights takes, and how many fewer lights the shader loops over
+    void LightBinner::RunBenchmark()
+    {
+        using Clock = std::chrono::high_resolution_clock;
+        static constexpr int lightCount = 500;
+        static constexpr int binCount = 100;
+        static constexpr float pixelsPerUnit = 60.0f;
+        static constexpr int sampleStride = 7;
+        glm::ivec2 const screenSize = { 1920, 1080 };
+
+        // lights scattered over an area larger than the screen, so some are off screen
+        std::mt19937 random( 0 );
+        std::uniform_real_distribution< float > xDistribution( -0.25f * screenSize.x, 1.25f * screenSize.x );
+        std::uniform_real_distribution< float > yDistribution( -0.25f * screenSize.y, 1.25f * screenSize.y );
+        std::uniform_real_distribution< float > radiusDistribution( 0.5f * pixelsPerUnit, 3.0f * pixelsPerUnit );
+        std::uniform_real_distribution< float > strengthDistribution( 0.3f, 1.0f );
+
+        std::vector< Spot > spots;
+        spots.reserve( lightCount );
+        for ( int i = 0; i < lightCount; ++i )
+        {
+            spots.push_back( {
+                { xDistribution( random ), yDistribution( random ) },
+                radiusDistribution( random ),
+                strengthDistribution( random )
+            } );
+        }
+
+        LightBinner binner;
+        Clock::time_point start = Clock::now();
+        for ( int i = 0; i < binCount; ++i )
+        {
+            binner.Bin( screenSize, spots );
+        }
+        double binMs = std::chrono::duration< double, std::milli >( Clock::now() - start ).count() / binCount;
+
+        // how many light loop iterations spotlight.frag runs, with and without binning
+        long long binnedIterations = 0;
+        long long listedCount = 0;
+        glm::ivec2 const& tileCounts = binner.GetTileCounts();
+        for ( int y = 0; y < tileCounts.y; ++y )
+        {
+            for ( int x = 0; x < tileCounts.x; ++x )
+            {
+                glm::ivec2 tileMin = glm::ivec2( x, y ) * s_TileSize;
+                glm::ivec2 tileSize = glm::min( tileMin + s_TileSize, screenSize ) - tileMin;
+                unsigned count = binner.GetTiles()[ y * tileCounts.x + x ].y;
+                binnedIterations += (long long)tileSize.x * tileSize.y * count;
+                listedCount += count;
+            }
+        }
+        long long unbinnedIterations = (long long)screenSize.x * screenSize.y * lightCount;
+
+        // shade a grid of pixels both ways, like spotlight.frag does
+        float largestDifference = 0.0f;
+        for ( int y = 0; y < screenSize.y; y += sampleStride )
+        {
+            for ( int x = 0; x < screenSize.x; x += sampleStride )
+            {
+                glm::vec2 pixel = glm::vec2( x, y ) + 0.5f;
+                auto shade = [ & ]( float alpha, Spot const& spot ) -> float
+                {
+                    glm::vec2 offset = pixel - spot.M_Center;
+                    return std::min( alpha, 1.0f - GetBrightness( spot, glm::dot( offset, offset ) ) );
+                };
+
+                float unbinned = 1.0f;
+                for ( Spot const& spot : spots )
+                {
+                    unbinned = shade( unbinned, spot );
+                }
+
+                float binned = 1.0f;
+                glm::uvec2 tile = binner.GetTiles()[ ( y / s_TileSize ) * tileCounts.x + x / s_TileSize ];
+                for ( unsigned i = tile.x; i < tile.x + tile.y; ++i )
+                {
+                    binned = shade( binned, spots[ binner.GetLightIndices()[ i ] ] );
+                }
+
+                largestDifference = std::max( largestDifference, std::abs( binned - unbinned ) );
+            }
+        }
+
+        Debug() << "Light binning benchmark (" << lightCount << " lights, " << screenSize.x << "x" << screenSize.y
+            << ", " << s_TileSize << "px tiles):\n"
+            << "    binning: " << binMs << " ms\n"
+            << "    lights culled: " << binner.GetCulledCount() << "\n"
+            << "    lights per tile: " << (double)listedCount / ( tileCounts.x * tileCounts.y ) << " (was " << lightCount << ")\n"
+            << "    shader light iterations: " << binnedIterations << " (was " << unbinnedIterations << ", "
+            << (double)unbinnedIterations / std::max( binnedIterations, 1LL ) << "x fewer)\n"
+            << "    largest shading difference: " << largestDifference << " (1/255 = " << s_VisibleBrightness << ")"
+            << std::endl;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  appends the lights whose range reaches an area
+    /// @param  spots       the lights being binned
+    /// @param  candidates  the lights to check
+    /// @param  count       how many lights to check
+    /// @param  min         the minimum corner of the area, in pixels
+    /// @param  max         the maximum corner of the area, in pixels
+    /// @param  lights      the list to append the lights that reach the area to
+    void LightBinner::gatherLights(
+        std::vector< Spot > const& spots, unsigned const* candidates, size_t count,
+        glm::vec2 const& min, glm::vec2 const& max, std::vector< unsigned >* lights
+    ) const
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            Spot const& spot = spots[ candidates[ i ] ];
+            float range = m_Ranges[ candidates[ i ] ];
+
+            glm::vec2 offset = glm::clamp( spot.M_Center, min, max ) - spot.M_Center;
+            if ( glm::dot( offset, offset ) <= range * range )
+            {
+                lights->push_back( candidates[ i ] );
+            }
+        }
+    }
+
+    /// @brief  drops the lights that can't change any pixel of an area, keeping the rest in order
+    /// @param  spots   the lights being binned
+    /// @param  lights  the lights that reach the area
+    /// @param  count   how many lights reach the area
+    /// @param  min     the minimum corner of the area, in pixels
+    /// @param  max     the maximum corner of the area, in pixels
+    /// @return how many lights were kept, at the front of lights
+    unsigned LightBinner::cullLights( std::vector< Spot > const& spots, unsigned* lights, unsigned count, glm::vec2 const& min, glm::vec2 const& max )
+    {
+        // find how bright each light gets within the area, and which light is brightest even at its dimmest
+        m_Brightness.resize( count );
+        float dominantBrightness = 0.0f;
+        unsigned dominant = count;
+        for ( unsigned i = 0; i < count; ++i )
+        {
+            Spot const& spot = spots[ lights[ i ] ];
+            glm::vec2 nearest = glm::clamp( spot.M_Center, min, max ) - spot.M_Center;
+            glm::vec2 farthest = glm::max( glm::abs( spot.M_Center - min ), glm::abs( spot.M_Center - max ) );
+
+            glm::vec2& brightness = m_Brightness[ i ];
+            brightness.x = GetBrightness( spot, glm::dot( nearest, nearest ) );
+            brightness.y = GetBrightness( spot, glm::dot( farthest, farthest ) );
+            if ( brightness.y > dominantBrightness )
+            {
+                dominantBrightness = brightness.y;
+                dominant = i;
+            }
+        }
+
+        // the shader keeps the brightest light at each pixel, so a light never brighter than the dominant light's
+        // dimmest can't win anywhere in the area
+        unsigned keptCount = 0;
+        for ( unsigned i = 0; i < count; ++i )
+        {
+            glm::vec2 const& brightness = m_Brightness[ i ];
+            if ( brightness.x >= s_VisibleBrightness && ( i == dominant || brightness.x > dominantBrightness ) )
+            {
+                lights[ keptCount++ ] = lights[ i ];
+            }
+        }
+
+        return keptCount;
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,161 @@
+/// @file       LightBinner.h
+/// @author     Oblivion Owls Inc
+/// @brief      splits the screen into tiles and lists which lights reach each tile
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+
+/// @brief  splits the screen into tiles and lists which lights reach each tile, so spotlight.frag only loops over those
+/// @note   spotlight.frag keeps only the brightest light at each pixel. Within a tile, a light is dropped when another
+///         light is at least as bright everywhere in the tile, or when it is too dim to show. This doesn't change the
+///         image (beyond 1/255 from dropping too-dim lights).
+/// @note   lights that reach no tile (entirely off screen, or too dim to matter) are culled
+/// @note   a LightBinner never touches the GPU, so binning can be checked without a rendering context
+class LightBinner
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a light as spotlight.frag sees it, in pixels (gl_FragCoord space)
+    struct Spot
+    {
+        /// @brief  the center of the light
+        glm::vec2 M_Center;
+
+        /// @brief  the radius of the light
+        float M_Radius;
+
+        /// @brief  the strength of the light
+        float M_Strength;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  bins lights into the tiles of the screen
+    /// @param  screenSize  the size of the screen, in pixels
+    /// @param  spots       the lights to bin - lights are referred to by their index in this list
+    void Bin( glm::ivec2 const& screenSize, std::vector< Spot > const& spots );
+
+
+    /// @brief  gets how brightly a light lights a pixel, the way spotlight.frag does
+    /// @param  spot            the light
+    /// @param  distanceSquared the squared distance from the light to the pixel
+    /// @return the brightness, 0 to 1
+    static float GetBrightness( Spot const& spot, float distanceSquared );
+
+    /// @brief  gets how far a light reaches before it is too dim to show on an 8-bit target
+    /// @param  spot    the light
+    /// @return the distance past which the light no longer shows - 0 if it never shows
+    /// @note   spotlight.frag lights a pixel by strength * r^2 / ( r^2 + d^2 ), which never quite reaches 0
+    static float GetRange( Spot const& spot );
+
+
+    /// @brief  logs how long binning 500 lights takes, and how many fewer lights the shader loops over
+    static void RunBenchmark();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the size of a tile
+    /// @return the width and height of a tile, in pixels
+    static constexpr int GetTileSize() { return s_TileSize; }
+
+    /// @brief  gets how many tiles the screen was split into along each axis
+    /// @return how many tiles the screen was split into along each axis
+    glm::ivec2 const& GetTileCounts() const { return m_TileCounts; }
+
+    /// @brief  gets the light list of each tile, row by row from the bottom left
+    /// @return the offset of each tile's first light in GetLightIndices(), and how many lights the tile has
+    std::vector< glm::uvec2 > const& GetTiles() const { return m_Tiles; }
+
+    /// @brief  gets the light lists of every tile, back to back
+    /// @return the indices of the lights in each tile's list
+    std::vector< unsigned > const& GetLightIndices() const { return m_LightIndices; }
+
+    /// @brief  gets how many lights reached no tile in the last Bin
+    /// @return how many lights were culled
+    int GetCulledCount() const { return m_CulledCount; }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the width and height of a tile, in pixels
+    static constexpr int s_TileSize = 32;
+
+    /// @brief  how many tiles wide and tall a block is - lights are culled per block first, so each tile only
+    ///         checks the few lights left in its block
+    static constexpr int s_BlockSize = 8;
+
+    /// @brief  the dimmest brightness an 8-bit target can show
+    static constexpr float s_VisibleBrightness = 1.0f / 255.0f;
+
+
+    /// @brief  how many tiles the screen was split into along each axis
+    glm::ivec2 m_TileCounts = { 0, 0 };
+
+    /// @brief  the offset and length of each tile's light list
+    std::vector< glm::uvec2 > m_Tiles;
+
+    /// @brief  the light lists of every tile, back to back
+    std::vector< unsigned > m_LightIndices;
+
+    /// @brief  how many lights reached no tile in the last Bin
+    int m_CulledCount = 0;
+
+    /// @brief  how far each light reaches - kept to reuse its memory
+    std::vector< float > m_Ranges;
+
+    /// @brief  the lights that reach the block being binned - kept to reuse its memory
+    std::vector< unsigned > m_BlockLights;
+
+    /// @brief  the brightest and dimmest each light gets within the area being culled - kept to reuse its memory
+    std::vector< glm::vec2 > m_Brightness;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  appends the lights whose range reaches an area
+    /// @param  spots       the lights being binned
+    /// @param  candidates  the lights to check
+    /// @param  count       how many lights to check
+    /// @param  min         the minimum corner of the area, in pixels
+    /// @param  max         the maximum corner of the area, in pixels
+    /// @param  lights      the list to append the lights that reach the area to
+    void gatherLights(
+        std::vector< Spot > const& spots, unsigned const* candidates, size_t count,
+        glm::vec2 const& min, glm::vec2 const& max, std::vector< unsigned >* lights
+    ) const;
+
+    /// @brief  drops the lights that can't change any pixel of an area, keeping the rest in order
+    /// @param  spots   the lights being binned
+    /// @param  lights  the lights that reach the area
+    /// @param  count   how many lights reach the area
+    /// @param  min     the minimum corner of the area, in pixels
+    /// @param  max     the maximum corner of the area, in pixels
+    /// @return how many lights were kept, at the front of lights
+    unsigned cullLights( std::vector< Spot > const& spots, unsigned* lights, unsigned count, glm::vec2 const& min, glm::vec2 const& max );
+
+
+//-----------------------------------------------------------------------------
+};
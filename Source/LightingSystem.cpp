@@ -13,8 +13,6 @@
 #include "PlatformSystem.h" // screen size
 #include "Mesh.h"           // rendering
 #include "CameraSystem.h"   // world-to-screen matrix for frag shader uniforms
-#include "Entity.h"         // parent position
-#include "Transform.h"      // parent position
 
 #include "InputSystem.h"
 
@@ -31,38 +29,32 @@ void LightingSystem::OnInit()
     m_Sprite = new LightingSprite;
     m_Sprite->SetLayer(0);  // scene transition will take care of this
 
-    Renderer()->AddShader("lights", new Shader("Data/shaders/vshader.vert", "Data/shaders/lighting.frag"));
     Renderer()->AddShader("spotlight", new Shader("Data/shaders/vshader.vert", "Data/shaders/spotlight.frag"));
-    Platform()->AddOnWindowResizeCallback( GetId(), std::bind(&LightingSystem::reallocTexArray, this) );
-    glGenFramebuffers(1, &m_FBO);
 
-    // uniform blocks
-    //glGenBuffers(1, &m_UBOrad);
-    //glGenBuffers(1, &m_UBOstr);         // TODO: do I need to bind them?
-    //glBindBufferBase(GL_UNIFORM_BUFFER, 1, m_UBOrad);
-    //glBindBufferBase(GL_UNIFORM_BUFFER, 2, m_UBOstr);
+    // light records
+    glGenBuffers(1, &m_SSBOlights);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 13, m_SSBOlights);
 
-    glGenBuffers(1, &m_UBOpos);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 13, m_UBOpos);
-    glGenBuffers(1, &m_UBOrad);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 14, m_UBOrad);
-    glGenBuffers(1, &m_UBOstr);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 15, m_UBOstr);
-
-
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    // per-tile light lists
+    glGenBuffers(1, &m_SSBOtiles);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, m_SSBOtiles);
+    glGenBuffers(1, &m_SSBOtileLights);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 12, m_SSBOtileLights);
 }
 
 
-/// @brief  Renders spotlights in advance, and (later) launches compute shader to
-///         to pre-calculate shadows.
+/// @brief  Reads lights that changed and bins all of them into screen tiles.
+///         Uploading is left to DrawLights.
 void LightingSystem::OnUpdate(float dt)
 {
     if (!m_Enabled || !GetComponents().size())
         return;
-    
+
+    auto start = std::chrono::high_resolution_clock::now();
+
     // for inverted screen y-coordinates
-    float scrheight = (float)Platform()->GetWindowDimensions().y;
+    glm::ivec2 screenSize = Platform()->GetWindowDimensions();
+    float scrheight = (float)screenSize.y;
 
     // get matrix inverse only when it's changed
     glm::mat4 s2w = Cameras()->GetMat_ScreenToWorld();
@@ -72,34 +64,39 @@ void LightingSystem::OnUpdate(float dt)
         m_W2S = glm::inverse(s2w);
     }
 
-    // put individual light source stats into vectors
-    size_t size = GetComponents().size();
-    m_Positions.clear();
-    m_Radii.clear();
-    m_Strengths.clear();
-    for (Light* thislight : GetComponents())
+    // world to gl_FragCoord: screen coords with y going up
+    glm::mat4 flip(1.0f);
+    flip[1][1] = -1.0f;
+    flip[3][1] = scrheight;
+    m_W2F = flip * m_W2S;
+
+    updateRecords();
+
+    // the camera moves every frame, so lights are put in screen space every frame
+    float radiusScale = m_W2S[0][0];
+    m_Spots.resize(m_Records.size());
+    for (size_t i = 0; i < m_Records.size(); ++i)
     {
-        // light position
-        glm::vec4 pos = glm::vec4( thislight->GetOffset(), 0, 1 );
-        Transform* pt = thislight->GetEntity()->GetComponent<Transform>();
-        if (pt)
-            pos += glm::vec4(pt->GetTranslation(), 0, 0);
-
-        // convert it to screen coords
-        glm::vec4 scrpos = m_W2S * pos;
-        scrpos.y = scrheight - scrpos.y; // TODO: does W2S need fixing, or am I doing something wrong here?
-
-        m_Positions.push_back(scrpos);
-        m_Radii.push_back(thislight->GetRadius() * m_W2S[0][0]);
-        m_Strengths.push_back(thislight->GetStrength());
+        LightRecord const& record = m_Records[i];
+        glm::vec2 center = m_W2F * glm::vec4(record.pos, 0, 1);
+        m_Spots[i] = { center, record.radius * radiusScale, record.strength };
     }
 
+    auto binStart = std::chrono::high_resolution_clock::now();
+
+    // sort lights into screen tiles, so each pixel only loops over the lights that can reach it
+    m_Binner.Bin(screenSize, m_Spots);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_UpdateMs = std::chrono::duration<float, std::milli>(binStart - start).count();
+    m_BinMs = std::chrono::duration<float, std::milli>(end - binStart).count();
+
     (void)dt;
 }
 
 void LightingSystem::DrawLights()
 {
-    if (!GetComponents().size() || !m_Enabled)
+    if (!GetComponents().size() || !m_Enabled || m_Binner.GetTiles().empty())
         return;
 
     Shader* spotShader = Renderer()->SetActiveShader("spotlight");
@@ -108,28 +105,22 @@ void LightingSystem::DrawLights()
     glm::mat4 m(glm::mat2(2.0f));
     glUniformMatrix4fv(spotShader->GetUniformID("mvp"), 1, false, &m[0][0]);
 
-    // light count
+    // records are in world space
+    glUniformMatrix4fv(spotShader->GetUniformID("world_to_frag"), 1, false, &m_W2F[0][0]);
+    glUniform1f(spotShader->GetUniformID("radius_scale"), m_W2S[0][0]);
+
+    // tile layout
     //spotShader->GetUniformID("ambient");
-    glUniform1i(spotShader->GetUniformID("light_count"), (int)GetComponents().size());
-
-    // send the vectors to GPU
-    glBindBuffer(GL_UNIFORM_BUFFER, m_UBOpos);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::vec4) * (int)m_Positions.size(),
-        &m_Positions[0], GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, m_UBOrad);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(float) * (int)m_Radii.size(),
-        &m_Radii[0], GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, m_UBOstr);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(float) * (int)m_Strengths.size(),
-        &m_Strengths[0], GL_DYNAMIC_DRAW);
-    
+    glUniform1i(spotShader->GetUniformID("tile_size"), LightBinner::GetTileSize());
+    glm::ivec2 tileCounts = m_Binner.GetTileCounts();
+    glUniform2i(spotShader->GetUniformID("tile_count"), tileCounts.x, tileCounts.y);
+
+    uploadBuffers();
 
     // draw it all
     glBindVertexArray(Renderer()->GetDefaultMesh()->GetVAO());
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
-
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
 
@@ -137,8 +128,9 @@ void LightingSystem::DrawLights()
 void LightingSystem::OnExit()
 {
     delete m_Sprite;
-    glDeleteFramebuffers(1, &m_FBO);
-    glDeleteTextures(1, &m_TextureArrayID);
+    glDeleteBuffers(1, &m_SSBOlights);
+    glDeleteBuffers(1, &m_SSBOtiles);
+    glDeleteBuffers(1, &m_SSBOtileLights);
 }
 
 
@@ -164,6 +156,23 @@ void LightingSystem::DebugWindow()
         m_Sprite->SetOpacity( m_Enabled ? 1.0f : 0.0f );
 
     ImGui::Text("Active Light Count:  %i", (int)GetComponents().size());
+    ImGui::Text("Culled Light Count:  %i", m_Binner.GetCulledCount());
+    glm::ivec2 tileCounts = m_Binner.GetTileCounts();
+    int tileCount = std::max(tileCounts.x * tileCounts.y, 1);
+    ImGui::Text("Lights per Tile:     %.2f", (float)m_Binner.GetLightIndices().size() / tileCount);
+
+    // CPU cost
+    ImGui::Spacing();
+    ImGui::Text("Reading Lights:      %.3f ms", m_UpdateMs);
+    ImGui::Text("Binning:             %.3f ms", m_BinMs);
+    ImGui::Text("Changed Lights:      %i", m_DirtyCount);
+    ImGui::Text("Uploaded:            %.2f KB", m_UploadedBytes / 1024.0f);
+
+    // VRAM cost
+    ImGui::Spacing();
+    ImGui::Text("Light Records VRAM:  %.2f KB", m_LightsCapacity / 1024.0f);
+    ImGui::Text("Tile Lists VRAM:     %.2f KB", (m_TilesCapacity + m_TileLightsCapacity) / 1024.0f);
+
     ImGui::Spacing();
     ImGui::TextWrapped("Adjust lighting layer per-scene in the SceneTransition entity.");
 
@@ -174,30 +183,101 @@ void LightingSystem::DebugWindow()
 
 
 
-/// @brief  Reallocates texture array - for when the amount of lights or the
-///         screen resolution changes. (This is why Ligthing System keeps track of it,
-///         rather than the sprite)
-void LightingSystem::reallocTexArray()
+//-----------------------------------------------------------------------------
+//              Helpers
+//-----------------------------------------------------------------------------
+
+
+/// @brief  Rewrites the records of lights that changed or moved in the
+///         component list, and marks them for upload.
+void LightingSystem::updateRecords()
 {
-    if (!GetComponents().size())
-        return;
+    std::vector<Light*> const& lights = GetComponents();
+    m_Records.resize(lights.size());
+    m_RecordOwners.resize(lights.size(), nullptr);
+    m_DirtyCount = 0;
 
-    // replace old texture array, if present
-    if (m_TextureArrayID)
-        glDeleteTextures(1, &m_TextureArrayID);
+    for (int i = 0; i < (int)lights.size(); ++i)
+    {
+        // a light shifts to another record when one before it is removed
+        Light* light = lights[i];
+        if (!light->GetIsDirty() && m_RecordOwners[i] == light)
+            continue;
+
+        m_Records[i] = { light->GetPosition(), light->GetRadius(), light->GetStrength() };
+        m_RecordOwners[i] = light;
+        light->ClearDirty();
+        ++m_DirtyCount;
+
+        // join nearby changes, so they go up in one call
+        if (!m_DirtyRanges.empty() && i >= m_DirtyRanges.back().x
+                                   && i <= m_DirtyRanges.back().y + s_RangeMergeGap)
+            m_DirtyRanges.back().y = std::max(m_DirtyRanges.back().y, i + 1);
+        else
+            m_DirtyRanges.push_back({ i, i + 1 });
+    }
+}
 
-    // create new one, match texture resolution to screen size
-    glGenTextures(1, &m_TextureArrayID);
-    glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureArrayID);
-    glm::ivec2 dims = Platform()->GetWindowDimensions();
-    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, dims.x, dims.y, (GLsizei)GetComponents().size());
 
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+/// @brief  Sends dirty records, and the tile light lists, to the GPU.
+void LightingSystem::uploadBuffers()
+{
+    m_UploadedBytes = 0;
 
-    m_PrevSize = GetComponents().size();
+    // light records: only the ones that changed, unless the buffer had to grow
+    int count = (int)m_Records.size();
+    if (growBuffer(m_SSBOlights, &m_LightsCapacity, sizeof(LightRecord) * count))
+        m_DirtyRanges.assign(1, { 0, count });
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_SSBOlights);
+    for (glm::ivec2 const& range : m_DirtyRanges)
+    {
+        int end = std::min(range.y, count);
+        if (end <= range.x)
+            continue;
+
+        size_t bytes = sizeof(LightRecord) * (end - range.x);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(LightRecord) * range.x, bytes, &m_Records[range.x]);
+        m_UploadedBytes += bytes;
+    }
+    m_DirtyRanges.clear();
+
+    // tile light lists change with the camera, so they go up every frame
+    std::vector<glm::uvec2> const& tiles = m_Binner.GetTiles();
+    size_t tileBytes = sizeof(glm::uvec2) * tiles.size();
+    growBuffer(m_SSBOtiles, &m_TilesCapacity, tileBytes);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_SSBOtiles);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, tileBytes, tiles.data());
+
+    // (buffers can't be empty, so there's always room for 1 index)
+    std::vector<unsigned> const& tileLights = m_Binner.GetLightIndices();
+    size_t tileLightBytes = sizeof(unsigned) * tileLights.size();
+    growBuffer(m_SSBOtileLights, &m_TileLightsCapacity, std::max(tileLightBytes, sizeof(unsigned)));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_SSBOtileLights);
+    if (tileLightBytes)
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, tileLightBytes, tileLights.data());
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    m_UploadedBytes += tileBytes + tileLightBytes;
+}
+
+
+/// @brief           Grows a buffer (to double its size) if data no longer fits.
+///                  Growing discards the buffer's contents.
+/// @param buffer    OpenGL ID of the buffer
+/// @param capacity  Current size of the buffer, in bytes. Updated when it grows.
+/// @param size      Bytes that need to fit
+/// @return          Whether the buffer grew
+bool LightingSystem::growBuffer(unsigned int buffer, size_t* capacity, size_t size)
+{
+    if (size <= *capacity)
+        return false;
+
+    *capacity = std::max(size, *capacity * 2);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, *capacity, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    return true;
 }
 
 
@@ -216,7 +296,8 @@ void LightingSystem::readEnabled(nlohmann::ordered_json const& data)
 
 /// @brief map of the LightingSystem read methods
 ReadMethodMap< LightingSystem > const LightingSystem::s_ReadMethods = {
-    { "Enabled", &readEnabled }
+    { "Enabled"             , &readEnabled              },
+    { "SpatialIndexCellSize", &readSpatialIndexCellSize }
 };
 
 
@@ -227,6 +308,7 @@ nlohmann::ordered_json LightingSystem::Write() const
     nlohmann::ordered_json json;
 
     json["Enabled"] = Stream::Write< bool >(m_Enabled);
+    writeSpatialIndexCellSize( &json );
 
     return json;
 }
@@ -11,6 +11,7 @@
 #include "ComponentSystem.h"
 #include "Sprite.h"
 #include "Light.h"
+#include "LightBinner.h"
 
 /// @brief   Let there be light.
 class LightingSystem : public ComponentSystem<Light>
@@ -29,15 +30,22 @@ public:
         virtual LightingSprite* Clone() const override { return nullptr; }
     };
 
+    /// @brief   One light, as spotlight.frag reads it. In world space, so a
+    ///          record only changes when its light does - not when the camera moves.
+    struct LightRecord
+    {
+        glm::vec2 pos;      /// @brief   World position
+        float radius;       /// @brief   Radius, in world units
+        float strength;     /// @brief   Strength (brightness)
+    };
+    static_assert(sizeof(LightRecord) == 16, "LightRecord must match the std430 layout in spotlight.frag");
+
 
 //-----------------------------------------------------------------------------
 //              Public methods
 //-----------------------------------------------------------------------------
 public:
 
-    /// @return     OpenGL ID of the texture array
-    __inline unsigned int GetTexArrayID() const { return m_TextureArrayID; }
-
     /// @return     Enabled state of the lighting system
     __inline bool GetLightingEnabled() const { return m_Enabled; }
 
@@ -83,25 +91,47 @@ private:
 //-----------------------------------------------------------------------------
 private:
     LightingSprite* m_Sprite = nullptr;   /// @brief   Does the rendering.
-    unsigned int m_TextureArrayID = 0;    /// @brief   Texture array for light sources
-    GLuint m_FBO = -1;                    /// @brief   Framebuffer for rendering lights to texture 
     bool m_Enabled = false;               /// @brief   For debugging. Can disable all lights.
     glm::mat4 m_S2W = {}, m_W2S = {};     /// @brief   Screen-to-world matrix (and inverse)
-    unsigned long long m_PrevSize = 0;    /// @brief   To reallocate only when light count has changed
-    unsigned int m_UBOpos = -1, 
-                 m_UBOrad = -1, 
-                 m_UBOstr = -1;
-    std::vector<glm::vec4> m_Positions;
-    std::vector<float> m_Radii,
-                       m_Strengths;
+    glm::mat4 m_W2F = {};                 /// @brief   World-to-gl_FragCoord matrix (W2S, y flipped)
+    unsigned int m_SSBOlights = -1,       /// @brief   LightRecord of every light
+                 m_SSBOtiles = -1,        /// @brief   Offset and count of each tile's light list
+                 m_SSBOtileLights = -1;   /// @brief   Light lists of all tiles, back to back
+    size_t m_LightsCapacity = 0,          /// @brief   Allocated size of each buffer, in bytes.
+           m_TilesCapacity = 0,           ///          Buffers only grow, so they aren't
+           m_TileLightsCapacity = 0;      ///          reallocated every frame.
+    std::vector<LightRecord> m_Records;   /// @brief   CPU copy of m_SSBOlights
+    std::vector<Light const*> m_RecordOwners; /// @brief   Light each record was last read from
+    std::vector<glm::ivec2> m_DirtyRanges;  /// @brief   Records to upload: [first, end)
+    std::vector<LightBinner::Spot> m_Spots; /// @brief   Lights in screen space, for binning
+    LightBinner m_Binner;                 /// @brief   Splits the screen into tiles of lights
+
+    int m_DirtyCount = 0;                 /// @brief   Records rewritten last frame
+    size_t m_UploadedBytes = 0;           /// @brief   Bytes sent to the GPU last frame
+    float m_UpdateMs = 0.0f;              /// @brief   How long reading lights took last frame
+    float m_BinMs = 0.0f;                 /// @brief   How long binning took last frame
+
+    /// @brief   Dirty records at most this far apart are uploaded in one call
+    static constexpr int s_RangeMergeGap = 4;
 
 //-----------------------------------------------------------------------------
 //              Helpers
 //-----------------------------------------------------------------------------
 private:
-    /// @brief  Reallocates texture array - for when the amount of lights 
-    ///         or the screen resolution changes.
-    void reallocTexArray();
+    /// @brief  Rewrites the records of lights that changed or moved in the
+    ///         component list, and marks them for upload.
+    void updateRecords();
+
+    /// @brief  Sends dirty records, and the tile light lists, to the GPU.
+    void uploadBuffers();
+
+    /// @brief           Grows a buffer (to double its size) if data no longer fits.
+    ///                  Growing discards the buffer's contents.
+    /// @param buffer    OpenGL ID of the buffer
+    /// @param capacity  Current size of the buffer, in bytes. Updated when it grows.
+    /// @param size      Bytes that need to fit
+    /// @return          Whether the buffer grew
+    static bool growBuffer(unsigned int buffer, size_t* capacity, size_t size);
 
 
 
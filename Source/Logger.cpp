@@ -0,0 +1,516 @@
+/// @file       Logger.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      asynchronous backend of the DebugStream - formats on the calling thread, writes on a background thread
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "Logger.h"
+
+#include "Console.h"
+#include "DebugSystem.h"
+#include "Stream.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <Windows.h>
+#endif
+
+
+    /// @brief  reproduces the synchronous DebugStream the Logger replaced, so the two can be benchmarked against
+    ///         each other: every fragment is formatted through a new stream, written straight to the file, and joined
+    ///         into console lines
+    struct LegacyLogSink
+    {
+        /// @brief  stands in for the trace log
+        std::ofstream M_File;
+
+        /// @brief  stands in for the (unbounded) console items
+        std::vector< std::string > M_Items;
+
+        /// @brief  the fragments of the current console line
+        std::string M_LastLog;
+
+        /// @brief  writes a fragment the way DebugSystem::Write() used to
+        /// @tparam ValueType   the type of fragment to write
+        /// @param  value       the fragment to write
+        template < typename ValueType >
+        void Append( ValueType const& value )
+        {
+            std::ostringstream oss;
+            oss << value;
+
+        #if defined( _WIN32 ) && defined( NDEBUG )
+            // release builds looked up and checked the trace log's directory on every fragment
+            char* appData = nullptr;
+            size_t size = 0;
+            if ( _dupenv_s( &appData, &size, "APPDATA" ) == 0 && appData != nullptr )
+            {
+                std::string gameDirectory = std::string( appData ) + "\\Dig_Deeper";
+                free( appData );
+                GetFileAttributesA( gameDirectory.c_str() );
+            }
+        #endif
+
+            M_File << oss.str();
+
+            std::string const& log = oss.str();
+            if ( log.empty() == false && log.back() == '\n' )
+            {
+                M_Items.push_back( M_LastLog + log );
+                M_LastLog.clear();
+            }
+            else
+            {
+                M_LastLog += log;
+            }
+        }
+    };
+
+
+    /// @brief  gets a percentile of a set of durations
+    /// @param  ticks       the durations, in steady_clock ticks - gets sorted
+    /// @param  percentile  the percentile to get, from 0 to 1
+    /// @return the percentile, in microseconds
+    static double percentileMicroseconds( std::vector< int64_t >& ticks, double percentile )
+    {
+        if ( ticks.empty() )
+        {
+            return 0.0;
+        }
+
+        std::sort( ticks.begin(), ticks.end() );
+        size_t index = std::min( (size_t)( percentile * ticks.size() ), ticks.size() - 1 );
+        return std::chrono::duration< double, std::micro >( std::chrono::steady_clock::duration( ticks[ index ] ) ).count();
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  blocks until every line submitted so far has been written
+    void Logger::Flush()
+    {
+        uint64_t target = m_EnqueuePosition.load( std::memory_order_acquire );
+        wakeWriter();
+
+        while ( m_WrittenPosition.load( std::memory_order_acquire ) < target )
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief  sets the DebugConsole that written lines are forwarded to
+    /// @param  console the DebugConsole to forward lines to, or nullptr to stop forwarding
+    /// @note   lines written before a console is set are held onto (up to a limit) and forwarded once one is
+    void Logger::SetConsole( DebugConsole* console )
+    {
+        m_Console.store( console );
+        wakeWriter();
+    }
+
+
+    /// @brief  measures the throughput and latency of the DebugStream against the old synchronous path
+    void Logger::RunBenchmark()
+    {
+        static constexpr int lineCount = 20000;
+        static constexpr int threadCount = 4;
+
+        // writes a line the way typical engine code does - a handful of fragments of mixed types
+        auto writeLine = []( auto& sink, int i )
+        {
+            sink.Append( "benchmark line " );
+            sink.Append( i );
+            sink.Append( " of " );
+            sink.Append( lineCount );
+            sink.Append( ", position " );
+            sink.Append( i * 0.25f );
+            sink.Append( "\n" );
+        };
+
+        Flush();
+        uint64_t droppedBefore = GetDroppedCount();
+
+        // synchronous path - a line has been written as soon as the call returns
+        std::vector< int64_t > legacyTimes;
+        legacyTimes.reserve( lineCount );
+        double legacyMs;
+        {
+            LegacyLogSink legacy;
+            legacy.M_File.open( "trace_benchmark.log" );
+
+            auto start = std::chrono::steady_clock::now();
+            for ( int i = 0; i < lineCount; ++i )
+            {
+                auto lineStart = std::chrono::steady_clock::now();
+                writeLine( legacy, i );
+                legacyTimes.push_back( ( std::chrono::steady_clock::now() - lineStart ).count() );
+            }
+            legacyMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+        }
+        std::remove( "trace_benchmark.log" );
+
+        // asynchronous path, single producer - while measuring, the writer only writes to the trace log
+        std::vector< int64_t > callerTimes;
+        callerTimes.reserve( lineCount );
+        if ( m_Latencies.empty() )
+        {
+            m_Latencies.resize( 2 * lineCount ); // never resized again, in case the writer is still finishing a line
+        }
+        m_LatencyCount.store( 0 );
+        m_MeasuringLatency.store( true );
+
+        auto start = std::chrono::steady_clock::now();
+        for ( int i = 0; i < lineCount; ++i )
+        {
+            auto lineStart = std::chrono::steady_clock::now();
+            writeLine( *this, i );
+            callerTimes.push_back( ( std::chrono::steady_clock::now() - lineStart ).count() );
+        }
+        double submitMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+        Flush();
+        double writtenMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+        // asynchronous path, several producers at once
+        start = std::chrono::steady_clock::now();
+        std::vector< std::thread > producers;
+        for ( int t = 0; t < threadCount; ++t )
+        {
+            producers.emplace_back( [ this, t, &writeLine ]()
+            {
+                for ( int i = t; i < lineCount; i += threadCount )
+                {
+                    writeLine( *this, i );
+                }
+            } );
+        }
+        for ( std::thread& producer : producers )
+        {
+            producer.join();
+        }
+        double threadedSubmitMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+        Flush();
+        double threadedWrittenMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+        m_MeasuringLatency.store( false );
+        std::vector< int64_t > latencies( m_Latencies.begin(), m_Latencies.begin() + m_LatencyCount.load() );
+
+        uint64_t dropped = GetDroppedCount() - droppedBefore;
+
+        Debug() << "Logging benchmark (" << lineCount << " lines, 7 fragments each):\n" <<
+            "  synchronous:        " << legacyMs << " ms, per line p50 " << percentileMicroseconds( legacyTimes, 0.5 ) <<
+            " us / p99 " << percentileMicroseconds( legacyTimes, 0.99 ) << " us / max " << percentileMicroseconds( legacyTimes, 1.0 ) << " us\n" <<
+            "  async, 1 thread:    " << submitMs << " ms to submit, " << writtenMs << " ms until written, per line p50 " <<
+            percentileMicroseconds( callerTimes, 0.5 ) << " us / p99 " << percentileMicroseconds( callerTimes, 0.99 ) <<
+            " us / max " << percentileMicroseconds( callerTimes, 1.0 ) << " us\n" <<
+            "  async, " << threadCount << " threads:   " << threadedSubmitMs << " ms to submit, " << threadedWrittenMs << " ms until written\n" <<
+            "  submit to written:  p50 " << percentileMicroseconds( latencies, 0.5 ) << " us / p99 " <<
+            percentileMicroseconds( latencies, 0.99 ) << " us / max " << percentileMicroseconds( latencies, 1.0 ) << " us\n" <<
+            "  dropped: " << dropped << " line(s)" << std::endl;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the calling thread's line buffer
+    /// @return the calling thread's line buffer
+    Logger::LineBuffer& Logger::getLineBuffer()
+    {
+        static thread_local LineBuffer s_LineBuffer;
+        return s_LineBuffer;
+    }
+
+
+    /// @brief  copies a completed line into the ring and wakes the writer thread
+    /// @param  line    the line to submit
+    void Logger::submit( std::string_view line )
+    {
+        int64_t time = std::chrono::steady_clock::now().time_since_epoch().count();
+        if ( push( line, time ) == false )
+        {
+            m_DroppedCount.fetch_add( 1, std::memory_order_relaxed );
+            m_DroppedTotal.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+
+        wakeWriter();
+    }
+
+    /// @brief  claims consecutive slots of the ring and copies a line into them
+    /// @param  line    the line to copy into the ring
+    /// @param  time    when the line was submitted
+    /// @return whether there was room in the ring
+    /// @note   each slot's sequence is its position once it's free to write, and its position + 1 once it's been
+    ///         written. The writer frees slots in order, so if the last slot a line needs is free, all of them are.
+    bool Logger::push( std::string_view line, int64_t time )
+    {
+        uint64_t slotCount = std::clamp< uint64_t >( ( line.size() + s_SlotTextSize - 1 ) / s_SlotTextSize, 1, s_MaxSlotsPerLine );
+
+        uint64_t position = m_EnqueuePosition.load( std::memory_order_relaxed );
+        while ( true )
+        {
+            uint64_t lastPosition = position + slotCount - 1;
+            uint64_t sequence = m_Slots[ lastPosition & ( s_SlotCount - 1 ) ].M_Sequence.load( std::memory_order_acquire );
+            int64_t difference = (int64_t)sequence - (int64_t)lastPosition;
+
+            if ( difference == 0 )
+            {
+                if ( m_EnqueuePosition.compare_exchange_weak( position, position + slotCount, std::memory_order_relaxed ) )
+                {
+                    break;
+                }
+            }
+            else if ( difference < 0 )
+            {
+                return false; // the ring is full
+            }
+            else
+            {
+                position = m_EnqueuePosition.load( std::memory_order_relaxed );
+            }
+        }
+
+        for ( uint64_t i = 0; i < slotCount; ++i )
+        {
+            Slot& slot = m_Slots[ ( position + i ) & ( s_SlotCount - 1 ) ];
+            size_t offset = std::min< size_t >( i * s_SlotTextSize, line.size() );
+            size_t length = std::min< size_t >( s_SlotTextSize, line.size() - offset );
+
+            std::memcpy( slot.M_Record.M_Text, line.data() + offset, length );
+            slot.M_Record.M_Length = (uint16_t)length;
+            slot.M_Record.M_Continues = i + 1 < slotCount;
+            slot.M_Record.M_SubmitTime = time;
+
+            slot.M_Sequence.store( position + i + 1, std::memory_order_release );
+        }
+
+        return true;
+    }
+
+    /// @brief  wakes the writer thread if it is waiting for new lines
+    void Logger::wakeWriter()
+    {
+        // pairs with the fence in writerLoop() - either the writer sees the new line, or this sees the writer asleep
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if ( m_WriterSleeping.load( std::memory_order_relaxed ) && m_WriterSleeping.exchange( false ) )
+        {
+            m_WriterSleeping.notify_one();
+        }
+    }
+
+
+    /// @brief  runs the writer thread
+    void Logger::writerLoop()
+    {
+        while ( true )
+        {
+            if ( drain() )
+            {
+                continue;
+            }
+
+            if ( m_Running.load() == false )
+            {
+                break;
+            }
+
+            // stay awake for a moment, so lines written in bursts don't each have to wake this thread
+            bool linesArrived = false;
+            for ( int i = 0; i < s_IdleSpinCount && linesArrived == false; ++i )
+            {
+                std::this_thread::yield();
+                linesArrived = m_Slots[ m_DequeuePosition & ( s_SlotCount - 1 ) ].M_Sequence.load( std::memory_order_acquire ) == m_DequeuePosition + 1;
+            }
+            if ( linesArrived )
+            {
+                continue;
+            }
+
+            // flush before going to sleep - but not after every line, which would cost a system call per line
+            auto now = std::chrono::steady_clock::now();
+            if ( m_TraceFileDirty && now - m_LastTraceFlush >= s_TraceFlushInterval )
+            {
+                m_TraceFile.flush();
+                m_TraceFileDirty = false;
+                m_LastTraceFlush = now;
+            }
+
+            m_WriterSleeping.store( true );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+
+            // check again now that producers can see this thread is asleep
+            bool linesWaiting = m_Slots[ m_DequeuePosition & ( s_SlotCount - 1 ) ].M_Sequence.load( std::memory_order_acquire ) == m_DequeuePosition + 1;
+            bool heldLinesWaiting = m_HeldLines.empty() == false && m_Console.load() != nullptr;
+            if ( linesWaiting || heldLinesWaiting || m_Running.load() == false )
+            {
+                m_WriterSleeping.store( false );
+                continue;
+            }
+
+            m_WriterSleeping.wait( true );
+        }
+
+        m_TraceFile.flush();
+    }
+
+    /// @brief  moves every available line out of the ring
+    /// @return whether anything was written
+    bool Logger::drain()
+    {
+        bool wroteAnything = false;
+
+        DebugConsole* console = m_Console.load();
+        if ( console != nullptr && m_HeldLines.empty() == false )
+        {
+            for ( std::string const& line : m_HeldLines )
+            {
+                console->AddLog( line );
+            }
+            m_HeldLines.clear();
+        }
+
+        while ( true )
+        {
+            Slot& slot = m_Slots[ m_DequeuePosition & ( s_SlotCount - 1 ) ];
+            if ( slot.M_Sequence.load( std::memory_order_acquire ) != m_DequeuePosition + 1 )
+            {
+                break;
+            }
+
+            m_PendingLine.append( slot.M_Record.M_Text, slot.M_Record.M_Length );
+            bool continues = slot.M_Record.M_Continues;
+            int64_t submitTime = slot.M_Record.M_SubmitTime;
+
+            slot.M_Sequence.store( m_DequeuePosition + s_SlotCount, std::memory_order_release );
+            ++m_DequeuePosition;
+            wroteAnything = true;
+
+            if ( continues )
+            {
+                continue;
+            }
+
+            if ( m_PendingLine.back() != '\n' )
+            {
+                m_PendingLine.push_back( '\n' ); // the line was truncated
+            }
+            writeLine( m_PendingLine );
+            m_PendingLine.clear();
+
+            size_t latencyIndex = m_LatencyCount.load( std::memory_order_relaxed );
+            if ( m_MeasuringLatency.load( std::memory_order_relaxed ) && latencyIndex < m_Latencies.size() )
+            {
+                m_Latencies[ latencyIndex ] = std::chrono::steady_clock::now().time_since_epoch().count() - submitTime;
+                m_LatencyCount.store( latencyIndex + 1, std::memory_order_relaxed );
+            }
+        }
+
+        uint64_t dropped = m_DroppedCount.exchange( 0, std::memory_order_relaxed );
+        if ( dropped != 0 )
+        {
+            writeLine( "WARNING: the log couldn't keep up - dropped " + std::to_string( dropped ) + " line(s)\n" );
+            wroteAnything = true;
+        }
+
+        if ( wroteAnything )
+        {
+            m_TraceFileDirty = true;
+            m_WrittenPosition.store( m_DequeuePosition, std::memory_order_release );
+        }
+
+        return wroteAnything;
+    }
+
+    /// @brief  writes a completed line to the trace log, stdout, and the DebugConsole
+    /// @param  line    the line to write
+    void Logger::writeLine( std::string const& line )
+    {
+        m_TraceFile << line;
+
+        if ( m_MeasuringLatency.load( std::memory_order_relaxed ) )
+        {
+            return; // keep benchmark lines out of the console
+        }
+
+    #ifndef NDEBUG  // only write to stdout in Debug mode
+        std::cout << line;
+    #endif
+
+        DebugConsole* console = m_Console.load();
+        if ( console != nullptr )
+        {
+            console->AddLog( line );
+            return;
+        }
+
+        if ( m_HeldLines.size() >= s_MaxHeldLines )
+        {
+            m_HeldLines.pop_front();
+        }
+        m_HeldLines.push_back( line );
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of the Logger
+    /// @return the instance of the Logger
+    Logger* Logger::GetInstance()
+    {
+        // initialized exactly once, even if the first lines are logged from several threads at once
+        static std::unique_ptr< Logger > s_Instance( new Logger() );
+        return s_Instance.get();
+    }
+
+    /// @brief  stops the writer thread once everything has been written
+    Logger::~Logger()
+    {
+        m_Running.store( false );
+        m_WriterSleeping.store( false );
+        m_WriterSleeping.notify_one();
+
+        if ( m_WriterThread.joinable() )
+        {
+            m_WriterThread.join();
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  opens the trace log and starts the writer thread
+    Logger::Logger() :
+        m_Slots( new Slot[ s_SlotCount ] )
+    {
+        for ( uint64_t i = 0; i < s_SlotCount; ++i )
+        {
+            m_Slots[ i ].M_Sequence.store( i, std::memory_order_relaxed );
+        }
+
+        std::string const& traceFilePath = Stream::GetTraceLogPath();
+        m_TraceFile.open( traceFilePath );
+        if ( m_TraceFile.is_open() == false )
+        {
+            std::cerr << "Warning: unable to open file \"" << traceFilePath << "\"" << std::endl;
+        }
+
+        m_WriterThread = std::thread( &Logger::writerLoop, this );
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,337 @@
+/// @file       Logger.h
+/// @author     Oblivion Owls Inc
+/// @brief      asynchronous backend of the DebugStream - formats on the calling thread, writes on a background thread
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <thread>
+#include <string_view>
+
+
+class DebugConsole;
+
+
+/// @brief  severity of a log message, used to strip messages at compile time
+enum class LogLevel : int
+{
+    Verbose = 0, /// @brief  chatter that is only useful while developing
+    Info    = 1, /// @brief  normal messages - everything written with Debug() directly
+    Warning = 2, /// @brief  something went wrong, but the game can continue
+    Error   = 3  /// @brief  something went badly wrong
+};
+
+
+/// @brief  the lowest LogLevel that gets compiled in - define it in the project settings to override
+#ifndef LOG_LEVEL_MIN
+    #ifdef NDEBUG
+        #define LOG_LEVEL_MIN 1
+    #else
+        #define LOG_LEVEL_MIN 0
+    #endif
+#endif
+
+/// @brief  swallows the result of a LOG_AT_LEVEL stream expression, so that both sides of its conditional are void
+struct LogVoidify
+{
+    /// @brief  binds looser than << and tighter than ?:, so it takes the whole chain of << as its operand
+    /// @tparam StreamType  the type the chain of << ends in
+    template < typename StreamType >
+    void operator &( StreamType const& ) const {}
+};
+
+/// @brief  writes to the DebugStream if the level is compiled in - otherwise its arguments are never evaluated, and
+///         the constant condition lets the compiler drop the statement entirely
+/// @note   usage: LOG_VERBOSE << "value: " << value << std::endl;
+/// @note   a single expression rather than an if / else, so it can't capture the else of a surrounding if
+#define LOG_AT_LEVEL( level ) ( (int)( level ) < LOG_LEVEL_MIN ) ? (void)0 : LogVoidify() & Debug()
+
+#define LOG_VERBOSE LOG_AT_LEVEL( LogLevel::Verbose )
+#define LOG_INFO    LOG_AT_LEVEL( LogLevel::Info    )
+#define LOG_WARNING LOG_AT_LEVEL( LogLevel::Warning )
+#define LOG_ERROR   LOG_AT_LEVEL( LogLevel::Error   )
+
+
+/// @brief  asynchronous backend of the DebugStream
+/// @note   each thread formats fragments into its own line buffer. Completed lines are copied into a bounded lock-free
+///         multi-producer / single-consumer ring, and a background writer thread moves them to the trace log, stdout,
+///         and the DebugConsole. Logging never blocks on file IO; if the ring is full the line is dropped and counted.
+class Logger
+{
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  appends a fragment to the calling thread's current line, submitting the line once it ends in a newline
+    /// @tparam ValueType   the type of fragment to append
+    /// @param  value       the fragment to append
+    template < typename ValueType >
+    void Append( ValueType const& value );
+
+
+    /// @brief  blocks until every line submitted so far has been written
+    void Flush();
+
+    /// @brief  sets the DebugConsole that written lines are forwarded to
+    /// @param  console the DebugConsole to forward lines to, or nullptr to stop forwarding
+    /// @note   lines written before a console is set are held onto (up to a limit) and forwarded once one is
+    void SetConsole( DebugConsole* console );
+
+
+    /// @brief  measures the throughput and latency of the DebugStream against the old synchronous path
+    void RunBenchmark();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets how many lines have been dropped because the ring was full
+    /// @return how many lines have been dropped
+    uint64_t GetDroppedCount() const { return m_DroppedTotal.load( std::memory_order_relaxed ); }
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how many characters of a line fit in one slot of the ring
+    static constexpr size_t s_SlotTextSize = 240;
+
+    /// @brief  a chunk of a line in the ring - long lines take several consecutive slots
+    struct Record
+    {
+        /// @brief  when the line was submitted, in steady_clock ticks
+        int64_t M_SubmitTime;
+
+        /// @brief  how many characters of M_Text are used
+        uint16_t M_Length;
+
+        /// @brief  whether the line continues in the next slot
+        bool M_Continues;
+
+        /// @brief  the text of this chunk of the line
+        char M_Text[ s_SlotTextSize ];
+    };
+
+    /// @brief  a slot of the ring
+    struct Slot
+    {
+        /// @brief  which position of the ring this slot is ready for - see push() and drain()
+        std::atomic< uint64_t > M_Sequence;
+
+        /// @brief  the chunk of a line stored in this slot
+        Record M_Record;
+    };
+
+    /// @brief  the line each thread is currently formatting
+    struct LineBuffer
+    {
+        /// @brief  the fragments of the current line
+        std::string M_Line;
+
+        /// @brief  reused to format fragments that aren't already text
+        std::ostringstream M_Stream;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how many slots the ring has - must be a power of two
+    static constexpr uint64_t s_SlotCount = 8192;
+
+    /// @brief  the most slots a single line can take - longer lines are truncated
+    static constexpr uint64_t s_MaxSlotsPerLine = 64;
+
+    /// @brief  how many lines are held onto while no DebugConsole is set
+    static constexpr size_t s_MaxHeldLines = 256;
+
+    /// @brief  how many times the writer thread checks for new lines before going to sleep
+    static constexpr int s_IdleSpinCount = 256;
+
+    /// @brief  the least time between flushes of the trace log
+    static constexpr std::chrono::milliseconds s_TraceFlushInterval = std::chrono::milliseconds( 100 );
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the ring lines are passed to the writer thread through
+    std::unique_ptr< Slot[] > m_Slots;
+
+    /// @brief  the next position of the ring producers will claim
+    alignas( 64 ) std::atomic< uint64_t > m_EnqueuePosition = 0;
+
+    /// @brief  how many lines have been dropped since the writer last reported it
+    std::atomic< uint64_t > m_DroppedCount = 0;
+
+    /// @brief  how many lines have been dropped in total
+    std::atomic< uint64_t > m_DroppedTotal = 0;
+
+    /// @brief  the next position of the ring the writer thread will read - only touched by the writer thread
+    alignas( 64 ) uint64_t m_DequeuePosition = 0;
+
+    /// @brief  every position before this one has been written out
+    std::atomic< uint64_t > m_WrittenPosition = 0;
+
+    /// @brief  whether the writer thread is waiting for new lines
+    std::atomic< bool > m_WriterSleeping = false;
+
+    /// @brief  whether the writer thread should keep running
+    std::atomic< bool > m_Running = true;
+
+
+    /// @brief  the DebugConsole written lines are forwarded to
+    std::atomic< DebugConsole* > m_Console = nullptr;
+
+    /// @brief  lines written while no DebugConsole was set - only touched by the writer thread
+    std::deque< std::string > m_HeldLines;
+
+    /// @brief  the line the writer thread is reassembling from consecutive slots - only touched by the writer thread
+    std::string m_PendingLine;
+
+    /// @brief  the trace log
+    std::ofstream m_TraceFile;
+
+    /// @brief  whether anything has been written to the trace log since it was last flushed
+    bool m_TraceFileDirty = false;
+
+    /// @brief  when the trace log was last flushed
+    std::chrono::steady_clock::time_point m_LastTraceFlush = {};
+
+
+    /// @brief  whether the writer thread is recording the latency of each line
+    std::atomic< bool > m_MeasuringLatency = false;
+
+    /// @brief  the latency of each line written while measuring, in steady_clock ticks
+    std::vector< int64_t > m_Latencies;
+
+    /// @brief  how many latencies have been recorded since measuring started
+    std::atomic< size_t > m_LatencyCount = 0;
+
+
+    /// @brief  the background writer thread
+    std::thread m_WriterThread;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the calling thread's line buffer
+    /// @return the calling thread's line buffer
+    static LineBuffer& getLineBuffer();
+
+
+    /// @brief  copies a completed line into the ring and wakes the writer thread
+    /// @param  line    the line to submit
+    void submit( std::string_view line );
+
+    /// @brief  claims consecutive slots of the ring and copies a line into them
+    /// @param  line    the line to copy into the ring
+    /// @param  time    when the line was submitted
+    /// @return whether there was room in the ring
+    bool push( std::string_view line, int64_t time );
+
+    /// @brief  wakes the writer thread if it is waiting for new lines
+    void wakeWriter();
+
+
+    /// @brief  runs the writer thread
+    void writerLoop();
+
+    /// @brief  moves every available line out of the ring
+    /// @return whether anything was written
+    bool drain();
+
+    /// @brief  writes a completed line to the trace log, stdout, and the DebugConsole
+    /// @param  line    the line to write
+    void writeLine( std::string const& line );
+
+
+//-----------------------------------------------------------------------------
+public: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of the Logger
+    /// @return the instance of the Logger
+    static Logger* GetInstance();
+
+    /// @brief  stops the writer thread once everything has been written
+    ~Logger();
+
+
+//-----------------------------------------------------------------------------
+private: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  opens the trace log and starts the writer thread
+    Logger();
+
+    // Prevent copying
+    Logger( Logger const& ) = delete;
+    void operator =( Logger const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  appends a fragment to the calling thread's current line, submitting the line once it ends in a newline
+    /// @tparam ValueType   the type of fragment to append
+    /// @param  value       the fragment to append
+    template < typename ValueType >
+    void Logger::Append( ValueType const& value )
+    {
+        LineBuffer& buffer = getLineBuffer();
+
+        if constexpr ( std::is_convertible_v< ValueType const&, std::string_view > )
+        {
+            buffer.M_Line.append( std::string_view( value ) );
+        }
+        else
+        {
+            buffer.M_Stream.str( std::string() );
+            buffer.M_Stream << value;
+            buffer.M_Line.append( buffer.M_Stream.view() );
+        }
+
+        if ( buffer.M_Line.empty() == false && buffer.M_Line.back() == '\n' )
+        {
+            submit( buffer.M_Line );
+            buffer.M_Line.clear();
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+
+
+/// @brief  shorthand for getting the Logger
+/// @return the instance of the Logger
+__inline Logger* Log()
+{
+    return Logger::GetInstance();
+}
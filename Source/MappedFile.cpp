@@ -0,0 +1,169 @@
+/// @file       MappedFile.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      read-only memory mapping of a file
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "MappedFile.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// public: constructor / destructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  unmaps the file
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    /// @brief  move constructor
+    /// @param  other   the MappedFile to take the mapping from
+    MappedFile::MappedFile( MappedFile&& other ) noexcept
+    {
+        *this = std::move( other );
+    }
+
+    /// @brief  move assignment
+    /// @param  other   the MappedFile to take the mapping from
+    /// @return reference to this MappedFile
+    MappedFile& MappedFile::operator =( MappedFile&& other ) noexcept
+    {
+        if ( this == &other )
+        {
+            return *this;
+        }
+
+        Close();
+
+        std::swap( m_Data, other.m_Data );
+        std::swap( m_Size, other.m_Size );
+    #ifdef _WIN32
+        std::swap( m_FileHandle, other.m_FileHandle );
+        std::swap( m_MappingHandle, other.m_MappingHandle );
+    #endif
+
+        return *this;
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  maps a file into memory, unmapping any previously mapped file
+    /// @param  filepath    the file to map
+    /// @return whether the file was successfully mapped
+    bool MappedFile::Open( std::string const& filepath )
+    {
+        Close();
+
+    #ifdef _WIN32
+
+        HANDLE file = CreateFileA(
+            filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+        );
+        if ( file == INVALID_HANDLE_VALUE )
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if ( GetFileSizeEx( file, &size ) == FALSE || size.QuadPart == 0 )
+        {
+            CloseHandle( file );
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( mapping == nullptr )
+        {
+            CloseHandle( file );
+            return false;
+        }
+
+        void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( data == nullptr )
+        {
+            CloseHandle( mapping );
+            CloseHandle( file );
+            return false;
+        }
+
+        m_FileHandle = file;
+        m_MappingHandle = mapping;
+        m_Data = static_cast< uint8_t const* >( data );
+        m_Size = static_cast< size_t >( size.QuadPart );
+
+    #else
+
+        int file = open( filepath.c_str(), O_RDONLY );
+        if ( file < 0 )
+        {
+            return false;
+        }
+
+        struct stat info;
+        if ( fstat( file, &info ) != 0 || info.st_size == 0 )
+        {
+            close( file );
+            return false;
+        }
+
+        void* data = mmap( nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+        close( file );
+        if ( data == MAP_FAILED )
+        {
+            return false;
+        }
+
+        m_Data = static_cast< uint8_t const* >( data );
+        m_Size = (size_t)info.st_size;
+
+    #endif
+
+        return true;
+    }
+
+
+    /// @brief  unmaps the file
+    void MappedFile::Close()
+    {
+        if ( m_Data == nullptr )
+        {
+            return;
+        }
+
+    #ifdef _WIN32
+        UnmapViewOfFile( m_Data );
+        CloseHandle( m_MappingHandle );
+        CloseHandle( m_FileHandle );
+        m_MappingHandle = nullptr;
+        m_FileHandle = nullptr;
+    #else
+        munmap( const_cast< uint8_t* >( m_Data ), m_Size );
+    #endif
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+/// @file       MappedFile.h
+/// @author     Oblivion Owls Inc
+/// @brief      read-only memory mapping of a file
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+
+/// @brief  read-only memory mapping of a file
+class MappedFile
+{
+//-----------------------------------------------------------------------------
+public: // constructor / destructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  default constructor - doesn't map anything
+    MappedFile() = default;
+
+    /// @brief  unmaps the file
+    ~MappedFile();
+
+    /// @brief  move constructor
+    /// @param  other   the MappedFile to take the mapping from
+    MappedFile( MappedFile&& other ) noexcept;
+
+    /// @brief  move assignment
+    /// @param  other   the MappedFile to take the mapping from
+    /// @return reference to this MappedFile
+    MappedFile& operator =( MappedFile&& other ) noexcept;
+
+    // Prevent copying
+    MappedFile( MappedFile const& ) = delete;
+    MappedFile& operator =( MappedFile const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  maps a file into memory, unmapping any previously mapped file
+    /// @param  filepath    the file to map
+    /// @return whether the file was successfully mapped
+    bool Open( std::string const& filepath );
+
+    /// @brief  unmaps the file
+    void Close();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the contents of the mapped file
+    /// @return the contents of the mapped file, or nullptr if nothing is mapped
+    uint8_t const* GetData() const { return m_Data; }
+
+    /// @brief  gets the size of the mapped file
+    /// @return the size of the mapped file in bytes
+    size_t GetSize() const { return m_Size; }
+
+    /// @brief  gets whether a file is currently mapped
+    /// @return whether a file is currently mapped
+    bool IsOpen() const { return m_Data != nullptr; }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the contents of the mapped file
+    uint8_t const* m_Data = nullptr;
+
+    /// @brief  the size of the mapped file
+    size_t m_Size = 0;
+
+#ifdef _WIN32
+    /// @brief  the handle of the open file
+    void* m_FileHandle = nullptr;
+
+    /// @brief  the handle of the file mapping
+    void* m_MappingHandle = nullptr;
+#endif
+
+
+//-----------------------------------------------------------------------------
+};
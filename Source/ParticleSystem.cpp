@@ -14,7 +14,8 @@
 #include "ParticleSystem.h"
 #include "Emitter.h"
 #include "RenderSystem.h"   // shader
-#include "CameraSystem.h"   // projection matrix
+#include "CpuParticleBuffer.h"  // CPU benchmark
+#include "DebugSystem.h"
 
 
 //-----------------------------------------------------------------------------
@@ -24,6 +25,14 @@
 /// @brief  Called when system starts: initialize compute shader, buffers, uniforms
 void ParticleSystem::OnInit()
 {
+    // no compute shaders before GL 4.3: fall back to simulating on the CPU
+    if (!GLEW_VERSION_4_3)
+    {
+        Debug() << "WARNING: compute shaders are not supported, particles will be simulated on the CPU" << std::endl;
+        m_IsSimulatingOnCpu = true;
+        return;
+    }
+
     // shader
     Shader* CShader = new Shader("Data/shaders/particles_compute.glsl");
     Renderer()->AddShader("pCompute", CShader);
@@ -37,7 +46,6 @@ void ParticleSystem::OnInit()
     // cache the uniform locations
     m_Ut = CShader->GetUniformID("t");
     m_Udt = CShader->GetUniformID("dt");
-    m_Uproj = CShader->GetUniformID("proj");
     m_UinitIndex = CShader->GetUniformID("initIndex");
 }
 
@@ -50,50 +58,88 @@ void ParticleSystem::OnUpdate(float dt)
     if (m_Emitters.empty())
         return;
 
-    Renderer()->SetActiveShader("pCompute");
-
-    // Put all of the emitters' init data together and send it to GPU.
-    // If each emitter was to load its own data instead, executions would not be
-    // parallelized / queued.    (bindings and basic uniforms are ok)
-    if (m_InitDataDirty)
+    if (!m_IsSimulatingOnCpu)
     {
-        m_InitDataDirty = false;
-        
-        std::vector<EmitData> inits;
-        for (auto& emitter : m_Emitters)
-            inits.push_back(emitter.second->GetEmitData());
+        Renderer()->SetActiveShader("pCompute");
 
-        glBindBuffer(GL_UNIFORM_BUFFER, m_UBO);
-        glBufferData(GL_UNIFORM_BUFFER, sizeof(EmitData) * (int)inits.size(), 
-                     &inits[0], GL_DYNAMIC_DRAW);
+        // Put all of the emitters' init data together and send it to GPU.
+        // If each emitter was to load its own data instead, executions would not be
+        // parallelized / queued.    (bindings and basic uniforms are ok)
+        if (m_InitDataDirty)
+        {
+            m_InitDataDirty = false;
+            
+            std::vector<EmitData> inits;
+            for (auto& emitter : m_Emitters)
+                inits.push_back(emitter.second->GetEmitData());
+
+            glBindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+            glBufferData(GL_UNIFORM_BUFFER, sizeof(EmitData) * (int)inits.size(), 
+                         &inits[0], GL_DYNAMIC_DRAW);
+        }
     }
 
-    static float time = 0.0f;  // for the shader-side PRNG
     if (dt > 0.2f)
         dt = 0.016f;
+
+    using Clock = std::chrono::high_resolution_clock;
+    Clock::duration cpuTime = Clock::duration::zero();
+    
+    // every instance is written by each dispatch (or CPU upload), and read once when drawn
+    m_InstanceTraffic = 0;
+    for (auto& emitter : m_Emitters)
+        m_InstanceTraffic += emitter.second->GetBufferSize();
     
     m_FastForward += dt;
     while (m_FastForward >= 0.0f)
     {
         m_FastForward -= dt;
 
-        // set common uniforms : dt, time, projection matrix
-        time += dt;
-        glUniform1f(m_Udt, dt);
-        glUniform1f(m_Ut, time);
-        glUniformMatrix4fv(m_Uproj, 1, 0, &Cameras()->GetMat_WorldToClip()[0][0]);
+        // set common uniforms : dt, time
+        m_Time += dt;
+        if (!m_IsSimulatingOnCpu)
+        {
+            glUniform1f(m_Udt, dt);
+            glUniform1f(m_Ut, m_Time);
+        }
     
         // let each emitter execute compute shader for its buffers
         int index = 0;
         for (auto& emitter : m_Emitters)
         {
+            if (emitter.second->GetIsSimulatedOnCpu())
+            {
+                Clock::time_point start = Clock::now();
+                emitter.second->Update(dt);
+                cpuTime += Clock::now() - start;
+                ++index;
+                continue;
+            }
+
             glUniform1i(m_UinitIndex, index++);
             emitter.second->Update(dt);
+            m_InstanceTraffic += emitter.second->GetBufferSize();
         }
         // This makes computations of particles little slower compared to doing it
         // all in one go with single buffer. But, it's more manageable this way.
         // The other version was too OP anyway.
     }
+
+    // CPU-simulated emitters only send their results once per frame, 
+    // no matter how many steps were fast-forwarded
+    m_CpuParticleCount = 0;
+    for (auto& emitter : m_Emitters)
+    {
+        if (!emitter.second->GetIsSimulatedOnCpu())
+            continue;
+
+        Clock::time_point start = Clock::now();
+        emitter.second->UploadCpuParticles();
+        cpuTime += Clock::now() - start;
+        m_CpuParticleCount += emitter.second->GetBufferSize();
+        m_InstanceTraffic += emitter.second->GetBufferSize();
+    }
+    m_CpuUpdateMs = std::chrono::duration<double, std::milli>(cpuTime).count();
 }
 
 
@@ -111,6 +157,33 @@ void ParticleSystem::OnSceneInit()
 }
 
 
+/// @brief  Shows the CPU fallback toggle and its timing
+void ParticleSystem::DebugWindow()
+{
+    bool showWindow = GetDebugEnabled();
+
+    if (ImGui::Begin("Particle System", &showWindow))
+    {
+        if (GLEW_VERSION_4_3)
+            ImGui::Checkbox("simulate every emitter on the CPU", &m_IsSimulatingOnCpu);
+        else
+            ImGui::Text("compute shaders unsupported: simulating on the CPU");
+
+        ImGui::Text("emitters: %i", (int)m_Emitters.size());
+        ImGui::Text("CPU-simulated particles: %i", m_CpuParticleCount);
+        ImGui::Text("CPU particle time: %.3f ms", m_CpuUpdateMs);
+        ImGui::Text("instance bytes last frame: %zu (%zu as mat4 + opacity)", 
+                    m_InstanceTraffic * sizeof(Instance),
+                    m_InstanceTraffic * (sizeof(glm::mat4) + sizeof(float)));
+        if (ImGui::Button("Run CPU particle benchmark"))
+            CpuParticleBuffer::RunBenchmark();
+    }
+    ImGui::End();
+
+    SetDebugEnable(showWindow);
+}
+
+
 //-----------------------------------------------------------------------------
 //              Public methods
 //-----------------------------------------------------------------------------
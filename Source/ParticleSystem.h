@@ -43,6 +43,17 @@ public:
         int bufferSize, align1;
     };
 
+    /// @brief  Mirrors the struct on the shader. What the vertex shader needs to
+    ///         draw one particle - it builds the matrix itself. 16 bytes, instead
+    ///         of the 68 a mat4 and an opacity took.
+    struct Instance
+    {
+        glm::vec2 pos;                  // world position, parent included
+        float size;
+        unsigned int rotationOpacity;   // glm::packHalf2x16(rotation, opacity)
+    };
+    static_assert(sizeof(Instance) == 16, "Instance must match the shader's layout");
+
 
 
 //-----------------------------------------------------------------------------
@@ -64,6 +75,16 @@ public:
     /// @brief    Sets emit data dirty flag (uniform block array will be re-loaded)
     void SetEmitDataDirty() { m_InitDataDirty = true; }
 
+    /// @return   Total time simulated so far (seeds the particle PRNG)
+    __inline float GetTime() const { return m_Time; }
+
+    /// @return   Whether every emitter is simulated on the CPU instead of the compute shader
+    __inline bool GetIsSimulatingOnCpu() const { return m_IsSimulatingOnCpu; }
+
+    /// @brief              Sets whether every emitter is simulated on the CPU
+    /// @param isOnCpu      If true, no emitter uses the compute shader
+    __inline void SetIsSimulatingOnCpu(bool isOnCpu) { m_IsSimulatingOnCpu = isOnCpu; }
+
 
 //-----------------------------------------------------------------------------
 //              Virtual overrides
@@ -82,6 +103,9 @@ private:
     /// @brief  Called when scene changes - reinits fast-forward
     virtual void OnSceneInit() override;
 
+    /// @brief  Shows the CPU fallback toggle and its timing
+    virtual void DebugWindow() override;
+
 
 
 //-----------------------------------------------------------------------------
@@ -92,6 +116,18 @@ private:
     unsigned int m_UBO = 0;         /// @brief  ID of buffer used by uniform block
     bool m_InitDataDirty = true;    /// @brief  When true, re-load init data buffer
     float m_FastForward = 5.0f;     /// @brief  Fast forward 5 sec at start
+    float m_Time = 0.0f;            /// @brief  Total simulated time, for the PRNG
+
+    /// @brief  When true, every emitter is simulated on the CPU. Forced on
+    ///         when compute shaders aren't supported (pre GL 4.3).
+    bool m_IsSimulatingOnCpu = false;
+
+    int m_CpuParticleCount = 0;     /// @brief  Particles simulated on the CPU last frame
+    double m_CpuUpdateMs = 0.0;     /// @brief  Time spent on CPU particles last frame
+
+    /// @brief  Particle instances written, uploaded, and drawn last frame. For
+    ///         estimating memory bandwidth.
+    size_t m_InstanceTraffic = 0;
 
     /// @brief  All the emitters.
     std::map<int, Emitter*> m_Emitters;
@@ -99,7 +135,6 @@ private:
     /// @brief  Uniform locations
     unsigned int m_Udt = -1, 
                  m_Ut = -1,
-                 m_Uproj = -1,
                  m_UinitIndex = -1;
 
     /// @brief  Size of each work group. This is also minimum amount of particles
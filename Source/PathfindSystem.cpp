@@ -10,6 +10,8 @@
 #include "pch.h" // precompiled header has to be included first
 #include "PathfindSystem.h"
 
+#include "DebugSystem.h"
+
 
 //-----------------------------------------------------------------------------
 //              Public methods
@@ -22,35 +24,45 @@
 /// @return      Direction vector towards target(s). If out of bounds, returns <0,0>
 glm::vec2 PathfindSystem::GetDirectionAt(glm::vec2 pos) const
 {
-    if ( m_Tilemap == nullptr )
+    if ( m_Tilemap == nullptr || m_Width != m_Tilemap->GetDimensions().x )
     {
         return glm::vec2( 0.0f );
     }
 
     // get coord (2D index), check bounds
     glm::ivec2 coord = m_Tilemap->WorldPosToTileCoord(pos);
-    if (coord.x == -1)
+    if (coord.x == -1 || coord.y * m_Width + coord.x >= (int)m_Nodes.size())
+    {
+        return { 0,0 };
+    }
+
+    int parent = m_Nodes[coord.y * m_Width + coord.x].parent;
+    if (parent == -1)
     {
         return { 0,0 };
     }
 
-    glm::vec2 direction = m_Nodes[coord.y * m_Tilemap->GetDimensions().x + coord.x].direction;
-    return direction == glm::vec2(0) ? direction : glm::normalize(direction);
+    // direction: pointing at the parent node  (y-up orientation)
+    glm::vec2 direction = { parent % m_Width - coord.x, coord.y - parent / m_Width };
+    return glm::normalize(direction);
 }
 
 
 /// @brief       Gets the travel distance (in tiles) to the destination
 /// @param pos   Position from which to travel
 /// @return      Amount of tiles to travel til destination. If out of bounds, 
-///              returns -1.
+///              or unreachable, returns -1.
 int PathfindSystem::GetTravelDistanceAt(glm::vec2 pos) const
 {
-    if ( m_Tilemap != nullptr )
+    if ( m_Tilemap != nullptr && m_Width == m_Tilemap->GetDimensions().x )
     {
         glm::ivec2 coord = m_Tilemap->WorldPosToTileCoord(pos);
 
-        if (coord.x != -1)
-            return m_Nodes[coord.y * m_Tilemap->GetDimensions().x + coord.x].cost;
+        if (coord.x != -1 && coord.y * m_Width + coord.x < (int)m_Nodes.size())
+        {
+            int cost = m_Nodes[coord.y * m_Width + coord.x].cost;
+            return cost == INT_MAX ? -1 : cost;
+        }
     }
 
     return -1;
@@ -62,13 +74,12 @@ int PathfindSystem::GetTravelDistanceAt(glm::vec2 pos) const
 /// @return      Walkable or not
 bool PathfindSystem::IsWalkable(glm::vec2 pos) const
 {
-    if ( m_Tilemap != nullptr )
+    if ( m_Tilemap != nullptr && m_Width == m_Tilemap->GetDimensions().x )
     {
-        int width = m_Tilemap->GetDimensions().x;
         glm::ivec2 coord = m_Tilemap->WorldPosToTileCoord(pos);
 
-        if (coord.x != -1)
-            return m_Nodes[width * coord.y + coord.x].type != Unwalkable;
+        if (coord.x != -1 && coord.y * m_Width + coord.x < (int)m_Nodes.size())
+            return m_Nodes[m_Width * coord.y + coord.x].walkable;
     }
 
     return false;
@@ -87,8 +98,8 @@ void PathfindSystem::SetActiveTilemap(Entity* entity)
     m_Tilemap.Init(entity);
 
     if (m_Tilemap)
-        m_Tilemap->AddOnTilemapChangedCallback( GetId(), std::bind(&PathfindSystem::MarkDirty, 
-                                                                    this ) );
+        m_Tilemap->AddOnTilemapChangedCallback( GetId(), std::bind(&PathfindSystem::onTilemapChanged, this,
+                                                std::placeholders::_1, std::placeholders::_2, std::placeholders::_3) );
     MarkDirty();
 }
 
@@ -110,6 +121,84 @@ void PathfindSystem::RemoveTransformCallback(Transform* t)
 }
 
 
+/// @brief  Times a full rebuild and a single-tile repair of the flow field
+///         on the active tilemap, and writes the results to the log.
+void PathfindSystem::RunBenchmark()
+{
+    static constexpr int iterations = 20;
+
+    if (!m_Tilemap)
+    {
+        Debug() << "WARNING: PathfindSystem benchmark needs an active tilemap" << std::endl;
+        return;
+    }
+
+    // finish whatever is in flight first, so the benchmark owns both buffers
+    if (m_Thread.joinable())
+        m_Thread.join();
+    publish();
+
+    // full rebuilds
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        MarkDirty();
+        if (!startJob(false))
+        {
+            Debug() << "WARNING: PathfindSystem benchmark needs at least one active PathfinderTarget" << std::endl;
+            return;
+        }
+        publish();
+    }
+    double rebuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / iterations;
+
+    // pick a reachable tile roughly halfway along the paths, so the repair has real work to do
+    int tile = -1;
+    int bestCost = INT_MAX;
+    int targetCost = 0;
+    for (Node const& node : m_Nodes)
+        if (node.cost != INT_MAX)
+            targetCost = std::max(targetCost, node.cost / 2);
+    for (int i = 0; i < (int)m_Nodes.size(); i++)
+    {
+        if (m_Nodes[i].cost == INT_MAX || m_Nodes[i].parent == -1)
+            continue;
+        int difference = std::abs(m_Nodes[i].cost - targetCost);
+        if (difference < bestCost)
+        {
+            bestCost = difference;
+            tile = i;
+        }
+    }
+
+    // single-tile repairs: block the tile, then unblock it again
+    double repairMs = 0.0;
+    if (tile != -1)
+    {
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            m_JobFullRebuild = false;
+            m_JobChangedTiles = { { tile, false } };
+            explore();
+            m_JobPending = true;
+            publish();
+
+            m_JobFullRebuild = false;
+            m_JobChangedTiles = { { tile, true } };
+            explore();
+            m_JobPending = true;
+            publish();
+        }
+        repairMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / (2 * iterations);
+    }
+
+    glm::ivec2 dimensions = m_Tilemap->GetDimensions();
+    Debug() << "Pathfinding benchmark (" << dimensions.x << "x" << dimensions.y << " tiles): " <<
+        rebuildMs << " ms per full rebuild, " << repairMs << " ms per single-tile repair" << std::endl;
+}
+
+
 
 //-----------------------------------------------------------------------------
 //              Virtual overrides
@@ -126,6 +215,8 @@ void PathfindSystem::OnInit()
         {
             m_Thread.join();
         }
+        m_JobPending = false;
+        m_ChangedTiles.clear();
     } );
 }
 
@@ -141,8 +232,10 @@ void PathfindSystem::OnUpdate(float dt)
         if (m_Thread.joinable())
             m_Thread.join();
 
-        if (m_Dirty.load() == true)
-            m_Thread = std::thread(&PathfindSystem::explore, this);
+        publish();
+
+        if (m_Dirty.load() == true || !m_ChangedTiles.empty())
+            startJob();
     }
 
 
@@ -166,41 +259,311 @@ void PathfindSystem::OnExit()
 //              Helpers
 //-----------------------------------------------------------------------------
 
-/// @brief      Actual pathfinding. Updates all nodes. It ain't super optimized,
-///             but it doens't need to be
+/// @brief      Actual pathfinding. Runs on the background thread and builds
+///             m_BackNodes from the job snapshot.
 void PathfindSystem::explore()
 {
-    // if no targets, leave.
-    if (!GetComponents().size())
-        return;
+    if (m_JobFullRebuild)
+        rebuild();
+    else
+        repair();
+
+    m_Done.store(true);  // signal that it's finished and ready to join.
+}
 
-    m_Done.store(false);
-    m_Dirty.store(false);
 
-    // update walkability of tiles
-    m_Nodes.resize(m_Tilemap->GetTilemap().size());
-    for (int i = 0; i < m_Nodes.size(); i++)
+/// @brief      Rebuilds every node from scratch.
+void PathfindSystem::rebuild()
+{
+    m_BackNodes.resize(m_JobTiles.size());
+    for (int i = 0; i < (int)m_BackNodes.size(); i++)
+    {
+        m_BackNodes[i].walkable = isWalkableTile(m_JobTiles[i]);
+    }
+
+    rebuildFromWalkability();
+}
+
+
+/// @brief      Recomputes every node from the walkability already in
+///             m_BackNodes.
+void PathfindSystem::rebuildFromWalkability()
+{
+    for (Node& node : m_BackNodes)
+    {
+        node = { INT_MAX, -1, 0, node.walkable };
+    }
+
+    // init target destinations
+    std::vector<int> seeds;
+    for (Source const& source : m_JobSources)
+    {
+        Node& node = m_BackNodes[source.index];
+        node.cost = 0;
+        node.priority = source.priority * 2;  // lower priority = higher number
+        seeds.push_back(source.index);
+    }
+
+    propagate(seeds, false);
+}
+
+
+/// @brief      Copies the published field and repairs only the nodes
+///             affected by the changed tiles. The result always matches a
+///             full rebuild: if the repair would change which priority a
+///             still-valid node carries, the nodes downstream of it could
+///             get more expensive without being revisited, so it falls back
+///             to rebuilding every node.
+void PathfindSystem::repair()
+{
+    // tile directions to pick from: counter clockwise, starting from left. (it's y-down)
+    static glm::ivec2 const dir[8] = { {-1,0}, {-1,1}, {0,1}, {1,1}, {1,0}, {1,-1}, {0,-1}, {-1,-1} };
+
+    m_BackNodes = m_Nodes;
+
+    int width = m_JobWidth;
+    int height = (int)m_BackNodes.size() / width;
+    auto inBounds = [width, height](int x, int y) { return x >= 0 && y >= 0 && x < width && y < height; };
+
+    std::vector<int> seeds;
+    std::vector<int> invalidated;
+
+    for (auto const& [indx, walkable] : m_JobChangedTiles)
     {
-        m_Nodes[i].type = Unwalkable;
-        // m_Nodes[i].direction = glm::ivec2(0);
+        if (m_BackNodes[indx].walkable == walkable)
+            continue;
+
+        m_BackNodes[indx].walkable = walkable;
+        int x = indx % width;
+        int y = indx / width;
 
-        for (int j : m_Walkables)
+        if (walkable)
         {
-            if (m_Tilemap->GetTilemap()[i] == j)
+            // costs can only go down: re-run the wavefront from the new node's
+            // neighbors (which also covers diagonals the new tile unblocked)
+            for (glm::ivec2 const& d : dir)
             {
-                m_Nodes[i].type = Undiscovered;
-                break;
+                if (inBounds(x + d.x, y + d.y) && m_BackNodes[(y + d.y) * width + x + d.x].cost != INT_MAX)
+                    seeds.push_back((y + d.y) * width + x + d.x);
             }
+            continue;
+        }
+
+        // costs can only go up: invalidate every node whose path ran through this
+        // tile, or cut diagonally past its corner
+        size_t first = invalidated.size();
+        invalidated.push_back(indx);
+        for (glm::ivec2 const& d : dir)
+        {
+            int i = x + d.x, j = y + d.y;
+            if (!inBounds(i, j))
+                continue;
+
+            int parent = m_BackNodes[j * width + i].parent;
+            if (parent == -1)
+                continue;
+
+            // a diagonal step cuts past the two corners (px, j) and (i, py)
+            int px = parent % width, py = parent / width;
+            if (px != i && py != j && ((px == x && j == y) || (i == x && py == y)))
+                invalidated.push_back(j * width + i);
+        }
+
+        for (size_t n = first; n < invalidated.size(); n++)
+        {
+            int current = invalidated[n];
+            if (m_BackNodes[current].cost == INT_MAX)
+                continue;
+
+            m_BackNodes[current].cost = INT_MAX;
+            m_BackNodes[current].parent = -1;
+            m_BackNodes[current].priority = 0;
+
+            // children are the neighbors that point back at this node
+            int cx = current % width, cy = current / width;
+            for (glm::ivec2 const& d : dir)
+            {
+                if (inBounds(cx + d.x, cy + d.y) && m_BackNodes[(cy + d.y) * width + cx + d.x].parent == current)
+                    invalidated.push_back((cy + d.y) * width + cx + d.x);
+            }
+        }
+    }
+
+    // destinations always stay at zero cost
+    m_Reached.assign(m_BackNodes.size(), false);
+    for (Source const& source : m_JobSources)
+    {
+        Node& node = m_BackNodes[source.index];
+        if (node.cost != 0)
+        {
+            node.cost = 0;
+            node.parent = -1;
+            node.priority = source.priority * 2;
+            m_Reached[source.index] = true;
+        }
+        seeds.push_back(source.index);
+    }
+
+    // refill the invalidated region from its still-valid border
+    for (int current : invalidated)
+    {
+        int cx = current % width, cy = current / width;
+        for (glm::ivec2 const& d : dir)
+        {
+            if (inBounds(cx + d.x, cy + d.y) && m_BackNodes[(cy + d.y) * width + cx + d.x].cost != INT_MAX)
+                seeds.push_back((cy + d.y) * width + cx + d.x);
         }
     }
 
+    if (!propagate(seeds, true))
+        rebuildFromWalkability();
+}
+
+
+/// @brief          Runs the Dijkstra wavefront outwards from the given nodes.
+///                 Costs are small integers, so a circular bucket queue is used
+///                 instead of a heap. Seeds are fed in in cost order as the
+///                 wavefront reaches them. Equal-cost paths are broken by
+///                 priority, then by parent index, so the field doesn't depend
+///                 on the order nodes were reached in.
+/// @param seeds    Indices of nodes whose costs are already set.
+/// @param repairing Whether the other nodes hold a previous field. If so,
+///                 gives up as soon as a node the wavefront didn't set
+///                 would change priority (see repair()).
+/// @return         Whether the wavefront finished
+bool PathfindSystem::propagate(std::vector<int>& seeds, bool repairing)
+{
     // tile directions to pick from: counter clockwise, starting from left. (it's y-down)
-    glm::ivec2 dir[8] = { {-1,0}, {-1,1}, {0,1}, {1,1}, {1,0}, {1,-1}, {0,-1}, {-1,-1} };
+    static glm::ivec2 const dir[8] = { {-1,0}, {-1,1}, {0,1}, {1,1}, {1,0}, {1,-1}, {0,-1}, {-1,-1} };
 
-    int width = m_Tilemap->GetDimensions().x;
-    int height = (int)m_Nodes.size() / width;
+    if (seeds.empty())
+        return true;
 
-    // init target destinations
+    int width = m_JobWidth;
+    int height = (int)m_BackNodes.size() / width;
+
+    // the widest step any node can take decides how many buckets are live at once
+    unsigned maxPriority = 0;
+    for (int seed : seeds)
+        maxPriority = std::max(maxPriority, m_BackNodes[seed].priority);
+    int bucketCount = 14 * (maxPriority + 1) + 1;
+
+    if ((int)m_Buckets.size() < bucketCount)
+        m_Buckets.resize(bucketCount);
+    for (std::vector<int>& bucket : m_Buckets)
+        bucket.clear();
+
+    // drop seeds that were invalidated after being queued, then order the rest by cost
+    seeds.erase(std::remove_if(seeds.begin(), seeds.end(), [this](int i) { return m_BackNodes[i].cost == INT_MAX; }), seeds.end());
+    std::sort(seeds.begin(), seeds.end(), [this](int a, int b)
+    {
+        return m_BackNodes[a].cost != m_BackNodes[b].cost ? m_BackNodes[a].cost < m_BackNodes[b].cost : a < b;
+    });
+    seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+    if (seeds.empty())
+        return true;
+
+    size_t nextSeed = 0;
+    int pending = 0;
+    int cost = m_BackNodes[seeds[0]].cost;
+
+    while (true)
+    {
+        // feed in seeds that now fit in the window of live buckets
+        while (nextSeed < seeds.size() && m_BackNodes[seeds[nextSeed]].cost < cost + bucketCount)
+        {
+            m_Buckets[m_BackNodes[seeds[nextSeed]].cost % bucketCount].push_back(seeds[nextSeed]);
+            nextSeed++;
+            pending++;
+        }
+
+        if (pending == 0)
+        {
+            if (nextSeed == seeds.size())
+                break;
+
+            // nothing live: skip ahead to the next seed
+            cost = m_BackNodes[seeds[nextSeed]].cost;
+            continue;
+        }
+
+        std::vector<int>& bucket = m_Buckets[cost % bucketCount];
+        for (size_t b = 0; b < bucket.size(); b++)
+        {
+            int indx = bucket[b];
+            pending--;
+
+            // stale entry: this node was reached more cheaply since it was queued
+            if (m_BackNodes[indx].cost != cost)
+                continue;
+
+            int x = indx % width;
+            int y = indx / width;
+            unsigned priority = m_BackNodes[indx].priority;
+
+            for (int k = 0; k < 8; k++)
+            {
+                // i and j are x and y of this neighbor node
+                int i = x + dir[k].x;
+                int j = y + dir[k].y;
+
+                if (i < 0 || j < 0 || i >= width || j >= height || !m_BackNodes[j * width + i].walkable)
+                    continue;
+
+                // nodes don't point at corners: a diagonal needs both non-diagonals around it to be walkable
+                if ((k & 1) && (!m_BackNodes[y * width + i].walkable || !m_BackNodes[j * width + x].walkable))
+                    continue;
+
+                // 14 if it's diagonal from current, 10 if it's straight
+                int new_cost = cost + ((k & 1) ? 14 : 10) * (priority + 1);
+
+                Node& node = m_BackNodes[j * width + i];
+                bool cheaper = new_cost < node.cost;
+                bool tieWins = new_cost == node.cost &&
+                    (priority != node.priority ? priority < node.priority : indx < node.parent);
+                if (!cheaper && !tieWins)
+                    continue;
+
+                // a node from the previous field that changes priority changes the cost of
+                // every step out of it, which the nodes downstream of it won't see
+                if (repairing && !m_Reached[j * width + i] && node.cost != INT_MAX && node.priority != priority)
+                    return false;
+
+                node.parent = indx;
+                node.priority = priority;
+                if (repairing)
+                    m_Reached[j * width + i] = true;
+
+                // a tie leaves the cost alone: the node is either queued at it already, or
+                // (from the previous field, with the same priority) its steps don't change
+                if (cheaper)
+                {
+                    node.cost = new_cost;
+                    m_Buckets[new_cost % bucketCount].push_back(j * width + i);
+                    pending++;
+                }
+            }
+        }
+        bucket.clear();
+
+        cost++;
+    }
+
+    return true;
+}
+
+
+/// @brief          Snapshots the tilemap and destinations and starts a job.
+/// @param thread   Whether to run the job on the background thread
+/// @return         Whether a job was started
+bool PathfindSystem::startJob(bool thread)
+{
+    glm::ivec2 dimensions = m_Tilemap->GetDimensions();
+    if (dimensions.x <= 0 || dimensions.y <= 0)
+        return false;
+
+    // snapshot destinations, so the worker never touches components
+    m_JobSources.clear();
     for (PathfinderTarget const* target : GetComponents())
     {
         if (!target->GetActive() || !target->GetParentTransform())
@@ -208,113 +571,82 @@ void PathfindSystem::explore()
 
         glm::ivec2 tile = m_Tilemap->WorldPosToTileCoord(target->GetParentTransform()->GetTranslation());
         if (tile.x != -1)
-        {
-            int indx = tile.y * width + tile.x;
-            m_Nodes[indx].type = Seen;
-            m_Nodes[indx].direction = { 0,0 };
-            m_Nodes[indx].cost = 0;
-            m_Nodes[indx].priority = target->GetPriority() * 2;  // lower priority = higher number
-        }
+            m_JobSources.push_back({ tile.y * dimensions.x + tile.x, target->GetPriority() });
     }
 
+    // if no targets, leave. (stays dirty until there are some)
+    if (m_JobSources.empty())
+        return false;
 
-    // keep going as long as at least one seen node is found
-    bool found = true;
+    m_JobWidth = dimensions.x;
+    m_JobFullRebuild = m_Dirty.load() || m_Width != dimensions.x || (int)m_Nodes.size() != dimensions.x * dimensions.y;
+    m_Dirty.store(false);
 
-    while (found)
+    if (m_JobFullRebuild)
+    {
+        m_JobTiles = m_Tilemap->GetTilemap();
+    }
+    else
     {
-        found = false;
+        m_JobChangedTiles.clear();
+        for (int indx : m_ChangedTiles)
+            m_JobChangedTiles.push_back({ indx, isWalkableTile(m_Tilemap->GetTile({ indx % dimensions.x, indx / dimensions.x })) });
+    }
+    m_ChangedTiles.clear();
 
-        for (int y = 0; y < height; y++)
-        {
-            for (int x = 0; x < width; x++)
-            {
-                int indx = y * width + x;
-                // only explore seen nodes.
-                if (m_Nodes[indx].type != Seen)
-                    continue;
+    m_JobPending = true;
+    m_Done.store(false);
 
-                m_Nodes[indx].type = Explored;
-                found = true;
+    if (thread)
+        m_Thread = std::thread(&PathfindSystem::explore, this);
+    else
+        explore();
 
+    return true;
+}
 
-                // and now the tough part: analyze nodes around the newly explored one.
 
-                int k = 0;                              // 8 nodes around current one
-                bool this_seen, previous_seen = false;  // for corner-checking (later)
+/// @brief          Swaps the finished field in, if there is one.
+void PathfindSystem::publish()
+{
+    if (!m_JobPending)
+        return;
 
-                // this looks at all neighbor nodes one at a time
-                while (k < 8)
-                {
-                    // i and j are x and y of this neighbor node
-                    int i = x + dir[k].x;
-                    int j = y + dir[k].y;
-
-                    // check bounds
-                    if (i < 0 || j < 0 || i >= width || j >= height
-                        || m_Nodes[j * width + i].type == Unwalkable)
-                        this_seen = false;
-                    else
-                    {
-                        this_seen = true;
-
-                        // cost for the node we're currently looking at:
-                        // 14 if it's diagonal from current, 10 if it's straight
-                        int new_cost = m_Nodes[indx].cost + ((k & 1) ? 14 : 10)
-                            * (m_Nodes[indx].priority + 1);
-                        int reverse_cost = 2 * m_Nodes[indx].cost - new_cost;
-
-                        // set new values if neighbor node isn't seen yet.
-                        // or update it if new cost is lower.
-                        Node& node = m_Nodes[j * width + i];
-
-                        if (node.type == Undiscovered || node.cost > new_cost)
-                        {
-                            node.type = Seen;
-                            node.cost = new_cost;
-                            // direction: pointing back at current node  (y-up orientation)
-                            node.direction = { -dir[k].x, dir[k].y };
-                            node.priority = m_Nodes[indx].priority;
-                        }
-                        else if (node.cost < reverse_cost)
-                            m_Nodes[indx].direction = { dir[k].x, -dir[k].y };
-                    }
-
-                    // The following is to ensure nodes don't point at corners (diagonally).
-                    // Diagonal neighbor will be seen only if both non-diagonals around it were seen.
-
-                    // even: non-diagonal neighbors.
-                    if (~k & 1)
-                    {
-                        // if this and previous were seen, step back to the diagonal
-                        // between them. Otherwise proceed to next non-diagonal.
-                        if (this_seen && previous_seen)
-                            k -= 1;
-                        else
-                            k += 2;
-
-                        previous_seen = this_seen;
-                    }
-                    else
-                    {
-                        // odd: diagonals. If this diagonal was seen just now, that means
-                        // the next non-diagonal is already seen too. Skip it, and skip
-                        // the diagonal after it.
-                        k += 3;
-                    }
-
-                    // after all that skipping around, backtrack to get the last node too
-                    if (k == 8 && previous_seen && x - 1 >= 0   // (left of center node)
-                        && m_Nodes[indx - 1].type == Seen)
-                        k = 7;
-
-                } // while k<8  (assessing nodes around current one)
-
-            } // for x
-        } // for y
-    } // while found
+    std::swap(m_Nodes, m_BackNodes);
+    m_Width = m_JobWidth;
+    m_JobPending = false;
+}
 
-    m_Done.store(true);  // signal that it's finished and ready to join.
+
+/// @brief          Called whenever the navigated tilemap changes.
+/// @param tilemap  The tilemap that changed
+/// @param tilePos  The tile that changed, (-1,-1) if the whole tilemap changed
+/// @param previous The previous value of the tile
+void PathfindSystem::onTilemapChanged(Tilemap<int>* tilemap, glm::ivec2 const& tilePos, int const& previous)
+{
+    if (tilePos.x == -1)
+    {
+        MarkDirty();
+        return;
+    }
+
+    if (isWalkableTile(previous) != isWalkableTile(tilemap->GetTile(tilePos)))
+        m_ChangedTiles.push_back(tilePos.y * tilemap->GetDimensions().x + tilePos.x);
+}
+
+
+/// @brief          Checks whether a tile ID is walkable.
+/// @param tile     Tile ID
+/// @return         Walkable or not
+bool PathfindSystem::isWalkableTile(int tile) const
+{
+    for (int j : m_Walkables)
+    {
+        if (tile == j)
+            return true;
+    }
+
+    return false;
 }
 
 
@@ -328,6 +660,7 @@ void PathfindSystem::explore()
 ReadMethodMap< ISerializable > const& PathfindSystem::GetReadMethods() const
 {
     static ReadMethodMap< PathfindSystem > const readMethods = {
+        { "SpatialIndexCellSize", &PathfindSystem::readSpatialIndexCellSize }
     };
     return (ReadMethodMap< ISerializable > const&)readMethods;
 }
@@ -339,6 +672,8 @@ nlohmann::ordered_json PathfindSystem::Write() const
 {
     nlohmann::ordered_json data;
 
+    writeSpatialIndexCellSize( &data );
+
     return data;
 }
 
@@ -61,6 +61,10 @@ public:
     /// @param t  Transform component
     void RemoveTransformCallback(Transform* t);
 
+    /// @brief  Times a full rebuild and a single-tile repair of the flow field
+    ///         on the active tilemap, and writes the results to the log.
+    void RunBenchmark();
+
 
 //-----------------------------------------------------------------------------
 //              Virtual overrides
@@ -85,24 +89,63 @@ private:
 //-----------------------------------------------------------------------------
 private:
 
-    /// @brief  Enum of node types, used by the algo.
-    enum Type { Unwalkable, Undiscovered, Seen, Explored };
-
     /// @brief  Struct used by the algo. Each node corresponds to a tile.
     struct Node
     {
-        Type type;              /// @brief  Node type (enum)  TODO: checking this for each node when iterating is cache-inefficient
-        int cost;               /// @brief  How far of a walk from destination
-        glm::ivec2 direction;   /// @brief  Unit vector pointing toward destination
+        int cost;               /// @brief  How far of a walk from destination (INT_MAX if unreachable)
+        int parent;             /// @brief  Index of the next node towards destination (-1 if none)
         unsigned priority;      /// @brief  Higher number = higher priority
+        bool walkable;          /// @brief  Whether the tile can be walked on
+    };
+
+    /// @brief  Destination snapshot taken when a job starts
+    struct Source
+    {
+        int index;              /// @brief  Index of the destination's node
+        unsigned priority;      /// @brief  Priority of the destination
     };
 
     /// @brief   Cached tilemap reference (map to navigate)
     ComponentReference< Tilemap<int> > m_Tilemap;
 
-    /// @brief   Array of nodes for navigation. Corresponds to tilemap.
+    /// @brief   Array of nodes for navigation. Corresponds to tilemap. Only
+    ///          read by the main thread, and only swapped while no job runs.
     std::vector<Node> m_Nodes;
 
+    /// @brief   Width of the tilemap m_Nodes was built from
+    int m_Width = 0;
+
+    /// @brief   Nodes being built by the background thread. Swapped with
+    ///          m_Nodes once finished, so readers never see a half-built field.
+    std::vector<Node> m_BackNodes;
+
+    /// @brief   Indices of tiles whose walkability changed since the last job
+    std::vector<int> m_ChangedTiles;
+
+    /// @brief   Snapshot of the tiles, taken when a full rebuild job starts
+    std::vector<int> m_JobTiles;
+
+    /// @brief   Tiles to repair (index, walkable), taken when a repair job starts
+    std::vector< std::pair<int, bool> > m_JobChangedTiles;
+
+    /// @brief   Snapshot of the destinations, taken when a job starts
+    std::vector<Source> m_JobSources;
+
+    /// @brief   Width of the tilemap when the job started
+    int m_JobWidth = 0;
+
+    /// @brief   Whether the current job rebuilds the whole field
+    bool m_JobFullRebuild = true;
+
+    /// @brief   Whether a job was started and its result hasn't been published yet
+    bool m_JobPending = false;
+
+    /// @brief   Bucket queue used by the wavefront (buckets indexed by cost)
+    std::vector< std::vector<int> > m_Buckets;
+
+    /// @brief   Nodes a repair's wavefront has set (the rest still hold the previous field)
+    std::vector<bool> m_Reached;
+
     /// @brief  Tile IDs of "not walls"
     std::vector<int> m_Walkables;
 
@@ -122,9 +165,48 @@ private:
 //-----------------------------------------------------------------------------
 private:
 
-    /// @brief      Actual pathfinding. Updates all nodes.
+    /// @brief      Actual pathfinding. Runs on the background thread and
+    ///             builds m_BackNodes from the job snapshot.
     void explore();
 
+    /// @brief      Rebuilds every node from scratch.
+    void rebuild();
+
+    /// @brief      Recomputes every node from the walkability already in
+    ///             m_BackNodes.
+    void rebuildFromWalkability();
+
+    /// @brief      Copies the published field and repairs only the nodes
+    ///             affected by the changed tiles. Falls back to a rebuild
+    ///             when a repair wouldn't match one.
+    void repair();
+
+    /// @brief          Runs the Dijkstra wavefront outwards from the given nodes.
+    /// @param seeds    Indices of nodes whose costs are already set.
+    /// @param repairing Whether the other nodes hold a previous field that
+    ///                 must not change priority
+    /// @return         Whether the wavefront finished
+    bool propagate(std::vector<int>& seeds, bool repairing);
+
+    /// @brief          Snapshots the tilemap and destinations and starts a job.
+    /// @param thread   Whether to run the job on the background thread
+    /// @return         Whether a job was started
+    bool startJob(bool thread = true);
+
+    /// @brief          Swaps the finished field in, if there is one.
+    void publish();
+
+    /// @brief          Called whenever the navigated tilemap changes.
+    /// @param tilemap  The tilemap that changed
+    /// @param tilePos  The tile that changed, (-1,-1) if the whole tilemap changed
+    /// @param previous The previous value of the tile
+    void onTilemapChanged(Tilemap<int>* tilemap, glm::ivec2 const& tilePos, int const& previous);
+
+    /// @brief          Checks whether a tile ID is walkable.
+    /// @param tile     Tile ID
+    /// @return         Walkable or not
+    bool isWalkableTile(int tile) const;
+
 
 
 //-----------------------------------------------------------------------------
@@ -418,7 +418,7 @@
     /// @param  focused whether the window is focused
     void PlatformSystem::glfwWindowFocusCallback( GLFWwindow* window, int focused )
     {
-        Debug() << "Window focus: " << focused << std::endl;
+        LOG_VERBOSE << "Window focus: " << focused << std::endl;
 
         for ( auto& [ key, callback ] : Platform()->m_OnFocusChangedCallbacks )
         {
@@ -351,7 +351,7 @@
             if (base->CanWin())
             {
                 Events()->BroadcastEvent< std::string >(m_EventNameWin);
-                Debug() << "Event Emitted: " << m_EventNameWin << std::endl;
+                LOG_VERBOSE << "Event Emitted: " << m_EventNameWin << std::endl;
                 base->GetEntity()->GetComponent<Lifetime>()->GetLifetime()->SetCurrent(1.0);
                 base->PlayWinSound();
                 m_Health->Reset();
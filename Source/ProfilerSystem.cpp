@@ -0,0 +1,470 @@
+/// @file       ProfilerSystem.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      System which records timed zones of each frame and displays / exports them
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "ProfilerSystem.h"
+
+#include "DebugSystem.h"
+
+#include "implot.h"
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the current time in the profiler's timebase
+    /// @return nanoseconds since the profiler was created
+    int64_t ProfilerSystem::GetTime() const
+    {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >(
+            std::chrono::steady_clock::now() - m_Epoch
+        ).count();
+    }
+
+
+    /// @brief  records a completed zone
+    /// @param  name        the name of the zone
+    /// @param  start       when the zone started
+    /// @param  end         when the zone ended
+    /// @param  depth       how many zones the zone was nested inside of
+    void ProfilerSystem::Record( char const* name, int64_t start, int64_t end, uint32_t depth )
+    {
+        // claim a slot - the oldest sample is overwritten once the buffer wraps
+        uint64_t index = m_WriteIndex.fetch_add( 1, std::memory_order_relaxed );
+        Slot& slot = m_Slots[ index & ( s_SampleCapacity - 1 ) ];
+
+        // mark the slot as being written so readers skip it
+        slot.M_Sequence.store( 2 * index + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        slot.M_Sample = { name, start, end, GetThreadId(), depth };
+
+        // publish the sample
+        slot.M_Sequence.store( 2 * ( index + 1 ), std::memory_order_release );
+    }
+
+
+    /// @brief  marks the start of a new frame
+    void ProfilerSystem::MarkFrame()
+    {
+        m_FrameStarts[ m_FrameCount & ( s_FrameCapacity - 1 ) ] = GetTime();
+        ++m_FrameCount;
+
+        m_MainThreadId = GetThreadId();
+    }
+
+
+    /// @brief  writes every sample currently in the buffer to a Chrome trace_event JSON file
+    /// @param  filepath    the file to write to
+    /// @note   open the file in chrome://tracing or https://ui.perfetto.dev
+    void ProfilerSystem::ExportTrace( std::string const& filepath ) const
+    {
+        std::vector< Sample > samples;
+        collectSamples( INT64_MIN, INT64_MAX, samples );
+
+        nlohmann::ordered_json events = nlohmann::ordered_json::array();
+
+        for ( Sample const& sample : samples )
+        {
+            nlohmann::ordered_json event;
+            event[ "name" ] = sample.M_Name;
+            event[ "cat"  ] = "zone";
+            event[ "ph"   ] = "X";
+            event[ "ts"   ] = sample.M_Start / 1000.0;
+            event[ "dur"  ] = ( sample.M_End - sample.M_Start ) / 1000.0;
+            event[ "pid"  ] = 0;
+            event[ "tid"  ] = sample.M_ThreadId;
+            events.push_back( std::move( event ) );
+        }
+
+        // mark the start of each remembered frame
+        uint64_t firstFrame = m_FrameCount > s_FrameCapacity ? m_FrameCount - s_FrameCapacity : 0;
+        for ( uint64_t frame = firstFrame; frame < m_FrameCount; ++frame )
+        {
+            nlohmann::ordered_json event;
+            event[ "name" ] = "Frame";
+            event[ "ph"   ] = "i";
+            event[ "s"    ] = "g";
+            event[ "ts"   ] = m_FrameStarts[ frame & ( s_FrameCapacity - 1 ) ] / 1000.0;
+            event[ "pid"  ] = 0;
+            event[ "tid"  ] = m_MainThreadId;
+            events.push_back( std::move( event ) );
+        }
+
+        nlohmann::ordered_json json;
+        json[ "traceEvents"     ] = std::move( events );
+        json[ "displayTimeUnit" ] = "ms";
+
+        std::ofstream file( filepath );
+        if ( file.is_open() == false )
+        {
+            Debug() << "WARNING: unable to open file \"" << filepath << "\" to export profiler trace" << std::endl;
+            return;
+        }
+        file << json << std::endl;
+
+        Debug() << "Exported " << samples.size() << " profiler samples to \"" << filepath << "\"" << std::endl;
+    }
+
+    /// @brief  writes every sample currently in the buffer to the configured trace file
+    void ProfilerSystem::ExportTrace() const
+    {
+        ExportTrace( m_TraceFilepath );
+    }
+
+
+    /// @brief  gets the profiler's id of the calling thread
+    /// @return the id of the calling thread
+    uint32_t ProfilerSystem::GetThreadId()
+    {
+        static std::atomic< uint32_t > s_NextThreadId = 0;
+        static thread_local uint32_t const s_ThreadId = s_NextThreadId.fetch_add( 1, std::memory_order_relaxed );
+        return s_ThreadId;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  copies every valid sample in the buffer that lies within a time range
+    /// @param  start   the start of the time range
+    /// @param  end     the end of the time range
+    /// @param  samples vector to append the samples to
+    void ProfilerSystem::collectSamples( int64_t start, int64_t end, std::vector< Sample >& samples ) const
+    {
+        uint64_t writeIndex = m_WriteIndex.load( std::memory_order_acquire );
+        uint64_t firstIndex = writeIndex > s_SampleCapacity ? writeIndex - s_SampleCapacity : 0;
+
+        for ( uint64_t index = firstIndex; index < writeIndex; ++index )
+        {
+            Slot const& slot = m_Slots[ index & ( s_SampleCapacity - 1 ) ];
+
+            // skip slots which are mid-write or have already been overwritten
+            uint64_t sequence = slot.M_Sequence.load( std::memory_order_acquire );
+            if ( sequence != 2 * ( index + 1 ) )
+            {
+                continue;
+            }
+
+            Sample sample = slot.M_Sample;
+
+            // make sure the slot wasn't overwritten while it was being copied
+            std::atomic_thread_fence( std::memory_order_acquire );
+            if ( slot.M_Sequence.load( std::memory_order_relaxed ) != sequence )
+            {
+                continue;
+            }
+
+            if ( sample.M_Start >= start && sample.M_End <= end )
+            {
+                samples.push_back( sample );
+            }
+        }
+    }
+
+
+    /// @brief  displays the inspected frame as a flame graph
+    /// @param  frameStart  when the inspected frame started
+    /// @param  frameEnd    when the inspected frame ended
+    void ProfilerSystem::inspectFlameGraph( int64_t frameStart, int64_t frameEnd ) const
+    {
+        uint32_t maxDepth = 0;
+        for ( Sample const& sample : m_InspectedSamples )
+        {
+            if ( sample.M_ThreadId == m_MainThreadId )
+            {
+                maxDepth = std::max( maxDepth, sample.M_Depth );
+            }
+        }
+
+        if ( ImPlot::BeginPlot( "##Flame Graph", ImVec2( -1, 40.0f + 20.0f * ( maxDepth + 1 ) ), ImPlotFlags_NoLegend | ImPlotFlags_NoMenus ) )
+        {
+            ImPlot::SetupAxes( "ms", nullptr, 0, ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_Invert );
+            ImPlot::SetupAxisLimits( ImAxis_X1, 0.0, ( frameEnd - frameStart ) / 1e6, ImPlotCond_Always );
+            ImPlot::SetupAxisLimits( ImAxis_Y1, 0.0, maxDepth + 1.0, ImPlotCond_Always );
+            ImPlot::SetupFinish();
+
+            ImDrawList* drawList = ImPlot::GetPlotDrawList();
+            ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+            bool hovered = ImPlot::IsPlotHovered();
+
+            ImPlot::PushPlotClipRect();
+            for ( Sample const& sample : m_InspectedSamples )
+            {
+                if ( sample.M_ThreadId != m_MainThreadId )
+                {
+                    continue;
+                }
+
+                double startMs = ( sample.M_Start - frameStart ) / 1e6;
+                double endMs   = ( sample.M_End   - frameStart ) / 1e6;
+
+                ImVec2 min = ImPlot::PlotToPixels( startMs, sample.M_Depth );
+                ImVec2 max = ImPlot::PlotToPixels( endMs, sample.M_Depth + 1.0 );
+                ImVec2 topLeft     = ImVec2( std::min( min.x, max.x ), std::min( min.y, max.y ) );
+                ImVec2 bottomRight = ImVec2( std::max( min.x, max.x ), std::max( min.y, max.y ) );
+
+                // color each zone by name so the same zone is the same color every frame
+                size_t hash = std::hash< std::string_view >()( sample.M_Name );
+                ImVec4 color = ImPlot::GetColormapColor( (int)( hash % ImPlot::GetColormapSize() ) );
+
+                drawList->AddRectFilled( topLeft, bottomRight, ImGui::GetColorU32( color ) );
+                drawList->AddRect( topLeft, bottomRight, IM_COL32( 0, 0, 0, 128 ) );
+
+                // only label zones wide enough to read
+                if ( bottomRight.x - topLeft.x > ImGui::CalcTextSize( sample.M_Name ).x + 4.0f )
+                {
+                    drawList->AddText( ImVec2( topLeft.x + 2.0f, topLeft.y + 2.0f ), IM_COL32( 0, 0, 0, 255 ), sample.M_Name );
+                }
+
+                if (
+                    hovered &&
+                    mouse.x >= startMs && mouse.x <= endMs &&
+                    mouse.y >= sample.M_Depth && mouse.y <= sample.M_Depth + 1.0
+                )
+                {
+                    ImGui::SetTooltip( "%s\n%.3f ms", sample.M_Name, endMs - startMs );
+                }
+            }
+            ImPlot::PopPlotClipRect();
+
+            ImPlot::EndPlot();
+        }
+    }
+
+
+    /// @brief  displays the time spent in each System in the inspected frame as a bar chart
+    void ProfilerSystem::inspectSystemTimes()
+    {
+        m_InspectedNames.clear();
+        m_InspectedTimes.clear();
+
+        // System zones are nested directly inside the Update and FixedUpdate zones
+        for ( Sample const& sample : m_InspectedSamples )
+        {
+            if ( sample.M_ThreadId != m_MainThreadId || sample.M_Depth != 1 )
+            {
+                continue;
+            }
+
+            double ms = ( sample.M_End - sample.M_Start ) / 1e6;
+
+            auto it = std::find( m_InspectedNames.begin(), m_InspectedNames.end(), sample.M_Name );
+            if ( it == m_InspectedNames.end() )
+            {
+                m_InspectedNames.push_back( sample.M_Name );
+                m_InspectedTimes.push_back( ms );
+            }
+            else
+            {
+                m_InspectedTimes[ it - m_InspectedNames.begin() ] += ms;
+            }
+        }
+
+        int count = (int)m_InspectedNames.size();
+        if ( count == 0 )
+        {
+            ImGui::Text( "no System zones recorded this frame" );
+            return;
+        }
+
+        if ( ImPlot::BeginPlot( "##System Times", ImVec2( -1, 20.0f + 16.0f * count ), ImPlotFlags_NoLegend | ImPlotFlags_NoMenus ) )
+        {
+            ImPlot::SetupAxes( "ms", nullptr, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_Invert );
+            ImPlot::SetupAxisLimits( ImAxis_Y1, -0.5, count - 0.5, ImPlotCond_Always );
+            ImPlot::SetupAxisTicks( ImAxis_Y1, 0.0, count - 1.0, count, m_InspectedNames.data() );
+
+            ImPlot::PlotBars( "ms", m_InspectedTimes.data(), count, 0.67, 0.0, ImPlotBarsFlags_Horizontal );
+
+            ImPlot::EndPlot();
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: inspection
+//-----------------------------------------------------------------------------
+
+
+    /// @brief Gets Called by the Debug system to display debug information
+    void ProfilerSystem::DebugWindow()
+    {
+        bool windowOpen = GetDebugEnabled();
+
+        if ( ImGui::Begin( "Profiler", &windowOpen ) )
+        {
+        #if PROFILER_ENABLED == 0
+            ImGui::TextColored( ImVec4( 1, 0.5f, 0, 1 ), "profiling is compiled out of this configuration" );
+        #endif
+
+            bool recording = GetRecording();
+            if ( ImGui::Checkbox( "Recording", &recording ) )
+            {
+                SetRecording( recording );
+            }
+
+            ImGui::SameLine();
+            if ( ImGui::Button( "Export Chrome Trace" ) )
+            {
+                ExportTrace();
+            }
+
+            ImGui::InputText( "Trace File", &m_TraceFilepath );
+
+            int maxOffset = (int)std::min< uint64_t >( s_FrameCapacity - 2, m_FrameCount < 2 ? 0 : m_FrameCount - 2 );
+            ImGui::SliderInt( "Frames Ago", &m_InspectedFrameOffset, 0, maxOffset );
+            m_InspectedFrameOffset = std::clamp( m_InspectedFrameOffset, 0, maxOffset );
+
+            if ( m_FrameCount >= 2 )
+            {
+                uint64_t frame = m_FrameCount - 2 - m_InspectedFrameOffset;
+                int64_t frameStart = m_FrameStarts[ frame & ( s_FrameCapacity - 1 ) ];
+                int64_t frameEnd   = m_FrameStarts[ ( frame + 1 ) & ( s_FrameCapacity - 1 ) ];
+
+                m_InspectedSamples.clear();
+                collectSamples( frameStart, frameEnd, m_InspectedSamples );
+
+                ImGui::Text( "frame time: %.3f ms", ( frameEnd - frameStart ) / 1e6 );
+                ImGui::Text( "samples recorded: %llu", (unsigned long long)m_WriteIndex.load( std::memory_order_relaxed ) );
+
+                inspectFlameGraph( frameStart, frameEnd );
+                inspectSystemTimes();
+            }
+        }
+        ImGui::End();
+
+        SetDebugEnable( windowOpen );
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: reading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  reads whether zones are recorded
+    /// @param  data    the JSON data to read from
+    void ProfilerSystem::readRecording( nlohmann::ordered_json const& data )
+    {
+        SetRecording( Stream::Read< bool >( data ) );
+    }
+
+    /// @brief  reads the file ExportTrace writes to by default
+    /// @param  data    the JSON data to read from
+    void ProfilerSystem::readTraceFilepath( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_TraceFilepath, data );
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: reading / writing
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets this System's read methods
+    /// @return this System's read methods
+    ReadMethodMap< ISerializable > const& ProfilerSystem::GetReadMethods() const
+    {
+        static ReadMethodMap< ProfilerSystem > const readMethods = {
+            { "Recording"    , &ProfilerSystem::readRecording     },
+            { "TraceFilepath", &ProfilerSystem::readTraceFilepath }
+        };
+
+        return (ReadMethodMap< ISerializable > const&)readMethods;
+    }
+
+
+    /// @brief  writes this ProfilerSystem to JSON
+    /// @return the JSON data of this ProfilerSystem
+    nlohmann::ordered_json ProfilerSystem::Write() const
+    {
+        nlohmann::ordered_json json;
+
+        json[ "Recording"     ] = GetRecording();
+        json[ "TraceFilepath" ] = m_TraceFilepath;
+
+        return json;
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of ProfilerSystem
+    /// @return the instance of the ProfilerSystem
+    ProfilerSystem* ProfilerSystem::GetInstance()
+    {
+        static std::unique_ptr< ProfilerSystem > s_Instance = nullptr;
+
+        if (s_Instance == nullptr )
+        {
+            s_Instance.reset(new ProfilerSystem());
+        }
+        return s_Instance.get();
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Constructs the ProfilerSystem
+    ProfilerSystem::ProfilerSystem() :
+        System( "ProfilerSystem" ),
+        m_Slots( new Slot[ s_SampleCapacity ] ),
+        m_Epoch( std::chrono::steady_clock::now() )
+    {}
+
+
+//-----------------------------------------------------------------------------
+// ProfileZone
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how deeply zones are currently nested on this thread
+    thread_local uint32_t ProfileZone::s_Depth = 0;
+
+
+    /// @brief  starts timing a zone
+    /// @param  name    the name of the zone
+    ProfileZone::ProfileZone( char const* name ) :
+        m_Name( Profiler()->GetRecording() ? name : nullptr ),
+        m_Start( 0 )
+    {
+        if ( m_Name == nullptr )
+        {
+            return;
+        }
+
+        ++s_Depth;
+        m_Start = Profiler()->GetTime();
+    }
+
+    /// @brief  stops timing the zone and records it
+    ProfileZone::~ProfileZone()
+    {
+        if ( m_Name == nullptr )
+        {
+            return;
+        }
+
+        int64_t end = Profiler()->GetTime();
+        --s_Depth;
+        Profiler()->Record( m_Name, m_Start, end, s_Depth );
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,326 @@
+/// @file       ProfilerSystem.h
+/// @author     Oblivion Owls Inc
+/// @brief      System which records timed zones of each frame and displays / exports them
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+#include "System.h"
+
+
+/// @brief  whether PROFILE_ macros record anything - defaults to on in Debug and ReleaseEditor and off in Release
+#ifndef PROFILER_ENABLED
+    #ifndef NDEBUG
+        #define PROFILER_ENABLED 1
+    #else
+        #define PROFILER_ENABLED 0
+    #endif
+#endif
+
+
+#if PROFILER_ENABLED
+
+    #define PROFILE_CONCAT_INNER( a, b ) a##b
+    #define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_INNER( a, b )
+
+    /// @brief  times the rest of the enclosing scope as a zone with the given name
+    /// @note   the name must outlive the profiler's sample buffer (string literals or persistent strings)
+    #define PROFILE_SCOPE( name ) ProfileZone const PROFILE_CONCAT( profileZone_, __LINE__ )( name )
+
+    /// @brief  times the rest of the enclosing function as a zone named after the function
+    #define PROFILE_FUNCTION() PROFILE_SCOPE( __FUNCTION__ )
+
+    /// @brief  marks the start of a new frame
+    #define PROFILE_FRAME() Profiler()->MarkFrame()
+
+#else
+
+    #define PROFILE_SCOPE( name ) ((void)0)
+    #define PROFILE_FUNCTION() ((void)0)
+    #define PROFILE_FRAME() ((void)0)
+
+#endif
+
+
+/// @brief  System which records timed zones of each frame and displays / exports them
+/// @note   zones may be recorded from any thread - samples go into a fixed-size lock-free ring buffer
+class ProfilerSystem : public System
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a single recorded zone
+    struct Sample
+    {
+        /// @brief  the name of the zone
+        char const* M_Name = nullptr;
+
+        /// @brief  when the zone started, in nanoseconds since the profiler was created
+        int64_t M_Start = 0;
+
+        /// @brief  when the zone ended, in nanoseconds since the profiler was created
+        int64_t M_End = 0;
+
+        /// @brief  the profiler's id of the thread the zone was recorded on
+        uint32_t M_ThreadId = 0;
+
+        /// @brief  how many zones the zone was nested inside of
+        uint32_t M_Depth = 0;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the current time in the profiler's timebase
+    /// @return nanoseconds since the profiler was created
+    int64_t GetTime() const;
+
+
+    /// @brief  records a completed zone
+    /// @param  name        the name of the zone
+    /// @param  start       when the zone started
+    /// @param  end         when the zone ended
+    /// @param  depth       how many zones the zone was nested inside of
+    void Record( char const* name, int64_t start, int64_t end, uint32_t depth );
+
+
+    /// @brief  marks the start of a new frame
+    void MarkFrame();
+
+
+    /// @brief  writes every sample currently in the buffer to a Chrome trace_event JSON file
+    /// @param  filepath    the file to write to
+    /// @note   open the file in chrome://tracing or https://ui.perfetto.dev
+    void ExportTrace( std::string const& filepath ) const;
+
+    /// @brief  writes every sample currently in the buffer to the configured trace file
+    void ExportTrace() const;
+
+
+    /// @brief  gets whether zones are currently being recorded
+    /// @return whether zones are being recorded
+    bool GetRecording() const { return m_Recording.load( std::memory_order_relaxed ); }
+
+    /// @brief  sets whether zones are currently being recorded
+    /// @param  recording   whether zones should be recorded
+    void SetRecording( bool recording ) { m_Recording.store( recording, std::memory_order_relaxed ); }
+
+
+    /// @brief  gets the profiler's id of the calling thread
+    /// @return the id of the calling thread
+    static uint32_t GetThreadId();
+
+
+//-----------------------------------------------------------------------------
+private: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how many samples the ring buffer holds (must be a power of two)
+    static constexpr uint64_t s_SampleCapacity = 1 << 16;
+
+    /// @brief  how many frame start times are remembered (must be a power of two)
+    static constexpr uint64_t s_FrameCapacity = 256;
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a slot in the sample ring buffer
+    struct Slot
+    {
+        /// @brief  odd while the slot is being written, 2 * ( index + 1 ) once sample index has been written
+        std::atomic< uint64_t > M_Sequence = 0;
+
+        /// @brief  the sample in this slot
+        Sample M_Sample = {};
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the sample ring buffer
+    std::unique_ptr< Slot[] > m_Slots;
+
+    /// @brief  the index of the next sample to be written
+    std::atomic< uint64_t > m_WriteIndex = 0;
+
+    /// @brief  whether zones are currently being recorded
+    std::atomic< bool > m_Recording = true;
+
+
+    /// @brief  the start times of recent frames
+    std::array< int64_t, s_FrameCapacity > m_FrameStarts = {};
+
+    /// @brief  how many frames have been marked
+    uint64_t m_FrameCount = 0;
+
+
+    /// @brief  the time point the profiler's timebase starts at
+    std::chrono::steady_clock::time_point m_Epoch;
+
+
+    /// @brief  the file ExportTrace writes to by default
+    std::string m_TraceFilepath = "ProfilerTrace.json";
+
+
+    /// @brief  which frame the debug window displays, counting back from the most recent complete frame
+    int m_InspectedFrameOffset = 0;
+
+    /// @brief  the samples of the frame being inspected (cached so the window doesn't need to allocate)
+    std::vector< Sample > m_InspectedSamples = {};
+
+    /// @brief  the name of each System zone in the inspected frame
+    std::vector< char const* > m_InspectedNames = {};
+
+    /// @brief  the total time in milliseconds of each System zone in the inspected frame
+    std::vector< double > m_InspectedTimes = {};
+
+    /// @brief  the profiler's id of the thread frames are marked on
+    uint32_t m_MainThreadId = 0;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  copies every valid sample in the buffer that lies within a time range
+    /// @param  start   the start of the time range
+    /// @param  end     the end of the time range
+    /// @param  samples vector to append the samples to
+    void collectSamples( int64_t start, int64_t end, std::vector< Sample >& samples ) const;
+
+
+    /// @brief  displays the inspected frame as a flame graph
+    /// @param  frameStart  when the inspected frame started
+    /// @param  frameEnd    when the inspected frame ended
+    void inspectFlameGraph( int64_t frameStart, int64_t frameEnd ) const;
+
+    /// @brief  displays the time spent in each System in the inspected frame as a bar chart
+    void inspectSystemTimes();
+
+
+//-----------------------------------------------------------------------------
+public: // inspection
+//-----------------------------------------------------------------------------
+
+
+    /// @brief Gets Called by the Debug system to display debug information
+    virtual void DebugWindow() override;
+
+
+//-----------------------------------------------------------------------------
+private: // reading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  reads whether zones are recorded
+    /// @param  data    the JSON data to read from
+    void readRecording( nlohmann::ordered_json const& data );
+
+    /// @brief  reads the file ExportTrace writes to by default
+    /// @param  data    the JSON data to read from
+    void readTraceFilepath( nlohmann::ordered_json const& data );
+
+
+//-----------------------------------------------------------------------------
+public: // reading / writing
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets this System's read methods
+    /// @return this System's read methods
+    virtual ReadMethodMap< ISerializable > const& GetReadMethods() const override;
+
+
+    /// @brief  writes this ProfilerSystem to JSON
+    /// @return the JSON data of this ProfilerSystem
+    virtual nlohmann::ordered_json Write() const override;
+
+
+//-----------------------------------------------------------------------------
+public: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of ProfilerSystem
+    /// @return the instance of the ProfilerSystem
+    static ProfilerSystem* GetInstance();
+
+
+//-----------------------------------------------------------------------------
+private: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Constructs the ProfilerSystem
+    ProfilerSystem();
+
+    // Prevent copying
+    ProfilerSystem( ProfilerSystem const& ) = delete;
+    void operator =( ProfilerSystem const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+/// @brief  shorthand function to get the ProfilerSystem instance
+/// @return the ProfilerSystem instance
+__inline ProfilerSystem* Profiler() { return ProfilerSystem::GetInstance(); }
+
+
+/// @brief  RAII timer which records a zone from its construction to its destruction
+/// @note   use through the PROFILE_SCOPE macro so that it compiles out with the profiler
+class ProfileZone
+{
+//-----------------------------------------------------------------------------
+public: // constructor / destructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts timing a zone
+    /// @param  name    the name of the zone
+    ProfileZone( char const* name );
+
+    /// @brief  stops timing the zone and records it
+    ~ProfileZone();
+
+    // Prevent copying
+    ProfileZone( ProfileZone const& ) = delete;
+    void operator =( ProfileZone const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the name of the zone
+    char const* m_Name;
+
+    /// @brief  when the zone started
+    int64_t m_Start;
+
+
+    /// @brief  how deeply zones are currently nested on this thread
+    static thread_local uint32_t s_Depth;
+
+
+//-----------------------------------------------------------------------------
+};
@@ -14,10 +14,12 @@
 #include "Mesh.h"
 #include "AssetLibrarySystem.h"
 #include "Texture.h"
+#include "CameraSystem.h"      // view culling
 
 // for GetMouseOverSprite
 #include "InputSystem.h"
 #include "Engine.h"
+#include "ProfilerSystem.h"
 
 static std::vector<Entity*> shapes; // this is inefficient. But whatever, it's for debug env only.
 
@@ -28,6 +30,9 @@ void RenderSystem::OnInit()
 
     // These 2 will be used to render basic colored and textured sprites.
     m_Shaders["texture"] = new Shader("Data/shaders/vshader.vert", "Data/shaders/texture.frag");
+    m_Shaders["sprite_instancing"] = new Shader("Data/shaders/sprite_instancing.vert", "Data/shaders/sprite_instancing.frag");
+    m_SpriteInstancingShader = m_Shaders["sprite_instancing"];
+    initSpriteBatching();
 
     // Enable transparency
     glEnable(GL_BLEND);
@@ -51,9 +56,24 @@ void RenderSystem::OnInit()
 /// @param dt   Time since last frame
 void RenderSystem::OnUpdate(float dt)
 {
-    std::stable_sort( m_Sprites.begin(), m_Sprites.end(), []( Sprite const* a, Sprite const* b ) -> bool {
-        return a->GetLayer() < b->GetLayer();
-    });
+    {
+        PROFILE_SCOPE( "CompactSprites" );
+        compactSpriteLayers();
+    }
+
+    m_LastSpriteResortCount = m_SpriteResortCount;
+    m_SpriteResortCount = 0;
+    m_LastTileBytesUploaded = m_TileBytesUploaded;
+    m_TileBytesUploaded = 0;
+
+    m_LastDrawnInstanceCount = m_DrawnInstanceCount;
+    m_LastCulledInstanceCount = m_CulledInstanceCount;
+    m_DrawnInstanceCount = 0;
+    m_CulledInstanceCount = 0;
+
+    // a default ViewFrustum sees everything
+    m_WorldView = m_IsCulling ? ViewFrustum( Cameras()->GetMat_WorldToClip() ) : ViewFrustum();
+    m_UiView = m_IsCulling ? ViewFrustum( Cameras()->GetMat_UiToClip() ) : ViewFrustum();
 
     // draw to off-screen texture instead of main buffer
     if (m_DrawToBuffer)
@@ -61,18 +81,18 @@ void RenderSystem::OnUpdate(float dt)
 
     glClear(GL_COLOR_BUFFER_BIT);
 
-    for ( Sprite* sprite : m_Sprites)
     {
-        if ( sprite->GetOpacity() != 0.0f )
-        {
-            sprite->Draw();
-        }
+        PROFILE_SCOPE( "DrawSprites" );
+        auto start = std::chrono::steady_clock::now();
+
+        m_SpriteDrawCallCount = m_BatchSprites ? drawSpritesBatched() : drawSpritesIndividually();
+
+        m_SpriteDrawMs = std::chrono::duration< float, std::milli >( std::chrono::steady_clock::now() - start ).count();
     }
 
-    // draw debug shapes
+    // debug shapes only last one frame
     for ( Entity* entity : shapes )
     {
-        entity->GetComponent< Sprite >()->Draw();
         delete entity;
     }
     shapes.clear();
@@ -95,6 +115,9 @@ void RenderSystem::OnExit()
 
     delete m_DefaultMesh;
 
+    glDeleteBuffers(1, &m_BatchInstanceBuffer);
+    glDeleteVertexArrays(1, &m_BatchVAO);
+
     glDeleteBuffers(1, &m_ScreenBufferFBO);
     glDeleteTextures(1, &m_ScreenBufferTexID);
 }
@@ -198,7 +221,16 @@ void RenderSystem::DrawTexture(
 /// @param sprite   Sprite pointer to add and keep track of
 void RenderSystem::AddSprite( Sprite* sprite )
 {
-    m_Sprites.push_back(sprite);
+    if ( sprite->GetRenderSlot() != -1 )
+    {
+        return;
+    }
+
+    SpriteLayer& spriteLayer = m_SpriteLayers[ sprite->GetLayer() ];
+
+    // the newest Sprite always goes last, so the layer stays in order without sorting
+    sprite->SetRenderSlot( (int)spriteLayer.M_Entries.size() );
+    spriteLayer.M_Entries.push_back( { sprite, m_NextSpriteOrder++ } );
 }
 
 
@@ -206,10 +238,114 @@ void RenderSystem::AddSprite( Sprite* sprite )
 /// @param sprite   Sprite pointer to remove
 void RenderSystem::RemoveSprite( Sprite* sprite )
 {
-    auto it = std::find( m_Sprites.begin(), m_Sprites.end(), sprite);
-    if ( it != m_Sprites.end() )
+    int slot = sprite->GetRenderSlot();
+    if ( slot == -1 )
+    {
+        return;
+    }
+
+    auto it = m_SpriteLayers.find( sprite->GetLayer() );
+    if (
+        it == m_SpriteLayers.end() ||
+        slot >= (int)it->second.M_Entries.size() ||
+        it->second.M_Entries[ slot ].M_Sprite != sprite
+    )
+    {
+        // the layer was changed without going through SetLayer() - fall back to searching for it
+        Debug() << "WARNING: Sprite's layer was changed without Sprite::SetLayer()" << std::endl;
+        for ( it = m_SpriteLayers.begin(); it != m_SpriteLayers.end(); ++it )
+        {
+            if ( slot < (int)it->second.M_Entries.size() && it->second.M_Entries[ slot ].M_Sprite == sprite )
+            {
+                break;
+            }
+        }
+
+        if ( it == m_SpriteLayers.end() )
+        {
+            sprite->SetRenderSlot( -1 );
+            return;
+        }
+    }
+
+    // leave a gap rather than shifting everything after it - gaps get closed at the start of the next frame
+    it->second.M_Entries[ slot ].M_Sprite = nullptr;
+    ++it->second.M_RemovedCount;
+    sprite->SetRenderSlot( -1 );
+}
+
+
+/// @brief                  Moves a sprite to the layer it was just set to. To be used by Sprite::SetLayer.
+/// @param sprite           Sprite that changed layers
+/// @param previousLayer    the layer the sprite was on before
+void RenderSystem::OnSpriteLayerChanged( Sprite* sprite, int previousLayer )
+{
+    int slot = sprite->GetRenderSlot();
+    auto it = m_SpriteLayers.find( previousLayer );
+    if (
+        slot == -1 || it == m_SpriteLayers.end() ||
+        slot >= (int)it->second.M_Entries.size() || it->second.M_Entries[ slot ].M_Sprite != sprite
+    )
+    {
+        return;
+    }
+
+    // take it out of its old layer
+    SpriteEntry entry = it->second.M_Entries[ slot ];
+    it->second.M_Entries[ slot ].M_Sprite = nullptr;
+    ++it->second.M_RemovedCount;
+
+    // and insert it into its new layer where it was originally added, same as a stable sort would put it
+    std::vector< SpriteEntry >& entries = m_SpriteLayers[ sprite->GetLayer() ].M_Entries;
+    auto position = std::upper_bound( entries.begin(), entries.end(), entry, []( SpriteEntry const& a, SpriteEntry const& b ) -> bool {
+        return a.M_Order < b.M_Order;
+    });
+    int index = (int)( position - entries.begin() );
+    entries.insert( position, entry );
+
+    for ( int i = index; i < (int)entries.size(); ++i )
+    {
+        if ( entries[ i ].M_Sprite != nullptr )
+        {
+            entries[ i ].M_Sprite->SetRenderSlot( i );
+        }
+    }
+
+    ++m_SpriteResortCount;
+}
+
+
+/// @brief  closes the gaps left by removed Sprites in layers that have too many of them
+void RenderSystem::compactSpriteLayers()
+{
+    for ( auto it = m_SpriteLayers.begin(); it != m_SpriteLayers.end(); )
     {
-        m_Sprites.erase( it );
+        SpriteLayer& spriteLayer = it->second;
+
+        // only compact once at least half of the layer is gaps, so removal stays O(1) amortized
+        if ( spriteLayer.M_RemovedCount * 2 >= (int)spriteLayer.M_Entries.size() && spriteLayer.M_RemovedCount > 0 )
+        {
+            int count = 0;
+            for ( SpriteEntry const& entry : spriteLayer.M_Entries )
+            {
+                if ( entry.M_Sprite != nullptr )
+                {
+                    entry.M_Sprite->SetRenderSlot( count );
+                    spriteLayer.M_Entries[ count++ ] = entry;
+                }
+            }
+            spriteLayer.M_Entries.resize( count );
+            spriteLayer.M_RemovedCount = 0;
+        }
+
+        if ( spriteLayer.M_Entries.empty() )
+        {
+            it = m_SpriteLayers.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
     }
 }
 
@@ -275,20 +411,24 @@ Sprite* RenderSystem::GetMouseOverSprite()
     glm::vec2 mousePosUi = Input()->GetMousePosUI();
     glm::vec2 mousePosWorld = Input()->GetMousePosWorld();
 
-    // iterate from back to front, as the back of the array gets drawn on top
-    for ( auto it = m_Sprites.rbegin(); it != m_Sprites.rend(); ++it )
+    // iterate from front to back, as the last layer gets drawn on top
+    for ( auto layerIt = m_SpriteLayers.rbegin(); layerIt != m_SpriteLayers.rend(); ++layerIt )
     {
-        Sprite* sprite = *it;
-
-        if ( sprite->GetOpacity() == 0.0f || sprite->GetTransform() == nullptr )
+        std::vector< SpriteEntry > const& entries = layerIt->second.M_Entries;
+        for ( auto it = entries.rbegin(); it != entries.rend(); ++it )
         {
-            continue;
-        }
+            Sprite* sprite = it->M_Sprite;
 
-        if ( sprite->OverlapsLocalPoint( sprite->GetTransform()->GetIsDiegetic() ? mousePosWorld : mousePosUi ) )
-        {
-            cachedSprite = sprite;
-            return cachedSprite;
+            if ( sprite == nullptr || sprite->GetOpacity() == 0.0f || sprite->GetTransform() == nullptr )
+            {
+                continue;
+            }
+
+            if ( sprite->OverlapsLocalPoint( sprite->GetTransform()->GetIsDiegetic() ? mousePosWorld : mousePosUi ) )
+            {
+                cachedSprite = sprite;
+                return cachedSprite;
+            }
         }
     }
 
@@ -358,6 +498,279 @@ void RenderSystem::reallocScreenBufferTexture()
 }
 
 
+/// @brief  creates the VAO and instance buffer batched Sprites are drawn with
+void RenderSystem::initSpriteBatching()
+{
+    glGenVertexArrays(1, &m_BatchVAO);
+    glBindVertexArray(m_BatchVAO);
+
+    // index 0 and 1: position and UV - pointed at the mesh of each batch as it's drawn
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    // index 2 - 6: the instance data, see SpriteInstance
+    glGenBuffers(1, &m_BatchInstanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_BatchInstanceBuffer);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, M_AxisX));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, M_AxisY));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, M_Origin));
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, M_Tint));
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)offsetof(SpriteInstance, M_UvOffset)); // UV offset + opacity
+    for (int i = 2; i <= 6; ++i)
+    {
+        glVertexAttribDivisor(i, 1);
+        glEnableVertexAttribArray(i);
+    }
+
+    glBindVertexArray(0);
+}
+
+
+/// @brief  checks whether a Sprite is on screen, and counts it as drawn or culled
+/// @param  sprite  the Sprite to check
+/// @return whether the Sprite needs drawing - Sprites with unknown bounds always do
+bool RenderSystem::isSpriteVisible( Sprite* sprite )
+{
+    glm::vec2 min, max;
+    if ( sprite->GetWorldBounds( &min, &max ) == false )
+    {
+        return true;
+    }
+
+    if ( GetView( sprite->GetTransform()->GetIsDiegetic() ).Overlaps( min, max ) == false )
+    {
+        ++m_CulledInstanceCount;
+        return false;
+    }
+
+    ++m_DrawnInstanceCount;
+    return true;
+}
+
+
+/// @brief  draws every Sprite, one draw call each
+/// @return how many draw calls were used
+int RenderSystem::drawSpritesIndividually()
+{
+    int drawCallCount = 0;
+
+    forEachSprite( [ & ]( Sprite* sprite )
+    {
+        if ( sprite->GetOpacity() != 0.0f && isSpriteVisible( sprite ) )
+        {
+            sprite->Draw();
+            ++drawCallCount;
+        }
+    });
+
+    // debug shapes go on top of everything
+    for ( Entity* entity : shapes )
+    {
+        entity->GetComponent< Sprite >()->Draw();
+        ++drawCallCount;
+    }
+
+    return drawCallCount;
+}
+
+
+/// @brief  draws every Sprite, grouped into instanced batches
+/// @return how many draw calls were used
+int RenderSystem::drawSpritesBatched()
+{
+    buildSpriteBatches();
+    return submitSpriteBatches();
+}
+
+
+/// @brief  groups every Sprite into batches
+void RenderSystem::buildSpriteBatches()
+{
+    SpriteInstance instance;
+    glm::vec2 boundsMin, boundsMax;
+
+    m_SpriteBatcher.Begin();
+
+    forEachSprite( [ & ]( Sprite* sprite )
+    {
+        if ( sprite->GetOpacity() == 0.0f || isSpriteVisible( sprite ) == false )
+        {
+            return;
+        }
+
+        if ( sprite->IsBatchable() == false )
+        {
+            m_SpriteBatcher.AddCustom( sprite->GetLayer(), sprite );
+        }
+        else if ( sprite->GetBatchInstance( &instance, &boundsMin, &boundsMax ) )
+        {
+            m_SpriteBatcher.Add( sprite->GetLayer(), m_SpriteInstancingShader, sprite->GetTexture(), instance, boundsMin, boundsMax );
+        }
+    });
+
+    // debug shapes go on top of everything
+    for ( Entity* entity : shapes )
+    {
+        Sprite* sprite = entity->GetComponent< Sprite >();
+        if ( sprite->GetBatchInstance( &instance, &boundsMin, &boundsMax ) )
+        {
+            m_SpriteBatcher.Add( INT_MAX, m_SpriteInstancingShader, sprite->GetTexture(), instance, boundsMin, boundsMax );
+        }
+    }
+
+    m_SpriteBatcher.End();
+}
+
+
+/// @brief  uploads the instances of the built batches and draws them
+/// @return how many draw calls were used
+int RenderSystem::submitSpriteBatches()
+{
+    std::vector< SpriteInstance > const& instances = m_SpriteBatcher.GetInstances();
+
+    // upload every instance at once, orphaning last frame's instances so the driver doesn't have to wait on them
+    glBindBuffer(GL_ARRAY_BUFFER, m_BatchInstanceBuffer);
+    if ( instances.size() > m_BatchInstanceCapacity )
+    {
+        m_BatchInstanceCapacity = std::max( instances.size(), m_BatchInstanceCapacity * 2 );
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_BatchInstanceCapacity * sizeof(SpriteInstance), nullptr, GL_STREAM_DRAW);
+    if ( instances.empty() == false )
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(SpriteInstance), instances.data());
+    }
+
+    int drawCallCount = 0;
+
+    // only change state between batches that need it
+    bool vaoBound = false;
+    Shader* boundShader = nullptr;
+    Texture const* boundTexture = nullptr;
+    unsigned boundMeshBuffer = 0;
+
+    for ( SpriteBatcher::Batch const& batch : m_SpriteBatcher.GetBatches() )
+    {
+        ++drawCallCount;
+
+        if ( batch.M_CustomSprite != nullptr )
+        {
+            batch.M_CustomSprite->Draw();
+
+            // the Sprite may have changed any of these
+            vaoBound = false;
+            boundShader = nullptr;
+            boundTexture = nullptr;
+            boundMeshBuffer = 0;
+            continue;
+        }
+
+        if ( vaoBound == false )
+        {
+            glBindVertexArray(m_BatchVAO);
+            vaoBound = true;
+        }
+
+        if ( batch.M_Shader != boundShader )
+        {
+            batch.M_Shader->use();
+            m_ActiveShader = batch.M_Shader;
+            boundShader = batch.M_Shader;
+        }
+
+        if ( batch.M_Texture != boundTexture )
+        {
+            batch.M_Texture->Bind();
+            boundTexture = batch.M_Texture;
+        }
+
+        Mesh const* mesh = batch.M_Texture->GetMesh();
+        if ( mesh->GetBuffer() != boundMeshBuffer )
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mesh->GetBuffer());
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Mesh::Vertex), 0);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Mesh::Vertex), (void*)offsetof(Mesh::Vertex, UV));
+            boundMeshBuffer = mesh->GetBuffer();
+        }
+
+        glDrawArraysInstancedBaseInstance(
+            GL_TRIANGLE_STRIP, 0, mesh->GetVertexCount(),
+            batch.M_InstanceCount, batch.M_FirstInstance
+        );
+    }
+
+    glBindVertexArray(0);
+
+    return drawCallCount;
+}
+
+
+/// @brief  checks the sprite batches of the current scene, and measures the draw calls and CPU time they save
+void RenderSystem::RunBatchingBenchmark()
+{
+    static constexpr int frameCount = 100;
+
+    // check that the batches keep every Sprite, in layer order
+    buildSpriteBatches();
+
+    int placedCount = 0;
+    int customCount = 0;
+    int nextInstance = 0;
+    int previousLayer = INT_MIN;
+    bool valid = true;
+    for ( SpriteBatcher::Batch const& batch : m_SpriteBatcher.GetBatches() )
+    {
+        valid &= batch.M_Layer >= previousLayer;
+        valid &= batch.M_FirstInstance == nextInstance;
+        previousLayer = batch.M_Layer;
+        nextInstance += batch.M_InstanceCount;
+
+        if ( batch.M_CustomSprite != nullptr )
+        {
+            ++placedCount;
+            ++customCount;
+        }
+        else
+        {
+            valid &= batch.M_InstanceCount > 0;
+            placedCount += batch.M_InstanceCount;
+        }
+    }
+    valid &= nextInstance == (int)m_SpriteBatcher.GetInstances().size();
+
+    Debug() << "Sprite batches: " << m_SpriteBatcher.GetSpriteCount() << " sprites (" << customCount << " drawing themselves) in " <<
+        m_SpriteBatcher.GetBatches().size() << " batches - " <<
+        ( valid && placedCount == m_SpriteBatcher.GetSpriteCount() ? "valid" : "INVALID" ) << std::endl;
+
+    // draw off-screen, so the benchmark doesn't show up
+    glBindFramebuffer(GL_FRAMEBUFFER, m_ScreenBufferFBO);
+
+    int individualDrawCalls = 0;
+    glFinish();
+    auto start = std::chrono::steady_clock::now();
+    for ( int frame = 0; frame < frameCount; ++frame )
+    {
+        individualDrawCalls = drawSpritesIndividually();
+    }
+    glFinish();
+    double individualMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count() / frameCount;
+
+    int batchedDrawCalls = 0;
+    start = std::chrono::steady_clock::now();
+    for ( int frame = 0; frame < frameCount; ++frame )
+    {
+        batchedDrawCalls = drawSpritesBatched();
+    }
+    glFinish();
+    double batchedMs = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count() / frameCount;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    Debug() << "Sprite drawing (" << frameCount << " frames): " <<
+        individualDrawCalls << " draw calls in " << individualMs << " ms/frame individually, " <<
+        batchedDrawCalls << " draw calls in " << batchedMs << " ms/frame batched (" << individualMs / batchedMs << "x)" << std::endl;
+}
+
+
 //-----------------------------------------------------------------------------
 // public: Inspection
 //-----------------------------------------------------------------------------
@@ -375,6 +788,21 @@ void RenderSystem::reallocScreenBufferTexture()
                 glClearColor( m_BackgroundColor.r, m_BackgroundColor.g, m_BackgroundColor.b, m_BackgroundColor.a );
             }
 
+            ImGui::Checkbox( "batch sprites", &m_BatchSprites );
+            ImGui::Text( "sprite draw calls: %i", m_SpriteDrawCallCount );
+            ImGui::Text( "sprite CPU time: %.3f ms", m_SpriteDrawMs );
+            ImGui::Text( "sprite layers: %i", (int)m_SpriteLayers.size() );
+            ImGui::Text( "sprite re-sorts last frame: %i", m_LastSpriteResortCount );
+            ImGui::Text( "tile bytes uploaded last frame: %zu", m_LastTileBytesUploaded );
+
+            ImGui::Checkbox( "cull off screen sprites and tiles", &m_IsCulling );
+            ImGui::Text( "instances drawn last frame: %i", m_LastDrawnInstanceCount );
+            ImGui::Text( "instances culled last frame: %i", m_LastCulledInstanceCount );
+            if ( m_BatchSprites )
+            {
+                ImGui::Text( "sprites: %i", m_SpriteBatcher.GetSpriteCount() );
+            }
+
         }
         ImGui::End();
 
@@ -394,6 +822,13 @@ void RenderSystem::reallocScreenBufferTexture()
         Stream::Read( &m_BackgroundColor, data );
     }
 
+    /// @brief  reads whether Sprites are drawn in instanced batches
+    /// @param  data    the JSON data to read from
+    void RenderSystem::readBatchSprites( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_BatchSprites, data );
+    }
+
 
 //-----------------------------------------------------------------------------
 // public: reading / writing
@@ -405,7 +840,8 @@ void RenderSystem::reallocScreenBufferTexture()
     ReadMethodMap< ISerializable > const& RenderSystem::GetReadMethods() const
     {
         static ReadMethodMap< RenderSystem > const readMethods = {
-            { "BackgroundColor", &RenderSystem::readBackgroundColor }
+            { "BackgroundColor", &RenderSystem::readBackgroundColor },
+            { "BatchSprites"   , &RenderSystem::readBatchSprites    }
         };
 
         return (ReadMethodMap< ISerializable > const&)readMethods;
@@ -419,6 +855,7 @@ void RenderSystem::reallocScreenBufferTexture()
         nlohmann::ordered_json json;
 
         json[ "BackgroundColor" ] = Stream::Write( m_BackgroundColor );
+        json[ "BatchSprites"    ] = Stream::Write( m_BatchSprites    );
 
         return json;
     }
@@ -8,6 +8,8 @@
 #include "pch.h" 
 #include "System.h"
 #include "Shader.h"
+#include "SpriteBatcher.h"
+#include "ViewFrustum.h"
 
 
 // fwd references
@@ -83,6 +85,11 @@ public:
     /// @param sprite   Sprite pointer to remove
     void RemoveSprite( Sprite* sprite );
 
+    /// @brief                  Moves a sprite to the layer it was just set to. To be used by Sprite::SetLayer.
+    /// @param sprite           Sprite that changed layers
+    /// @param previousLayer    the layer the sprite was on before
+    void OnSpriteLayerChanged( Sprite* sprite, int previousLayer );
+
     /// @brief          Adds a shader to keep track of, so it can be freed 
     ///                 automatically upon shutdown.
     /// param name      Name to reference shader with
@@ -105,6 +112,30 @@ public:
     Sprite* GetMouseOverSprite();
 
 
+    /// @brief  checks the sprite batches of the current scene, and measures the draw calls and CPU time they save
+    void RunBatchingBenchmark();
+
+
+    /// @brief          records tile data uploaded to the GPU this frame, to show in the debug window
+    /// @param bytes    how many bytes were uploaded
+    void AddTileBytesUploaded( size_t bytes ) { m_TileBytesUploaded += bytes; }
+
+
+    /// @brief              gets the area that is visible this frame
+    /// @param isDiegetic   whether to get the visible area of the world, or of the UI
+    /// @return             the visible area
+    ViewFrustum const& GetView( bool isDiegetic ) const { return isDiegetic ? m_WorldView : m_UiView; }
+
+    /// @brief  gets whether things off screen are culled
+    /// @return whether things off screen are culled
+    bool GetIsCulling() const { return m_IsCulling; }
+
+    /// @brief              records how many instances were drawn and culled this frame, to show in the debug window
+    /// @param drawnCount   how many instances were drawn
+    /// @param culledCount  how many instances were culled
+    void AddCullingCounts( int drawnCount, int culledCount ) { m_DrawnInstanceCount += drawnCount; m_CulledInstanceCount += culledCount; }
+
+
     /// @return         Default mesh for simple quad textures
     __inline Mesh const* GetDefaultMesh() const { return m_DefaultMesh; }
 
@@ -134,7 +165,6 @@ private:
 private:
     std::map<const char*, Shader*> m_Shaders;   /// @brief   Shader storage
     Shader* m_ActiveShader = nullptr;           /// @brief   Currently bound shader
-    std::vector<Sprite*> m_Sprites;             /// @brief   Layered sprite references
     Mesh* m_DefaultMesh = nullptr;              /// @brief   Used for 1-frame textures
     unsigned m_ScreenBufferTexID = 0;           /// @brief   Texture ID for screen buffer
     unsigned m_ScreenBufferFBO = -1;            /// @brief   Framebuffer for rendering the screen
@@ -143,6 +173,92 @@ private:
     /// @brief  the color to fill the background with
     glm::vec4 m_BackgroundColor = glm::vec4( 0.2f, 0.3f, 0.3f, 1.0f );
 
+
+    /// @brief  a Sprite in a layer, along with when it was added
+    struct SpriteEntry
+    {
+        /// @brief  the Sprite, or nullptr if it has been removed
+        Sprite* M_Sprite;
+
+        /// @brief  when the Sprite was added - Sprites within a layer are drawn in this order
+        uint64_t M_Order;
+    };
+
+    /// @brief  the Sprites on a layer, in draw order
+    struct SpriteLayer
+    {
+        /// @brief  the Sprites on this layer, including the gaps left by removed Sprites
+        std::vector< SpriteEntry > M_Entries;
+
+        /// @brief  how many gaps removed Sprites have left in M_Entries
+        int M_RemovedCount = 0;
+    };
+
+    /// @brief  every Sprite, bucketed by layer - iterating the map in order draws back to front
+    std::map< int, SpriteLayer > m_SpriteLayers;
+
+    /// @brief  the order the next added Sprite is drawn in within its layer
+    uint64_t m_NextSpriteOrder = 0;
+
+    /// @brief  how many Sprites have changed layer so far this frame
+    int m_SpriteResortCount = 0;
+
+    /// @brief  how many Sprites changed layer last frame
+    int m_LastSpriteResortCount = 0;
+
+    /// @brief  how many bytes of tile data have been uploaded so far this frame
+    size_t m_TileBytesUploaded = 0;
+
+    /// @brief  how many bytes of tile data were uploaded last frame
+    size_t m_LastTileBytesUploaded = 0;
+
+
+    /// @brief  whether Sprites and tiles that are off screen are skipped
+    bool m_IsCulling = true;
+
+    /// @brief  the area of the world that is visible this frame
+    ViewFrustum m_WorldView;
+
+    /// @brief  the area of the UI that is visible this frame
+    ViewFrustum m_UiView;
+
+    /// @brief  how many Sprites and tiles with known bounds have been drawn so far this frame
+    int m_DrawnInstanceCount = 0;
+
+    /// @brief  how many Sprites and tiles have been culled so far this frame
+    int m_CulledInstanceCount = 0;
+
+    /// @brief  how many Sprites and tiles with known bounds were drawn last frame
+    int m_LastDrawnInstanceCount = 0;
+
+    /// @brief  how many Sprites and tiles were culled last frame
+    int m_LastCulledInstanceCount = 0;
+
+
+    /// @brief  whether Sprites are drawn in instanced batches rather than one at a time
+    bool m_BatchSprites = true;
+
+    /// @brief  groups Sprites into batches each frame
+    SpriteBatcher m_SpriteBatcher;
+
+    /// @brief  the shader batched Sprites are drawn with
+    Shader* m_SpriteInstancingShader = nullptr;
+
+    /// @brief  the VAO batched Sprites are drawn with
+    unsigned m_BatchVAO = 0;
+
+    /// @brief  the buffer the instances of batched Sprites are uploaded to
+    unsigned m_BatchInstanceBuffer = 0;
+
+    /// @brief  how many instances m_BatchInstanceBuffer has room for
+    size_t m_BatchInstanceCapacity = 0;
+
+    /// @brief  how many draw calls were used to draw Sprites last frame
+    int m_SpriteDrawCallCount = 0;
+
+    /// @brief  how long it took the CPU to draw Sprites last frame, in milliseconds
+    float m_SpriteDrawMs = 0.0f;
+
     //-------------------------------------------------------------------------
     //          helpers
     //-------------------------------------------------------------------------
@@ -175,6 +291,40 @@ private:
     /// @brief   Reallocates the texture for screen buffer.
     //           (needs to happen when resizing the screen)
     void reallocScreenBufferTexture();
+
+
+    /// @brief  closes the gaps left by removed Sprites in layers that have too many of them
+    void compactSpriteLayers();
+
+    /// @brief  calls a function on every Sprite, back to front
+    /// @tparam FunctionType    the type of function to call
+    /// @param  function        the function to call on each Sprite
+    template < typename FunctionType >
+    void forEachSprite( FunctionType&& function );
+
+
+    /// @brief  creates the VAO and instance buffer batched Sprites are drawn with
+    void initSpriteBatching();
+
+    /// @brief  checks whether a Sprite is on screen, and counts it as drawn or culled
+    /// @param  sprite  the Sprite to check
+    /// @return whether the Sprite needs drawing - Sprites with unknown bounds always do
+    bool isSpriteVisible( Sprite* sprite );
+
+    /// @brief  draws every Sprite, one draw call each
+    /// @return how many draw calls were used
+    int drawSpritesIndividually();
+
+    /// @brief  draws every Sprite, grouped into instanced batches
+    /// @return how many draw calls were used
+    int drawSpritesBatched();
+
+    /// @brief  groups every Sprite into batches
+    void buildSpriteBatches();
+
+    /// @brief  uploads the instances of the built batches and draws them
+    /// @return how many draw calls were used
+    int submitSpriteBatches();
     
 //-----------------------------------------------------------------------------
 public: // Inspection
@@ -194,6 +344,10 @@ private: // reading
     /// @param  data    the JSON data to read from
     void readBackgroundColor( nlohmann::ordered_json const& data );
 
+    /// @brief  reads whether Sprites are drawn in instanced batches
+    /// @param  data    the JSON data to read from
+    void readBatchSprites( nlohmann::ordered_json const& data );
+
 
 //-----------------------------------------------------------------------------
 public: // reading / writing
@@ -224,4 +378,28 @@ public:
 };
 
 /// @brief      Convenient function for getting RenderSystem instance.
-__inline RenderSystem* Renderer() { return RenderSystem::GetInstance(); }
\ No newline at end of file
+__inline RenderSystem* Renderer() { return RenderSystem::GetInstance(); }
+
+
+//-----------------------------------------------------------------------------
+// private: helpers
+//-----------------------------------------------------------------------------
+
+
+/// @brief  calls a function on every Sprite, back to front
+/// @tparam FunctionType    the type of function to call
+/// @param  function        the function to call on each Sprite
+template < typename FunctionType >
+void RenderSystem::forEachSprite( FunctionType&& function )
+{
+    for ( auto& [ layer, spriteLayer ] : m_SpriteLayers )
+    {
+        for ( SpriteEntry const& entry : spriteLayer.M_Entries )
+        {
+            if ( entry.M_Sprite != nullptr )
+            {
+                function( entry.M_Sprite );
+            }
+        }
+    }
+}
@@ -11,7 +11,7 @@
 
 #include "pch.h" // precompiled header has to be included first
 #include "RigidBody.h"
-#include "BehaviorSystem.h"
+#include "RigidBodySystem.h"
 #include "DebugSystem.h"
 #include "Engine.h"
 
@@ -38,14 +38,14 @@
     /// @param  acceleration    the acceleration to apply
     void RigidBody::ApplyAcceleration( glm::vec2 const& acceleration )
     {
-        m_Velocity += acceleration * GameEngine()->GetFixedFrameDuration();
+        SetVelocity( GetVelocity() + acceleration * GameEngine()->GetFixedFrameDuration() );
     }
 
     /// @brief  adds to the Velocity of this Rigidbody
     /// @param  velocity    the velocity to apply
     void RigidBody::ApplyVelocity( glm::vec2 const& velocity )
     {
-        m_Velocity += velocity;
+        SetVelocity( GetVelocity() + velocity );
     }
 
 
@@ -60,7 +60,80 @@
     /// @param  impulse the impulse to apply
     void RigidBody::ApplyImpulse( glm::vec2 const& impulse )
     {
-        m_Velocity += impulse / m_Mass;
+        SetVelocity( GetVelocity() + impulse / m_Mass );
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Get the acceleration vector of the rigidBody.
+    /// @return the acceleration vector.
+    glm::vec2 RigidBody::GetAcceleration() const
+    {
+        return m_BodyIndex >= 0 ? RigidBodies()->GetAcceleration( m_BodyIndex ) : m_Acceleration;
+    }
+
+    /// @brief  Set the acceleration vector of the rigidBody.
+    /// @param  acceleration    the new acceleration vector.
+    void RigidBody::SetAcceleration( glm::vec2 const& acceleration )
+    {
+        ( m_BodyIndex >= 0 ? RigidBodies()->GetAcceleration( m_BodyIndex ) : m_Acceleration ) = acceleration;
+    }
+
+
+    /// @brief  Get the velocity vector of the rigidBody.
+    /// @return the velocity vector.
+    glm::vec2 RigidBody::GetVelocity() const
+    {
+        return m_BodyIndex >= 0 ? RigidBodies()->GetVelocity( m_BodyIndex ) : m_Velocity;
+    }
+
+    /// @brief  Set the velocity vector of the rigidBody.
+    /// @param  velocity    the new velocity vector.
+    void RigidBody::SetVelocity( glm::vec2 const& velocity )
+    {
+        ( m_BodyIndex >= 0 ? RigidBodies()->GetVelocity( m_BodyIndex ) : m_Velocity ) = velocity;
+    }
+
+
+    /// @brief Get the rotational velocity of the rigidBody.
+    /// @return The rotational velocity.
+    float RigidBody::GetRotationalVelocity() const
+    {
+        return m_BodyIndex >= 0 ? RigidBodies()->GetRotationalVelocity( m_BodyIndex ) : m_RotationalVelocity;
+    }
+
+    /// @brief Set the rotational velocity of the rigidBody.
+    /// @param rotationalVelocity The new rotational velocity.
+    void RigidBody::SetRotationalVelocity( float rotationalVelocity )
+    {
+        ( m_BodyIndex >= 0 ? RigidBodies()->GetRotationalVelocity( m_BodyIndex ) : m_RotationalVelocity ) = rotationalVelocity;
+    }
+
+
+    /// @brief Set the mass of the rigidBody.
+    /// @param mass The new mass.
+    void RigidBody::SetMass( float mass )
+    {
+        m_Mass = mass;
+        if ( m_BodyIndex >= 0 )
+        {
+            RigidBodies()->SetMass( m_BodyIndex, mass );
+        }
+    }
+
+    /// @brief Set the drag of the rigidBody.
+    /// @param drag The new drag.
+    void RigidBody::SetDrag( float drag )
+    {
+        m_Drag = drag;
+        if ( m_BodyIndex >= 0 )
+        {
+            RigidBodies()->SetDrag( m_BodyIndex, drag );
+        }
     }
 
 
@@ -72,7 +145,26 @@
     /// @brief Default constructor for the RigidBody class.
     void RigidBody::OnInit()
     {
-        BehaviorSystem< RigidBody >::GetInstance()->AddComponent( this );
+        RigidBodies()->AddBody( this );
+
+        m_Transform.SetOnConnectCallback(
+            [ this ]()
+            {
+                if ( m_BodyIndex >= 0 )
+                {
+                    RigidBodies()->SetTransform( m_BodyIndex, m_Transform );
+                }
+            }
+        );
+        m_Transform.SetOnDisconnectCallback(
+            [ this ]()
+            {
+                if ( m_BodyIndex >= 0 )
+                {
+                    RigidBodies()->SetTransform( m_BodyIndex, nullptr );
+                }
+            }
+        );
 
         m_Collider.SetOnConnectCallback(
             [ this ]()
@@ -98,7 +190,7 @@
     /// @note   NOT CALLED WHEN THE SCENE IS EXITED - that should be handled by this Component's System
     void RigidBody::OnExit()
     {
-        BehaviorSystem< RigidBody >::GetInstance()->RemoveComponent( this );
+        RigidBodies()->RemoveBody( this );
 
         m_Transform.Exit();
         m_Collider .Exit();
@@ -118,34 +210,7 @@
             return;
         }
 
-        m_Transform->SetMatrix( glm::translate( glm::mat4( 1.0f ), glm::vec3( m_Velocity * dt, 0.0f ) ) * m_Transform->GetMatrix() );
-    }
-
-    /// @brief Fixed update method called at a fixed time step.
-    void RigidBody::OnFixedUpdate()
-    {
-        if ( m_Transform == nullptr )
-        {
-            return;
-        }
-
-        float dt = GameEngine()->GetFixedFrameDuration();
-
-        // linear movement
-        glm::vec2 position = m_Transform->GetTranslation();
-        m_Velocity += m_Acceleration * dt;
-        position += m_Velocity * dt;
-
-        // angular movement
-        float rotation = m_Transform->GetRotation();
-        rotation += m_RotationalVelocity * dt;
-
-        // apply drag
-        m_Velocity -= (m_Velocity * m_Drag * dt) / m_Mass;
-        // TODO: angular drag
-
-        // apply movement
-        m_Transform->Set( position, rotation );
+        m_Transform->SetMatrix( glm::translate( glm::mat4( 1.0f ), glm::vec3( GetVelocity() * dt, 0.0f ) ) * m_Transform->GetMatrix() );
     }
 
     /// @brief Used by the Debug System to display information about this Component
@@ -161,19 +226,39 @@
             ImGui::Text( "no Collider attached" );
         }
 
-        ImGui::DragFloat2( "Velocity", &m_Velocity.x );
+        glm::vec2 velocity = GetVelocity();
+        if ( ImGui::DragFloat2( "Velocity", &velocity.x ) )
+        {
+            SetVelocity( velocity );
+        }
 
-        ImGui::DragFloat2( "Acceleration", &m_Acceleration.x );
+        glm::vec2 acceleration = GetAcceleration();
+        if ( ImGui::DragFloat2( "Acceleration", &acceleration.x ) )
+        {
+            SetAcceleration( acceleration );
+        }
 
-        ImGui::DragFloat( "Rotational Velocity", &m_RotationalVelocity );
+        float rotationalVelocity = GetRotationalVelocity();
+        if ( ImGui::DragFloat( "Rotational Velocity", &rotationalVelocity ) )
+        {
+            SetRotationalVelocity( rotationalVelocity );
+        }
 
-        ImGui::DragFloat( "Mass", &m_Mass, 0.05f, 0.05f, INFINITY );
+        float mass = m_Mass;
+        if ( ImGui::DragFloat( "Mass", &mass, 0.05f, 0.05f, INFINITY ) )
+        {
+            SetMass( mass );
+        }
 
         ImGui::DragFloat( "Restitution", &m_Restitution, 0.05f, 0.0f, 1.0f );
 
         ImGui::DragFloat( "Friction", &m_Friction, 0.05f, 0.0f, INFINITY );
 
-        ImGui::DragFloat( "Drag", &m_Drag, 0.05f, 0.0f, INFINITY );
+        float drag = m_Drag;
+        if ( ImGui::DragFloat( "Drag", &drag, 0.05f, 0.0f, INFINITY ) )
+        {
+            SetDrag( drag );
+        }
     }
 
 
@@ -225,7 +310,7 @@
         float massB = rigidBodyB->GetMass();
         float totalMass = massA + massB;
 
-        glm::vec2 velA = m_Velocity;
+        glm::vec2 velA = GetVelocity();
         glm::vec2 velB = rigidBodyB->GetVelocity();
 
         // get speed in axis of collision
@@ -268,25 +353,27 @@
         pos += collisionData.normal * (collisionData.depth + 0.001f);
         m_Transform->SetTranslation( pos );
 
-        float speed = glm::dot( m_Velocity, collisionData.normal );
+        glm::vec2 velocity = GetVelocity();
+        float speed = glm::dot( velocity, collisionData.normal );
         float newSpeed = -speed * m_Restitution * other->GetRestitution();
         float impulse = newSpeed - speed;
         
         glm::vec2 perpendicularAxis = glm::vec2( collisionData.normal.y, -collisionData.normal.x );
-        float perpendicularSpeed = glm::dot( m_Velocity, perpendicularAxis );
+        float perpendicularSpeed = glm::dot( velocity, perpendicularAxis );
 
         float frictionImpulse = m_Friction * other->GetFriction() * impulse;
 
         if ( frictionImpulse >= glm::abs( perpendicularSpeed ) )
         {
-            m_Velocity += perpendicularAxis * -perpendicularSpeed;
+            velocity += perpendicularAxis * -perpendicularSpeed;
         }
         else
         {
-            m_Velocity += perpendicularAxis * frictionImpulse * -glm::sign( perpendicularSpeed );
+            velocity += perpendicularAxis * frictionImpulse * -glm::sign( perpendicularSpeed );
         }
 
-        m_Velocity += collisionData.normal * impulse;
+        velocity += collisionData.normal * impulse;
+        SetVelocity( velocity );
     }
 
 //-----------------------------------------------------------------------------
@@ -297,28 +384,32 @@
     /// @param data the json data
     void RigidBody::readVelocity( nlohmann::ordered_json const& data )
     {
-        Stream::Read( &m_Velocity, data );
+        glm::vec2 velocity = GetVelocity();
+        Stream::Read( &velocity, data );
+        SetVelocity( velocity );
     }
 
     /// @brief reads the acceleration from json
     /// @param data the json data
     void RigidBody::readAcceleration( nlohmann::ordered_json const& data )
     {
-        Stream::Read( &m_Acceleration, data );
+        glm::vec2 acceleration = GetAcceleration();
+        Stream::Read( &acceleration, data );
+        SetAcceleration( acceleration );
     }
 
     /// @brief reads the rotationalVelocity from json
     /// @param data the json data
     void RigidBody::readRotationalVelocity( nlohmann::ordered_json const& data )
     {
-        Stream::Read( m_RotationalVelocity, data );
+        SetRotationalVelocity( Stream::Read< float >( data ) );
     }
 
     /// @brief reads the inverseMass from json
     /// @param data the json data
     void RigidBody::readMass( nlohmann::ordered_json const& data )
     {
-        Stream::Read( m_Mass, data );
+        SetMass( Stream::Read< float >( data ) );
     }
 
     /// @brief reads the restitution from json
@@ -339,7 +430,7 @@
     /// @param  data    the json data
     void RigidBody::readDrag( nlohmann::ordered_json const& data )
     {
-        Stream::Read( m_Drag, data );
+        SetDrag( Stream::Read< float >( data ) );
     }
 
     
@@ -371,9 +462,9 @@
     {
         nlohmann::ordered_json data;
 
-        data[ "Velocity"           ] = Stream::Write( m_Velocity           );
-        data[ "Acceleration"       ] = Stream::Write( m_Acceleration       );
-        data[ "RotationalVelocity" ] = Stream::Write( m_RotationalVelocity );
+        data[ "Velocity"           ] = Stream::Write( GetVelocity()           );
+        data[ "Acceleration"       ] = Stream::Write( GetAcceleration()       );
+        data[ "RotationalVelocity" ] = Stream::Write( GetRotationalVelocity() );
         data[ "Mass"               ] = Stream::Write( m_Mass               );
         data[ "Restitution"        ] = Stream::Write( m_Restitution        );
         data[ "Friction"           ] = Stream::Write( m_Friction           );
@@ -395,6 +486,23 @@
         return new RigidBody( *this );
     }
 
+    /// @brief  resets this RigidBody to a copy of another RigidBody so that its Entity can be pooled
+    /// @param  other   the RigidBody to copy
+    void RigidBody::ResetTo( Component const& other )
+    {
+        Behavior::ResetTo( other );
+
+        RigidBody const& rigidBody = static_cast< RigidBody const& >( other );
+        m_Velocity           = rigidBody.m_Velocity;
+        m_Acceleration       = rigidBody.m_Acceleration;
+        m_RotationalVelocity = rigidBody.m_RotationalVelocity;
+        m_Mass               = rigidBody.m_Mass;
+        m_Restitution        = rigidBody.m_Restitution;
+        m_Friction           = rigidBody.m_Friction;
+        m_Drag               = rigidBody.m_Drag;
+        m_CollisionResolved  = false;
+    }
+
     
 //-----------------------------------------------------------------------------
 // private: copying
@@ -405,9 +513,9 @@
     /// @param  other   the other RigidBody to copy
     RigidBody::RigidBody(const RigidBody& other) :
         Behavior( other ),
-        m_Velocity          ( other.m_Velocity           ),
-        m_Acceleration      ( other.m_Acceleration       ),
-        m_RotationalVelocity( other.m_RotationalVelocity ),
+        m_Velocity          ( other.GetVelocity()           ),
+        m_Acceleration      ( other.GetAcceleration()       ),
+        m_RotationalVelocity( other.GetRotationalVelocity() ),
         m_Mass              ( other.m_Mass               ),
         m_Restitution       ( other.m_Restitution        ),
         m_Friction          ( other.m_Friction           ),
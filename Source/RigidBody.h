@@ -62,29 +62,29 @@ public: // accessors
 
     /// @brief  Get the acceleration vector of the rigidBody.
     /// @return the acceleration vector.
-    glm::vec2 const& GetAcceleration() const { return m_Acceleration; }
+    glm::vec2 GetAcceleration() const;
 
     /// @brief  Set the acceleration vector of the rigidBody.
     /// @param  acceleration    the new acceleration vector.
-    void SetAcceleration( glm::vec2 const& acceleration ) { m_Acceleration = acceleration; }
+    void SetAcceleration( glm::vec2 const& acceleration );
 
 
     /// @brief  Get the velocity vector of the rigidBody.
     /// @return the velocity vector.
-    glm::vec2 const& GetVelocity() const { return m_Velocity; }
+    glm::vec2 GetVelocity() const;
 
     /// @brief  Set the velocity vector of the rigidBody.
     /// @param  velocity    the new velocity vector.
-    void SetVelocity( glm::vec2 const& velocity ) { m_Velocity = velocity; }
+    void SetVelocity( glm::vec2 const& velocity );
 
 
     /// @brief Get the rotational velocity of the rigidBody.
     /// @return The rotational velocity.
-    float GetRotationalVelocity() const { return m_RotationalVelocity; }
+    float GetRotationalVelocity() const;
 
     /// @brief Set the rotational velocity of the rigidBody.
     /// @param rotationalVelocity The new rotational velocity.
-    void SetRotationalVelocity( float rotationalVelocity ) { m_RotationalVelocity = rotationalVelocity; }
+    void SetRotationalVelocity( float rotationalVelocity );
 
 
     /// @brief Get the mass of the rigidBody.
@@ -93,7 +93,7 @@ public: // accessors
 
     /// @brief Set the mass of the rigidBody.
     /// @param mass The new mass.
-    void SetMass( float mass ) { m_Mass = mass; }
+    void SetMass( float mass );
 
 
     /// @brief Get the restitution of the rigidBody.
@@ -120,7 +120,7 @@ public: // accessors
 
     /// @brief Set the drag of the rigidBody.
     /// @param drag The new drag.
-    void SetDrag( float drag ) { m_Drag = drag; }
+    void SetDrag( float drag );
 
 
     /// @brief  gets whether the collision between two RigidBodies has already been resolved;
@@ -133,6 +133,16 @@ public: // accessors
     /// @note   SHOULD ONLY BE CALLED BY RigidBody::OnCollision();
     void SetCollisionResolved( bool collisionResolved ) { m_CollisionResolved = collisionResolved; }
 
+
+    /// @brief  gets where this RigidBody's state is stored in the RigidBodySystem
+    /// @return the index of this RigidBody in the RigidBodySystem, or -1 if it isn't being simulated
+    int GetBodyIndex() const { return m_BodyIndex; }
+
+    /// @brief  sets where this RigidBody's state is stored in the RigidBodySystem
+    /// @param  bodyIndex   the index of this RigidBody in the RigidBodySystem, or -1 if it isn't being simulated
+    /// @note   SHOULD ONLY BE CALLED BY RigidBodySystem
+    void SetBodyIndex( int bodyIndex ) { m_BodyIndex = bodyIndex; }
+
 //-----------------------------------------------------------------------------
 public: // virtual override methods
 //-----------------------------------------------------------------------------
@@ -148,9 +158,6 @@ public: // virtual override methods
     /// @param dt The time elapsed since the last frame.
     virtual void OnUpdate( float dt ) override;
 
-    /// @brief Fixed update method called at a fixed time step.
-    virtual void OnFixedUpdate() override;
-
     /// @brief Used by the Debug System to display information about this Component
     virtual void Inspector() override;
 
@@ -172,13 +179,13 @@ private: // methods
 private: // member variables
 //-----------------------------------------------------------------------------
 
-    /// @brief The velocity vector of the rigidBody.
+    /// @brief The velocity vector of the rigidBody - only used while not simulated, see m_BodyIndex
     glm::vec2 m_Velocity = { 0.0f, 0.0f };
 
-    /// @brief The acceleration vector of the rigidBody.
+    /// @brief The acceleration vector of the rigidBody - only used while not simulated, see m_BodyIndex
     glm::vec2 m_Acceleration = { 0.0f, 0.0f };
 
-    /// @brief The rotational velocity of the rigidBody.
+    /// @brief The rotational velocity of the rigidBody - only used while not simulated, see m_BodyIndex
     float m_RotationalVelocity = 0.0f;
 
 
@@ -199,6 +206,11 @@ private: // member variables
     bool m_CollisionResolved = false;
 
 
+    /// @brief  where this RigidBody's velocity, acceleration, and rotational velocity are stored in the RigidBodySystem
+    ///         while it's being simulated, or -1 while they're stored in this RigidBody
+    int m_BodyIndex = -1;
+
+
     /// @brief  the transform associated with this RigidBody
     ComponentReference< Transform > m_Transform;
 
@@ -265,6 +277,15 @@ public: // copying
     /// @return the newly created clone of this RigidBody
     virtual RigidBody* Clone() const override;
 
+    /// @brief  checks whether this RigidBody can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a RigidBody
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< RigidBody >( other ); }
+
+    /// @brief  resets this RigidBody to a copy of another RigidBody so that its Entity can be pooled
+    /// @param  other   the RigidBody to copy
+    virtual void ResetTo( Component const& other ) override;
+
 
 //-----------------------------------------------------------------------------
 private: // copying
@@ -0,0 +1,271 @@
+/// @file       RigidBodySystem.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      System that integrates every RigidBody at once from structure-of-arrays storage
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "RigidBodySystem.h"
+
+#include "DebugSystem.h"
+#include "Engine.h"
+#include "Entity.h"
+#include "Transform.h"
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts simulating a RigidBody, moving its state into this System's arrays
+    /// @param  body    the RigidBody to add
+    void RigidBodySystem::AddBody( RigidBody* body )
+    {
+        m_Bodies              .push_back( body );
+        m_Transforms          .push_back( nullptr ); // set once the RigidBody's Transform connects
+        m_Velocities          .push_back( body->GetVelocity() );
+        m_Accelerations       .push_back( body->GetAcceleration() );
+        m_RotationalVelocities.push_back( body->GetRotationalVelocity() );
+        m_Drags               .push_back( body->GetDrag() );
+        m_InverseMasses       .push_back( 1.0f / body->GetMass() );
+
+        m_Displacements .emplace_back();
+        m_RotationDeltas.emplace_back();
+
+        body->SetBodyIndex( (int)m_Bodies.size() - 1 );
+
+        AddComponent( body );
+    }
+
+    /// @brief  stops simulating a RigidBody, moving its state back into the RigidBody
+    /// @param  body    the RigidBody to remove
+    void RigidBodySystem::RemoveBody( RigidBody* body )
+    {
+        int index = body->GetBodyIndex();
+        if ( index < 0 )
+        {
+            return;
+        }
+
+        // hand the state back to the RigidBody
+        body->SetBodyIndex( -1 );
+        body->SetVelocity( m_Velocities[ index ] );
+        body->SetAcceleration( m_Accelerations[ index ] );
+        body->SetRotationalVelocity( m_RotationalVelocities[ index ] );
+
+        // move the last body into the freed slot
+        int last = (int)m_Bodies.size() - 1;
+        if ( index != last )
+        {
+            m_Bodies              [ index ] = m_Bodies              [ last ];
+            m_Transforms          [ index ] = m_Transforms          [ last ];
+            m_Velocities          [ index ] = m_Velocities          [ last ];
+            m_Accelerations       [ index ] = m_Accelerations       [ last ];
+            m_RotationalVelocities[ index ] = m_RotationalVelocities[ last ];
+            m_Drags               [ index ] = m_Drags               [ last ];
+            m_InverseMasses       [ index ] = m_InverseMasses       [ last ];
+
+            m_Bodies[ index ]->SetBodyIndex( index );
+        }
+
+        m_Bodies              .pop_back();
+        m_Transforms          .pop_back();
+        m_Velocities          .pop_back();
+        m_Accelerations       .pop_back();
+        m_RotationalVelocities.pop_back();
+        m_Drags               .pop_back();
+        m_InverseMasses       .pop_back();
+        m_Displacements       .pop_back();
+        m_RotationDeltas      .pop_back();
+
+        RemoveComponent( body );
+    }
+
+
+    /// @brief  measures how many bodies per millisecond the batched integrator and the per-component path each update
+    void RigidBodySystem::RunBenchmark()
+    {
+        static constexpr int bodyCount = 10000;
+        static constexpr int frameCount = 100;
+
+        std::mt19937 random( 0 );
+        std::uniform_real_distribution< float > randomPosition( 0.0f, 100.0f );
+        std::uniform_real_distribution< float > randomVelocity( -5.0f, 5.0f );
+
+        // spawn the bodies straight into this System, without adding them to the scene
+        int first = (int)m_Bodies.size();
+        std::vector< Entity* > entities;
+        entities.reserve( bodyCount );
+        for ( int i = 0; i < bodyCount; ++i )
+        {
+            Transform* transform = new Transform();
+            transform->SetTranslation( { randomPosition( random ), randomPosition( random ) } );
+
+            RigidBody* body = new RigidBody();
+            body->SetVelocity( { randomVelocity( random ), randomVelocity( random ) } );
+            body->SetAcceleration( { 0.0f, -9.8f } );
+            body->SetRotationalVelocity( randomVelocity( random ) );
+            body->SetDrag( 0.5f );
+
+            Entity* entity = new Entity();
+            entity->AddComponent( transform );
+            entity->AddComponent( body );
+            entity->Init();
+
+            // most bodies in game have something listening to their Transform, like a Collider or a Sprite
+            transform->AddOnTransformChangedCallback( 0, []() {} );
+
+            entities.push_back( entity );
+        }
+        int last = (int)m_Bodies.size();
+
+        float dt = GameEngine()->GetFixedFrameDuration();
+
+        // per-component path - what RigidBody::OnFixedUpdate() used to do, one body at a time
+        // through the RigidBody's accessors and its Transform
+        auto start = std::chrono::high_resolution_clock::now();
+        for ( int frame = 0; frame < frameCount; ++frame )
+        {
+            for ( int i = first; i < last; ++i )
+            {
+                RigidBody* body = m_Bodies[ i ];
+                Transform* transform = m_Transforms[ i ];
+                if ( transform == nullptr )
+                {
+                    continue;
+                }
+
+                glm::vec2 velocity = body->GetVelocity();
+                glm::vec2 position = transform->GetTranslation();
+                velocity += body->GetAcceleration() * dt;
+                position += velocity * dt;
+
+                float rotation = transform->GetRotation();
+                rotation += body->GetRotationalVelocity() * dt;
+
+                velocity -= (velocity * body->GetDrag() * dt) / body->GetMass();
+
+                body->SetVelocity( velocity );
+                transform->Set( position, rotation );
+            }
+        }
+        double perComponentMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        // batched path
+        start = std::chrono::high_resolution_clock::now();
+        for ( int frame = 0; frame < frameCount; ++frame )
+        {
+            integrate( first, last, dt );
+        }
+        double batchedMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        for ( Entity* entity : entities )
+        {
+            entity->Exit();
+            delete entity;
+        }
+
+        double bodyUpdates = (double)bodyCount * frameCount;
+        Debug() << "RigidBody benchmark (" << bodyCount << " bodies, " << frameCount << " frames): " <<
+            bodyUpdates / perComponentMs << " bodies/ms per-component, " <<
+            bodyUpdates / batchedMs << " bodies/ms batched (" << perComponentMs / batchedMs << "x)" << std::endl;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: virtual override methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  integrates every body
+    void RigidBodySystem::OnFixedUpdate()
+    {
+        integrate( 0, (int)m_Bodies.size(), GameEngine()->GetFixedFrameDuration() );
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  integrates a range of bodies, then moves the Transforms of the ones that moved
+    /// @param  first   the index of the first body to integrate
+    /// @param  last    one past the index of the last body to integrate
+    /// @param  dt      the duration to integrate over
+    void RigidBodySystem::integrate( int first, int last, float dt )
+    {
+        // integrate - branchless and over plain arrays, so the compiler can vectorize it.
+        // velocities don't depend on position, so this pass only produces how far each body moves,
+        // and never has to touch the Transforms themselves
+        Transform* const* __restrict transforms = m_Transforms.data();
+        glm::vec2* __restrict velocities = m_Velocities.data();
+        glm::vec2* __restrict displacements = m_Displacements.data();
+        float* __restrict rotationDeltas = m_RotationDeltas.data();
+        glm::vec2 const* __restrict accelerations = m_Accelerations.data();
+        float const* __restrict rotationalVelocities = m_RotationalVelocities.data();
+        float const* __restrict drags = m_Drags.data();
+        float const* __restrict inverseMasses = m_InverseMasses.data();
+
+        for ( int i = first; i < last; ++i )
+        {
+            // bodies without a Transform don't move
+            float stepDuration = transforms[ i ] != nullptr ? dt : 0.0f;
+
+            velocities[ i ] += accelerations[ i ] * stepDuration;
+            displacements[ i ] = velocities[ i ] * stepDuration;
+            rotationDeltas[ i ] = rotationalVelocities[ i ] * stepDuration;
+
+            // apply drag
+            velocities[ i ] -= velocities[ i ] * ( drags[ i ] * inverseMasses[ i ] * stepDuration );
+        }
+
+        // write back - each Transform is touched once, with a single change notification, and none for bodies that didn't move
+        for ( int i = first; i < last; ++i )
+        {
+            Transform* transform = transforms[ i ];
+            if ( transform == nullptr || ( displacements[ i ] == glm::vec2( 0.0f ) && rotationDeltas[ i ] == 0.0f ) )
+            {
+                continue;
+            }
+
+            transform->Set( transform->GetTranslation() + displacements[ i ], transform->GetRotation() + rotationDeltas[ i ] );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of RigidBodySystem
+    /// @return the instance of the RigidBodySystem
+    RigidBodySystem* RigidBodySystem::GetInstance()
+    {
+        static std::unique_ptr< RigidBodySystem > s_Instance = nullptr;
+
+        if ( s_Instance == nullptr )
+        {
+            s_Instance.reset( new RigidBodySystem() );
+        }
+
+        return s_Instance.get();
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Constructs the RigidBodySystem
+    RigidBodySystem::RigidBodySystem() :
+        BehaviorSystem< RigidBody >( "RigidBodySystem" )
+    {}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,167 @@
+/// @file       RigidBodySystem.h
+/// @author     Oblivion Owls Inc
+/// @brief      System that integrates every RigidBody at once from structure-of-arrays storage
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include "BehaviorSystem.h"
+
+#include "RigidBody.h"
+
+class Transform;
+
+
+/// @brief  System that integrates every RigidBody at once from structure-of-arrays storage
+/// @note   while a RigidBody is in the scene, its velocity, acceleration, rotational velocity, drag, and mass live in
+///         this System's arrays at the RigidBody's body index, rather than in the RigidBody itself
+class RigidBodySystem : public BehaviorSystem< RigidBody >
+{
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts simulating a RigidBody, moving its state into this System's arrays
+    /// @param  body    the RigidBody to add
+    void AddBody( RigidBody* body );
+
+    /// @brief  stops simulating a RigidBody, moving its state back into the RigidBody
+    /// @param  body    the RigidBody to remove
+    void RemoveBody( RigidBody* body );
+
+
+    /// @brief  measures how many bodies per millisecond the batched integrator and the per-component path each update
+    void RunBenchmark();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the velocity of a body
+    /// @param  bodyIndex   the index of the body
+    /// @return the velocity of the body
+    glm::vec2& GetVelocity( int bodyIndex ) { return m_Velocities[ bodyIndex ]; }
+
+    /// @brief  gets the acceleration of a body
+    /// @param  bodyIndex   the index of the body
+    /// @return the acceleration of the body
+    glm::vec2& GetAcceleration( int bodyIndex ) { return m_Accelerations[ bodyIndex ]; }
+
+    /// @brief  gets the rotational velocity of a body
+    /// @param  bodyIndex   the index of the body
+    /// @return the rotational velocity of the body
+    float& GetRotationalVelocity( int bodyIndex ) { return m_RotationalVelocities[ bodyIndex ]; }
+
+    /// @brief  sets the drag of a body
+    /// @param  bodyIndex   the index of the body
+    /// @param  drag        the drag of the body
+    void SetDrag( int bodyIndex, float drag ) { m_Drags[ bodyIndex ] = drag; }
+
+    /// @brief  sets the mass of a body
+    /// @param  bodyIndex   the index of the body
+    /// @param  mass        the mass of the body
+    void SetMass( int bodyIndex, float mass ) { m_InverseMasses[ bodyIndex ] = 1.0f / mass; }
+
+    /// @brief  sets the Transform a body moves
+    /// @param  bodyIndex   the index of the body
+    /// @param  transform   the Transform the body moves, or nullptr if it doesn't have one
+    void SetTransform( int bodyIndex, Transform* transform ) { m_Transforms[ bodyIndex ] = transform; }
+
+
+//-----------------------------------------------------------------------------
+private: // virtual override methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  integrates every body
+    virtual void OnFixedUpdate() override;
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the RigidBody each body belongs to
+    std::vector< RigidBody* > m_Bodies;
+
+    /// @brief  the Transform each body moves
+    std::vector< Transform* > m_Transforms;
+
+
+    /// @brief  the velocity of each body
+    std::vector< glm::vec2 > m_Velocities;
+
+    /// @brief  the acceleration of each body
+    std::vector< glm::vec2 > m_Accelerations;
+
+    /// @brief  the rotational velocity of each body
+    std::vector< float > m_RotationalVelocities;
+
+    /// @brief  the drag of each body
+    std::vector< float > m_Drags;
+
+    /// @brief  one over the mass of each body
+    std::vector< float > m_InverseMasses;
+
+
+    /// @brief  scratch: how far each body moves this step
+    std::vector< glm::vec2 > m_Displacements;
+
+    /// @brief  scratch: how far each body rotates this step
+    std::vector< float > m_RotationDeltas;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  integrates a range of bodies, then moves the Transforms of the ones that moved
+    /// @param  first   the index of the first body to integrate
+    /// @param  last    one past the index of the last body to integrate
+    /// @param  dt      the duration to integrate over
+    void integrate( int first, int last, float dt );
+
+
+//-----------------------------------------------------------------------------
+public: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the instance of RigidBodySystem
+    /// @return the instance of the RigidBodySystem
+    static RigidBodySystem* GetInstance();
+
+
+//-----------------------------------------------------------------------------
+private: // singleton stuff
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  Constructs the RigidBodySystem
+    RigidBodySystem();
+
+    // Prevent copying
+    RigidBodySystem( RigidBodySystem const& ) = delete;
+    void operator =( RigidBodySystem const& ) = delete;
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+/// @brief  shorthand method for RigidBodySystem::GetInstance()
+/// @return the RigidBodySystem instance
+__inline RigidBodySystem* RigidBodies()
+{
+    return RigidBodySystem::GetInstance();
+}
@@ -23,6 +23,9 @@
 #include "AnimationAsset.h"
 
 #include "Stream.h"
+#include "CookedScene.h"
+#include "ComponentFactory.h"
+#include "Component.h"
 //-----------------------------------------------------------------------------
 // public methods
 //-----------------------------------------------------------------------------
@@ -32,6 +35,13 @@
     void SceneSystem::SetNextScene( std::string const& nextSceneName_ )
     {
         m_NextSceneName = nextSceneName_;
+
+        // get the next scene parsed before any other scene that's waiting to be
+        auto it = m_PreparseJobs.find( m_NextSceneName );
+        if ( it != m_PreparseJobs.end() )
+        {
+            Jobs()->Prioritize( it->second );
+        }
     }
 
     /// @brief  saves the current scene to a file
@@ -194,6 +204,283 @@
     }
 
 
+    /// @brief  cooks a scene's JSON file into the binary format used for faster loading
+    /// @param  sceneName   the name of the scene to cook
+    /// @return whether the scene was cooked successfully
+    bool SceneSystem::CookScene( std::string const& sceneName ) const
+    {
+        return CookedScene::Cook( scenePath( sceneName ), cookedScenePath( sceneName ) );
+    }
+
+    /// @brief  cooks every scene in the Scenes directory which doesn't have an up to date cooked file
+    void SceneSystem::CookAllScenes()
+    {
+        getSceneNames();
+
+        int cookedCount = 0;
+        for ( std::string const& sceneName : m_SceneNames )
+        {
+            if ( CookedScene::IsUpToDate( scenePath( sceneName ), cookedScenePath( sceneName ) ) )
+            {
+                continue;
+            }
+
+            if ( CookScene( sceneName ) )
+            {
+                ++cookedCount;
+            }
+        }
+
+        Debug() << "Cooked " << cookedCount << " scene(s) - " << m_SceneNames.size() - cookedCount << " already up to date or failed" << std::endl;
+    }
+
+    /// @brief  logs how long every scene in the Scenes directory takes to load from JSON and from its cooked file
+    void SceneSystem::RunLoadBenchmark()
+    {
+        getSceneNames();
+
+        Debug() << "Scene load benchmark (parse / decode only, best of 5):" << std::endl;
+        for ( std::string const& sceneName : m_SceneNames )
+        {
+            CookedScene::Benchmark( scenePath( sceneName ), cookedScenePath( sceneName ) );
+        }
+    }
+
+    /// @brief  logs how fast the Entities of AlphaScene are read from already-parsed JSON
+    void SceneSystem::RunDeserializationBenchmark()
+    {
+        using Clock = std::chrono::high_resolution_clock;
+        using LegacyMap = std::map< std::string, ReadMethod< ISerializable > >;
+        static constexpr int passCount = 5;
+
+        std::string const path = scenePath( "AlphaScene" );
+        nlohmann::ordered_json const sceneJson = Stream::ParseFromFile( path );
+        if ( sceneJson.contains( "Entities" ) == false || sceneJson[ "Entities" ].is_array() == false )
+        {
+            Debug() << "WARNING: unable to benchmark deserialization, \"" << path << "\" has no Entities array" << std::endl;
+            return;
+        }
+        nlohmann::ordered_json const& entitiesJson = sceneJson[ "Entities" ];
+
+        // gather every key read directly by an Entity or Component, along with the table it's dispatched through
+        struct Lookup
+        {
+            ReadMethodMap< ISerializable > const* M_Methods;
+            LegacyMap const* M_LegacyMethods;
+            std::string const* M_Key;
+        };
+        std::vector< Lookup > lookups;
+        std::map< ReadMethodMap< ISerializable > const*, LegacyMap > legacyMaps;
+        std::map< std::string, Component* > components;
+        Entity entity;
+
+        auto addLookups = [ & ]( ISerializable const& object, nlohmann::ordered_json const& json )
+        {
+            ReadMethodMap< ISerializable > const& methods = object.GetReadMethods();
+            auto [ legacy, isNew ] = legacyMaps.try_emplace( &methods );
+            if ( isNew )
+            {
+                for ( auto const& entry : methods )
+                {
+                    legacy->second.emplace( entry.M_Name, entry.M_Method );
+                }
+            }
+
+            for ( auto& [ key, value ] : json.items() )
+            {
+                lookups.push_back( { &methods, &legacy->second, &key } );
+            }
+        };
+
+        int keyCount = 0;
+        std::function< void ( nlohmann::ordered_json const& ) > gather = [ & ]( nlohmann::ordered_json const& json )
+        {
+            if ( json.is_object() )
+            {
+                keyCount += (int)json.size();
+            }
+            if ( json.is_structured() )
+            {
+                for ( nlohmann::ordered_json const& child : json )
+                {
+                    gather( child );
+                }
+            }
+        };
+        gather( entitiesJson );
+
+        std::function< void ( nlohmann::ordered_json const& ) > gatherEntity = [ & ]( nlohmann::ordered_json const& json )
+        {
+            if ( json.is_object() == false )
+            {
+                return;
+            }
+            addLookups( entity, json );
+
+            if ( json.contains( "Components" ) && json[ "Components" ].is_object() )
+            {
+                for ( auto& [ typeName, componentJson ] : json[ "Components" ].items() )
+                {
+                    if ( ComponentFactory::GetTypeId( typeName ) == nullptr || componentJson.is_object() == false )
+                    {
+                        continue;
+                    }
+
+                    Component*& component = components[ typeName ];
+                    if ( component == nullptr )
+                    {
+                        component = ComponentFactory::Create( typeName );
+                    }
+                    addLookups( *component, componentJson );
+                }
+            }
+
+            if ( json.contains( "Children" ) && json[ "Children" ].is_array() )
+            {
+                for ( nlohmann::ordered_json const& child : json[ "Children" ] )
+                {
+                    gatherEntity( child );
+                }
+            }
+        };
+        for ( nlohmann::ordered_json const& entityJson : entitiesJson )
+        {
+            gatherEntity( entityJson );
+        }
+
+        for ( auto& [ typeName, component ] : components )
+        {
+            delete component;
+        }
+
+        // dispatch the way reads used to: a std::map lookup, and a concatenated string pushed for the location
+        size_t found = 0;
+        double legacyMs = INFINITY;
+        std::vector< std::string > legacyStack;
+        for ( int pass = 0; pass < passCount; ++pass )
+        {
+            Clock::time_point start = Clock::now();
+            for ( Lookup const& lookup : lookups )
+            {
+                found += lookup.M_LegacyMethods->find( *lookup.M_Key ) != lookup.M_LegacyMethods->end();
+                legacyStack.push_back( *lookup.M_Key + "." );
+                legacyStack.pop_back();
+            }
+            legacyMs = std::min( legacyMs, std::chrono::duration< double, std::milli >( Clock::now() - start ).count() );
+        }
+
+        // dispatch the way reads do now: a hashed table lookup, and a view pushed for the location
+        double hashedMs = INFINITY;
+        for ( int pass = 0; pass < passCount; ++pass )
+        {
+            Clock::time_point start = Clock::now();
+            for ( Lookup const& lookup : lookups )
+            {
+                found += lookup.M_Methods->find( *lookup.M_Key ) != lookup.M_Methods->end();
+                Stream::PushDebugLocation( *lookup.M_Key );
+                Stream::PopDebugLocation();
+            }
+            hashedMs = std::min( hashedMs, std::chrono::duration< double, std::milli >( Clock::now() - start ).count() );
+        }
+
+        // read every Entity in full, without adding them to the scene
+        double readMs = INFINITY;
+        Stream::PushDebugLocation( path, "::" );
+        for ( int pass = 0; pass < passCount; ++pass )
+        {
+            Clock::time_point start = Clock::now();
+            for ( nlohmann::ordered_json const& entityJson : entitiesJson )
+            {
+                Entity* loaded = new Entity();
+                Stream::Read( loaded, entityJson );
+                delete loaded;
+            }
+            readMs = std::min( readMs, std::chrono::duration< double, std::milli >( Clock::now() - start ).count() );
+        }
+        Stream::PopDebugLocation();
+
+        Debug() << "Deserialization benchmark (AlphaScene, " << entitiesJson.size() << " entities, " << keyCount << " keys, best of " << passCount << "):\n"
+            << "    dispatch of " << lookups.size() << " Entity/Component keys (" << found / ( passCount * 2 ) << " recognized):\n"
+            << "        std::map + string location: " << legacyMs * 1000000.0 / lookups.size() << " ns/key\n"
+            << "        hashed table + view location: " << hashedMs * 1000000.0 / lookups.size() << " ns/key\n"
+            << "    full Entity read: " << readMs << " ms, " << keyCount / ( readMs / 1000.0 ) / 1000000.0 << " million keys/s" << std::endl;
+    }
+
+    /// @brief  logs how long AlphaScene takes to be ready to load while every scene is preparsed, on a single thread
+    ///         and on the JobSystem, and how long its textures take to decode
+    void SceneSystem::RunSceneSwitchBenchmark()
+    {
+        using Clock = std::chrono::high_resolution_clock;
+        std::string const targetName = "AlphaScene";
+
+        getSceneNames();
+
+        // preparse every scene, with the one being switched to last - the worst case for a single thread
+        std::vector< std::string > filepaths;
+        for ( std::string const& sceneName : m_SceneNames )
+        {
+            if ( sceneName != targetName )
+            {
+                filepaths.push_back( scenePath( sceneName ) );
+            }
+        }
+        filepaths.push_back( scenePath( targetName ) );
+        std::vector< nlohmann::ordered_json > scenes( filepaths.size() );
+
+        // before: one thread parses the scenes one after another, and loading waits for all of them
+        Clock::time_point start = Clock::now();
+        std::thread preparseThread( [ &filepaths, &scenes ]()
+        {
+            for ( size_t i = 0; i < filepaths.size(); ++i )
+            {
+                scenes[ i ] = Stream::ParseFromFile( filepaths[ i ] );
+            }
+        } );
+        preparseThread.join();
+        double threadMs = std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+        scenes = std::vector< nlohmann::ordered_json >( filepaths.size() );
+
+        // after: a job per scene, the one being switched to prioritized, and loading waits only for its own job
+        start = Clock::now();
+        std::vector< JobSystem::JobId > jobs( filepaths.size() );
+        for ( size_t i = 0; i < filepaths.size(); ++i )
+        {
+            jobs[ i ] = Jobs()->Push( [ &filepaths, &scenes, i ]()
+            {
+                scenes[ i ] = Stream::ParseFromFile( filepaths[ i ] );
+            } );
+        }
+        Jobs()->Prioritize( jobs.back() );
+        Jobs()->Wait( jobs.back() );
+        double readyMs = std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+        for ( JobSystem::JobId job : jobs )
+        {
+            Jobs()->Wait( job );
+        }
+        double allMs = std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+        Debug() << "Scene switch benchmark (" << targetName << ", preparsed alongside " << filepaths.size() - 1 << " other scenes):\n"
+            << "    one preparse thread: ready after " << threadMs << " ms\n"
+            << "    " << Jobs()->GetWorkerCount() << " workers, prioritized: ready after " << readyMs << " ms, all parsed after " << allMs << " ms" << std::endl;
+
+        // the textures the scene decodes while its assets are read
+        std::vector< std::string > texturePaths;
+        nlohmann::ordered_json const& targetJson = scenes.back();
+        if ( targetJson.contains( "Assets" ) && targetJson[ "Assets" ].contains( "Textures" ) )
+        {
+            for ( auto& [ name, textureJson ] : targetJson[ "Assets" ][ "Textures" ].items() )
+            {
+                if ( textureJson.contains( "Filepath" ) && textureJson[ "Filepath" ].is_string() )
+                {
+                    texturePaths.push_back( textureJson[ "Filepath" ] );
+                }
+            }
+        }
+        Texture::RunDecodeBenchmark( texturePaths );
+    }
+
+
 //-----------------------------------------------------------------------------
 // public accessors
 //-----------------------------------------------------------------------------
@@ -215,6 +502,9 @@
     /// @brief  The file extension for Scene files
     std::string const SceneSystem::s_SceneFileExtension = ".scene.json";
 
+    /// @brief  The file extension for cooked Scene files
+    std::string const SceneSystem::s_CookedSceneFileExtension = ".scene.bin";
+
 //-----------------------------------------------------------------------------
 // virtual override methods
 //-----------------------------------------------------------------------------
@@ -238,6 +528,8 @@
             return;
         }
 
+        auto start = std::chrono::high_resolution_clock::now();
+
         exitScene();
 
         m_CurrentSceneName = m_NextSceneName;
@@ -245,6 +537,9 @@
 
         loadScene();
         initScene();
+
+        m_LastSceneSwitchMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+        Debug() << "Switched to Scene \"" << m_CurrentSceneName << "\" in " << m_LastSceneSwitchMs << " ms" << std::endl;
     }
 
     /// @brief  Gets called once before the Engine closes
@@ -253,10 +548,7 @@
 
         exitScene();
 
-        if ( m_PreparseThread.joinable() )
-        {
-            m_PreparseThread.join();
-        }
+        waitForPreparsing();
     }
 
     /// @brief  Displays the DebugWindow GUI for this System
@@ -276,10 +568,15 @@
 
         ImGui::InputText("Starting Scene", &m_StartingSceneName);
 
-        // wait for thread to finish before changing preparsed scenes
-        if ( m_PreparseThread.joinable() )
+        ImGui::Text( "Last scene switch: %.2f ms", m_LastSceneSwitchMs );
+
+        ImGui::Checkbox( "Use Cooked Scenes", &m_UseCookedScenes );
+        ImGui::SameLine();
+        ImGui::Checkbox( "Cook On Load", &m_CookOnLoad );
+        ImGui::SameLine();
+        if ( ImGui::Button( "Cook All Scenes" ) )
         {
-            m_PreparseThread.join();
+            CookAllScenes();
         }
 
         auto sceneToRemove = m_PreparsedScenes.end();
@@ -296,6 +593,7 @@
         }
         if ( sceneToRemove != m_PreparsedScenes.end() )
         {
+            waitForPreparsing( sceneToRemove->first );
             m_PreparsedScenes.erase( sceneToRemove );
         }
 
@@ -340,11 +638,27 @@
         Stream::Read( m_AutosaveName, data );
     }
 
+    /// @brief  reads whether scenes are loaded from their cooked files
+    /// @param  data    the data to read from
+    void SceneSystem::readUseCookedScenes( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_UseCookedScenes, data );
+    }
+
+    /// @brief  reads whether scenes loaded from JSON are cooked right away
+    /// @param  data    the data to read from
+    void SceneSystem::readCookOnLoad( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_CookOnLoad, data );
+    }
+
     /// @brief  map of the SceneSystem read methods
     ReadMethodMap< SceneSystem > const SceneSystem::s_ReadMethods = {
         { "BaseScenePath", &readBaseScenePath },
         { "StartingSceneName", &readStartingSceneName },
-        { "AutosaveName" , &readAutosaveName  }
+        { "AutosaveName" , &readAutosaveName  },
+        { "UseCookedScenes", &readUseCookedScenes },
+        { "CookOnLoad", &readCookOnLoad }
     };
 
     /// @brief  writes this System to json
@@ -355,6 +669,8 @@
         json[ "BaseScenePath" ] = m_BaseScenePath;
         json[ "StartingSceneName" ] = m_StartingSceneName;
         json[ "AutosaveName"  ] = m_AutosaveName;
+        json[ "UseCookedScenes" ] = m_UseCookedScenes;
+        json[ "CookOnLoad" ] = m_CookOnLoad;
 
         return json;
     }
@@ -367,6 +683,9 @@
     /// @param  data    the data to read from
     void SceneSystem::Scene::readAssets( nlohmann::ordered_json const& data )
     {
+        // decode the scene's images on worker threads while the rest of its assets are read
+        Texture::BeginDeferredLoads();
+
         for ( auto& [ key, value ] : data.items() )
         {
             auto it = std::find_if(
@@ -382,12 +701,14 @@
                 break;
             }
 
-            Stream::PushDebugLocation( key + "." );
+            Stream::PushDebugLocation( key );
 
             it->second()->LoadAssets( value );
 
             Stream::PopDebugLocation();
         }
+
+        Texture::FinishDeferredLoads();
     }
 
     /// @brief  reads the entities in a Scene
@@ -401,22 +722,35 @@
     /// @param  data    the JSON data to read from
     void SceneSystem::Scene::readPreparsedScenes( nlohmann::ordered_json const& data )
     {
-        // wait for the preparse thread to finish
-        if ( Scenes()->m_PreparseThread.joinable() )
+        SceneSystem* scenes = Scenes();
+
+        std::set< std::string > sceneNames;
+        for ( nlohmann::ordered_json const& sceneName : data )
         {
-            Scenes()->m_PreparseThread.join();
+            sceneNames.insert( Stream::Read< std::string >( sceneName ) );
+        }
+
+        // clean up previously preparsed scenes, keeping any this scene also wants
+        for ( auto it = scenes->m_PreparsedScenes.begin(); it != scenes->m_PreparsedScenes.end(); )
+        {
+            if ( sceneNames.contains( it->first ) )
+            {
+                ++it;
+                continue;
+            }
+
+            scenes->waitForPreparsing( it->first );
+            it = scenes->m_PreparsedScenes.erase( it );
         }
-        // clean up previously preparsed scenes
-        Scenes()->m_PreparsedScenes.clear();
 
         // load the new preparsed scene names
-        for ( nlohmann::ordered_json const& sceneName : data )
+        for ( std::string const& sceneName : sceneNames )
         {
-            Scenes()->m_PreparsedScenes.emplace( Stream::Read< std::string >( sceneName ), nlohmann::ordered_json() );
+            scenes->m_PreparsedScenes.try_emplace( sceneName );
         }
 
-        // start the thread to preparse the scenes
-        Scenes()->m_PreparseThread = std::thread( &SceneSystem::preparseScenes, Scenes() );
+        // start the jobs to preparse the scenes
+        scenes->preparseScenes();
     }
 
 
@@ -480,31 +814,67 @@
         return m_BaseScenePath + sceneName + s_SceneFileExtension;
     }
 
+    /// @brief  assembles the filepath of the cooked file of a scene with the given name
+    /// @param  sceneName   the name of the scene to assemble the cooked filepath of
+    /// @return the filepath of the cooked scene
+    std::string SceneSystem::cookedScenePath( std::string const& sceneName ) const
+    {
+        return m_BaseScenePath + sceneName + s_CookedSceneFileExtension;
+    }
+
     /// @brief  Loads the next Scene
     void SceneSystem::loadScene()
     {
         Debug() << "Loading Scene \"" << m_CurrentSceneName << "\"..." << std::endl;
 
-        // wait for preparsing to finish, if it's not done already
-        if ( m_PreparseThread.joinable() )
+        // wait for this scene to finish preparsing, if it's not done already - the others can keep going
+        waitForPreparsing( m_CurrentSceneName );
+
+        auto it = m_PreparsedScenes.find( m_CurrentSceneName );
+        bool isPreparsed = it != m_PreparsedScenes.end() && it->second.is_null() == false;
+
+        // cooked scenes load faster than parsing JSON, unless the JSON was already parsed in the background
+        if ( isPreparsed == false && m_UseCookedScenes && loadCookedScene() )
         {
-            m_PreparseThread.join();
+            if ( it != m_PreparsedScenes.end() )
+            {
+                m_PreparsedScenes.erase( it );
+            }
+
+            if ( m_MustCopyAutosave )
+            {
+                // the cooked file is up to date, so its JSON source is exactly what was loaded
+                if ( m_CurrentSceneName != m_AutosaveName )
+                {
+                    std::error_code error;
+                    std::filesystem::copy_file(
+                        scenePath( m_CurrentSceneName ), scenePath( m_AutosaveName ),
+                        std::filesystem::copy_options::overwrite_existing, error
+                    );
+                }
+                m_MustCopyAutosave = false;
+            }
+            return;
         }
 
         nlohmann::ordered_json sceneJson;
 
-        auto it = m_PreparsedScenes.find( m_CurrentSceneName );
-        if ( it == m_PreparsedScenes.end() )
+        if ( isPreparsed == false )
         {
             sceneJson = Stream::ParseFromFile( scenePath( m_CurrentSceneName ) );
         }
         else
         {
             sceneJson = std::move( it->second );
+        }
+
+        if ( it != m_PreparsedScenes.end() )
+        {
             m_PreparsedScenes.erase( it );
         }
 
-        Stream::PushDebugLocation( scenePath( m_CurrentSceneName ) + "::" );
+        std::string const path = scenePath( m_CurrentSceneName );
+        Stream::PushDebugLocation( path, "::" );
 
         Scene scene = Scene();
         Stream::Read( scene, sceneJson );
@@ -516,6 +886,120 @@
             Stream::WriteToFile( scenePath( m_AutosaveName ), sceneJson );
             m_MustCopyAutosave = false;
         }
+
+        // cook the scene from the already-parsed JSON so that the next load of it is faster
+        if ( m_CookOnLoad && m_UseCookedScenes && sceneJson.is_object() )
+        {
+            CookedScene::Cook( sceneJson, scenePath( m_CurrentSceneName ), cookedScenePath( m_CurrentSceneName ) );
+        }
+    }
+
+    /// @brief  Loads the next Scene from its cooked file
+    /// @return whether the cooked file was up to date and could be loaded
+    bool SceneSystem::loadCookedScene()
+    {
+        CookedScene cooked;
+        if ( cooked.Open( scenePath( m_CurrentSceneName ), cookedScenePath( m_CurrentSceneName ) ) == false )
+        {
+            return false;
+        }
+
+        std::string const path = cookedScenePath( m_CurrentSceneName );
+
+        // check the whole file before loading anything from it, so a bad file falls back to the JSON cleanly
+        if ( cooked.Validate() == false )
+        {
+            Debug() << "ERROR: cooked scene \"" << path << "\" is invalid - loading \"" << scenePath( m_CurrentSceneName ) << "\" instead" << std::endl;
+            return false;
+        }
+
+        Stream::PushDebugLocation( path, "::" );
+
+        Scene scene = Scene();
+
+        std::string_view sectionName;
+        CookedScene::SectionKind kind;
+        uint32_t elementCount;
+        while ( cooked.NextSection( &sectionName, &kind, &elementCount ) )
+        {
+            std::string_view key;
+            std::span< uint8_t const > data;
+
+            // decode and load Entities one at a time, so the whole scene is never held as JSON at once
+            if ( sectionName == "Entities" && kind != CookedScene::SectionKind::Value )
+            {
+                Stream::PushDebugLocation( "Entities" );
+
+                int index = 0;
+                while ( cooked.NextElement( &key, &data ) )
+                {
+                    if ( key.empty() )
+                    {
+                        Stream::PushDebugLocation( index );
+                    }
+                    else
+                    {
+                        Stream::PushDebugLocation( key );
+                    }
+                    nlohmann::ordered_json entityJson = CookedScene::ParseElement( data );
+                    if ( entityJson.is_discarded() )
+                    {
+                        Debug() << "ERROR: could not decode " << Stream::GetDebugLocation() << std::endl;
+                    }
+                    else
+                    {
+                        Entities()->LoadEntity( entityJson );
+                    }
+                    Stream::PopDebugLocation();
+                    ++index;
+                }
+                Entities()->InitLoadedEntities();
+
+                Stream::PopDebugLocation();
+                continue;
+            }
+
+            // the other sections are small, so reassemble them and read them like normal
+            nlohmann::ordered_json sectionJson;
+            nlohmann::ordered_json& section = sectionJson[ std::string( sectionName ) ];
+            if ( kind == CookedScene::SectionKind::Object )
+            {
+                section = nlohmann::ordered_json::object();
+            }
+            else if ( kind == CookedScene::SectionKind::Array )
+            {
+                section = nlohmann::ordered_json::array();
+            }
+
+            while ( cooked.NextElement( &key, &data ) )
+            {
+                nlohmann::ordered_json element = CookedScene::ParseElement( data );
+                if ( element.is_discarded() )
+                {
+                    Debug() << "ERROR: could not decode an element of section \"" << sectionName << "\" of " << path << std::endl;
+                    continue;
+                }
+
+                switch ( kind )
+                {
+                    case CookedScene::SectionKind::Object:
+                        section[ std::string( key ) ] = std::move( element );
+                        break;
+                    case CookedScene::SectionKind::Array:
+                        section.push_back( std::move( element ) );
+                        break;
+                    default:
+                        section = std::move( element );
+                        break;
+                }
+            }
+
+            Stream::Read( scene, sectionJson );
+        }
+
+        Stream::PopDebugLocation();
+
+        return true;
     }
 
     /// @brief  Initializes the current Scene
@@ -590,15 +1074,61 @@
     }
 
 
-    /// @brief  preparses the JSON files of the scenes in the PreparsedScenes map
-    /// @brief  intended to be run on a separate thread
+    /// @brief  queues a job to parse each scene in the PreparsedScenes map that isn't parsed or being parsed yet
     void SceneSystem::preparseScenes()
     {
         for ( auto& [ name, json ] : m_PreparsedScenes )
         {
-            std::string filepath = scenePath( name );
-            json = Stream::ParseFromFile( filepath );
+            if ( m_PreparseJobs.contains( name ) || json.is_null() == false )
+            {
+                continue;
+            }
+
+            // the job only gets copies, so nothing else of the SceneSystem is touched off the main thread
+            m_PreparseJobs[ name ] = Jobs()->Push(
+                [ target = &json, filepath = scenePath( name ), cookedPath = cookedScenePath( name ), useCooked = m_UseCookedScenes ]()
+                {
+                    // scenes with up to date cooked files load quickly enough without preparsing
+                    if ( useCooked && CookedScene::IsUpToDate( filepath, cookedPath ) )
+                    {
+                        return;
+                    }
+
+                    *target = Stream::ParseFromFile( filepath );
+                }
+            );
+        }
+
+        // a scene change may already have been asked for
+        auto it = m_PreparseJobs.find( m_NextSceneName );
+        if ( it != m_PreparseJobs.end() )
+        {
+            Jobs()->Prioritize( it->second );
+        }
+    }
+
+    /// @brief  waits for a scene to finish preparsing, if it's being preparsed
+    /// @param  sceneName   the name of the scene to wait for
+    void SceneSystem::waitForPreparsing( std::string const& sceneName )
+    {
+        auto it = m_PreparseJobs.find( sceneName );
+        if ( it == m_PreparseJobs.end() )
+        {
+            return;
+        }
+
+        Jobs()->Wait( it->second );
+        m_PreparseJobs.erase( it );
+    }
+
+    /// @brief  waits for every scene being preparsed to finish
+    void SceneSystem::waitForPreparsing()
+    {
+        for ( auto& [ name, job ] : m_PreparseJobs )
+        {
+            Jobs()->Wait( job );
         }
+        m_PreparseJobs.clear();
     }
 
 
@@ -12,6 +12,7 @@
 #include "System.h"
 
 #include "AssetLibrarySystem.h"
+#include "JobSystem.h"
 
 #include "Engine.h"
 /// @brief  Example System meant to be copy-pasted when creating new Systems
@@ -53,6 +54,25 @@ public: // methods
     bool InspectorSelectScene( char const* label, std::string* sceneName );
 
 
+    /// @brief  cooks a scene's JSON file into the binary format used for faster loading
+    /// @param  sceneName   the name of the scene to cook
+    /// @return whether the scene was cooked successfully
+    bool CookScene( std::string const& sceneName ) const;
+
+    /// @brief  cooks every scene in the Scenes directory which doesn't have an up to date cooked file
+    void CookAllScenes();
+
+    /// @brief  logs how long every scene in the Scenes directory takes to load from JSON and from its cooked file
+    void RunLoadBenchmark();
+
+    /// @brief  logs how fast the Entities of AlphaScene are read from already-parsed JSON
+    void RunDeserializationBenchmark();
+
+    /// @brief  logs how long AlphaScene takes to be ready to load while every scene is preparsed, on a single thread
+    ///         and on the JobSystem, and how long its textures take to decode
+    void RunSceneSwitchBenchmark();
+
+
 //-----------------------------------------------------------------------------
 public: // accessors
 //-----------------------------------------------------------------------------
@@ -78,7 +98,6 @@ private: // member variables
     std::string m_NextSceneName = "";
 
     /// @brief  The base path of all Scene files
-    /// @brief  NOTE: this is also accessed from a separate thread. be careful with it
     std::string m_BaseScenePath = "Data/Scenes/";
 
 
@@ -88,13 +107,24 @@ private: // member variables
     /// @brief  whether the next scene loaded must be copied into the autosave
     bool m_MustCopyAutosave = true;
 
+    /// @brief  whether scenes are loaded from their cooked files when those are up to date
+    bool m_UseCookedScenes = true;
+
+    /// @brief  whether scenes loaded from JSON are cooked right away, writing their cooked files next to them
+    /// @brief  NOTE: off by default - scenes are otherwise only cooked by CookScene / CookAllScenes
+    bool m_CookOnLoad = false;
+
 
     /// @brief  scene JSON files parsed in advance
-    /// @brief  NOTE: this is also accessed from a separate thread. be careful with it
+    /// @brief  NOTE: each scene's JSON is written by its preparse job. wait for the job before touching it
     std::map< std::string, nlohmann::ordered_json > m_PreparsedScenes = {};
 
-    /// @brief  thread used to parse scene files in the background
-    std::thread m_PreparseThread;
+    /// @brief  the JobSystem jobs parsing scene files in the background, by scene name
+    std::map< std::string, JobSystem::JobId > m_PreparseJobs = {};
+
+
+    /// @brief  how long the last scene switch took, from exiting the old scene to initializing the new one
+    double m_LastSceneSwitchMs = 0.0;
 
 
     /// @brief  array of all Scene names in the Scenes directory
@@ -109,6 +139,9 @@ private: // constants
     /// @brief  The file extension for Scene files
     static std::string const s_SceneFileExtension;
 
+    /// @brief  The file extension for cooked Scene files
+    static std::string const s_CookedSceneFileExtension;
+
 
 //-----------------------------------------------------------------------------
 private: // virtual override methods
@@ -143,6 +176,14 @@ private: // reading
     /// @param  stream  the data to read from
     void readAutosaveName( nlohmann::ordered_json const& data );
 
+    /// @brief  reads whether scenes are loaded from their cooked files
+    /// @param  data    the data to read from
+    void readUseCookedScenes( nlohmann::ordered_json const& data );
+
+    /// @brief  reads whether scenes loaded from JSON are cooked right away
+    /// @param  data    the data to read from
+    void readCookOnLoad( nlohmann::ordered_json const& data );
+
     /// @brief  map of the SceneSystem read methods
     static ReadMethodMap< SceneSystem > const s_ReadMethods;
 
@@ -169,9 +210,18 @@ private: // methods
     /// @return the filepath of the scene
     std::string scenePath( std::string const& sceneName ) const;
 
+    /// @brief  assembles the filepath of the cooked file of a scene with the given name
+    /// @param  sceneName   the name of the scene to assemble the cooked filepath of
+    /// @return the filepath of the cooked scene
+    std::string cookedScenePath( std::string const& sceneName ) const;
+
     /// @brief  Loads the next Scene
     void loadScene();
 
+    /// @brief  Loads the next Scene from its cooked file
+    /// @return whether the cooked file was up to date and could be loaded
+    bool loadCookedScene();
+
     /// @brief  Initializes the current Scene
     void initScene();
 
@@ -186,10 +236,16 @@ private: // methods
     void getSceneNames();
 
 
-    /// @brief  preparses the JSON files of the scenes in the PreparsedScenes map
-    /// @brief  intended to be run on a separate thread
+    /// @brief  queues a job to parse each scene in the PreparsedScenes map that isn't parsed or being parsed yet
     void preparseScenes();
 
+    /// @brief  waits for a scene to finish preparsing, if it's being preparsed
+    /// @param  sceneName   the name of the scene to wait for
+    void waitForPreparsing( std::string const& sceneName );
+
+    /// @brief  waits for every scene being preparsed to finish
+    void waitForPreparsing();
+
 
 //-----------------------------------------------------------------------------
 private: // scene loading
@@ -31,7 +31,10 @@
     /// @brief  Destroys this Sound
     Sound::~Sound()
     {
-        m_Sound->release();
+        if ( m_Sound != nullptr )
+        {
+            m_Sound->release();
+        }
     }
 
 //-----------------------------------------------------------------------------
@@ -39,14 +42,18 @@
 //-----------------------------------------------------------------------------
 
     /// @brief  Plays this sound
-    /// @param  volume  the relative volume to play this sound at
-    /// @param  pitch   the relative pitch to play this sound at
+    /// @param  volume      the relative volume to play this sound at
+    /// @param  pitch       the relative pitch to play this sound at
+    /// @param  time        how far into the sound to start playing, in seconds
+    /// @param  isPaused    whether to leave the channel paused
     /// @return The channel that this sound is being played on
     FMOD::Channel* Sound::Play(
         FMOD::ChannelGroup* group,
         float volume,
         float pitch,
-        int loopCount
+        int loopCount,
+        float time,
+        bool isPaused
     ) const
     {
         if ( m_Sound == nullptr )
@@ -55,19 +62,27 @@
             return nullptr;
         }
 
-        FMOD::Channel* channel;
+        FMOD::Channel* channel = nullptr;
         AudioSystem::GetInstance()->GetFMOD()->playSound(
             m_Sound,
             group,
             true,
             &channel
         );
+        if ( channel == nullptr )
+        {
+            return nullptr;
+        }
 
         channel->setVolume( volume * m_Volume );
         channel->setPitch( pitch );
         channel->setLoopCount( loopCount );
+        if ( time > 0.0f )
+        {
+            channel->setPosition( (unsigned int)( time * 1000 ), FMOD_TIMEUNIT_MS );
+        }
 
-        channel->setPaused( false );
+        channel->setPaused( isPaused );
 
         return channel;
     }
@@ -128,6 +143,9 @@
 
         ImGui::DragFloat( "volume", &m_Volume, 0.05f, 0.0f, INFINITY );
 
+        ImGui::DragInt( "max voices", &m_MaxVoices, 0.05f, 0, INT_MAX );
+        ImGui::SetItemTooltip( "the most instances of this sound that can play at once - 0 for no limit" );
+
         if ( ImGui::Button( "Reload Sound" ) )
         {
             Reload();
@@ -162,6 +180,13 @@
         Stream::Read( m_Volume, data );
     }
 
+    /// @brief  reads the most voices of this Sound that can play at once
+    /// @param  data    the JSON data to read from
+    void Sound::readMaxVoices( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_MaxVoices, data );
+    }
+
     /// @brief  runs after Sound has been loaded 
     void Sound::AfterLoad()
     {
@@ -177,6 +202,7 @@
         data[ "IsLoopable" ] = Stream::Write( m_IsLoopable );
         data[ "Filepath"   ] = Stream::Write( m_Filepath   );
         data[ "Volume"     ] = Stream::Write( m_Volume     );
+        data[ "MaxVoices"  ] = Stream::Write( m_MaxVoices  );
 
         return data;
     }
@@ -185,7 +211,8 @@
     ReadMethodMap< Sound > const Sound::s_ReadMethods = {
         { "IsLoopable", &readIsLoopable },
         { "Filepath"  , &readFilepath   },
-        { "Volume"    , &readVolume     }
+        { "Volume"    , &readVolume     },
+        { "MaxVoices" , &readMaxVoices  }
     };
 
 
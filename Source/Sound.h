@@ -41,14 +41,18 @@ public: // methods
 
 
     /// @brief  Plays this sound
-    /// @param  volume  the relative volume to play this sound at
-    /// @param  pitch   the relative pitch to play this sound at
+    /// @param  volume      the relative volume to play this sound at
+    /// @param  pitch       the relative pitch to play this sound at
+    /// @param  time        how far into the sound to start playing, in seconds
+    /// @param  isPaused    whether to leave the channel paused
     /// @return The channel that this sound is being played on
     FMOD::Channel* Play(
         FMOD::ChannelGroup* group = nullptr,
         float volume = 1.0f,
         float pitch = 1.0f,
-        int loopCount = 0
+        int loopCount = 0,
+        float time = 0.0f,
+        bool isPaused = false
     ) const;
 
 
@@ -70,6 +74,15 @@ public: // accessors
     float GetVolume() const;
 
 
+    /// @brief  gets the most voices of this Sound that can play at once
+    /// @return the most voices of this Sound that can play at once - 0 for no limit
+    __inline int GetMaxVoices() const { return m_MaxVoices; }
+
+    /// @brief  sets the most voices of this Sound that can play at once
+    /// @param  maxVoices   the most voices of this Sound that can play at once - 0 for no limit
+    __inline void SetMaxVoices( int maxVoices ) { m_MaxVoices = maxVoices; }
+
+
     /// @brief  gets whether this Sound is looping
     /// @return whether this Sound is looping
     __inline bool GetIsLoopable() const { return m_IsLoopable; }
@@ -105,6 +118,9 @@ private: // member variables
     /// @brief  the default volume of this sound
     float m_Volume = 1.0f;
 
+    /// @brief  the most voices of this Sound that can play at once - 0 for no limit
+    int m_MaxVoices = 0;
+
 
 //-----------------------------------------------------------------------------
 private: // reading
@@ -123,6 +139,10 @@ private: // reading
     /// @param  data    the JSON data to read from
     void readVolume( nlohmann::ordered_json const& data );
 
+    /// @brief  reads the most voices of this Sound that can play at once
+    /// @param  data    the JSON data to read from
+    void readMaxVoices( nlohmann::ordered_json const& data );
+
 
     /// @brief  map of the SceneSystem read methods
     static ReadMethodMap< Sound > const s_ReadMethods;
@@ -0,0 +1,196 @@
+/// @file       SpatialHashGrid.h
+/// @author     Oblivion Owls Inc
+/// @brief      flat, open-addressed hash grid which buckets values by integer cell position
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#define SPATIALHASHGRID_H
+
+#include "pch.h"
+
+
+/// @brief  flat, open-addressed hash grid which buckets values by integer cell position
+/// @tparam ValueType   the type of value stored in each cell
+/// @note   active cells are stored contiguously, and cells which are freed keep their allocated
+///         storage so that they can be reused without allocating
+template < typename ValueType >
+class SpatialHashGrid
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a single occupied cell of the grid
+    struct Cell
+    {
+        /// @brief  the position of this Cell in the grid
+        glm::ivec2 position = { 0, 0 };
+
+        /// @brief  the values in this Cell
+        std::vector< ValueType > values = {};
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // constructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructor
+    /// @param  initialCapacity the initial number of slots in the hash table (rounded up to a power of two)
+    SpatialHashGrid( int initialCapacity = 64 );
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  inserts a value into the specified cell, creating the cell if needed
+    /// @param  cellPos the cell to insert the value into
+    /// @param  value   the value to insert
+    /// @note   invalidates Cell references and iterators
+    void Insert( glm::ivec2 const& cellPos, ValueType const& value );
+
+    /// @brief  removes a value from the specified cell
+    /// @param  cellPos the cell to remove the value from
+    /// @param  value   the value to remove
+    /// @return whether the value was found and removed
+    /// @note   does not free the cell if it becomes empty - call RemoveEmptyCells() for that
+    bool Remove( glm::ivec2 const& cellPos, ValueType const& value );
+
+    /// @brief  moves a value from one cell to another
+    /// @param  from    the cell the value is currently in
+    /// @param  to      the cell to move the value to
+    /// @param  value   the value to move
+    /// @return whether the value was found in the source cell
+    bool Move( glm::ivec2 const& from, glm::ivec2 const& to, ValueType const& value );
+
+    /// @brief  finds the values in the specified cell
+    /// @param  cellPos the cell to find
+    /// @return the values in the cell, or nullptr if the cell is not occupied
+    std::vector< ValueType >* Find( glm::ivec2 const& cellPos );
+
+    /// @brief  finds the values in the specified cell
+    /// @param  cellPos the cell to find
+    /// @return the values in the cell, or nullptr if the cell is not occupied
+    std::vector< ValueType > const* Find( glm::ivec2 const& cellPos ) const;
+
+    /// @brief  frees all cells which contain no values
+    void RemoveEmptyCells();
+
+    /// @brief  removes all values and cells from the grid, keeping allocated storage
+    void Clear();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the number of occupied cells
+    /// @return the number of occupied cells
+    int GetCellCount() const { return m_CellCount; }
+
+    /// @brief  gets the number of slots in the hash table
+    /// @return the number of slots in the hash table
+    int GetCapacity() const { return (int)m_Slots.size(); }
+
+    /// @brief  gets the number of cells that have been allocated, including freed cells available for reuse
+    /// @return the number of allocated cells
+    int GetPooledCellCount() const { return (int)m_Cells.size(); }
+
+
+    /// @brief  iterator to the first occupied Cell
+    Cell* begin() { return m_Cells.data(); }
+
+    /// @brief  iterator past the last occupied Cell
+    Cell* end() { return m_Cells.data() + m_CellCount; }
+
+    /// @brief  iterator to the first occupied Cell
+    Cell const* begin() const { return m_Cells.data(); }
+
+    /// @brief  iterator past the last occupied Cell
+    Cell const* end() const { return m_Cells.data() + m_CellCount; }
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a slot in the open-addressed hash table
+    struct Slot
+    {
+        /// @brief  the position of the cell this slot refers to
+        glm::ivec2 position = { 0, 0 };
+
+        /// @brief  the index of the cell in m_Cells, or -1 if this slot is empty
+        int cellIndex = -1;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  pool of cells - the first m_CellCount are occupied, the rest are free for reuse
+    std::vector< Cell > m_Cells = {};
+
+    /// @brief  the number of occupied cells
+    int m_CellCount = 0;
+
+    /// @brief  open-addressed hash table mapping cell positions to cell indices
+    std::vector< Slot > m_Slots = {};
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  hashes a cell position
+    /// @param  cellPos the cell position to hash
+    /// @return the hash of the cell position
+    static unsigned hash( glm::ivec2 const& cellPos );
+
+    /// @brief  finds the slot containing the specified cell
+    /// @param  cellPos the cell to find
+    /// @return the index of the slot, or -1 if the cell is not occupied
+    int findSlot( glm::ivec2 const& cellPos ) const;
+
+    /// @brief  occupies a new cell at the specified position
+    /// @param  cellPos the position of the new cell
+    /// @return the index of the new cell
+    int addCell( glm::ivec2 const& cellPos );
+
+    /// @brief  frees the specified cell
+    /// @param  cellIndex   the index of the cell to free
+    void removeCell( int cellIndex );
+
+    /// @brief  inserts a cell into the hash table
+    /// @param  cellPos     the position of the cell
+    /// @param  cellIndex   the index of the cell
+    void insertSlot( glm::ivec2 const& cellPos, int cellIndex );
+
+    /// @brief  removes a slot from the hash table, shifting later entries in its probe chain backwards
+    /// @param  slotIndex   the index of the slot to remove
+    void eraseSlot( int slotIndex );
+
+    /// @brief  doubles the size of the hash table and re-inserts all cells
+    void grow();
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+#ifndef SPATIALHASHGRID_C
+#include "SpatialHashGrid.t.cpp"
+#endif
@@ -0,0 +1,299 @@
+/// @file       SpatialHashGrid.t.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      flat, open-addressed hash grid which buckets values by integer cell position
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#include "pch.h" // precompiled header has to be included first
+#define SPATIALHASHGRID_C
+
+#ifndef SPATIALHASHGRID_H
+#include "SpatialHashGrid.h"
+#endif
+
+
+//-----------------------------------------------------------------------------
+// public: constructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructor
+    /// @param  initialCapacity the initial number of slots in the hash table (rounded up to a power of two)
+    template < typename ValueType >
+    SpatialHashGrid< ValueType >::SpatialHashGrid( int initialCapacity )
+    {
+        int capacity = 8;
+        while ( capacity < initialCapacity )
+        {
+            capacity <<= 1;
+        }
+
+        m_Slots.resize( capacity );
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  inserts a value into the specified cell, creating the cell if needed
+    /// @param  cellPos the cell to insert the value into
+    /// @param  value   the value to insert
+    /// @note   invalidates Cell references and iterators
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::Insert( glm::ivec2 const& cellPos, ValueType const& value )
+    {
+        int slotIndex = findSlot( cellPos );
+        int cellIndex = slotIndex != -1 ? m_Slots[ slotIndex ].cellIndex : addCell( cellPos );
+
+        m_Cells[ cellIndex ].values.push_back( value );
+    }
+
+    /// @brief  removes a value from the specified cell
+    /// @param  cellPos the cell to remove the value from
+    /// @param  value   the value to remove
+    /// @return whether the value was found and removed
+    /// @note   does not free the cell if it becomes empty - call RemoveEmptyCells() for that
+    template < typename ValueType >
+    bool SpatialHashGrid< ValueType >::Remove( glm::ivec2 const& cellPos, ValueType const& value )
+    {
+        std::vector< ValueType >* values = Find( cellPos );
+        if ( values == nullptr )
+        {
+            return false;
+        }
+
+        auto it = std::find( values->begin(), values->end(), value );
+        if ( it == values->end() )
+        {
+            return false;
+        }
+
+        // order within a cell doesn't matter, so swap with the back instead of shifting
+        *it = values->back();
+        values->pop_back();
+        return true;
+    }
+
+    /// @brief  moves a value from one cell to another
+    /// @param  from    the cell the value is currently in
+    /// @param  to      the cell to move the value to
+    /// @param  value   the value to move
+    /// @return whether the value was found in the source cell
+    template < typename ValueType >
+    bool SpatialHashGrid< ValueType >::Move( glm::ivec2 const& from, glm::ivec2 const& to, ValueType const& value )
+    {
+        if ( from == to )
+        {
+            return Find( from ) != nullptr;
+        }
+
+        if ( Remove( from, value ) == false )
+        {
+            return false;
+        }
+
+        Insert( to, value );
+        return true;
+    }
+
+    /// @brief  finds the values in the specified cell
+    /// @param  cellPos the cell to find
+    /// @return the values in the cell, or nullptr if the cell is not occupied
+    template < typename ValueType >
+    std::vector< ValueType >* SpatialHashGrid< ValueType >::Find( glm::ivec2 const& cellPos )
+    {
+        int slotIndex = findSlot( cellPos );
+        if ( slotIndex == -1 )
+        {
+            return nullptr;
+        }
+
+        return &m_Cells[ m_Slots[ slotIndex ].cellIndex ].values;
+    }
+
+    /// @brief  finds the values in the specified cell
+    /// @param  cellPos the cell to find
+    /// @return the values in the cell, or nullptr if the cell is not occupied
+    template < typename ValueType >
+    std::vector< ValueType > const* SpatialHashGrid< ValueType >::Find( glm::ivec2 const& cellPos ) const
+    {
+        int slotIndex = findSlot( cellPos );
+        if ( slotIndex == -1 )
+        {
+            return nullptr;
+        }
+
+        return &m_Cells[ m_Slots[ slotIndex ].cellIndex ].values;
+    }
+
+    /// @brief  frees all cells which contain no values
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::RemoveEmptyCells()
+    {
+        // iterate backwards so that cells swapped in from the back have already been visited
+        for ( int i = m_CellCount - 1; i >= 0; --i )
+        {
+            if ( m_Cells[ i ].values.empty() )
+            {
+                removeCell( i );
+            }
+        }
+    }
+
+    /// @brief  removes all values and cells from the grid, keeping allocated storage
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::Clear()
+    {
+        for ( int i = 0; i < m_CellCount; ++i )
+        {
+            m_Cells[ i ].values.clear();
+        }
+        m_CellCount = 0;
+
+        for ( Slot& slot : m_Slots )
+        {
+            slot.cellIndex = -1;
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  hashes a cell position
+    /// @param  cellPos the cell position to hash
+    /// @return the hash of the cell position
+    template < typename ValueType >
+    unsigned SpatialHashGrid< ValueType >::hash( glm::ivec2 const& cellPos )
+    {
+        unsigned h = (unsigned)cellPos.x * 0x9E3779B1u ^ (unsigned)cellPos.y * 0x85EBCA77u;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        return h;
+    }
+
+    /// @brief  finds the slot containing the specified cell
+    /// @param  cellPos the cell to find
+    /// @return the index of the slot, or -1 if the cell is not occupied
+    template < typename ValueType >
+    int SpatialHashGrid< ValueType >::findSlot( glm::ivec2 const& cellPos ) const
+    {
+        unsigned mask = (unsigned)m_Slots.size() - 1;
+        for ( unsigned i = hash( cellPos ) & mask; ; i = (i + 1) & mask )
+        {
+            Slot const& slot = m_Slots[ i ];
+            if ( slot.cellIndex == -1 )
+            {
+                return -1;
+            }
+
+            if ( slot.position == cellPos )
+            {
+                return (int)i;
+            }
+        }
+    }
+
+    /// @brief  occupies a new cell at the specified position
+    /// @param  cellPos the position of the new cell
+    /// @return the index of the new cell
+    template < typename ValueType >
+    int SpatialHashGrid< ValueType >::addCell( glm::ivec2 const& cellPos )
+    {
+        // keep the load factor at or below one half
+        if ( (m_CellCount + 1) * 2 > (int)m_Slots.size() )
+        {
+            grow();
+        }
+
+        if ( m_CellCount == (int)m_Cells.size() )
+        {
+            m_Cells.emplace_back();
+        }
+
+        int cellIndex = m_CellCount++;
+        m_Cells[ cellIndex ].position = cellPos;
+        insertSlot( cellPos, cellIndex );
+
+        return cellIndex;
+    }
+
+    /// @brief  frees the specified cell
+    /// @param  cellIndex   the index of the cell to free
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::removeCell( int cellIndex )
+    {
+        eraseSlot( findSlot( m_Cells[ cellIndex ].position ) );
+
+        int lastIndex = m_CellCount - 1;
+        if ( cellIndex != lastIndex )
+        {
+            // swap the last occupied cell into the hole so that occupied cells stay contiguous
+            std::swap( m_Cells[ cellIndex ], m_Cells[ lastIndex ] );
+            m_Slots[ findSlot( m_Cells[ cellIndex ].position ) ].cellIndex = cellIndex;
+        }
+
+        m_Cells[ lastIndex ].values.clear();
+        --m_CellCount;
+    }
+
+    /// @brief  inserts a cell into the hash table
+    /// @param  cellPos     the position of the cell
+    /// @param  cellIndex   the index of the cell
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::insertSlot( glm::ivec2 const& cellPos, int cellIndex )
+    {
+        unsigned mask = (unsigned)m_Slots.size() - 1;
+        unsigned i = hash( cellPos ) & mask;
+        while ( m_Slots[ i ].cellIndex != -1 )
+        {
+            i = (i + 1) & mask;
+        }
+
+        m_Slots[ i ].position = cellPos;
+        m_Slots[ i ].cellIndex = cellIndex;
+    }
+
+    /// @brief  removes a slot from the hash table, shifting later entries in its probe chain backwards
+    /// @param  slotIndex   the index of the slot to remove
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::eraseSlot( int slotIndex )
+    {
+        unsigned mask = (unsigned)m_Slots.size() - 1;
+        unsigned hole = (unsigned)slotIndex;
+
+        for ( unsigned i = (hole + 1) & mask; m_Slots[ i ].cellIndex != -1; i = (i + 1) & mask )
+        {
+            // move the entry into the hole only if its home slot isn't between the hole and its current slot
+            unsigned home = hash( m_Slots[ i ].position ) & mask;
+            if ( ((i - home) & mask) >= ((i - hole) & mask) )
+            {
+                m_Slots[ hole ] = m_Slots[ i ];
+                hole = i;
+            }
+        }
+
+        m_Slots[ hole ].cellIndex = -1;
+    }
+
+    /// @brief  doubles the size of the hash table and re-inserts all cells
+    template < typename ValueType >
+    void SpatialHashGrid< ValueType >::grow()
+    {
+        m_Slots.assign( m_Slots.size() * 2, Slot() );
+
+        for ( int i = 0; i < m_CellCount; ++i )
+        {
+            insertSlot( m_Cells[ i ].position, i );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
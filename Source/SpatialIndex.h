@@ -0,0 +1,221 @@
+/// @file       SpatialIndex.h
+/// @author     Oblivion Owls Inc
+/// @brief      point index which answers radius, nearest, and k-nearest queries
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#define SPATIALINDEX_H
+
+#include "pch.h"
+
+#include "SpatialHashGrid.h"
+#include "CollisionLayerFlags.h"
+
+
+/// @brief  point index which answers radius, nearest, and k-nearest queries
+/// @tparam ValueType   the type of value stored in the index (must be hashable and comparable)
+/// @note   each value may also have a radius of its own, in which case radius queries find values whose
+///         circles overlap the query circle
+template < typename ValueType >
+class SpatialIndex
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a single value stored in the index
+    struct Entry
+    {
+        /// @brief  the value
+        ValueType value;
+
+        /// @brief  the position of the value
+        glm::vec2 position = { 0, 0 };
+
+        /// @brief  the radius of the value
+        float radius = 0.0f;
+
+        /// @brief  the collision layer of the value, or NoLayer if it doesn't have one
+        unsigned layer = NoLayer;
+
+        /// @brief  entries are identified by their value alone
+        /// @param  other   the entry to compare to
+        /// @return whether the entries refer to the same value
+        bool operator ==( Entry const& other ) const { return value == other.value; }
+    };
+
+
+    /// @brief  layer given to values which don't belong to a collision layer
+    static constexpr unsigned NoLayer = UINT_MAX;
+
+    /// @brief  layer flags which match every value, including values without a layer
+    static constexpr unsigned AllLayers = UINT_MAX;
+
+
+//-----------------------------------------------------------------------------
+public: // constructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructor
+    /// @param  cellSize    the size of each cell of the index
+    SpatialIndex( float cellSize = 1.0f );
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  adds a value to the index
+    /// @param  value       the value to add
+    /// @param  position    the position of the value
+    /// @param  radius      the radius of the value
+    /// @param  layer       the collision layer of the value
+    void Insert( ValueType const& value, glm::vec2 const& position, float radius = 0.0f, unsigned layer = NoLayer );
+
+    /// @brief  removes a value from the index
+    /// @param  value   the value to remove
+    void Remove( ValueType const& value );
+
+    /// @brief  moves a value in the index
+    /// @param  value       the value to move
+    /// @param  position    the new position of the value
+    void Move( ValueType const& value, glm::vec2 const& position );
+
+    /// @brief  sets the radius of a value in the index
+    /// @param  value   the value to modify
+    /// @param  radius  the new radius of the value
+    void SetRadius( ValueType const& value, float radius );
+
+    /// @brief  sets the collision layer of a value in the index
+    /// @param  value   the value to modify
+    /// @param  layer   the new collision layer of the value
+    void SetLayer( ValueType const& value, unsigned layer );
+
+    /// @brief  removes all values from the index
+    void Clear();
+
+
+    /// @brief  finds all values whose circles overlap a query circle
+    /// @param  center  the center of the query circle
+    /// @param  radius  the radius of the query circle
+    /// @param  results vector to append the found values to (in no particular order)
+    /// @param  layers  which collision layers to include
+    void QueryRadius(
+        glm::vec2 const& center, float radius,
+        std::vector< ValueType >& results,
+        CollisionLayerFlags layers = AllLayers
+    ) const;
+
+    /// @brief  finds the value nearest to a point
+    /// @param  center          the point to search from
+    /// @param  maxDistance     the maximum distance to search (extended by each value's radius)
+    /// @param  layers          which collision layers to include
+    /// @return the nearest value, or a default-constructed value if none found
+    ValueType QueryNearest(
+        glm::vec2 const& center, float maxDistance = INFINITY,
+        CollisionLayerFlags layers = AllLayers
+    ) const;
+
+    /// @brief  finds the k values nearest to a point
+    /// @param  center          the point to search from
+    /// @param  k               the maximum number of values to find
+    /// @param  results         vector to append the found values to, nearest first
+    /// @param  maxDistance     the maximum distance to search (extended by each value's radius)
+    /// @param  layers          which collision layers to include
+    void QueryKNearest(
+        glm::vec2 const& center, int k,
+        std::vector< ValueType >& results,
+        float maxDistance = INFINITY,
+        CollisionLayerFlags layers = AllLayers
+    ) const;
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the size of each cell of the index
+    /// @return the size of each cell
+    float GetCellSize() const { return m_CellSize; }
+
+    /// @brief  gets the number of values in the index
+    /// @return the number of values in the index
+    int GetCount() const { return (int)m_ValueCells.size(); }
+
+    /// @brief  gets the number of occupied cells
+    /// @return the number of occupied cells
+    int GetCellCount() const { return m_Grid.GetCellCount(); }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the grid the entries are bucketed into
+    SpatialHashGrid< Entry > m_Grid;
+
+    /// @brief  which cell each value is currently in
+    std::unordered_map< ValueType, glm::ivec2 > m_ValueCells = {};
+
+    /// @brief  the size of each cell
+    float m_CellSize = 1.0f;
+
+    /// @brief  the largest radius of any value (only grows until the index is cleared)
+    float m_MaxRadius = 0.0f;
+
+    /// @brief  the lowest cell that has been occupied (only grows until the index is cleared)
+    glm::ivec2 m_MinCell = { INT_MAX, INT_MAX };
+
+    /// @brief  the highest cell that has been occupied (only grows until the index is cleared)
+    glm::ivec2 m_MaxCell = { INT_MIN, INT_MIN };
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the cell containing a position
+    /// @param  position    the position to get the cell of
+    /// @return the cell containing the position
+    glm::ivec2 getCell( glm::vec2 const& position ) const;
+
+    /// @brief  finds the entry of a value
+    /// @param  value   the value to find
+    /// @return the entry of the value, or nullptr if the value isn't in the index
+    Entry* findEntry( ValueType const& value );
+
+    /// @brief  checks whether an entry is on one of the specified layers
+    /// @param  entry   the entry to check
+    /// @param  layers  the layers to check against
+    /// @return whether the entry is on one of the layers
+    static bool isOnLayers( Entry const& entry, CollisionLayerFlags layers );
+
+    /// @brief  calls a function on every entry in the cells surrounding a point, ring by ring, until the
+    ///         function reports that no farther entry could matter
+    /// @tparam VisitFunction   void( Entry const& entry, float squaredDistance )
+    /// @tparam DoneFunction    bool( float minSquaredDistance )
+    /// @param  center      the point to search from
+    /// @param  maxDistance the maximum distance to search
+    /// @param  visit       function to call on each entry
+    /// @param  done        function which checks whether entries at least a given distance away can be skipped
+    template < typename VisitFunction, typename DoneFunction >
+    void searchRings( glm::vec2 const& center, float maxDistance, VisitFunction const& visit, DoneFunction const& done ) const;
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+#ifndef SPATIALINDEX_C
+#include "SpatialIndex.t.cpp"
+#endif
@@ -0,0 +1,483 @@
+/// @file       SpatialIndex.t.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      point index which answers radius, nearest, and k-nearest queries
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#include "pch.h" // precompiled header has to be included first
+#define SPATIALINDEX_C
+
+#ifndef SPATIALINDEX_H
+#include "SpatialIndex.h"
+#endif
+
+
+//-----------------------------------------------------------------------------
+// public: constructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructor
+    /// @param  cellSize    the size of each cell of the index
+    template < typename ValueType >
+    SpatialIndex< ValueType >::SpatialIndex( float cellSize ) :
+        m_CellSize( cellSize > 0.0f ? cellSize : 1.0f )
+    {}
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  adds a value to the index
+    /// @param  value       the value to add
+    /// @param  position    the position of the value
+    /// @param  radius      the radius of the value
+    /// @param  layer       the collision layer of the value
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::Insert( ValueType const& value, glm::vec2 const& position, float radius, unsigned layer )
+    {
+        if ( m_ValueCells.contains( value ) )
+        {
+            Remove( value );
+        }
+
+        glm::ivec2 cell = getCell( position );
+        m_Grid.Insert( cell, Entry{ value, position, radius, layer } );
+        m_ValueCells[ value ] = cell;
+
+        m_MaxRadius = std::max( m_MaxRadius, radius );
+        m_MinCell = glm::min( m_MinCell, cell );
+        m_MaxCell = glm::max( m_MaxCell, cell );
+    }
+
+    /// @brief  removes a value from the index
+    /// @param  value   the value to remove
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::Remove( ValueType const& value )
+    {
+        auto it = m_ValueCells.find( value );
+        if ( it == m_ValueCells.end() )
+        {
+            return;
+        }
+
+        m_Grid.Remove( it->second, Entry{ value } );
+        m_ValueCells.erase( it );
+
+        // free empty cells once they start to outnumber the values
+        if ( m_Grid.GetCellCount() > 2 * GetCount() + 16 )
+        {
+            m_Grid.RemoveEmptyCells();
+        }
+    }
+
+    /// @brief  moves a value in the index
+    /// @param  value       the value to move
+    /// @param  position    the new position of the value
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::Move( ValueType const& value, glm::vec2 const& position )
+    {
+        auto it = m_ValueCells.find( value );
+        if ( it == m_ValueCells.end() )
+        {
+            return;
+        }
+
+        glm::ivec2 cell = getCell( position );
+        if ( cell == it->second )
+        {
+            findEntry( value )->position = position;
+            return;
+        }
+
+        Entry entry = *findEntry( value );
+        entry.position = position;
+
+        m_Grid.Remove( it->second, entry );
+        m_Grid.Insert( cell, entry );
+        it->second = cell;
+
+        m_MinCell = glm::min( m_MinCell, cell );
+        m_MaxCell = glm::max( m_MaxCell, cell );
+
+        if ( m_Grid.GetCellCount() > 2 * GetCount() + 16 )
+        {
+            m_Grid.RemoveEmptyCells();
+        }
+    }
+
+    /// @brief  sets the radius of a value in the index
+    /// @param  value   the value to modify
+    /// @param  radius  the new radius of the value
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::SetRadius( ValueType const& value, float radius )
+    {
+        Entry* entry = findEntry( value );
+        if ( entry == nullptr )
+        {
+            return;
+        }
+
+        entry->radius = radius;
+        m_MaxRadius = std::max( m_MaxRadius, radius );
+    }
+
+    /// @brief  sets the collision layer of a value in the index
+    /// @param  value   the value to modify
+    /// @param  layer   the new collision layer of the value
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::SetLayer( ValueType const& value, unsigned layer )
+    {
+        Entry* entry = findEntry( value );
+        if ( entry == nullptr )
+        {
+            return;
+        }
+
+        entry->layer = layer;
+    }
+
+    /// @brief  removes all values from the index
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::Clear()
+    {
+        m_Grid.Clear();
+        m_ValueCells.clear();
+
+        m_MaxRadius = 0.0f;
+        m_MinCell = { INT_MAX, INT_MAX };
+        m_MaxCell = { INT_MIN, INT_MIN };
+    }
+
+
+    /// @brief  finds all values whose circles overlap a query circle
+    /// @param  center  the center of the query circle
+    /// @param  radius  the radius of the query circle
+    /// @param  results vector to append the found values to (in no particular order)
+    /// @param  layers  which collision layers to include
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::QueryRadius(
+        glm::vec2 const& center, float radius,
+        std::vector< ValueType >& results,
+        CollisionLayerFlags layers
+    ) const
+    {
+        if ( GetCount() == 0 )
+        {
+            return;
+        }
+
+        auto check = [ & ]( Entry const& entry )
+        {
+            glm::vec2 offset = entry.position - center;
+            float reach = radius + entry.radius;
+            if ( glm::dot( offset, offset ) <= reach * reach && isOnLayers( entry, layers ) )
+            {
+                results.push_back( entry.value );
+            }
+        };
+
+        // every value within reach is in a cell overlapping the query circle grown by the largest radius
+        float reach = radius + m_MaxRadius;
+        glm::ivec2 min = glm::max( getCell( center - reach ), m_MinCell );
+        glm::ivec2 max = glm::min( getCell( center + reach ), m_MaxCell );
+        if ( min.x > max.x || min.y > max.y )
+        {
+            return;
+        }
+
+        // if the query covers more cells than are occupied, it's cheaper to visit the occupied cells directly
+        if ( (long long)( max.x - min.x + 1 ) * ( max.y - min.y + 1 ) > m_Grid.GetCellCount() )
+        {
+            for ( auto const& cell : m_Grid )
+            {
+                if ( glm::any( glm::lessThan( cell.position, min ) ) || glm::any( glm::greaterThan( cell.position, max ) ) )
+                {
+                    continue;
+                }
+
+                for ( Entry const& entry : cell.values )
+                {
+                    check( entry );
+                }
+            }
+            return;
+        }
+
+        for ( int y = min.y; y <= max.y; ++y )
+        {
+            for ( int x = min.x; x <= max.x; ++x )
+            {
+                std::vector< Entry > const* entries = m_Grid.Find( { x, y } );
+                if ( entries == nullptr )
+                {
+                    continue;
+                }
+
+                for ( Entry const& entry : *entries )
+                {
+                    check( entry );
+                }
+            }
+        }
+    }
+
+    /// @brief  finds the value nearest to a point
+    /// @param  center          the point to search from
+    /// @param  maxDistance     the maximum distance to search (extended by each value's radius)
+    /// @param  layers          which collision layers to include
+    /// @return the nearest value, or a default-constructed value if none found
+    template < typename ValueType >
+    ValueType SpatialIndex< ValueType >::QueryNearest(
+        glm::vec2 const& center, float maxDistance,
+        CollisionLayerFlags layers
+    ) const
+    {
+        ValueType nearest = ValueType();
+        float nearestSquaredDistance = INFINITY;
+
+        searchRings(
+            center, maxDistance,
+            [ & ]( Entry const& entry, float squaredDistance )
+            {
+                float reach = maxDistance + entry.radius;
+                if (
+                    squaredDistance < nearestSquaredDistance &&
+                    squaredDistance <= reach * reach &&
+                    isOnLayers( entry, layers )
+                )
+                {
+                    nearest = entry.value;
+                    nearestSquaredDistance = squaredDistance;
+                }
+            },
+            [ & ]( float minSquaredDistance )
+            {
+                return minSquaredDistance >= nearestSquaredDistance;
+            }
+        );
+
+        return nearest;
+    }
+
+    /// @brief  finds the k values nearest to a point
+    /// @param  center          the point to search from
+    /// @param  k               the maximum number of values to find
+    /// @param  results         vector to append the found values to, nearest first
+    /// @param  maxDistance     the maximum distance to search (extended by each value's radius)
+    /// @param  layers          which collision layers to include
+    template < typename ValueType >
+    void SpatialIndex< ValueType >::QueryKNearest(
+        glm::vec2 const& center, int k,
+        std::vector< ValueType >& results,
+        float maxDistance,
+        CollisionLayerFlags layers
+    ) const
+    {
+        if ( k <= 0 )
+        {
+            return;
+        }
+
+        // max-heap of the nearest values found so far, farthest on top
+        std::vector< std::pair< float, ValueType > > nearest;
+        nearest.reserve( k );
+        auto farther = []( std::pair< float, ValueType > const& a, std::pair< float, ValueType > const& b )
+        {
+            return a.first < b.first;
+        };
+
+        searchRings(
+            center, maxDistance,
+            [ & ]( Entry const& entry, float squaredDistance )
+            {
+                float reach = maxDistance + entry.radius;
+                if ( squaredDistance > reach * reach || isOnLayers( entry, layers ) == false )
+                {
+                    return;
+                }
+
+                if ( (int)nearest.size() < k )
+                {
+                    nearest.push_back( { squaredDistance, entry.value } );
+                    std::push_heap( nearest.begin(), nearest.end(), farther );
+                }
+                else if ( squaredDistance < nearest.front().first )
+                {
+                    std::pop_heap( nearest.begin(), nearest.end(), farther );
+                    nearest.back() = { squaredDistance, entry.value };
+                    std::push_heap( nearest.begin(), nearest.end(), farther );
+                }
+            },
+            [ & ]( float minSquaredDistance )
+            {
+                return (int)nearest.size() == k && minSquaredDistance >= nearest.front().first;
+            }
+        );
+
+        std::sort_heap( nearest.begin(), nearest.end(), farther );
+        for ( auto const& [ squaredDistance, value ] : nearest )
+        {
+            results.push_back( value );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the cell containing a position
+    /// @param  position    the position to get the cell of
+    /// @return the cell containing the position
+    template < typename ValueType >
+    glm::ivec2 SpatialIndex< ValueType >::getCell( glm::vec2 const& position ) const
+    {
+        // clamp so that far-off or infinite positions don't overflow
+        glm::vec2 cell = glm::clamp( glm::floor( position / m_CellSize ), glm::vec2( -1e9f ), glm::vec2( 1e9f ) );
+        return glm::ivec2( cell );
+    }
+
+    /// @brief  finds the entry of a value
+    /// @param  value   the value to find
+    /// @return the entry of the value, or nullptr if the value isn't in the index
+    template < typename ValueType >
+    typename SpatialIndex< ValueType >::Entry* SpatialIndex< ValueType >::findEntry( ValueType const& value )
+    {
+        auto it = m_ValueCells.find( value );
+        if ( it == m_ValueCells.end() )
+        {
+            return nullptr;
+        }
+
+        std::vector< Entry >* entries = m_Grid.Find( it->second );
+        return &*std::find( entries->begin(), entries->end(), Entry{ value } );
+    }
+
+    /// @brief  checks whether an entry is on one of the specified layers
+    /// @param  entry   the entry to check
+    /// @param  layers  the layers to check against
+    /// @return whether the entry is on one of the layers
+    template < typename ValueType >
+    bool SpatialIndex< ValueType >::isOnLayers( Entry const& entry, CollisionLayerFlags layers )
+    {
+        if ( (unsigned)layers == AllLayers )
+        {
+            return true;
+        }
+
+        return entry.layer != NoLayer && layers.Includes( entry.layer );
+    }
+
+    /// @brief  calls a function on every entry in the cells surrounding a point, ring by ring, until the
+    ///         function reports that no farther entry could matter
+    /// @tparam VisitFunction   void( Entry const& entry, float squaredDistance )
+    /// @tparam DoneFunction    bool( float minSquaredDistance )
+    /// @param  center      the point to search from
+    /// @param  maxDistance the maximum distance to search
+    /// @param  visit       function to call on each entry
+    /// @param  done        function which checks whether entries at least a given distance away can be skipped
+    template < typename ValueType >
+    template < typename VisitFunction, typename DoneFunction >
+    void SpatialIndex< ValueType >::searchRings(
+        glm::vec2 const& center, float maxDistance,
+        VisitFunction const& visit, DoneFunction const& done
+    ) const
+    {
+        if ( GetCount() == 0 )
+        {
+            return;
+        }
+
+        auto visitCell = [ & ]( std::vector< Entry > const& entries )
+        {
+            for ( Entry const& entry : entries )
+            {
+                glm::vec2 offset = entry.position - center;
+                visit( entry, glm::dot( offset, offset ) );
+            }
+        };
+
+        glm::ivec2 origin = getCell( center );
+
+        // the farthest ring that could contain anything
+        glm::ivec2 extent = glm::max( glm::abs( m_MinCell - origin ), glm::abs( m_MaxCell - origin ) );
+        int lastRing = std::max( extent.x, extent.y );
+        float reachInCells = ( maxDistance + m_MaxRadius ) / m_CellSize;
+        if ( reachInCells < (float)lastRing )
+        {
+            lastRing = (int)std::ceil( reachInCells );
+        }
+
+        int cellsVisited = 0;
+        for ( int ring = 0; ring <= lastRing; ++ring )
+        {
+            // every point in this ring is at least (ring - 1) cells away from the center
+            if ( ring > 0 )
+            {
+                float minDistance = ( ring - 1 ) * m_CellSize;
+                if ( done( minDistance * minDistance ) )
+                {
+                    return;
+                }
+            }
+
+            // once the rings cover more cells than are occupied, visit the remaining occupied cells directly
+            int ringCellCount = ring == 0 ? 1 : 8 * ring;
+            if ( cellsVisited + ringCellCount > m_Grid.GetCellCount() )
+            {
+                for ( auto const& cell : m_Grid )
+                {
+                    glm::ivec2 offset = glm::abs( cell.position - origin );
+                    if ( std::max( offset.x, offset.y ) >= ring )
+                    {
+                        visitCell( cell.values );
+                    }
+                }
+                return;
+            }
+            cellsVisited += ringCellCount;
+
+            if ( ring == 0 )
+            {
+                std::vector< Entry > const* entries = m_Grid.Find( origin );
+                if ( entries != nullptr )
+                {
+                    visitCell( *entries );
+                }
+                continue;
+            }
+
+            // top and bottom rows of the ring, then the left and right columns between them
+            for ( int x = -ring; x <= ring; ++x )
+            {
+                for ( int y : { -ring, ring } )
+                {
+                    std::vector< Entry > const* entries = m_Grid.Find( origin + glm::ivec2( x, y ) );
+                    if ( entries != nullptr )
+                    {
+                        visitCell( *entries );
+                    }
+                }
+            }
+            for ( int y = -ring + 1; y <= ring - 1; ++y )
+            {
+                for ( int x : { -ring, ring } )
+                {
+                    std::vector< Entry > const* entries = m_Grid.Find( origin + glm::ivec2( x, y ) );
+                    if ( entries != nullptr )
+                    {
+                        visitCell( *entries );
+                    }
+                }
+            }
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
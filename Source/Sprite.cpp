@@ -14,6 +14,9 @@
 #include "Entity.h"         // parent
 #include "CameraSystem.h"   // projection matrix
 
+#include "SpriteBatcher.h"  // SpriteInstance
+#include "ViewFrustum.h"    // bounds
+
 #include "AssetLibrarySystem.h"
 #include "Inspection.h"
 
@@ -66,6 +69,23 @@ Sprite::Sprite( std::type_index type ) :
 /// @brief  Creates new Sprite using copy constructor.
 /// @return pointer to copied Sprite component.
 Sprite* Sprite::Clone() const { return new Sprite( *this ); }
+
+/// @brief  resets this Sprite to a copy of another Sprite so that its Entity can be pooled
+/// @param  other   the Sprite to copy
+void Sprite::ResetTo( Component const& other )
+{
+    Component::ResetTo( other );
+
+    Sprite const& sprite = static_cast< Sprite const& >( other );
+    m_Color      = sprite.m_Color;
+    m_Opacity    = sprite.m_Opacity;
+    m_Layer      = sprite.m_Layer;
+    m_FrameIndex = sprite.m_FrameIndex;
+    m_Texture    = sprite.m_Texture;
+
+    m_RenderSlot = -1;
+    m_WorldBoundsMesh = nullptr;
+}
     
 //-----------------------------------------------------------------------------
 // public: copying
@@ -90,25 +110,9 @@ Sprite::Sprite(Sprite const& other) :
     /// @brief          Draws the mesh with texture (if one is present), or color.
     void Sprite::Draw()
     {
-        if (!m_Texture)
+        if ( prepareToDraw() == false )
             return;
 
-        if ( m_Transform == nullptr )
-        {
-            m_Transform.Init( GetEntity() );
-            if ( m_Transform == nullptr )
-            {
-                Debug() << "WARNING: Sprite component must have an attached Transform on entity \"" << GetEntity()->GetName() << "\"" << std::endl;
-                return;
-            }
-        }
-
-        if ( m_Texture->GetMesh() == nullptr )
-        {
-            Debug() << "WARNING: texture attached to sprite on \"" << GetEntity()->GetName() << "\" does not have an associated mesh"<< std::endl;
-            return;
-        }
-
         Shader* sh = Renderer()->SetActiveShader("texture");
         m_Texture->Bind();
         glm::vec2 uv_offset = calcUVoffset();
@@ -116,17 +120,7 @@ Sprite::Sprite(Sprite const& other) :
     
 
         // Stuff they both have in common: transform and opacity
-        glm::mat4 mat(1);   // it can still draw without parent and transform
-        if (m_Transform)
-        {
-            mat = m_Transform->GetMatrix();
-
-            // world or UI space
-            if ( m_Transform->GetIsDiegetic() )
-                mat = Cameras()->GetMat_WorldToClip() * mat;
-            else
-                mat = Cameras()->GetMat_UiToClip() * mat;
-        }
+        glm::mat4 mat = calcMvp();
 
         glUniformMatrix4fv(sh->GetUniformID("mvp"), 1, false, &mat[0][0]);
         glUniform1f(sh->GetUniformID("opacity"), m_Opacity);
@@ -139,6 +133,42 @@ Sprite::Sprite(Sprite const& other) :
         glBindVertexArray(0);
     }
 
+    /// @brief  checks whether this Sprite can be drawn as an instance of a batch, rather than by drawing itself
+    /// @return whether this Sprite can be batched
+    bool Sprite::IsBatchable() const
+    {
+        // every derived Sprite draws itself
+        return GetType() == typeid( Sprite );
+    }
+
+    /// @brief  fills in the per-instance data that draws this Sprite as part of a batch
+    /// @param  instance    the instance to fill in
+    /// @param  boundsMin   out: the minimum corner of the area this Sprite covers, in clip space
+    /// @param  boundsMax   out: the maximum corner of the area this Sprite covers, in clip space
+    /// @return whether this Sprite has anything to draw
+    bool Sprite::GetBatchInstance( SpriteInstance* instance, glm::vec2* boundsMin, glm::vec2* boundsMax )
+    {
+        if ( prepareToDraw() == false )
+        {
+            return false;
+        }
+
+        glm::mat4 mvp = calcMvp();
+
+        instance->M_AxisX    = mvp[ 0 ];
+        instance->M_AxisY    = mvp[ 1 ];
+        instance->M_Origin   = mvp[ 3 ];
+        instance->M_Tint     = m_Color;
+        instance->M_UvOffset = calcUVoffset();
+        instance->M_Opacity  = m_Opacity;
+        instance->M_Padding  = 0.0f;
+
+        // clip space is shared by diegetic and non-diegetic Sprites, so their bounds can be compared
+        Mesh const* mesh = m_Texture->GetMesh();
+        ViewFrustum::TransformBounds( mvp, mesh->GetBounds()[ 0 ], mesh->GetBounds()[ 1 ], boundsMin, boundsMax );
+        return true;
+    }
+
 
     /// @brief  checks if a a point in local space overlaps this Sprite
     /// @param  point   the point to check if overlaps this Sprite
@@ -162,6 +192,34 @@ Sprite::Sprite(Sprite const& other) :
     }
 
 
+    /// @brief  gets the AABB this Sprite covers, in world space (or UI space if its Transform isn't diegetic)
+    /// @param  min the minimum corner of the AABB
+    /// @param  max the maximum corner of the AABB
+    /// @return whether the AABB is known - derived Sprites draw themselves, so only they know where they draw
+    /// @note   the AABB is cached, and only recalculated when the Transform or mesh changes
+    bool Sprite::GetWorldBounds( glm::vec2* min, glm::vec2* max )
+    {
+        if ( GetType() != typeid( Sprite ) || m_Transform == nullptr || m_Texture == nullptr || m_Texture->GetMesh() == nullptr )
+        {
+            return false;
+        }
+
+        Mesh const* mesh = m_Texture->GetMesh();
+        if ( mesh != m_WorldBoundsMesh )
+        {
+            ViewFrustum::TransformBounds(
+                m_Transform->GetMatrix(), mesh->GetBounds()[ 0 ], mesh->GetBounds()[ 1 ],
+                &m_WorldBounds[ 0 ], &m_WorldBounds[ 1 ]
+            );
+            m_WorldBoundsMesh = mesh;
+        }
+
+        *min = m_WorldBounds[ 0 ];
+        *max = m_WorldBounds[ 1 ];
+        return true;
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: accessors
 //-----------------------------------------------------------------------------
@@ -191,7 +249,19 @@ Sprite::Sprite(Sprite const& other) :
     /// @param  layer   Rendering layer to move this sprite to.
     void Sprite::SetLayer( int layer )
     {
+        if ( layer == m_Layer )
+        {
+            return;
+        }
+
+        int previousLayer = m_Layer;
         m_Layer = layer;
+
+        // only the Sprites that changed layer get moved, rather than re-sorting every Sprite every frame
+        if ( m_RenderSlot != -1 )
+        {
+            Renderer()->OnSpriteLayerChanged( this, previousLayer );
+        }
     }
 
     /// @brief  gets the opacity
@@ -259,6 +329,20 @@ Sprite::Sprite(Sprite const& other) :
     {
         Renderer()->AddSprite( this );
 
+        // the cached bounds need recalculating whenever the Transform moves
+        m_Transform.SetOnConnectCallback(
+            [ this ]()
+            {
+                m_WorldBoundsMesh = nullptr;
+                m_Transform->AddOnTransformChangedCallback( GetId(), [ this ]() { m_WorldBoundsMesh = nullptr; } );
+            }
+        );
+        m_Transform.SetOnDisconnectCallback(
+            [ this ]()
+            {
+                m_Transform->RemoveOnTransformChangedCallback( GetId() );
+            }
+        );
         m_Transform.Init( GetEntity() );
 
         m_Texture.SetOwnerName( GetName() );
@@ -276,9 +360,10 @@ Sprite::Sprite(Sprite const& other) :
 
     void Sprite::Inspector()
     {
-        if ( ImGui::DragInt( "Layer", &m_Layer, 0.05f ) )
+        int layer = m_Layer;
+        if ( ImGui::DragInt( "Layer", &layer, 0.05f ) )
         {
-            SetLayer(m_Layer);
+            SetLayer(layer);
         }
         if ( ImGui::ColorEdit3( "Color", &m_Color[ 0 ] ) )
         {
@@ -326,6 +411,51 @@ Sprite::Sprite(Sprite const& other) :
         return m_Texture->GetUvOffset( m_FrameIndex );
     }
 
+    /// @brief  makes sure this Sprite has everything it needs to be drawn
+    /// @return whether this Sprite can be drawn
+    bool Sprite::prepareToDraw()
+    {
+        if (!m_Texture)
+            return false;
+
+        if ( m_Transform == nullptr )
+        {
+            m_Transform.Init( GetEntity() );
+            if ( m_Transform == nullptr )
+            {
+                Debug() << "WARNING: Sprite component must have an attached Transform on entity \"" << GetEntity()->GetName() << "\"" << std::endl;
+                return false;
+            }
+        }
+
+        if ( m_Texture->GetMesh() == nullptr )
+        {
+            Debug() << "WARNING: texture attached to sprite on \"" << GetEntity()->GetName() << "\" does not have an associated mesh"<< std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief  calculates the matrix that takes this Sprite's mesh to clip space
+    /// @return the mvp matrix of this Sprite
+    glm::mat4 Sprite::calcMvp() const
+    {
+        glm::mat4 mat(1);   // it can still draw without parent and transform
+        if (m_Transform)
+        {
+            mat = m_Transform->GetMatrix();
+
+            // world or UI space
+            if ( m_Transform->GetIsDiegetic() )
+                mat = Cameras()->GetMat_WorldToClip() * mat;
+            else
+                mat = Cameras()->GetMat_UiToClip() * mat;
+        }
+
+        return mat;
+    }
+
 
 //-----------------------------------------------------------------------------
 // protected: reading
@@ -363,7 +493,7 @@ void Sprite::readOpacity( nlohmann::ordered_json const& data )
 /// @param data The json to read from.
 void Sprite::readLayer( nlohmann::ordered_json const& data )
 {
-    m_Layer = Stream::Read<int>( data );
+    SetLayer( Stream::Read<int>( data ) );
 }
 
 /// @brief Write all Sprite component data to a JSON file.
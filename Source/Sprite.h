@@ -14,6 +14,8 @@
 #include "AssetReference.h"
 #include "Texture.h"
 
+struct SpriteInstance;
+
 /// @brief      Stores mesh + texture, along with other data needed to draw a basic 2D sprite.
 class Sprite : public Component
 {
@@ -50,6 +52,15 @@ public: // copying
     /// @return Copy of this component.
     virtual Sprite* Clone() const override;
 
+    /// @brief  checks whether this Sprite can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a Sprite
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< Sprite >( other ); }
+
+    /// @brief  resets this Sprite to a copy of another Sprite so that its Entity can be pooled
+    /// @param  other   the Sprite to copy
+    virtual void ResetTo( Component const& other ) override;
+
 //-----------------------------------------------------------------------------
 protected: // copying
 //-----------------------------------------------------------------------------
@@ -64,12 +75,30 @@ public: // methods
     /// @brief  Draws the mesh with texture (if one is present), or color.
     virtual void Draw();
 
+    /// @brief  checks whether this Sprite can be drawn as an instance of a batch, rather than by drawing itself
+    /// @return whether this Sprite can be batched
+    bool IsBatchable() const;
+
+    /// @brief  fills in the per-instance data that draws this Sprite as part of a batch
+    /// @param  instance    the instance to fill in
+    /// @param  boundsMin   out: the minimum corner of the area this Sprite covers, in clip space
+    /// @param  boundsMax   out: the maximum corner of the area this Sprite covers, in clip space
+    /// @return whether this Sprite has anything to draw
+    bool GetBatchInstance( SpriteInstance* instance, glm::vec2* boundsMin, glm::vec2* boundsMax );
+
 
     /// @brief  checks if a a point in local space overlaps this Sprite
     /// @param  point   the point to check if overlaps this Sprite
     /// @return whether this Sprite overlaps the point
     virtual bool OverlapsLocalPoint( glm::vec2 const& point ) const;
 
+    /// @brief  gets the AABB this Sprite covers, in world space (or UI space if its Transform isn't diegetic)
+    /// @param  min the minimum corner of the AABB
+    /// @param  max the maximum corner of the AABB
+    /// @return whether the AABB is known - derived Sprites draw themselves, so only they know where they draw
+    /// @note   the AABB is cached, and only recalculated when the Transform or mesh changes
+    bool GetWorldBounds( glm::vec2* min, glm::vec2* max );
+
 
 //-----------------------------------------------------------------------------
 public: // accessors
@@ -120,6 +149,15 @@ public: // accessors
     Transform* GetTransform();
 
 
+    /// @brief  gets where this Sprite is within its layer in the RenderSystem
+    /// @return where this Sprite is within its layer, or -1 if it isn't being rendered
+    int GetRenderSlot() const { return m_RenderSlot; }
+
+    /// @brief  sets where this Sprite is within its layer in the RenderSystem - only to be used by the RenderSystem
+    /// @param  renderSlot  where this Sprite is within its layer, or -1 if it isn't being rendered
+    void SetRenderSlot( int renderSlot ) { m_RenderSlot = renderSlot; }
+
+
 //-----------------------------------------------------------------------------
 protected: // virtual override methods
 //-----------------------------------------------------------------------------
@@ -149,6 +187,15 @@ protected: // member variables
     /// @brief  the Transform attached to this Sprite
     ComponentReference< Transform > m_Transform;
 
+    /// @brief  where this Sprite is within its layer in the RenderSystem, or -1 if it isn't being rendered
+    int m_RenderSlot = -1;
+
+    /// @brief  the cached AABB this Sprite covers
+    glm::vec2 m_WorldBounds[ 2 ] = { glm::vec2( 0.0f ), glm::vec2( 0.0f ) };
+
+    /// @brief  the mesh m_WorldBounds was calculated with, or nullptr if it needs recalculating
+    Mesh const* m_WorldBoundsMesh = nullptr;
+
 
 //-----------------------------------------------------------------------------
 protected: // methods
@@ -158,6 +205,14 @@ protected: // methods
     /// @return the UV offset
     glm::vec2 calcUVoffset() const;
 
+    /// @brief  makes sure this Sprite has everything it needs to be drawn
+    /// @return whether this Sprite can be drawn
+    bool prepareToDraw();
+
+    /// @brief  calculates the matrix that takes this Sprite's mesh to clip space
+    /// @return the mvp matrix of this Sprite
+    glm::mat4 calcMvp() const;
+
 //-----------------------------------------------------------------------------
 protected: // reading
 //-----------------------------------------------------------------------------
@@ -0,0 +1,144 @@
+/// @file       SpriteBatcher.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      groups a frame's Sprites into batches that can each be drawn with one instanced draw call
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "SpriteBatcher.h"
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  clears the batches of the previous frame
+    void SpriteBatcher::Begin()
+    {
+        m_Batches.clear();
+        m_Instances.clear();
+        m_SpriteCount = 0;
+
+        m_RunInstances.clear();
+        m_RunBatchIndices.clear();
+        m_RunStart = 0;
+    }
+
+    /// @brief  adds a Sprite that can be drawn as an instance of a batch
+    /// @param  layer       the layer the Sprite is drawn on
+    /// @param  shader      the shader the Sprite is drawn with
+    /// @param  texture     the texture the Sprite is drawn with
+    /// @param  instance    the per-instance data of the Sprite
+    /// @param  boundsMin   the minimum corner of the area the Sprite covers, in clip space
+    /// @param  boundsMax   the maximum corner of the area the Sprite covers, in clip space
+    void SpriteBatcher::Add(
+        int layer, Shader* shader, Texture const* texture, SpriteInstance const& instance,
+        glm::vec2 const& boundsMin, glm::vec2 const& boundsMax
+    )
+    {
+        ++m_SpriteCount;
+
+        // nothing merges across layers
+        if ( layer != m_RunLayer && m_RunStart != (int)m_Batches.size() )
+        {
+            flushRun();
+        }
+        m_RunLayer = layer;
+
+        // walk back from the newest batch. joining an earlier batch draws this Sprite before every batch after it,
+        // so the walk stops at the first batch this Sprite overlaps - it has to stay on top of that one
+        int batchIndex = -1;
+        int const lookBackEnd = std::max( m_RunStart, (int)m_Batches.size() - s_MaxLookBack );
+        for ( int i = (int)m_Batches.size() - 1; i >= lookBackEnd; --i )
+        {
+            Batch const& batch = m_Batches[ i ];
+            if ( batch.M_Shader == shader && batch.M_Texture == texture )
+            {
+                batchIndex = i;
+                break;
+            }
+
+            if (
+                boundsMin.x < batch.M_BoundsMax.x && batch.M_BoundsMin.x < boundsMax.x &&
+                boundsMin.y < batch.M_BoundsMax.y && batch.M_BoundsMin.y < boundsMax.y
+            )
+            {
+                break;
+            }
+        }
+
+        if ( batchIndex == -1 )
+        {
+            batchIndex = (int)m_Batches.size();
+            m_Batches.push_back( { layer, shader, texture, nullptr, 0, 0, boundsMin, boundsMax } );
+        }
+
+        Batch& batch = m_Batches[ batchIndex ];
+        batch.M_BoundsMin = glm::min( batch.M_BoundsMin, boundsMin );
+        batch.M_BoundsMax = glm::max( batch.M_BoundsMax, boundsMax );
+        ++batch.M_InstanceCount;
+        m_RunInstances.push_back( instance );
+        m_RunBatchIndices.push_back( batchIndex );
+    }
+
+    /// @brief  adds a Sprite that has to draw itself
+    /// @param  layer   the layer the Sprite is drawn on
+    /// @param  sprite  the Sprite to draw
+    void SpriteBatcher::AddCustom( int layer, Sprite* sprite )
+    {
+        ++m_SpriteCount;
+
+        flushRun();
+
+        m_Batches.push_back( { layer, nullptr, nullptr, sprite, (int)m_Instances.size(), 0, glm::vec2( 0.0f ), glm::vec2( 0.0f ) } );
+
+        m_RunStart = (int)m_Batches.size();
+        m_RunLayer = layer;
+    }
+
+    /// @brief  finishes building the batches of this frame
+    void SpriteBatcher::End()
+    {
+        flushRun();
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  moves the instances of the current run into m_Instances, grouped by batch, and starts a new run
+    void SpriteBatcher::flushRun()
+    {
+        int batchCount = (int)m_Batches.size() - m_RunStart;
+
+        // lay the batches of the run out one after another
+        m_Cursors.resize( batchCount );
+        int firstInstance = (int)m_Instances.size();
+        for ( int i = 0; i < batchCount; ++i )
+        {
+            Batch& batch = m_Batches[ m_RunStart + i ];
+            batch.M_FirstInstance = firstInstance;
+            m_Cursors[ i ] = firstInstance;
+            firstInstance += batch.M_InstanceCount;
+        }
+
+        // scatter the instances into their batches, keeping the order they were added in
+        m_Instances.resize( firstInstance );
+        for ( int i = 0; i < (int)m_RunInstances.size(); ++i )
+        {
+            m_Instances[ m_Cursors[ m_RunBatchIndices[ i ] - m_RunStart ]++ ] = m_RunInstances[ i ];
+        }
+
+        m_RunInstances.clear();
+        m_RunBatchIndices.clear();
+        m_RunStart = (int)m_Batches.size();
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+/// @file       SpriteBatcher.h
+/// @author     Oblivion Owls Inc
+/// @brief      groups a frame's Sprites into batches that can each be drawn with one instanced draw call
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+
+class Shader;
+class Texture;
+class Sprite;
+
+
+/// @brief  the per-instance data of a batched Sprite, laid out the way sprite_instancing.vert reads it
+/// @note   a Sprite's mesh is flat, so only the x, y, and translation columns of its mvp matrix are needed
+struct SpriteInstance
+{
+    /// @brief  the first column of the Sprite's mvp matrix
+    glm::vec4 M_AxisX;
+
+    /// @brief  the second column of the Sprite's mvp matrix
+    glm::vec4 M_AxisY;
+
+    /// @brief  the fourth column of the Sprite's mvp matrix
+    glm::vec4 M_Origin;
+
+    /// @brief  the tint of the Sprite
+    glm::vec4 M_Tint;
+
+    /// @brief  the UV offset of the Sprite's current frame
+    glm::vec2 M_UvOffset;
+
+    /// @brief  the opacity of the Sprite
+    float M_Opacity;
+
+    /// @brief  unused - keeps instances 16 byte aligned
+    float M_Padding;
+};
+
+
+/// @brief  groups a frame's Sprites into batches that can each be drawn with one instanced draw call
+/// @note   Sprites must be added in draw order. Every Sprite on a layer is still drawn before every Sprite on a later
+///         layer. Within a layer, a Sprite joins the batch before it if that batch shares its shader and texture. It can
+///         also join an earlier matching batch, but only if it doesn't overlap any batch in between, since it would then
+///         be drawn before them. Sprites that can't be batched act as barriers: nothing is merged across them, so they
+///         keep their place relative to everything else on their layer.
+/// @note   the SpriteBatcher never touches the GPU, so its output can be inspected without a rendering context
+class SpriteBatcher
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a group of instances that are drawn with a single draw call
+    struct Batch
+    {
+        /// @brief  the layer the batch is drawn on
+        int M_Layer;
+
+        /// @brief  the shader to draw the batch with
+        Shader* M_Shader;
+
+        /// @brief  the texture to draw the batch with
+        Texture const* M_Texture;
+
+        /// @brief  the Sprite that draws itself in place of this batch, or nullptr if this batch is instanced
+        Sprite* M_CustomSprite;
+
+        /// @brief  the index of the first instance of the batch
+        int M_FirstInstance;
+
+        /// @brief  how many instances the batch has
+        int M_InstanceCount;
+
+        /// @brief  the minimum corner of the area the batch's instances cover, in clip space
+        glm::vec2 M_BoundsMin;
+
+        /// @brief  the maximum corner of the area the batch's instances cover, in clip space
+        glm::vec2 M_BoundsMax;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  clears the batches of the previous frame
+    void Begin();
+
+    /// @brief  adds a Sprite that can be drawn as an instance of a batch
+    /// @param  layer       the layer the Sprite is drawn on
+    /// @param  shader      the shader the Sprite is drawn with
+    /// @param  texture     the texture the Sprite is drawn with
+    /// @param  instance    the per-instance data of the Sprite
+    /// @param  boundsMin   the minimum corner of the area the Sprite covers, in clip space
+    /// @param  boundsMax   the maximum corner of the area the Sprite covers, in clip space
+    void Add(
+        int layer, Shader* shader, Texture const* texture, SpriteInstance const& instance,
+        glm::vec2 const& boundsMin, glm::vec2 const& boundsMax
+    );
+
+    /// @brief  adds a Sprite that has to draw itself
+    /// @param  layer   the layer the Sprite is drawn on
+    /// @param  sprite  the Sprite to draw
+    void AddCustom( int layer, Sprite* sprite );
+
+    /// @brief  finishes building the batches of this frame
+    void End();
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the batches of this frame, in draw order
+    /// @return the batches of this frame
+    std::vector< Batch > const& GetBatches() const { return m_Batches; }
+
+    /// @brief  gets the instances of this frame, grouped by batch
+    /// @return the instances of this frame
+    std::vector< SpriteInstance > const& GetInstances() const { return m_Instances; }
+
+    /// @brief  gets how many Sprites were added this frame
+    /// @return how many Sprites were added this frame
+    int GetSpriteCount() const { return m_SpriteCount; }
+
+
+//-----------------------------------------------------------------------------
+private: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how many batches back a Sprite looks for a batch to join, so that the search stays cheap
+    static constexpr int s_MaxLookBack = 16;
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the batches of this frame
+    std::vector< Batch > m_Batches;
+
+    /// @brief  the instances of this frame, grouped by batch
+    std::vector< SpriteInstance > m_Instances;
+
+    /// @brief  how many Sprites were added this frame
+    int m_SpriteCount = 0;
+
+
+    /// @brief  the index of the first batch of the current run of mergeable Sprites
+    int m_RunStart = 0;
+
+    /// @brief  the layer of the current run
+    int m_RunLayer = 0;
+
+    /// @brief  the instances of the current run, in the order they were added
+    std::vector< SpriteInstance > m_RunInstances;
+
+    /// @brief  the batch each instance of the current run belongs to
+    std::vector< int > m_RunBatchIndices;
+
+    /// @brief  scratch: where the next instance of each batch of the current run goes
+    std::vector< int > m_Cursors;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  moves the instances of the current run into m_Instances, grouped by batch, and starts a new run
+    void flushRun();
+
+
+//-----------------------------------------------------------------------------
+};
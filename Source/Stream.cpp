@@ -58,11 +58,11 @@
             return;
         }
 
-        s_DebugLocationStack.push_back( filepath + "::" );
+        PushDebugLocation( filepath, "::" );
 
         Stream::Read( *object, json );
 
-        s_DebugLocationStack.pop_back();
+        PopDebugLocation();
     }
 
 
@@ -85,59 +85,54 @@
         return mappings;
     }
 
-    /// @brief Write a meesage to the trace log.
-    /// @param traceMessage The message to be written.
-    void Stream::WriteToTraceLog(std::string const& traceMessage)
+    /// @brief  gets the path of the trace log, creating its directory if needed
+    /// @return the path of the trace log, or an empty string if it couldn't be found
+    /// @note   only looked up the first time it's called
+    std::string const& Stream::GetTraceLogPath()
     {
+        static std::string const traceFilePath = []() -> std::string
+        {
 #ifdef NDEBUG //These are backwards for some reason but it works
 
-        char* appData = nullptr;
-        size_t size = 0;
-        errno_t err = _dupenv_s(&appData, &size, "APPDATA");
+            char* appData = nullptr;
+            size_t size = 0;
+            errno_t err = _dupenv_s(&appData, &size, "APPDATA");
 
-        if (err || appData == nullptr) 
-        {
-            std::cerr << "Error: Unable to retrieve APPDATA environment variable." << std::endl;
-            return;
-        }
+            if (err || appData == nullptr) 
+            {
+                std::cerr << "Error: Unable to retrieve APPDATA environment variable." << std::endl;
+                return "";
+            }
 
-        std::string gameDirectory = std::string(appData) + "\\Dig_Deeper"; // Create the game directory path
-        free(appData); // Free the memory allocated by _dupenv_s
+            std::string gameDirectory = std::string(appData) + "\\Dig_Deeper"; // Create the game directory path
+            free(appData); // Free the memory allocated by _dupenv_s
 
-        // Check if the game directory exists
-        DWORD ftyp = GetFileAttributesA(gameDirectory.c_str());
-        if (ftyp == INVALID_FILE_ATTRIBUTES) 
-        {
-            // Directory doesn't exist, attempt to create it
-            if (!CreateDirectoryA(gameDirectory.c_str(), NULL)) 
+            // Check if the game directory exists
+            DWORD ftyp = GetFileAttributesA(gameDirectory.c_str());
+            if (ftyp == INVALID_FILE_ATTRIBUTES) 
             {
-                std::cerr << "Error: Unable to create directory \"" << gameDirectory << "\"" << std::endl;
-                return;
+                // Directory doesn't exist, attempt to create it
+                if (!CreateDirectoryA(gameDirectory.c_str(), NULL)) 
+                {
+                    std::cerr << "Error: Unable to create directory \"" << gameDirectory << "\"" << std::endl;
+                    return "";
+                }
+            }
+            else if (!(ftyp & FILE_ATTRIBUTE_DIRECTORY))  // Check if the path is a directory
+            {
+                // A file with the same name as the directory exists
+                std::cerr << "Error: Game directory path \"" << gameDirectory << "\" is a file!" << std::endl;
+                return "";
             }
-        }
-        else if (!(ftyp & FILE_ATTRIBUTE_DIRECTORY))  // Check if the path is a directory
-        {
-            // A file with the same name as the directory exists
-            std::cerr << "Error: Game directory path \"" << gameDirectory << "\" is a file!" << std::endl;
-            return;
-        }
 
-        std::string traceFilePath = gameDirectory + "\\trace.log";
+            return gameDirectory + "\\trace.log";
 
 #else
-    		std::string traceFilePath = "trace.log";
+            return "trace.log";
 #endif
+        }();
 
-        // Attempt to open the trace log for writing.
-        static std::ofstream traceFile(traceFilePath.c_str());
-        if (!traceFile.is_open())
-        {
-            std::cerr << "Warning: unable to open file \"" << traceFilePath << "\"" << std::endl;
-            return;
-        }
-
-        // Write the trace message to the log.
-        traceFile << traceMessage;
+        return traceFilePath;
     }
 
     /// @brief  Writes json data to a file
@@ -169,10 +164,19 @@
 
 
     /// @brief  pushes a Debug Location name to the DebugLocationStack
-    /// @param  locationName    the name of the location to push
-    void Stream::PushDebugLocation( std::string const& locationName )
+    /// @param  locationName    the name of the location to push - only viewed, so it must outlive the push
+    /// @param  separator       what to put between this location and the next
+    /// @note   nothing is copied or concatenated until GetDebugLocation is called
+    void Stream::PushDebugLocation( std::string_view locationName, std::string_view separator )
+    {
+        s_DebugLocationStack.push_back( { locationName, separator } );
+    }
+
+    /// @brief  pushes an array index to the DebugLocationStack
+    /// @param  index   the index of the array element being read
+    void Stream::PushDebugLocation( int index )
     {
-        s_DebugLocationStack.push_back( locationName );
+        s_DebugLocationStack.push_back( { {}, ".", index } );
     }
 
 
@@ -189,9 +193,17 @@
     {
         std::string result = "";
 
-        for ( std::string const& string : s_DebugLocationStack )
+        for ( DebugLocation const& location : s_DebugLocationStack )
         {
-            result += string;
+            if ( location.M_Index != -1 )
+            {
+                result += "[ " + std::to_string( location.M_Index ) + " ]";
+            }
+            else
+            {
+                result += location.M_Name;
+            }
+            result += location.M_Separator;
         }
 
         if ( result.empty() == false )
@@ -208,8 +220,8 @@
 //-----------------------------------------------------------------------------
 
 
-    /// @brief  stack of strings representing the current location in the JSON file
-    std::vector< std::string > Stream::s_DebugLocationStack = {};
+    /// @brief  stack of views representing the current location in the JSON file
+    std::vector< Stream::DebugLocation > Stream::s_DebugLocationStack = {};
     
 
 //-----------------------------------------------------------------------------
\ No newline at end of file
@@ -62,9 +62,9 @@ public: // methods
     /// @param  json        the json data to write to the file
     static void WriteToFile( std::string const& filepath, nlohmann::ordered_json const& json );
 
-    /// @brief Write a message to the trace log.
-    /// @param traceMessage The message to write.
-    static void WriteToTraceLog(std::string const& traceMessage);
+    /// @brief  gets the path of the trace log, creating its directory if needed
+    /// @return the path of the trace log, or an empty string if it couldn't be found
+    static std::string const& GetTraceLogPath();
 
 
     /// @brief  copies a value to the clipbaord
@@ -190,9 +190,26 @@ public: // debug stack
 //-----------------------------------------------------------------------------
 
 
+    /// @brief  pushes a Debug Location name to the DebugLocationStack
+    /// @param  locationName    the name of the location to push - only viewed, so it must outlive the push
+    /// @param  separator       what to put between this location and the next
+    /// @note   nothing is copied or concatenated until GetDebugLocation is called
+    static void PushDebugLocation( std::string_view locationName, std::string_view separator = "." );
+
     /// @brief  pushes a Debug Location name to the DebugLocationStack
     /// @param  locationName    the name of the location to push
-    static void PushDebugLocation( std::string const& locationName );
+    /// @param  separator       what to put between this location and the next
+    static void PushDebugLocation( char const* locationName, std::string_view separator = "." )
+    {
+        PushDebugLocation( std::string_view( locationName ), separator );
+    }
+
+    /// @brief  temporary strings would be destroyed before the location is printed, so don't accept them
+    static void PushDebugLocation( std::string&& locationName, std::string_view separator = "." ) = delete;
+
+    /// @brief  pushes an array index to the DebugLocationStack
+    /// @param  index   the index of the array element being read
+    static void PushDebugLocation( int index );
 
 
     /// @brief  pops a Debug Location name from the DebugLocationStack
@@ -209,8 +226,21 @@ private: // debug stack
 //-----------------------------------------------------------------------------
 
 
-    /// @brief  stack of strings representing the current location in the JSON file
-    static std::vector< std::string > s_DebugLocationStack;
+    /// @brief  one level of the current location in the JSON file
+    struct DebugLocation
+    {
+        /// @brief  the name of the location, if it isn't an array index
+        std::string_view M_Name;
+
+        /// @brief  what to put between this location and the next
+        std::string_view M_Separator;
+
+        /// @brief  the index of the location, if it is an array index
+        int M_Index = -1;
+    };
+
+    /// @brief  stack of views representing the current location in the JSON file
+    static std::vector< DebugLocation > s_DebugLocationStack;
     
 
 //-----------------------------------------------------------------------------
@@ -406,12 +406,12 @@
                 continue;
             }
 
-            s_DebugLocationStack.push_back( name + "." );
+            PushDebugLocation( name );
 
-            ReadMethod< ISerializable > const& readMethod = it->second;
+            ReadMethod< ISerializable > const& readMethod = it->M_Method;
             (value.*readMethod)(data);
 
-            s_DebugLocationStack.pop_back();
+            PopDebugLocation();
         }
 
         value.AfterLoad();
@@ -37,6 +37,8 @@
     /// @brief      Destructor: deletes texture data from GPU
     Texture::~Texture()
     { 
+        cancelDeferredLoad();
+
         if (m_TextureID)
             glDeleteTextures(1, &m_TextureID);
 
@@ -46,6 +48,85 @@
 
 
 
+//-----------------------------------------------------------------------------
+// public: deferred loading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts decoding the images of Textures loaded from now on on worker threads, instead of on this thread
+    /// @note   until FinishDeferredLoads is called, those Textures have no image and no Mesh
+    void Texture::BeginDeferredLoads()
+    {
+        s_IsDeferringLoads = true;
+    }
+
+    /// @brief  waits for every deferred image to be decoded, uploads them to the GPU, and stops deferring loads
+    void Texture::FinishDeferredLoads()
+    {
+        s_IsDeferringLoads = false;
+
+        // upload in the order the Textures were loaded, while the later ones may still be decoding
+        for ( DeferredLoad& load : s_DeferredLoads )
+        {
+            Jobs()->Wait( load.M_Job );
+            load.M_Texture->m_IsLoadDeferred = false;
+            load.M_Texture->uploadImage( *load.M_Image );
+        }
+        s_DeferredLoads.clear();
+    }
+
+
+    /// @brief  logs how long decoding a set of images takes on this thread, and spread across the JobSystem
+    /// @param  filepaths   the images to decode
+    void Texture::RunDecodeBenchmark( std::vector< std::string > const& filepaths )
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::vector< DecodedImage > images( filepaths.size() );
+
+        // the old way: one after another on this thread
+        Clock::time_point start = Clock::now();
+        for ( size_t i = 0; i < filepaths.size(); ++i )
+        {
+            images[ i ] = decodeImage( filepaths[ i ] );
+        }
+        double serialMs = std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+        size_t pixelCount = 0;
+        for ( DecodedImage& image : images )
+        {
+            pixelCount += (size_t)image.M_Dimensions.x * image.M_Dimensions.y;
+            stbi_image_free( image.M_Pixels );
+            image = DecodedImage();
+        }
+
+        // the new way: one job per image, waited on in order like FinishDeferredLoads does
+        start = Clock::now();
+        std::vector< JobSystem::JobId > jobs( filepaths.size() );
+        for ( size_t i = 0; i < filepaths.size(); ++i )
+        {
+            jobs[ i ] = Jobs()->Push( [ &filepaths, &images, i ]()
+            {
+                images[ i ] = decodeImage( filepaths[ i ] );
+            } );
+        }
+        for ( JobSystem::JobId job : jobs )
+        {
+            Jobs()->Wait( job );
+        }
+        double parallelMs = std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+
+        for ( DecodedImage& image : images )
+        {
+            stbi_image_free( image.M_Pixels );
+        }
+
+        Debug() << "    texture decoding (" << filepaths.size() << " images, " << pixelCount / 1000000.0 << " megapixels):\n"
+            << "        serial on the main thread: " << serialMs << " ms\n"
+            << "        " << Jobs()->GetWorkerCount() << " workers: " << parallelMs << " ms" << std::endl;
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: methods
 //-----------------------------------------------------------------------------
@@ -246,6 +327,45 @@ ReadMethodMap< Texture > const Texture::s_ReadMethods = {
 
 /// @brief  Loads texture image from file (deletes old one if present)
 void Texture::loadImage()
+{
+    cancelDeferredLoad();
+
+    if ( s_IsDeferringLoads == false )
+    {
+        uploadImage( decodeImage( m_Filepath ) );
+        return;
+    }
+
+    // decode on a worker thread, and upload once FinishDeferredLoads is called
+    std::unique_ptr< DecodedImage > image = std::make_unique< DecodedImage >();
+    JobSystem::JobId job = Jobs()->Push( [ filepath = m_Filepath, target = image.get() ]()
+    {
+        *target = decodeImage( filepath );
+    } );
+
+    s_DeferredLoads.push_back( { this, job, std::move( image ) } );
+    m_IsLoadDeferred = true;
+}
+
+/// @brief  decodes an image file - safe to call from any thread
+/// @param  filepath    the image file to decode
+/// @return the decoded image
+Texture::DecodedImage Texture::decodeImage( std::string const& filepath )
+{
+    DecodedImage image;
+
+    int BPP; // throwaway (don't need it) - bytes per pixel, the amount of channels received.
+    // (I mean, why ever have less than 4?)
+
+    // load the file as a chunk of pixels
+    image.M_Pixels = stbi_load(filepath.c_str(), &image.M_Dimensions.x, &image.M_Dimensions.y, &BPP, 4); // 4 channels - r,g,b,a
+
+    return image;
+}
+
+/// @brief  uploads a decoded image to the GPU and frees its pixels (deletes old one if present)
+/// @param  image   the decoded image to upload
+void Texture::uploadImage( DecodedImage const& image )
 {
     if (m_TextureID)            // reloading with new data?
     {
@@ -258,17 +378,13 @@ void Texture::loadImage()
     glGenTextures(1, &m_TextureID);
     glBindTexture(GL_TEXTURE_2D, m_TextureID);
 
-    int BPP; // throwaway (don't need it) - bytes per pixel, the amount of channels received.
-    // (I mean, why ever have less than 4?)
-
-    // load the file as a chunk of pixels
-    unsigned char* content = stbi_load(m_Filepath.c_str(), &m_PixelDimensions.x, &m_PixelDimensions.y, &BPP, 4); // 4 channels - r,g,b,a
-
-    if (content)
+    if (image.M_Pixels)
     {
+        m_PixelDimensions = image.M_Dimensions;
+
         // load those pixels into texture buffer, and free them from stb.
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_PixelDimensions.x, m_PixelDimensions.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, content);
-        stbi_image_free(content);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_PixelDimensions.x, m_PixelDimensions.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.M_Pixels);
+        stbi_image_free(image.M_Pixels);
 
         // sampling settings - scaling and wrapping
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -290,6 +406,28 @@ void Texture::loadImage()
     }
 }
 
+    /// @brief  stops waiting for this Texture's deferred image, if it has one
+    void Texture::cancelDeferredLoad()
+    {
+        if ( m_IsLoadDeferred == false )
+        {
+            return;
+        }
+
+        auto it = std::find_if( s_DeferredLoads.begin(), s_DeferredLoads.end(), [ this ]( DeferredLoad const& load ) -> bool
+        {
+            return load.M_Texture == this;
+        } );
+        if ( it != s_DeferredLoads.end() )
+        {
+            Jobs()->Wait( it->M_Job );
+            stbi_image_free( it->M_Image->M_Pixels );
+            s_DeferredLoads.erase( it );
+        }
+
+        m_IsLoadDeferred = false;
+    }
+
 
     /// @brief  reloads this Texture's mesh
     void Texture::reloadMesh()
@@ -310,3 +448,14 @@ void Texture::loadImage()
     }
 
 //-----------------------------------------------------------------------------
+// private: deferred loading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  whether Textures loaded now have their images decoded on worker threads
+    bool Texture::s_IsDeferringLoads = false;
+
+    /// @brief  Textures waiting for their images to be decoded
+    std::vector< Texture::DeferredLoad > Texture::s_DeferredLoads = {};
+
+//-----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #include "ISerializable.h"
 
 #include "Mesh.h"
+#include "JobSystem.h"
 
 /// @brief          Stores texture data, and allows to bind it for rendering.
 class Texture : public ISerializable
@@ -94,6 +95,24 @@ public: // acccessors
     unsigned GetTextureId() const;
 
 
+//-----------------------------------------------------------------------------
+public: // deferred loading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts decoding the images of Textures loaded from now on on worker threads, instead of on this thread
+    /// @note   until FinishDeferredLoads is called, those Textures have no image and no Mesh
+    static void BeginDeferredLoads();
+
+    /// @brief  waits for every deferred image to be decoded, uploads them to the GPU, and stops deferring loads
+    static void FinishDeferredLoads();
+
+
+    /// @brief  logs how long decoding a set of images takes on this thread, and spread across the JobSystem
+    /// @param  filepaths   the images to decode
+    static void RunDecodeBenchmark( std::vector< std::string > const& filepaths );
+
+
 //-----------------------------------------------------------------------------
 private: // member variables
 //-----------------------------------------------------------------------------
@@ -124,6 +143,45 @@ private: // member variables
     /// @brief   Mesh to render texture onto
     Mesh const* m_Mesh = nullptr;
 
+    /// @brief  whether this Texture's image is being decoded on a worker thread
+    bool m_IsLoadDeferred = false;
+
+
+//-----------------------------------------------------------------------------
+private: // deferred loading
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  pixels decoded from an image file
+    struct DecodedImage
+    {
+        /// @brief  the RGBA pixels of the image, owned by stb_image - nullptr if the image couldn't be decoded
+        unsigned char* M_Pixels = nullptr;
+
+        /// @brief  the width and height of the image
+        glm::ivec2 M_Dimensions = { 0, 0 };
+    };
+
+    /// @brief  a Texture waiting for its image to be decoded
+    struct DeferredLoad
+    {
+        /// @brief  the Texture to upload the image to
+        Texture* M_Texture;
+
+        /// @brief  the job decoding the image
+        JobSystem::JobId M_Job;
+
+        /// @brief  where the job puts the decoded image - heap allocated so it doesn't move while the job runs
+        std::unique_ptr< DecodedImage > M_Image;
+    };
+
+
+    /// @brief  whether Textures loaded now have their images decoded on worker threads
+    static bool s_IsDeferringLoads;
+
+    /// @brief  Textures waiting for their images to be decoded
+    static std::vector< DeferredLoad > s_DeferredLoads;
+
 
 //-----------------------------------------------------------------------------
 private: // methods
@@ -132,6 +190,18 @@ private: // methods
     /// @brief  Loads texture image from file (deletes old one if present)
     void loadImage();
 
+    /// @brief  decodes an image file - safe to call from any thread
+    /// @param  filepath    the image file to decode
+    /// @return the decoded image
+    static DecodedImage decodeImage( std::string const& filepath );
+
+    /// @brief  uploads a decoded image to the GPU and frees its pixels (deletes old one if present)
+    /// @param  image   the decoded image to upload
+    void uploadImage( DecodedImage const& image );
+
+    /// @brief  stops waiting for this Texture's deferred image, if it has one
+    void cancelDeferredLoad();
+
     /// @brief  reloads this Texture's mesh
     void reloadMesh();
 
@@ -0,0 +1,87 @@
+/// @file       TileUploadTracker.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      tracks which tiles of a TilemapSprite's instance buffer need to be uploaded again
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "TileUploadTracker.h"
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  marks a tile as changed
+    /// @param  index   the index of the tile in the buffer
+    void TileUploadTracker::MarkTile( int index )
+    {
+        if ( m_IsAllMarked == false )
+        {
+            m_MarkedTiles.push_back( index );
+        }
+    }
+
+    /// @brief  marks every tile as changed
+    void TileUploadTracker::MarkAll()
+    {
+        m_IsAllMarked = true;
+        m_MarkedTiles.clear();
+    }
+
+    /// @brief  works out what to upload this frame, and clears the marks
+    /// @param  tileCount   how many tiles the buffer needs to hold
+    /// @return whether the buffer needs to be reallocated - if so, the only range covers every tile
+    bool TileUploadTracker::Flush( int tileCount )
+    {
+        m_Ranges.clear();
+
+        bool reallocate = m_IsAllMarked || tileCount != m_TileCount;
+        if ( reallocate )
+        {
+            if ( tileCount > 0 )
+            {
+                m_Ranges.push_back( { 0, tileCount } );
+            }
+        }
+        else if ( m_MarkedTiles.empty() == false )
+        {
+            std::sort( m_MarkedTiles.begin(), m_MarkedTiles.end() );
+            for ( int index : m_MarkedTiles )
+            {
+                if ( index < 0 || index >= tileCount )
+                {
+                    continue;
+                }
+
+                if ( m_Ranges.empty() == false && index - ( m_Ranges.back().M_First + m_Ranges.back().M_Count ) <= s_MaxMergeGap )
+                {
+                    m_Ranges.back().M_Count = std::max( m_Ranges.back().M_Count, index - m_Ranges.back().M_First + 1 );
+                }
+                else
+                {
+                    m_Ranges.push_back( { index, 1 } );
+                }
+            }
+        }
+
+        m_UploadedBytes = 0;
+        for ( Range const& range : m_Ranges )
+        {
+            m_UploadedBytes += range.M_Count * sizeof( int );
+        }
+        m_TotalUploadedBytes += m_UploadedBytes;
+
+        m_MarkedTiles.clear();
+        m_IsAllMarked = false;
+        m_TileCount = tileCount;
+
+        return reallocate;
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+/// @file       TileUploadTracker.h
+/// @author     Oblivion Owls Inc
+/// @brief      tracks which tiles of a TilemapSprite's instance buffer need to be uploaded again
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+
+/// @brief  tracks which tiles of a TilemapSprite's instance buffer need to be uploaded again
+/// @note   tiles are marked as they change, and Flush() turns the marks into as few ranges as it can each frame
+/// @note   the TileUploadTracker never touches the GPU, so its output can be inspected without a rendering context
+class TileUploadTracker
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a range of consecutive tiles to upload
+    struct Range
+    {
+        /// @brief  the index of the first tile in the range
+        int M_First;
+
+        /// @brief  how many tiles are in the range
+        int M_Count;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  ranges separated by at most this many unchanged tiles are merged, since each upload has a fixed cost
+    static constexpr int s_MaxMergeGap = 32;
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  marks a tile as changed
+    /// @param  index   the index of the tile in the buffer
+    void MarkTile( int index );
+
+    /// @brief  marks every tile as changed
+    void MarkAll();
+
+    /// @brief  works out what to upload this frame, and clears the marks
+    /// @param  tileCount   how many tiles the buffer needs to hold
+    /// @return whether the buffer needs to be reallocated - if so, the only range covers every tile
+    bool Flush( int tileCount );
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the ranges of tiles to upload, from the last call to Flush()
+    /// @return the ranges of tiles to upload, in order
+    std::vector< Range > const& GetRanges() const { return m_Ranges; }
+
+    /// @brief  gets how many bytes the last call to Flush() said to upload
+    /// @return how many bytes to upload
+    size_t GetUploadedBytes() const { return m_UploadedBytes; }
+
+    /// @brief  gets how many bytes have been uploaded in total
+    /// @return how many bytes have been uploaded in total
+    size_t GetTotalUploadedBytes() const { return m_TotalUploadedBytes; }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the tiles that changed since the last flush, unsorted and possibly repeated
+    std::vector< int > m_MarkedTiles;
+
+    /// @brief  whether every tile changed since the last flush
+    bool m_IsAllMarked = true;
+
+    /// @brief  how many tiles the buffer held as of the last flush
+    int m_TileCount = 0;
+
+    /// @brief  the ranges of tiles to upload, from the last flush
+    std::vector< Range > m_Ranges;
+
+    /// @brief  how many bytes the last flush said to upload
+    size_t m_UploadedBytes = 0;
+
+    /// @brief  how many bytes have been uploaded in total
+    size_t m_TotalUploadedBytes = 0;
+
+
+//-----------------------------------------------------------------------------
+};
@@ -9,6 +9,286 @@
 #include "pch.h" // precompiled header has to be included first
 #include "Tilemap.h"
 
+#include "DebugSystem.h"
+#include "TilemapCollider.h" // TilemapCollider::FlagChunk, for the benchmark's memory use
+
+#include <charconv> // std::from_chars, std::to_chars
+
+
+//-----------------------------------------------------------------------------
+// TilemapBase: protected static methods
+//-----------------------------------------------------------------------------
+
+    /// @brief          Run-length encodes tile IDs as text: comma separated IDs, with
+    ///                 repeated IDs written as id*count (e.g. "-1*40,3,3*2")
+    /// @param tiles    the tile IDs to encode
+    /// @return         the encoded tile IDs
+    std::string TilemapBase::encodeTileRuns( std::vector< int > const& tiles )
+    {
+        std::string text;
+        char buffer[ 32 ];
+
+        for ( size_t i = 0; i < tiles.size(); )
+        {
+            size_t runEnd = i + 1;
+            while ( runEnd < tiles.size() && tiles[ runEnd ] == tiles[ i ] )
+            {
+                ++runEnd;
+            }
+
+            if ( i != 0 )
+            {
+                text += ',';
+            }
+
+            char* end = std::to_chars( buffer, buffer + sizeof( buffer ), tiles[ i ] ).ptr;
+            if ( runEnd - i > 1 )
+            {
+                *end++ = '*';
+                end = std::to_chars( end, buffer + sizeof( buffer ), runEnd - i ).ptr;
+            }
+            text.append( buffer, end );
+
+            i = runEnd;
+        }
+
+        return text;
+    }
+
+    /// @brief          Decodes tile IDs written by encodeTileRuns()
+    /// @param text     the encoded tile IDs
+    /// @param tiles    where to store the decoded tile IDs
+    /// @return         whether the text was valid
+    bool TilemapBase::decodeTileRuns( std::string const& text, std::vector< int >* tiles )
+    {
+        tiles->clear();
+
+        char const* current = text.data();
+        char const* end = text.data() + text.size();
+        while ( current < end )
+        {
+            int tile;
+            std::from_chars_result result = std::from_chars( current, end, tile );
+            if ( result.ec != std::errc() )
+            {
+                return false;
+            }
+            current = result.ptr;
+
+            int count = 1;
+            if ( current < end && *current == '*' )
+            {
+                result = std::from_chars( current + 1, end, count );
+                if ( result.ec != std::errc() || count < 1 )
+                {
+                    return false;
+                }
+                current = result.ptr;
+            }
+
+            tiles->insert( tiles->end(), count, tile );
+
+            if ( current < end )
+            {
+                if ( *current != ',' )
+                {
+                    return false;
+                }
+                ++current;
+            }
+        }
+
+        return true;
+    }
+
+
+//-----------------------------------------------------------------------------
+// TilemapBase: public benchmarking
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  times filling, iterating, editing, and resizing a 1024x4096 Tilemap, compares its memory use
+    ///         to a flat array of tiles, and writes the results to the log
+    void TilemapBase::RunStorageBenchmark()
+    {
+        static constexpr glm::ivec2 dimensions = { 1024, 4096 };
+        static constexpr int skyHeight = 1024;
+        static constexpr int caveCount = 400;
+        static constexpr int editCount = 100000;
+        static constexpr int passCount = 10;
+        using Chunk = Tilemap< int >::Chunk;
+        static constexpr int chunkSize = Tilemap< int >::s_ChunkSize;
+
+        // a level like the game's: open sky over solid rock, with caves and a few mined out shafts
+        std::mt19937 random( 0 );
+        std::vector< int > tiles( dimensions.x * dimensions.y, -1 );
+        std::uniform_int_distribution< int > randomTile( 0, 15 );
+        for ( int i = skyHeight * dimensions.x; i < (int)tiles.size(); ++i )
+        {
+            tiles[ i ] = randomTile( random );
+        }
+
+        std::uniform_int_distribution< int > randomX( 0, dimensions.x - 1 );
+        std::uniform_int_distribution< int > randomY( skyHeight, dimensions.y - 1 );
+        std::uniform_int_distribution< int > randomRadius( 8, 40 );
+        for ( int i = 0; i < caveCount; ++i )
+        {
+            glm::ivec2 center = { randomX( random ), randomY( random ) };
+            int radius = randomRadius( random );
+            glm::ivec2 min = glm::max( center - radius, glm::ivec2( 0 ) );
+            glm::ivec2 max = glm::min( center + radius, dimensions - 1 );
+            for ( int y = min.y; y <= max.y; ++y )
+            {
+                for ( int x = min.x; x <= max.x; ++x )
+                {
+                    glm::ivec2 offset = glm::ivec2( x, y ) - center;
+                    if ( offset.x * offset.x + offset.y * offset.y <= radius * radius )
+                    {
+                        tiles[ y * dimensions.x + x ] = -1;
+                    }
+                }
+            }
+        }
+
+        Tilemap< int > tilemap;
+        tilemap.SetDimensions( { dimensions.x, 1 } );
+
+        auto start = std::chrono::high_resolution_clock::now();
+        tilemap.SetTilemap( tiles );
+        double loadMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        // visit every tile of the flat array
+        long long flatSum = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for ( int pass = 0; pass < passCount; ++pass )
+        {
+            for ( int y = 0; y < dimensions.y; ++y )
+            {
+                for ( int x = 0; x < dimensions.x; ++x )
+                {
+                    flatSum += tiles[ y * dimensions.x + x ];
+                }
+            }
+        }
+        double flatMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        // visit every tile through GetTile()
+        long long getTileSum = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for ( int pass = 0; pass < passCount; ++pass )
+        {
+            for ( int y = 0; y < dimensions.y; ++y )
+            {
+                for ( int x = 0; x < dimensions.x; ++x )
+                {
+                    getTileSum += tilemap.GetTile( { x, y } );
+                }
+            }
+        }
+        double getTileMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        // visit every tile that isn't empty, a chunk at a time
+        long long chunkSum = 0;
+        glm::ivec2 chunkCounts = tilemap.GetChunkCounts();
+        start = std::chrono::high_resolution_clock::now();
+        for ( int pass = 0; pass < passCount; ++pass )
+        {
+            for ( int chunkY = 0; chunkY < chunkCounts.y; ++chunkY )
+            {
+                for ( int chunkX = 0; chunkX < chunkCounts.x; ++chunkX )
+                {
+                    Chunk const* chunk = tilemap.GetChunk( { chunkX, chunkY } );
+                    if ( chunk == nullptr )
+                    {
+                        chunkSum -= chunkSize * chunkSize;
+                        continue;
+                    }
+
+                    for ( int tile : chunk->M_Tiles )
+                    {
+                        chunkSum += tile;
+                    }
+                }
+            }
+        }
+        double chunkMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        if ( getTileSum != flatSum || chunkSum != flatSum )
+        {
+            Debug() << "WARNING: chunked tiles don't match the flat array (sums " << getTileSum << " and " << chunkSum
+                << ", expected " << flatSum << ")" << std::endl;
+        }
+
+        // a TilemapCollider keeps a chunk of flags for every chunk of tiles, where a flat array would need a flag per tile
+        size_t chunkBytes = tilemap.GetAllocatedChunkCount() * sizeof( Chunk ) +
+            chunkCounts.x * chunkCounts.y * ( sizeof( std::unique_ptr< Chunk > ) + sizeof( unsigned ) );
+        size_t chunkFlagBytes = tilemap.GetAllocatedChunkCount() * sizeof( TilemapCollider::FlagChunk ) +
+            chunkCounts.x * chunkCounts.y * sizeof( std::unique_ptr< TilemapCollider::FlagChunk > );
+        size_t flatBytes = tiles.size() * sizeof( int );
+        size_t flatFlagBytes = tiles.size() * sizeof( uint8_t );
+
+        // mine out random tiles, like the game does
+        unsigned versionBeforeEdits = tilemap.GetVersion();
+        std::vector< glm::ivec2 > edits( editCount );
+        std::uniform_int_distribution< int > randomAnyY( 0, dimensions.y - 1 );
+        for ( glm::ivec2& edit : edits )
+        {
+            edit = { randomX( random ), randomAnyY( random ) };
+        }
+
+        start = std::chrono::high_resolution_clock::now();
+        for ( glm::ivec2 const& edit : edits )
+        {
+            tilemap.SetTile( edit, -1 );
+        }
+        double editMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        int dirtyChunkCount = 0;
+        for ( int chunkY = 0; chunkY < chunkCounts.y; ++chunkY )
+        {
+            for ( int chunkX = 0; chunkX < chunkCounts.x; ++chunkX )
+            {
+                dirtyChunkCount += tilemap.GetChunkVersion( { chunkX, chunkY } ) > versionBeforeEdits;
+            }
+        }
+
+        // copy out every tile, like saving does - nothing keeps the copy
+        start = std::chrono::high_resolution_clock::now();
+        tilemap.GetTilemap();
+        double flattenMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        // double the height of both
+        start = std::chrono::high_resolution_clock::now();
+        tilemap.SetDimensions( { dimensions.x, dimensions.y * 2 } );
+        double growMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector< int > grownTiles( dimensions.x * dimensions.y * 2 );
+        std::copy( tiles.begin(), tiles.end(), grownTiles.begin() );
+        double flatGrowMs = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+
+        Debug() << "Tilemap storage benchmark (" << dimensions.x << "x" << dimensions.y << " tiles, "
+            << chunkSize << "x" << chunkSize << " chunks):\n"
+            << "    memory: " << chunkBytes / ( 1024.0 * 1024.0 ) << " MB in " << tilemap.GetAllocatedChunkCount()
+            << " of " << chunkCounts.x * chunkCounts.y << " chunks, vs " << flatBytes / ( 1024.0 * 1024.0 ) << " MB flat\n"
+            << "    collider flags: " << chunkFlagBytes / ( 1024.0 * 1024.0 ) << " MB chunked, vs "
+            << flatFlagBytes / ( 1024.0 * 1024.0 ) << " MB flat\n"
+            << "    total with the collider: " << ( chunkBytes + chunkFlagBytes ) / ( 1024.0 * 1024.0 ) << " MB chunked, vs "
+            << ( flatBytes + flatFlagBytes ) / ( 1024.0 * 1024.0 ) << " MB flat\n"
+            << "    loading from a flat array: " << loadMs << " ms\n"
+            << "    visiting every tile: " << getTileMs / passCount << " ms with GetTile(), "
+            << chunkMs / passCount << " ms a chunk at a time, " << flatMs / passCount << " ms in a flat array\n"
+            << "    " << editCount << " SetTile() calls: " << editMs << " ms (" << dirtyChunkCount << " chunks changed)\n"
+            << "    copying out GetTilemap(): " << flattenMs << " ms\n"
+            << "    doubling the height: " << growMs << " ms, vs " << flatGrowMs << " ms for a flat array" << std::endl;
+    }
+
+
+//-----------------------------------------------------------------------------
+// Tilemap< int >: inspection
+//-----------------------------------------------------------------------------
+
+
 // @brief  inspector for int tilemaps
 template<>
 void Tilemap<int>::Inspector()
@@ -29,15 +309,22 @@ void Tilemap<int>::Inspector()
         SetTileScale( tileSize );
     }
 
+    ImGui::Checkbox( "Is Derived", &m_IsDerived );
+    if ( ImGui::IsItemHovered() )
+    {
+        ImGui::SetTooltip( "derived tiles are generated from another Tilemap, so they aren't saved" );
+    }
+
     static std::string buffer;
     ImGui::InputTextMultiline( "Tilemap Data CSV", &buffer );
 
     if ( ImGui::Button( "Tilemap to CSV" ) )
     {
         buffer.clear();
-        for ( int i = 0; i < m_Tiles.size(); ++i )
+        std::vector< int > const& tiles = GetTilemap();
+        for ( int i = 0; i < tiles.size(); ++i )
         {
-            buffer += std::to_string( m_Tiles[ i ] );
+            buffer += std::to_string( tiles[ i ] );
             buffer += ( i % m_Dimensions.x == m_Dimensions.x - 1 ) ? '\n' : ',';
         }
 
@@ -47,7 +334,7 @@ void Tilemap<int>::Inspector()
     if ( ImGui::Button( "CSV to Tilemap" ) )
     {
         m_Dimensions = glm::ivec2( 0 );
-        m_Tiles.clear();
+        std::vector< int > tiles;
 
         std::istringstream csvData( buffer );
         csvData >> std::noskipws;
@@ -56,7 +343,7 @@ void Tilemap<int>::Inspector()
         {
             int tile;
             csvData >> tile;
-            m_Tiles.push_back( tile );
+            tiles.push_back( tile );
 
             char c;
             if ( !csvData.get( c ) )
@@ -66,18 +353,18 @@ void Tilemap<int>::Inspector()
 
             if ( c == '\n' && m_Dimensions.x == 0 )
             {
-                m_Dimensions.x = (int)m_Tiles.size();
+                m_Dimensions.x = (int)tiles.size();
             }
         }
 
         if ( m_Dimensions.x != 0 )
         {
-            m_Dimensions.y = (int)m_Tiles.size() / m_Dimensions.x;
-
-            int extraTiles = m_Tiles.size() % m_Dimensions.x;
-            m_Tiles.resize( m_Tiles.size() + ( extraTiles == 0 ? 0 : m_Dimensions.x - extraTiles ) );
+            m_Dimensions.y = ( (int)tiles.size() + m_Dimensions.x - 1 ) / m_Dimensions.x;
+            tiles.resize( m_Dimensions.x * m_Dimensions.y );
         }
 
+        loadTiles( tiles );
+
         callOnTilemapChangedCallbacks();
     }
 }
\ No newline at end of file
@@ -34,6 +34,30 @@ protected: // constructor
         Component( other )
     {}
 
+//-----------------------------------------------------------------------------
+public: // benchmarking
+//-----------------------------------------------------------------------------
+
+    /// @brief  times filling, iterating, editing, and resizing a 1024x4096 Tilemap, compares its memory use
+    ///         to a flat array of tiles, and writes the results to the log
+    static void RunStorageBenchmark();
+
+//-----------------------------------------------------------------------------
+protected: // static methods
+//-----------------------------------------------------------------------------
+
+    /// @brief          Run-length encodes tile IDs as text: comma separated IDs, with
+    ///                 repeated IDs written as id*count (e.g. "-1*40,3,3*2")
+    /// @param tiles    the tile IDs to encode
+    /// @return         the encoded tile IDs
+    static std::string encodeTileRuns( std::vector< int > const& tiles );
+
+    /// @brief          Decodes tile IDs written by encodeTileRuns()
+    /// @param text     the encoded tile IDs
+    /// @param tiles    where to store the decoded tile IDs
+    /// @return         whether the text was valid
+    static bool decodeTileRuns( std::string const& text, std::vector< int >* tiles );
+
 //-----------------------------------------------------------------------------    
 };
 
@@ -68,6 +92,24 @@ public: // types
 //-----------------------------------------------------------------------------
 
 
+    /// @brief  log2 of the width and height of each chunk, in tiles
+    static constexpr int s_ChunkShift = 5;
+
+    /// @brief  the width and height of each chunk, in tiles
+    static constexpr int s_ChunkSize = 1 << s_ChunkShift;
+
+    /// @brief  a square block of tiles
+    /// @note   chunks that would only hold empty tiles aren't allocated
+    struct Chunk
+    {
+        /// @brief  the tiles of the chunk, row by row
+        TileType M_Tiles[ s_ChunkSize * s_ChunkSize ];
+
+        /// @brief  how many tiles of the chunk aren't empty
+        int M_FilledCount = 0;
+    };
+
+
     /// @brief  OnTilemapChanged callback type
     /// @param  tilemap         the tilemap this callback was called from
     /// @param  tilepos         the position of the tile that was changed - will be (-1, -1) if whole tilemap changed
@@ -85,8 +127,16 @@ public: // methods
 
 
     /// @brief          Retrieve entire tilemap
-    /// @return         array (vector) of tile IDs
-    std::vector<TileType> const& GetTilemap() const { return m_Tiles; }
+    /// @return         array (vector) of tile IDs, row by row
+    /// @note           tiles are stored in chunks, so this builds a new copy on every call - it's meant for
+    ///                 saving and other one-off uses. Use GetTile(), GetChunk(), or CopyTiles() every frame.
+    std::vector<TileType> GetTilemap() const;
+
+    /// @brief          Copies a run of tiles out of the chunks, in the same order as GetTilemap()
+    /// @param  first   the index of the first tile to copy, row by row
+    /// @param  count   how many tiles to copy
+    /// @param  tiles   where to copy the tiles to
+    void CopyTiles( int first, int count, TileType* tiles ) const;
 
     /// @brief          Sets the whole tilemap to a given array (vector)
     /// @param  tiles   vector of tile IDs
@@ -96,7 +146,16 @@ public: // methods
     /// @brief          Gets the index of the tile at given coordinate.
     /// @param coord    tile 2D coordinate (within the tilemap)
     /// @return         index of the tile
-    TileType GetTile(glm::ivec2 coord) const { return m_Tiles[coord.y*m_Dimensions.x + coord.x]; }
+    TileType GetTile(glm::ivec2 coord) const
+    {
+        Chunk const* chunk = m_Chunks[ ( coord.y >> s_ChunkShift ) * m_ChunkCounts.x + ( coord.x >> s_ChunkShift ) ].get();
+        if ( chunk == nullptr )
+        {
+            return EmptyTile();
+        }
+
+        return chunk->M_Tiles[ ( ( coord.y & ( s_ChunkSize - 1 ) ) << s_ChunkShift ) + ( coord.x & ( s_ChunkSize - 1 ) ) ];
+    }
 
     /// @brief          Sets the tile at given coordinate to given index.
     /// @param coord    Tile 2D coordinate (within the tilemap)
@@ -138,14 +197,60 @@ public: // methods
     glm::vec2 GetTileScale() const { return m_TileScale; }
 
 
-    /// @brief  sets the size of the tilemap in tiles
+    /// @brief  sets the size of the tilemap in tiles. Tiles keep their coordinates, and new tiles are TileType() (0 for int tilemaps).
     /// @param  dimensions  the size of the tilemap
-    void SetDimensions( glm::ivec2 const& dimensions ) { m_Dimensions = dimensions; m_Tiles.resize( dimensions.x * dimensions.y ); }
+    void SetDimensions( glm::ivec2 const& dimensions );
 
     /// @return size of the tilemap in tiles
     glm::ivec2 GetDimensions() const { return m_Dimensions; }
 
 
+    /// @return how many chunks the tilemap is split into along each axis
+    glm::ivec2 GetChunkCounts() const { return m_ChunkCounts; }
+
+    /// @brief  gets a chunk of tiles
+    /// @param  chunkPos    the position of the chunk, in chunks
+    /// @return the chunk, or nullptr if every tile in it is empty
+    Chunk const* GetChunk( glm::ivec2 const& chunkPos ) const { return m_Chunks[ chunkPos.y * m_ChunkCounts.x + chunkPos.x ].get(); }
+
+    /// @brief  gets the version of the tilemap when a chunk last changed
+    /// @param  chunkPos    the position of the chunk, in chunks
+    /// @return the version of the tilemap when the chunk last changed
+    unsigned GetChunkVersion( glm::ivec2 const& chunkPos ) const { return m_ChunkVersions[ chunkPos.y * m_ChunkCounts.x + chunkPos.x ]; }
+
+    /// @brief  gets the version of the tilemap, which increases whenever any tile changes
+    /// @return the version of the tilemap
+    /// @note   a chunk has changed since a consumer last saw the tilemap if its version is newer than the tilemap's was then
+    unsigned GetVersion() const { return m_Version; }
+
+    /// @return how many chunks hold at least one tile that isn't empty
+    int GetAllocatedChunkCount() const;
+
+
+    /// @return the value of the tiles in chunks that aren't allocated - tiles with this value take up no memory
+    /// @note   this isn't what new tiles are filled with: padding and grown tiles are TileType(), as they were
+    ///         before tiles were chunked, so for int tilemaps they are tile 0 and do take up memory
+    static constexpr TileType EmptyTile()
+    {
+        if constexpr ( std::is_same_v< TileType, int > )
+        {
+            return -1;
+        }
+        else
+        {
+            return TileType();
+        }
+    }
+
+
+    /// @brief          Sets whether the tiles are generated from another Tilemap, and so aren't saved
+    /// @param isDerived whether the tiles are generated from another Tilemap
+    void SetIsDerived( bool isDerived ) { m_IsDerived = isDerived; }
+
+    /// @return         whether the tiles are generated from another Tilemap, and so aren't saved
+    bool GetIsDerived() const { return m_IsDerived; }
+
+
     /// @brief  gets the Tilemap to word matrix
     /// @return the matrix
     glm::mat4 const& GetTilemapToWorldMatrix() const { return m_Mat; }
@@ -182,8 +287,17 @@ private: // data
 //-----------------------------------------------------------------------------
 
 
-    /// @brief   Tilemap array
-    std::vector<TileType> m_Tiles;
+    /// @brief   the chunks of the tilemap, row by row - nullptr where every tile of a chunk is empty
+    std::vector< std::unique_ptr< Chunk > > m_Chunks;
+
+    /// @brief   how many chunks the tilemap is split into along each axis
+    glm::ivec2 m_ChunkCounts = { 0, 0 };
+
+    /// @brief   the version of the tilemap when each chunk last changed
+    std::vector< unsigned > m_ChunkVersions;
+
+    /// @brief   the version of the tilemap, incremented whenever any tile changes
+    unsigned m_Version = 0;
 
     /// @brief   Size of the Tilemap in tiles
     glm::ivec2 m_Dimensions = { 10, 0 };
@@ -191,6 +305,10 @@ private: // data
     /// @brief   Scale of tiles (on top of transform) - to adjust spacing
     glm::vec2 m_TileScale = {1,1};
 
+    /// @brief   Whether the tiles are generated from another Tilemap (e.g. by a TilemapTextureConnector).
+    ///          Derived tiles aren't saved, since they're regenerated on load.
+    bool m_IsDerived = false;
+
     /// @brief   Matrix for converting tile coord to world pos
     glm::mat4 m_Mat = glm::mat4(1);
 
@@ -219,6 +337,21 @@ private: // methods
     void updateMat();
 
 
+    /// @brief          Replaces every tile, reallocating only the chunks that aren't empty
+    /// @param tiles    the new tiles, row by row - there must be at least as many as the dimensions hold
+    void loadTiles( std::vector<TileType> const& tiles );
+
+    /// @brief          Empties the tiles of a chunk that lie outside the dimensions, freeing the chunk if nothing is left
+    /// @param chunkPos the position of the chunk, in chunks
+    void clearOutsideDimensions( glm::ivec2 const& chunkPos );
+
+    /// @brief          Sets every tile in a rectangle, without calling the OnTilemapChanged callbacks
+    /// @param min      the first tile of the rectangle
+    /// @param max      one past the last tile of the rectangle
+    /// @param tile     the value to set the tiles to
+    void fillTiles( glm::ivec2 const& min, glm::ivec2 const& max, TileType const& tile );
+
+
 //-----------------------------------------------------------------------------
 //              Reading
 //-----------------------------------------------------------------------------
@@ -236,6 +369,10 @@ private:
     /// @param  stream    The json to read from.
     void readTileScale( nlohmann::ordered_json const& data );
 
+    /// @brief            Read in whether the tiles are generated from another Tilemap
+    /// @param  stream    The json to read from.
+    void readIsDerived( nlohmann::ordered_json const& data );
+
     /// @brief the map of read methods for this Component
     static ReadMethodMap< Tilemap > const s_ReadMethods;
 
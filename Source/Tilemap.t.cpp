@@ -18,6 +18,7 @@
 
 #include "Entity.h"  // parent
 #include "Transform.h"
+#include "DebugSystem.h"
 
 
 
@@ -48,8 +49,20 @@
         m_InvMat(other.m_InvMat),
         m_Mat(other.m_Mat),
         m_TileScale(other.m_TileScale),
-        m_Tiles(other.m_Tiles)
-    {}
+        m_IsDerived(other.m_IsDerived),
+        m_ChunkCounts(other.m_ChunkCounts),
+        m_ChunkVersions(other.m_ChunkVersions),
+        m_Version(other.m_Version)
+    {
+        m_Chunks.resize( other.m_Chunks.size() );
+        for ( int i = 0; i < (int)m_Chunks.size(); ++i )
+        {
+            if ( other.m_Chunks[ i ] != nullptr )
+            {
+                m_Chunks[ i ] = std::make_unique< Chunk >( *other.m_Chunks[ i ] );
+            }
+        }
+    }
 
 
 
@@ -57,13 +70,55 @@
 //          Public methods
 //-----------------------------------------------------------------------------
 
+    /// @brief          Retrieve entire tilemap
+    /// @return         array (vector) of tile IDs, row by row
+    template < typename TileType >
+    std::vector<TileType> Tilemap<TileType>::GetTilemap() const
+    {
+        std::vector<TileType> tiles( std::max( m_Dimensions.x * m_Dimensions.y, 0 ) );
+        CopyTiles( 0, (int)tiles.size(), tiles.data() );
+        return tiles;
+    }
+
+
+    /// @brief          Copies a run of tiles out of the chunks, in the same order as GetTilemap()
+    /// @param  first   the index of the first tile to copy, row by row
+    /// @param  count   how many tiles to copy
+    /// @param  tiles   where to copy the tiles to
+    template < typename TileType >
+    void Tilemap<TileType>::CopyTiles( int first, int count, TileType* tiles ) const
+    {
+        while ( count > 0 )
+        {
+            glm::ivec2 coord = { first % m_Dimensions.x, first / m_Dimensions.x };
+
+            // copy up to the end of the row, within either the chunk or the tilemap
+            int runLength = std::min( { count, s_ChunkSize - ( coord.x & ( s_ChunkSize - 1 ) ), m_Dimensions.x - coord.x } );
+
+            Chunk const* chunk = m_Chunks[ ( coord.y >> s_ChunkShift ) * m_ChunkCounts.x + ( coord.x >> s_ChunkShift ) ].get();
+            if ( chunk == nullptr )
+            {
+                std::fill_n( tiles, runLength, EmptyTile() );
+            }
+            else
+            {
+                std::copy_n( chunk->M_Tiles + ( ( coord.y & ( s_ChunkSize - 1 ) ) << s_ChunkShift ) + ( coord.x & ( s_ChunkSize - 1 ) ), runLength, tiles );
+            }
+
+            first += runLength;
+            count -= runLength;
+            tiles += runLength;
+        }
+    }
+
+
     /// @brief          Sets the whole tilemap to a given array (vector)
     /// @param  tiles   vector of tile IDs
     template < typename TileType >
     void Tilemap<TileType>::SetTilemap( std::vector<TileType> const& tiles ) 
     {
-        m_Tiles = tiles;
         m_Dimensions.y = (int)tiles.size() / m_Dimensions.x;
+        loadTiles( tiles );
 
         callOnTilemapChangedCallbacks();
 
@@ -77,15 +132,90 @@
     template < typename TileType >
     void Tilemap<TileType>::SetTile(glm::ivec2 coord, TileType const& tile)
     {
-        int index = coord.y * m_Dimensions.x + coord.x;
+        int chunkIndex = ( coord.y >> s_ChunkShift ) * m_ChunkCounts.x + ( coord.x >> s_ChunkShift );
+        std::unique_ptr< Chunk >& chunk = m_Chunks[ chunkIndex ];
+
+        TileType previousValue = chunk != nullptr ? chunk->M_Tiles[ ( ( coord.y & ( s_ChunkSize - 1 ) ) << s_ChunkShift ) + ( coord.x & ( s_ChunkSize - 1 ) ) ] : EmptyTile();
+        if ( previousValue == tile )
+        {
+            return;
+        }
 
-        TileType previousValue = m_Tiles[ index ];
-        m_Tiles[ index ] = tile;
+        if ( chunk == nullptr )
+        {
+            chunk = std::make_unique< Chunk >();
+            std::fill_n( chunk->M_Tiles, s_ChunkSize * s_ChunkSize, EmptyTile() );
+        }
 
-        if ( previousValue != tile )
+        chunk->M_Tiles[ ( ( coord.y & ( s_ChunkSize - 1 ) ) << s_ChunkShift ) + ( coord.x & ( s_ChunkSize - 1 ) ) ] = tile;
+        chunk->M_FilledCount += ( tile != EmptyTile() ) - ( previousValue != EmptyTile() );
+        if ( chunk->M_FilledCount == 0 )
         {
-            callOnTilemapChangedCallbacks( coord, previousValue );
+            chunk.reset();
         }
+
+        m_ChunkVersions[ chunkIndex ] = ++m_Version;
+
+        callOnTilemapChangedCallbacks( coord, previousValue );
+    }
+
+
+    /// @brief  sets the size of the tilemap in tiles. Tiles keep their coordinates, and new tiles are TileType() (0 for int tilemaps).
+    /// @param  dimensions  the size of the tilemap
+    template < typename TileType >
+    void Tilemap<TileType>::SetDimensions( glm::ivec2 const& dimensions )
+    {
+        glm::ivec2 chunkCounts = ( glm::max( dimensions, glm::ivec2( 0 ) ) + s_ChunkSize - 1 ) / s_ChunkSize;
+
+        // move the chunks that are still within the tilemap to their new positions
+        std::vector< std::unique_ptr< Chunk > > chunks( chunkCounts.x * chunkCounts.y );
+        glm::ivec2 keptCounts = glm::min( chunkCounts, m_ChunkCounts );
+        for ( int y = 0; y < keptCounts.y; ++y )
+        {
+            for ( int x = 0; x < keptCounts.x; ++x )
+            {
+                chunks[ y * chunkCounts.x + x ] = std::move( m_Chunks[ y * m_ChunkCounts.x + x ] );
+            }
+        }
+
+        glm::ivec2 keptDimensions = glm::clamp( m_Dimensions, glm::ivec2( 0 ), glm::max( dimensions, glm::ivec2( 0 ) ) );
+
+        m_Chunks = std::move( chunks );
+        m_ChunkCounts = chunkCounts;
+        m_Dimensions = dimensions;
+
+        // empty the tiles that were cut off, so they don't come back if the tilemap grows again
+        for ( int y = 0; y < m_ChunkCounts.y; ++y )
+        {
+            clearOutsideDimensions( { m_ChunkCounts.x - 1, y } );
+        }
+        for ( int x = 0; x < m_ChunkCounts.x - 1; ++x )
+        {
+            clearOutsideDimensions( { x, m_ChunkCounts.y - 1 } );
+        }
+
+        // grown tiles are value-initialized, like resizing a vector of tiles does
+        if ( TileType() != EmptyTile() )
+        {
+            fillTiles( { keptDimensions.x, 0 }, m_Dimensions, TileType() );
+            fillTiles( { 0, keptDimensions.y }, { keptDimensions.x, m_Dimensions.y }, TileType() );
+        }
+
+        m_ChunkVersions.assign( m_Chunks.size(), ++m_Version );
+    }
+
+
+    /// @return how many chunks hold at least one tile that isn't empty
+    template < typename TileType >
+    int Tilemap<TileType>::GetAllocatedChunkCount() const
+    {
+        int count = 0;
+        for ( std::unique_ptr< Chunk > const& chunk : m_Chunks )
+        {
+            count += chunk != nullptr;
+        }
+
+        return count;
     }
 
 
@@ -249,32 +379,178 @@
     }
 
 
+    /// @brief          Replaces every tile, reallocating only the chunks that aren't empty
+    /// @param tiles    the new tiles, row by row - there must be at least as many as the dimensions hold
+    template < typename TileType >
+    void Tilemap<TileType>::loadTiles( std::vector<TileType> const& tiles )
+    {
+        m_ChunkCounts = ( glm::max( m_Dimensions, glm::ivec2( 0 ) ) + s_ChunkSize - 1 ) / s_ChunkSize;
+        m_Chunks.clear();
+        m_Chunks.resize( m_ChunkCounts.x * m_ChunkCounts.y );
+
+        for ( int chunkY = 0; chunkY < m_ChunkCounts.y; ++chunkY )
+        {
+            for ( int chunkX = 0; chunkX < m_ChunkCounts.x; ++chunkX )
+            {
+                glm::ivec2 first = glm::ivec2( chunkX, chunkY ) * s_ChunkSize;
+                int width = std::min( s_ChunkSize, m_Dimensions.x - first.x );
+                int height = std::min( s_ChunkSize, m_Dimensions.y - first.y );
+
+                int filledCount = 0;
+                for ( int y = 0; y < height; ++y )
+                {
+                    auto row = tiles.begin() + ( first.y + y ) * m_Dimensions.x + first.x;
+                    filledCount += width - (int)std::count( row, row + width, EmptyTile() );
+                }
+
+                if ( filledCount == 0 )
+                {
+                    continue;
+                }
+
+                std::unique_ptr< Chunk >& chunk = m_Chunks[ chunkY * m_ChunkCounts.x + chunkX ];
+                chunk = std::make_unique< Chunk >();
+                std::fill_n( chunk->M_Tiles, s_ChunkSize * s_ChunkSize, EmptyTile() );
+                for ( int y = 0; y < height; ++y )
+                {
+                    std::copy_n( tiles.begin() + ( first.y + y ) * m_Dimensions.x + first.x, width, chunk->M_Tiles + y * s_ChunkSize );
+                }
+                chunk->M_FilledCount = filledCount;
+            }
+        }
+
+        m_ChunkVersions.assign( m_Chunks.size(), ++m_Version );
+    }
+
+
+    /// @brief          Empties the tiles of a chunk that lie outside the dimensions, freeing the chunk if nothing is left
+    /// @param chunkPos the position of the chunk, in chunks
+    template < typename TileType >
+    void Tilemap<TileType>::clearOutsideDimensions( glm::ivec2 const& chunkPos )
+    {
+        if ( chunkPos.x < 0 || chunkPos.y < 0 )
+        {
+            return;
+        }
+
+        std::unique_ptr< Chunk >& chunk = m_Chunks[ chunkPos.y * m_ChunkCounts.x + chunkPos.x ];
+        if ( chunk == nullptr )
+        {
+            return;
+        }
+
+        glm::ivec2 first = chunkPos * s_ChunkSize;
+        int width = std::min( s_ChunkSize, m_Dimensions.x - first.x );
+        int height = std::min( s_ChunkSize, m_Dimensions.y - first.y );
+        for ( int y = 0; y < s_ChunkSize; ++y )
+        {
+            for ( int x = y < height ? width : 0; x < s_ChunkSize; ++x )
+            {
+                TileType& tile = chunk->M_Tiles[ y * s_ChunkSize + x ];
+                chunk->M_FilledCount -= tile != EmptyTile();
+                tile = EmptyTile();
+            }
+        }
+
+        if ( chunk->M_FilledCount == 0 )
+        {
+            chunk.reset();
+        }
+    }
+
+
+    /// @brief          Sets every tile in a rectangle, without calling the OnTilemapChanged callbacks
+    /// @param min      the first tile of the rectangle
+    /// @param max      one past the last tile of the rectangle
+    /// @param tile     the value to set the tiles to
+    template < typename TileType >
+    void Tilemap<TileType>::fillTiles( glm::ivec2 const& min, glm::ivec2 const& max, TileType const& tile )
+    {
+        if ( min.x >= max.x || min.y >= max.y )
+        {
+            return;
+        }
+
+        glm::ivec2 minChunk = min >> s_ChunkShift;
+        glm::ivec2 maxChunk = ( max - 1 ) >> s_ChunkShift;
+        for ( int chunkY = minChunk.y; chunkY <= maxChunk.y; ++chunkY )
+        {
+            for ( int chunkX = minChunk.x; chunkX <= maxChunk.x; ++chunkX )
+            {
+                std::unique_ptr< Chunk >& chunk = m_Chunks[ chunkY * m_ChunkCounts.x + chunkX ];
+                if ( chunk == nullptr )
+                {
+                    if ( tile == EmptyTile() )
+                    {
+                        continue;
+                    }
+
+                    chunk = std::make_unique< Chunk >();
+                    std::fill_n( chunk->M_Tiles, s_ChunkSize * s_ChunkSize, EmptyTile() );
+                }
+
+                glm::ivec2 first = glm::max( glm::ivec2( chunkX, chunkY ) * s_ChunkSize, min );
+                glm::ivec2 last = glm::min( glm::ivec2( chunkX, chunkY ) * s_ChunkSize + s_ChunkSize, max );
+                for ( int y = first.y; y < last.y; ++y )
+                {
+                    for ( int x = first.x; x < last.x; ++x )
+                    {
+                        TileType& current = chunk->M_Tiles[ ( ( y & ( s_ChunkSize - 1 ) ) << s_ChunkShift ) + ( x & ( s_ChunkSize - 1 ) ) ];
+                        chunk->M_FilledCount += ( tile != EmptyTile() ) - ( current != EmptyTile() );
+                        current = tile;
+                    }
+                }
+
+                if ( chunk->M_FilledCount == 0 )
+                {
+                    chunk.reset();
+                }
+            }
+        }
+    }
+
+
 //-----------------------------------------------------------------------------
 // private: reading
 //-----------------------------------------------------------------------------
 
 
     /// @brief          Read in the text this Tilemap displays
-    /// @param  stream  The json to read from.
+    /// @param  stream  The json to read from - either run-length encoded text, or an array with one ID per tile
     template < typename TileType >
     void Tilemap<TileType>::readTilemap( nlohmann::ordered_json const& data )
     {
-        if ( std::is_same_v< TileType , int > == false )
+        if constexpr ( std::is_same_v< TileType , int > == false )
         { // only serialize int tilemaps
             return;
         }
+        else
+        {
+            std::vector< int > tiles;
+            if ( data.is_string() )
+            {
+                if ( decodeTileRuns( data.get_ref< std::string const& >(), &tiles ) == false )
+                {
+                    Debug() << "WARNING: invalid run-length encoded TileData, the Tilemap was left empty" << std::endl;
+                    tiles.clear();
+                }
+            }
+            else
+            {
+                tiles.resize( data.size() );
+                for ( int i = 0; i < data.size(); ++i )
+                {
+                    Stream::Read( tiles[ i ], data[ i ] );
+                }
+            }
 
-        m_Dimensions.y = (int)data.size() / m_Dimensions.x;
-        int extraTiles = data.size() % m_Dimensions.x;
-        m_Tiles.resize( data.size() + ( extraTiles == 0 ? 0 : m_Dimensions.x - extraTiles ) );
+            // pad out the last row with tile 0, as it always has been
+            m_Dimensions.y = ( (int)tiles.size() + m_Dimensions.x - 1 ) / m_Dimensions.x;
+            tiles.resize( m_Dimensions.x * m_Dimensions.y );
+            loadTiles( tiles );
 
-        m_Dimensions.y = (int)data.size() / m_Dimensions.x;
-        for ( int i = 0; i < data.size(); ++i )
-        {
-            Stream::Read( m_Tiles[ i ], data[ i ] );
+            callOnTilemapChangedCallbacks();
         }
-
-        callOnTilemapChangedCallbacks();
     }
 
 
@@ -283,8 +559,7 @@
     template < typename TileType >
     void Tilemap<TileType>::readDimensions( nlohmann::ordered_json const& data )
     {
-        m_Dimensions = Stream::Read< 2, int >( data );
-        m_Tiles.resize( m_Dimensions.x * m_Dimensions.y );
+        SetDimensions( Stream::Read< 2, int >( data ) );
     }
 
 
@@ -297,12 +572,22 @@
     }
 
 
+    /// @brief            Read in whether the tiles are generated from another Tilemap
+    /// @param  stream    The json to read from.
+    template < typename TileType >
+    void Tilemap<TileType>::readIsDerived( nlohmann::ordered_json const& data )
+    {
+        Stream::Read( m_IsDerived, data );
+    }
+
+
     /// @brief      The map of read methods for this Component
     template < typename TileType >
     ReadMethodMap< Tilemap<TileType> > const Tilemap<TileType>::s_ReadMethods = {
         { "TileData", &readTilemap  },
         { "Dimensions", &readDimensions },
-        { "TileScale", &readTileScale }
+        { "TileScale", &readTileScale },
+        { "IsDerived", &readIsDerived }
     };
 
 
@@ -321,16 +606,14 @@
 
         data[ "Dimensions" ] = Stream::Write( m_Dimensions );
         data[ "TileScale" ] = Stream::Write( m_TileScale );
+        data[ "IsDerived" ] = Stream::Write( m_IsDerived );
 
-        if ( std::is_same_v< TileType, int > == false )
+        if constexpr ( std::is_same_v< TileType, int > )
         {
-            return data;
-        }
-
-        nlohmann::ordered_json& tileData = data[ "TileData" ];
-        for ( TileType const& tile : m_Tiles )
-        {
-            tileData.push_back( Stream::Write( tile ) );
+            if ( m_IsDerived == false )
+            {
+                data[ "TileData" ] = encodeTileRuns( GetTilemap() );
+            }
         }
 
         return data;
@@ -33,6 +33,22 @@
     {}
 
 
+//-----------------------------------------------------------------------------
+// public: accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  rebuilds the tile flags if the Tilemap was resized without notifying its callbacks
+    /// @note   call before GetTileFlags(), and before reading flags from several threads at once
+    void TilemapCollider::PrepareTileFlags() const
+    {
+        if ( m_Tilemap != nullptr && m_FlagDimensions != m_Tilemap->GetDimensions() )
+        {
+            rebuildTileFlags();
+        }
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: virtual overrides
 //-----------------------------------------------------------------------------
@@ -54,6 +70,32 @@
             }
         );
 
+        m_Tilemap.SetOnConnectCallback(
+            [ this ]()
+            {
+                m_Tilemap->AddOnTilemapChangedCallback(
+                    GetId(),
+                    std::bind(
+                        &TilemapCollider::onTilemapChanged,
+                        this,
+                        std::placeholders::_1,
+                        std::placeholders::_2,
+                        std::placeholders::_3
+                    )
+                );
+                rebuildTileFlags();
+            }
+        );
+        m_Tilemap.SetOnDisconnectCallback(
+            [ this ]()
+            {
+                m_Tilemap->RemoveOnTilemapChangedCallback( GetId() );
+                m_FlagChunks.clear();
+                m_FlagChunkCounts = { 0, 0 };
+                m_FlagDimensions = { 0, 0 };
+            }
+        );
+
         m_RigidBody .Init( GetEntity() );
         m_StaticBody.Init( GetEntity() );
         m_Tilemap   .Init( GetEntity() );
@@ -127,6 +169,128 @@
     }
 
 
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  recalculates the flags of every tile
+    void TilemapCollider::rebuildTileFlags() const
+    {
+        static constexpr int chunkSize = Tilemap< int >::s_ChunkSize;
+
+        m_FlagDimensions = m_Tilemap->GetDimensions();
+        m_FlagChunkCounts = m_Tilemap->GetChunkCounts();
+        m_FlagChunks.clear();
+        m_FlagChunks.resize( m_FlagChunkCounts.x * m_FlagChunkCounts.y );
+
+        // only chunks with tiles in them can have flags
+        glm::ivec2 chunkPos;
+        for ( chunkPos.y = 0; chunkPos.y < m_FlagChunkCounts.y; ++chunkPos.y )
+        {
+            for ( chunkPos.x = 0; chunkPos.x < m_FlagChunkCounts.x; ++chunkPos.x )
+            {
+                if ( m_Tilemap->GetChunk( chunkPos ) == nullptr )
+                {
+                    continue;
+                }
+
+                std::unique_ptr< FlagChunk >& flagChunk = m_FlagChunks[ chunkPos.y * m_FlagChunkCounts.x + chunkPos.x ];
+                flagChunk = std::make_unique< FlagChunk >();
+                flagChunk->fill( 0 );
+
+                glm::ivec2 first = chunkPos * chunkSize;
+                glm::ivec2 last = glm::min( first + chunkSize, m_FlagDimensions ) - 1;
+                glm::ivec2 tilePos;
+                for ( tilePos.y = first.y; tilePos.y <= last.y; ++tilePos.y )
+                {
+                    for ( tilePos.x = first.x; tilePos.x <= last.x; ++tilePos.x )
+                    {
+                        ( *flagChunk )[ ( tilePos.y - first.y ) * chunkSize + ( tilePos.x - first.x ) ] = calculateTileFlags( tilePos );
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief  recalculates the flags of a single tile, allocating or freeing its chunk of flags to match the Tilemap
+    /// @param  tilePos the position of the tile to recalculate the flags of
+    void TilemapCollider::updateTileFlags( glm::ivec2 const& tilePos ) const
+    {
+        static constexpr int chunkShift = Tilemap< int >::s_ChunkShift;
+        static constexpr int chunkMask = Tilemap< int >::s_ChunkSize - 1;
+
+        glm::ivec2 chunkPos = { tilePos.x >> chunkShift, tilePos.y >> chunkShift };
+        std::unique_ptr< FlagChunk >& flagChunk = m_FlagChunks[ chunkPos.y * m_FlagChunkCounts.x + chunkPos.x ];
+
+        // the Tilemap frees chunks that become empty, and allocates them when their first tile is set
+        if ( m_Tilemap->GetChunk( chunkPos ) == nullptr )
+        {
+            flagChunk.reset();
+            return;
+        }
+        if ( flagChunk == nullptr )
+        {
+            flagChunk = std::make_unique< FlagChunk >();
+            flagChunk->fill( 0 );
+        }
+
+        ( *flagChunk )[ ( ( tilePos.y & chunkMask ) << chunkShift ) + ( tilePos.x & chunkMask ) ] = calculateTileFlags( tilePos );
+    }
+
+    /// @brief  works out the flags of a tile from it and its neighbors
+    /// @param  tilePos the position of the tile
+    /// @return the flags of the tile
+    uint8_t TilemapCollider::calculateTileFlags( glm::ivec2 const& tilePos ) const
+    {
+        if ( m_Tilemap->GetTile( tilePos ) < 0 )
+        {
+            return 0;
+        }
+
+        // an edge only collides if it faces an empty tile - edges facing out of the tilemap don't
+        glm::ivec2 const& dimensions = m_FlagDimensions;
+        uint8_t flags = s_TileSolid;
+        if ( tilePos.x > 0                && m_Tilemap->GetTile( tilePos + glm::ivec2( -1,  0 ) ) < 0 ) { flags |= s_TileEdgeLeft;  }
+        if ( tilePos.x < dimensions.x - 1 && m_Tilemap->GetTile( tilePos + glm::ivec2( +1,  0 ) ) < 0 ) { flags |= s_TileEdgeRight; }
+        if ( tilePos.y > 0                && m_Tilemap->GetTile( tilePos + glm::ivec2(  0, -1 ) ) < 0 ) { flags |= s_TileEdgeDown;  }
+        if ( tilePos.y < dimensions.y - 1 && m_Tilemap->GetTile( tilePos + glm::ivec2(  0, +1 ) ) < 0 ) { flags |= s_TileEdgeUp;    }
+
+        return flags;
+    }
+
+    /// @brief  called whenever the Tilemap changes
+    /// @param  tilemap         the tilemap that changed
+    /// @param  tilePos         the position of the tile that changed, or (-1, -1) if the whole tilemap changed
+    /// @param  previousValue   the previous value of the changed tile
+    void TilemapCollider::onTilemapChanged( Tilemap< int >* tilemap, glm::ivec2 const& tilePos, int const& previousValue )
+    {
+        if ( tilePos.x == -1 || m_FlagDimensions != tilemap->GetDimensions() )
+        {
+            rebuildTileFlags();
+            return;
+        }
+
+        // the tile itself, and the edges of its neighbors that face it
+        glm::ivec2 const offsets[] = {
+            glm::ivec2(  0,  0 ),
+            glm::ivec2( -1,  0 ),
+            glm::ivec2( +1,  0 ),
+            glm::ivec2(  0, -1 ),
+            glm::ivec2(  0, +1 )
+        };
+        for ( glm::ivec2 const& offset : offsets )
+        {
+            if ( tilemap->IsPositionWithinBounds( tilePos + offset ) )
+            {
+                updateTileFlags( tilePos + offset );
+            }
+        }
+
+        (void)previousValue;
+    }
+
+
 //-----------------------------------------------------------------------------
 // public: reading / writing
 //-----------------------------------------------------------------------------
@@ -27,6 +27,40 @@ public: // constructor
     TilemapCollider();
 
 
+//-----------------------------------------------------------------------------
+public: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  tile flag: the left edge of the tile faces an empty tile - the edge flags match CollisionSystem's edge flags
+    static constexpr uint8_t s_TileEdgeLeft  = 0b00001;
+
+    /// @brief  tile flag: the right edge of the tile faces an empty tile
+    static constexpr uint8_t s_TileEdgeRight = 0b00010;
+
+    /// @brief  tile flag: the bottom edge of the tile faces an empty tile
+    static constexpr uint8_t s_TileEdgeDown  = 0b00100;
+
+    /// @brief  tile flag: the top edge of the tile faces an empty tile
+    static constexpr uint8_t s_TileEdgeUp    = 0b01000;
+
+    /// @brief  tile flag mask: all of the edge flags
+    static constexpr uint8_t s_TileEdges     = 0b01111;
+
+    /// @brief  tile flag: the tile is solid
+    static constexpr uint8_t s_TileSolid     = 0b10000;
+
+
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the flags of one chunk of the Tilemap, laid out like the tiles of Tilemap< int >::Chunk
+    /// @note   only allocated where the Tilemap's chunk is, since empty tiles have no flags
+    using FlagChunk = std::array< uint8_t, Tilemap< int >::s_ChunkSize * Tilemap< int >::s_ChunkSize >;
+
+
 //-----------------------------------------------------------------------------
 public: // accessors
 //-----------------------------------------------------------------------------
@@ -37,6 +71,28 @@ public: // accessors
     Tilemap< int > const* GetTilemap() const { return m_Tilemap; }
 
 
+    /// @brief  rebuilds the tile flags if the Tilemap was resized without notifying its callbacks
+    /// @note   call before GetTileFlags(), and before reading flags from several threads at once
+    void PrepareTileFlags() const;
+
+    /// @brief  gets the collision flags of a tile - whether it's solid, and which of its edges face an empty tile
+    /// @param  tilePos the position of the tile, which must be within the Tilemap
+    /// @return the flags of the tile
+    uint8_t GetTileFlags( glm::ivec2 const& tilePos ) const
+    {
+        static constexpr int chunkShift = Tilemap< int >::s_ChunkShift;
+        static constexpr int chunkMask = Tilemap< int >::s_ChunkSize - 1;
+
+        FlagChunk const* flagChunk = m_FlagChunks[ ( tilePos.y >> chunkShift ) * m_FlagChunkCounts.x + ( tilePos.x >> chunkShift ) ].get();
+        if ( flagChunk == nullptr )
+        {
+            return 0;
+        }
+
+        return ( *flagChunk )[ ( ( tilePos.y & chunkMask ) << chunkShift ) + ( tilePos.x & chunkMask ) ];
+    }
+
+
 //-----------------------------------------------------------------------------
 public: // virtual overrides
 //-----------------------------------------------------------------------------
@@ -61,6 +117,40 @@ private: // members
     /// @brief  the Tilemap component associated with this TilemapCollider
     ComponentReference< Tilemap< int > > m_Tilemap;
 
+    /// @brief  the collision flags of each chunk of the Tilemap, kept up to date as the Tilemap changes
+    /// @note   mutable so that they can be rebuilt on demand if the Tilemap was resized without notifying its callbacks
+    mutable std::vector< std::unique_ptr< FlagChunk > > m_FlagChunks;
+
+    /// @brief  how many chunks m_FlagChunks holds along each axis
+    mutable glm::ivec2 m_FlagChunkCounts = { 0, 0 };
+
+    /// @brief  the dimensions of the Tilemap when the flags were last rebuilt
+    mutable glm::ivec2 m_FlagDimensions = { 0, 0 };
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  recalculates the flags of every tile
+    void rebuildTileFlags() const;
+
+    /// @brief  recalculates the flags of a single tile, allocating or freeing its chunk of flags to match the Tilemap
+    /// @param  tilePos the position of the tile to recalculate the flags of
+    void updateTileFlags( glm::ivec2 const& tilePos ) const;
+
+    /// @brief  works out the flags of a tile from it and its neighbors
+    /// @param  tilePos the position of the tile
+    /// @return the flags of the tile
+    uint8_t calculateTileFlags( glm::ivec2 const& tilePos ) const;
+
+    /// @brief  called whenever the Tilemap changes
+    /// @param  tilemap         the tilemap that changed
+    /// @param  tilePos         the position of the tile that changed, or (-1, -1) if the whole tilemap changed
+    /// @param  previousValue   the previous value of the changed tile
+    void onTilemapChanged( Tilemap< int >* tilemap, glm::ivec2 const& tilePos, int const& previousValue );
+
 
 //-----------------------------------------------------------------------------
 public: // reading / writing
@@ -24,6 +24,7 @@
 #include "Inspection.h"
 
 #include "EntitySystem.h"
+#include "EntityPoolSystem.h"
 #include "TileInfoSystem.h"
 
 
@@ -149,7 +150,7 @@
 
 
         // spawn the item
-        Entity* itemEntity = m_ItemArchetype->Clone();
+        Entity* itemEntity = EntityPools()->Spawn( m_ItemArchetype );
 
         itemEntity->GetComponent< Transform >()->SetTranslation( position );
         itemEntity->GetComponent< RigidBody >()->SetVelocity( velocity );
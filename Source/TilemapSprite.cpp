@@ -14,6 +14,7 @@
 #include "Entity.h"         // parent
 #include "Transform.h"
 #include "Texture.h"
+#include "ViewFrustum.h"    // culling
 
 #ifndef NDEBUG
 #include <iostream>
@@ -53,33 +54,21 @@ void TilemapSprite::LoadTileArray(const char* tiles, int size)
     if (!size)
         return;
 
-    // Until I figure out what's wrong with reading ints from buffer, convert to floats.
-    std::vector<float> chars(size);
-    for (int i = 0; i < size; i++)
-        chars[i] = (float)tiles[i];
-
-    // Load the array into buffer.
-    glBindBuffer(GL_ARRAY_BUFFER, m_InstBufferID);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * size, &chars[0], GL_DYNAMIC_DRAW);
+    LoadTileArray(std::vector<int>(tiles, tiles + size));
 }
 
 
 /// @brief              Loads the tile array from a vector of ints.
 /// @param tiles        tile IDs  (spritesheet frames)
-void TilemapSprite::LoadTileArray(std::vector<int> tiles)
+void TilemapSprite::LoadTileArray(std::vector<int> const& tiles)
 {
     int size = (int)tiles.size();
     if (!size)
         return;
 
-    // Until I figure out what's wrong with reading ints from buffer, convert to floats.
-    std::vector<float> chars(size);         // (this one will load directly)
-    for (int i = 0; i < size; i++)
-        chars[i] = (float)tiles[i];
-
     // Load the array into buffer.
     glBindBuffer(GL_ARRAY_BUFFER, m_InstBufferID);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * size, &chars[0], GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(int) * size, tiles.data(), GL_DYNAMIC_DRAW);
 }
 
 
@@ -101,7 +90,7 @@ void TilemapSprite::OnInit()
     }
 
     initInstancingStuff();
-    m_TilemapChanged = true;
+    m_UploadTracker.MarkAll();
 
     // Init text shader if it ain't.
     if ( Renderer()->GetShader( "tile" ) == nullptr )
@@ -177,13 +166,8 @@ void TilemapSprite::Draw()
     glm::vec2 tileScale = m_Tilemap->GetTileScale() * m_Transform->GetScale();
     int rowWidth = m_Tilemap->GetDimensions().x;
 
-    // Get data from Tilemap component, if it has been updated.
-    if (m_TilemapChanged)
-    {
-        LoadTileArray(m_Tilemap->GetTilemap());
-
-        m_TilemapChanged = false;
-    }
+    // Upload whichever tiles changed since the last frame.
+    uploadChangedTiles();
 
 
     // Calculate matrix and stride based on parent't transform
@@ -191,11 +175,33 @@ void TilemapSprite::Draw()
     glm::vec2 stridex = {tileScale.x - 0.00001f,0};  // right vector (x stride)
     glm::vec2 stridey = {0,-tileScale.y + 0.00001f}; // down vector (y stride) (needs slight adjustment to avoid tearing)
 
+    // Only draw the rows of tiles that are on screen
+    int firstTile = 0;
+    int tileCount = rowWidth * m_Tilemap->GetDimensions().y;
+
     if (parent && parent->GetComponent<Transform>())
     {
         Transform* tr = parent->GetComponent<Transform>();
         trm = tr->GetMatrix();
 
+        glm::vec2 tileMin, tileMax;
+        ViewFrustum::TransformBounds(trm, mesh->GetBounds()[0], mesh->GetBounds()[1], &tileMin, &tileMax);
+
+        glm::ivec2 firstVisible, lastVisible;
+        if (!Renderer()->GetView(tr->GetIsDiegetic()).GetVisibleCells(
+            tileMin, tileMax, {tileScale.x, -tileScale.y}, {rowWidth, tileCount / std::max(rowWidth, 1)},
+            &firstVisible, &lastVisible
+        ))
+        {
+            Renderer()->AddCullingCounts(0, tileCount);
+            return;
+        }
+
+        firstTile = firstVisible.y * rowWidth;
+        int visibleCount = (lastVisible.y + 1 - firstVisible.y) * rowWidth;
+        Renderer()->AddCullingCounts(visibleCount, tileCount - visibleCount);
+        tileCount = visibleCount;
+
         // world or camera projection
         glm::mat4 proj;
         if (tr->GetIsDiegetic())
@@ -222,13 +228,14 @@ void TilemapSprite::Draw()
     glUniform2f(sh_txt->GetUniformID("UVsize"), uvsize.x, uvsize.y);
     glUniform1i(sh_txt->GetUniformID("columns"), m_Texture->GetSheetDimensions().x);
     glUniform1i(sh_txt->GetUniformID("rowwidth"), rowWidth);
+    glUniform1i(sh_txt->GetUniformID("firsttile"), firstTile);
     glUniform4fv(sh_txt->GetUniformID("tint"), 1, &m_Color[0]);
 
 
     // Bind the texture and render instanced mesh
     m_Texture->Bind();
     glBindVertexArray(m_VAO);
-    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, mesh->GetVertexCount(), (int)m_Tilemap->GetTilemap().size());
+    glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, mesh->GetVertexCount(), tileCount, firstTile);
     glBindVertexArray(0);
 }
 
@@ -261,7 +268,7 @@ void TilemapSprite::initInstancingStuff()
     glBindBuffer(GL_ARRAY_BUFFER, m_InstBufferID);
 
     // ...and an extra attribute that refers to this buffer in particular.
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, 0);  // 1 float, no offset
+    glVertexAttribIPointer(2, 1, GL_INT, 0, 0);             // 1 int, no offset
     glVertexAttribDivisor(2, 1);                            // 1 per instance
     glEnableVertexAttribArray(2);
 
@@ -269,6 +276,70 @@ void TilemapSprite::initInstancingStuff()
 }
 
 
+/// @brief          Marks the changed tiles to be uploaded. Used as callback for
+///                 Tilemap component. The marks are cleared when Draw() is called.
+/// @param tilemap  the Tilemap that changed
+/// @param tilepos  the tile that changed, or (-1, -1) if the whole tilemap changed
+void TilemapSprite::onTilemapChanged( Tilemap< int >* tilemap, glm::ivec2 const& tilepos, int const& )
+{
+    if ( tilepos.x < 0 )
+    {
+        m_UploadTracker.MarkAll();
+    }
+    else
+    {
+        m_UploadTracker.MarkTile( tilepos.y * tilemap->GetDimensions().x + tilepos.x );
+    }
+}
+
+
+/// @brief          Uploads the tiles the upload tracker says have changed
+void TilemapSprite::uploadChangedTiles()
+{
+    glm::ivec2 dimensions = m_Tilemap->GetDimensions();
+    int tileCount = std::max( dimensions.x * dimensions.y, 0 );
+
+    if ( m_UploadTracker.Flush( tileCount ) )
+    {
+        // reallocate, then fill it straight from the chunks
+        if ( tileCount > 0 )
+        {
+            glBindBuffer( GL_ARRAY_BUFFER, m_InstBufferID );
+            glBufferData( GL_ARRAY_BUFFER, sizeof( int ) * tileCount, nullptr, GL_DYNAMIC_DRAW );
+            uploadTiles( 0, tileCount );
+        }
+    }
+    else if ( m_UploadTracker.GetRanges().empty() == false )
+    {
+        glBindBuffer( GL_ARRAY_BUFFER, m_InstBufferID );
+        for ( TileUploadTracker::Range const& range : m_UploadTracker.GetRanges() )
+        {
+            uploadTiles( range.M_First, range.M_Count );
+        }
+    }
+
+    Renderer()->AddTileBytesUploaded( m_UploadTracker.GetUploadedBytes() );
+}
+
+
+/// @brief          Copies a run of tiles from the Tilemap into the instance buffer, a block at a time
+/// @param first    the index of the first tile to upload
+/// @param count    how many tiles to upload
+void TilemapSprite::uploadTiles( int first, int count )
+{
+    while ( count > 0 )
+    {
+        int blockSize = std::min( count, s_UploadBlockSize );
+        m_UploadBuffer.resize( blockSize );
+        m_Tilemap->CopyTiles( first, blockSize, m_UploadBuffer.data() );
+        glBufferSubData( GL_ARRAY_BUFFER, first * sizeof( int ), blockSize * sizeof( int ), m_UploadBuffer.data() );
+
+        first += blockSize;
+        count -= blockSize;
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // public: copying
 //-----------------------------------------------------------------------------
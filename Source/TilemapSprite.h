@@ -10,6 +10,7 @@
 #include "Sprite.h"
 #include "ComponentReference.h"
 #include "Tilemap.h"
+#include "TileUploadTracker.h"
 
 /// @brief      A version of Sprite for rendering tilemaps using GPU instancing.
 class TilemapSprite : public Sprite
@@ -46,7 +47,7 @@ public:
 
     /// @brief          Loads the tile array from a vector of ints.
     /// @param tiles    tile IDs  (spritesheet frames)
-    void LoadTileArray(std::vector<int> tiles);
+    void LoadTileArray(std::vector<int> const& tiles);
 
 
 
@@ -81,7 +82,15 @@ private:
 
     unsigned int m_InstBufferID = 0; /// @brief   ID of buffer that stores instance data (tile IDs)
     unsigned int m_VAO = 0;          /// @brief   VAO that uses this specific buffer
-    bool m_TilemapChanged = true;    /// @brief   Whether new tiles need to be loaded in
+
+    /// @brief  which tiles need to be uploaded to the instance buffer
+    TileUploadTracker m_UploadTracker;
+
+    /// @brief  tiles copied out of the Tilemap's chunks on their way to the instance buffer
+    std::vector< int > m_UploadBuffer;
+
+    /// @brief  the most tiles copied into m_UploadBuffer at once, so it stays small however big the tilemap is
+    static constexpr int s_UploadBlockSize = 4096;
 
     /// @brief  Cached parent tilemap
     ComponentReference< Tilemap< int > > m_Tilemap;
@@ -96,9 +105,20 @@ private:
     void initInstancingStuff();
 
 
-    /// @brief          Sets TilemapChanged flag to true. Used as callbeck for
-    ///                 Tilemap component. The flag is reset when Draw() is called.
-    void onTilemapChanged( Tilemap< int >*, glm::ivec2 const&, int const& ) { m_TilemapChanged = true; }
+    /// @brief          Marks the changed tiles to be uploaded. Used as callback for
+    ///                 Tilemap component. The marks are cleared when Draw() is called.
+    /// @param tilemap  the Tilemap that changed
+    /// @param tilepos  the tile that changed, or (-1, -1) if the whole tilemap changed
+    void onTilemapChanged( Tilemap< int >* tilemap, glm::ivec2 const& tilepos, int const& );
+
+
+    /// @brief          Uploads the tiles the upload tracker says have changed
+    void uploadChangedTiles();
+
+    /// @brief          Copies a run of tiles from the Tilemap into the instance buffer, a block at a time
+    /// @param first    the index of the first tile to upload
+    /// @param count    how many tiles to upload
+    void uploadTiles( int first, int count );
 
 
 //-----------------------------------------------------------------------------
@@ -368,6 +368,28 @@
     };
 
 
+//-----------------------------------------------------------------------------
+// public: copying
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  resets this Transform to a copy of another Transform so that its Entity can be pooled
+    /// @param  other   the Transform to copy
+    void Transform::ResetTo( Component const& other )
+    {
+        Component::ResetTo( other );
+
+        Transform const& transform = static_cast< Transform const& >( other );
+        m_Translation = transform.m_Translation;
+        m_Rotation    = transform.m_Rotation;
+        m_Scale       = transform.m_Scale;
+        m_IsDirty     = transform.m_IsDirty;
+        m_Matrix      = transform.m_Matrix;
+        m_IsDiegetic  = transform.m_IsDiegetic;
+        m_OnTransformChangedCallbacks.clear();
+    }
+
+
 //-----------------------------------------------------------------------------
 // protected: copying
 //-----------------------------------------------------------------------------
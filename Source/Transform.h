@@ -227,6 +227,15 @@ public: // copying
         return new Transform( *this );
     }
 
+    /// @brief  checks whether this Transform can be reset to a copy of another Component
+    /// @param  other   the Component that would be copied
+    /// @return whether both Components are exactly a Transform
+    virtual bool CanResetTo( Component const& other ) const override { return isExactType< Transform >( other ); }
+
+    /// @brief  resets this Transform to a copy of another Transform so that its Entity can be pooled
+    /// @param  other   the Transform to copy
+    virtual void ResetTo( Component const& other ) override;
+
 //-----------------------------------------------------------------------------
 protected: // copying
 //-----------------------------------------------------------------------------
@@ -56,6 +56,16 @@ public: // virtual override methods
     void OnFixedUpdate() override;
 
 
+//-----------------------------------------------------------------------------
+public: // benchmarking
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  times target acquisition for 1k turrets against 5k enemies, both by looping over every enemy
+    ///         and through the spatial index, and writes the results to the log
+    static void RunTargetingBenchmark();
+
+
 //-----------------------------------------------------------------------------
 private: /// Members
 //-----------------------------------------------------------------------------
@@ -254,7 +254,11 @@
     {
        m_Texture.Inspect( "texture" );
 
-        ImGui::DragInt( "layer", &m_Layer, 0.05f );
+        int layer = m_Layer;
+        if ( ImGui::DragInt( "layer", &layer, 0.05f ) )
+        {
+            SetLayer( layer );
+        }
 
         ImGui::DragFloat( "opacity", &m_Opacity, 0.05f, 0.0f, 1.0f );
 
@@ -0,0 +1,111 @@
+/// @file       ViewFrustum.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      the area of a space that a camera can see, for culling what it can't
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+
+#include "pch.h" // precompiled header has to be included first
+#include "ViewFrustum.h"
+
+
+//-----------------------------------------------------------------------------
+// public: constructors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructs the ViewFrustum of a projection
+    /// @param  spaceToClip the matrix that takes the space to clip space
+    ViewFrustum::ViewFrustum( glm::mat4 const& spaceToClip )
+    {
+        TransformBounds( glm::inverse( spaceToClip ), glm::vec2( -1.0f ), glm::vec2( 1.0f ), &m_Min, &m_Max );
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  finds the cells of an axis-aligned grid that are at least partly visible
+    /// @param  cellMin     the minimum corner of cell (0, 0)
+    /// @param  cellMax     the maximum corner of cell (0, 0)
+    /// @param  step        the offset from each cell to the next along x and y - either may be negative
+    /// @param  dimensions  how many cells the grid has along each axis
+    /// @param  first       the first visible cell along each axis
+    /// @param  last        the last visible cell along each axis
+    /// @return whether any cell is visible
+    bool ViewFrustum::GetVisibleCells(
+        glm::vec2 const& cellMin, glm::vec2 const& cellMax, glm::vec2 const& step, glm::ivec2 const& dimensions,
+        glm::ivec2* first, glm::ivec2* last
+    ) const
+    {
+        return (
+            getVisibleCells( cellMin.x, cellMax.x, step.x, m_Min.x, m_Max.x, dimensions.x, &first->x, &last->x ) &&
+            getVisibleCells( cellMin.y, cellMax.y, step.y, m_Min.y, m_Max.y, dimensions.y, &first->y, &last->y )
+        );
+    }
+
+
+    /// @brief  finds the AABB of a transformed AABB
+    /// @param  matrix  the matrix to transform the AABB by
+    /// @param  min     the minimum corner of the AABB
+    /// @param  max     the maximum corner of the AABB
+    /// @param  outMin  the minimum corner of the transformed AABB
+    /// @param  outMax  the maximum corner of the transformed AABB
+    void ViewFrustum::TransformBounds(
+        glm::mat4 const& matrix, glm::vec2 const& min, glm::vec2 const& max,
+        glm::vec2* outMin, glm::vec2* outMax
+    )
+    {
+        // each axis of the matrix stretches the box by its absolute value
+        glm::vec2 center = glm::vec2( matrix * glm::vec4( ( min + max ) * 0.5f, 0.0f, 1.0f ) );
+        glm::vec2 halfSize = ( max - min ) * 0.5f;
+        glm::vec2 extent = glm::abs( glm::vec2( matrix[ 0 ] ) ) * halfSize.x + glm::abs( glm::vec2( matrix[ 1 ] ) ) * halfSize.y;
+
+        *outMin = center - extent;
+        *outMax = center + extent;
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  finds the visible cells of a grid along one axis
+    /// @param  cellMin     the minimum of cell 0 along the axis
+    /// @param  cellMax     the maximum of cell 0 along the axis
+    /// @param  step        the offset from each cell to the next along the axis
+    /// @param  viewMin     the minimum of the view along the axis
+    /// @param  viewMax     the maximum of the view along the axis
+    /// @param  count       how many cells the grid has along the axis
+    /// @param  first       the first visible cell
+    /// @param  last        the last visible cell
+    /// @return whether any cell is visible
+    bool ViewFrustum::getVisibleCells( float cellMin, float cellMax, float step, float viewMin, float viewMax, int count, int* first, int* last )
+    {
+        if ( step == 0.0f )
+        {
+            *first = 0;
+            *last = count - 1;
+            return count > 0 && cellMin <= viewMax && cellMax >= viewMin;
+        }
+
+        // cell i is visible while cellMax + i * step >= viewMin and cellMin + i * step <= viewMax
+        float a = ( viewMin - cellMax ) / step;
+        float b = ( viewMax - cellMin ) / step;
+
+        // round outwards so nothing on the edge gets culled, and clamp before converting so infinities stay in range
+        *first = (int)std::floor( std::clamp( std::min( a, b ), -1.0f, (float)count ) );
+        *last = (int)std::ceil( std::clamp( std::max( a, b ), -1.0f, (float)count ) );
+        *first = std::max( *first, 0 );
+        *last = std::min( *last, count - 1 );
+
+        return *first <= *last;
+    }
+
+
+//-----------------------------------------------------------------------------
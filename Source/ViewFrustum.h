@@ -0,0 +1,117 @@
+/// @file       ViewFrustum.h
+/// @author     Oblivion Owls Inc
+/// @brief      the area of a space that a camera can see, for culling what it can't
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+
+/// @brief  the axis-aligned area of a space (world or UI) that ends up on screen
+/// @note   if the camera is rotated, the area is the AABB of what it sees, so culling stays conservative
+/// @note   a ViewFrustum never touches the GPU, so culling can be checked without a rendering context
+class ViewFrustum
+{
+//-----------------------------------------------------------------------------
+public: // constructors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructs a ViewFrustum that sees everything
+    ViewFrustum() = default;
+
+    /// @brief  constructs the ViewFrustum of a projection
+    /// @param  spaceToClip the matrix that takes the space to clip space
+    explicit ViewFrustum( glm::mat4 const& spaceToClip );
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  checks whether an AABB is at least partly visible
+    /// @param  min the minimum corner of the AABB
+    /// @param  max the maximum corner of the AABB
+    /// @return whether the AABB overlaps the view
+    bool Overlaps( glm::vec2 const& min, glm::vec2 const& max ) const
+    {
+        return min.x <= m_Max.x && max.x >= m_Min.x && min.y <= m_Max.y && max.y >= m_Min.y;
+    }
+
+    /// @brief  finds the cells of an axis-aligned grid that are at least partly visible
+    /// @param  cellMin     the minimum corner of cell (0, 0)
+    /// @param  cellMax     the maximum corner of cell (0, 0)
+    /// @param  step        the offset from each cell to the next along x and y - either may be negative
+    /// @param  dimensions  how many cells the grid has along each axis
+    /// @param  first       the first visible cell along each axis
+    /// @param  last        the last visible cell along each axis
+    /// @return whether any cell is visible
+    bool GetVisibleCells(
+        glm::vec2 const& cellMin, glm::vec2 const& cellMax, glm::vec2 const& step, glm::ivec2 const& dimensions,
+        glm::ivec2* first, glm::ivec2* last
+    ) const;
+
+
+    /// @brief  finds the AABB of a transformed AABB
+    /// @param  matrix  the matrix to transform the AABB by
+    /// @param  min     the minimum corner of the AABB
+    /// @param  max     the maximum corner of the AABB
+    /// @param  outMin  the minimum corner of the transformed AABB
+    /// @param  outMax  the maximum corner of the transformed AABB
+    static void TransformBounds(
+        glm::mat4 const& matrix, glm::vec2 const& min, glm::vec2 const& max,
+        glm::vec2* outMin, glm::vec2* outMax
+    );
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the minimum corner of the visible area
+    /// @return the minimum corner of the visible area
+    glm::vec2 const& GetMin() const { return m_Min; }
+
+    /// @brief  gets the maximum corner of the visible area
+    /// @return the maximum corner of the visible area
+    glm::vec2 const& GetMax() const { return m_Max; }
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  the minimum corner of the visible area
+    glm::vec2 m_Min = glm::vec2( -INFINITY );
+
+    /// @brief  the maximum corner of the visible area
+    glm::vec2 m_Max = glm::vec2( INFINITY );
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  finds the visible cells of a grid along one axis
+    /// @param  cellMin     the minimum of cell 0 along the axis
+    /// @param  cellMax     the maximum of cell 0 along the axis
+    /// @param  step        the offset from each cell to the next along the axis
+    /// @param  viewMin     the minimum of the view along the axis
+    /// @param  viewMax     the maximum of the view along the axis
+    /// @param  count       how many cells the grid has along the axis
+    /// @param  first       the first visible cell
+    /// @param  last        the last visible cell
+    /// @return whether any cell is visible
+    static bool getVisibleCells( float cellMin, float cellMax, float step, float viewMin, float viewMax, int count, int* first, int* last );
+
+
+//-----------------------------------------------------------------------------
+};
@@ -0,0 +1,383 @@
+/// @file       VoiceBackend.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      plays the voices the VoiceManager makes real - through FMOD, or through nothing at all
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#include "pch.h" // precompiled header has to be included first
+#include "VoiceBackend.h"
+
+#include "Sound.h"
+
+
+//-----------------------------------------------------------------------------
+// IVoiceBackend public: static methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  advances playback of a sound that isn't backed by a real channel
+    /// @param  length      the length of the sound, in seconds
+    /// @param  pitch       the relative pitch the sound plays at
+    /// @param  loopCount   how many more times the sound will loop - counted down as it loops
+    /// @param  time        how far into the sound playback is, in seconds
+    /// @param  dt          the duration of the frame in seconds
+    /// @return whether the sound is still playing
+    bool IVoiceBackend::AdvancePlayback( float length, float pitch, int* loopCount, float* time, float dt )
+    {
+        // without a length, loops play on and one-shots are assumed to be over
+        if ( length <= 0.0f )
+        {
+            return *loopCount != 0;
+        }
+
+        *time += dt * pitch;
+        if ( *time < length )
+        {
+            return true;
+        }
+
+        int loops = (int)( *time / length );
+        *time -= loops * length;
+
+        if ( *loopCount < 0 )
+        {
+            return true;
+        }
+
+        *loopCount -= loops;
+        if ( *loopCount < 0 )
+        {
+            *loopCount = 0;
+            return false;
+        }
+        return true;
+    }
+
+
+//-----------------------------------------------------------------------------
+// FmodVoiceBackend public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts playing a voice
+    /// @param  voice   the voice to play
+    /// @param  time    how far into the sound to start, in seconds
+    /// @return the FMOD::Channel the voice is playing on - nullptr if it couldn't be played
+    void* FmodVoiceBackend::Start( Voice const& voice, float time )
+    {
+        if ( voice.M_Sound == nullptr )
+        {
+            return nullptr;
+        }
+
+        // start paused, so the channel is set up before it makes any sound
+        FMOD::Channel* channel = voice.M_Sound->Play( voice.M_Group, voice.M_Volume, voice.M_Pitch, voice.M_LoopCount, time, true );
+        if ( channel == nullptr )
+        {
+            return nullptr;
+        }
+
+        // have the channel report when it ends
+        channel->setUserData( this );
+        channel->setCallback( onFmodChannelCallback );
+
+        Apply( channel, voice );
+        return channel;
+    }
+
+    /// @brief  stops a channel
+    /// @param  channel the FMOD::Channel to stop
+    void FmodVoiceBackend::Stop( void* channel )
+    {
+        // channels that already ended can't be touched
+        if ( m_EndedChannels.erase( channel ) != 0 )
+        {
+            return;
+        }
+
+        FMOD::Channel* fmodChannel = (FMOD::Channel*)channel;
+        fmodChannel->setCallback( nullptr );
+        fmodChannel->stop();
+    }
+
+
+    /// @brief  does nothing - FMOD advances its own channels in AudioSystem::OnUpdate
+    /// @param  dt  the duration of the frame in seconds
+    void FmodVoiceBackend::Update( float dt )
+    {}
+
+
+    /// @brief  gets whether a channel is still playing
+    /// @param  channel the FMOD::Channel to check
+    /// @return whether the channel is still playing
+    bool FmodVoiceBackend::GetIsPlaying( void* channel ) const
+    {
+        return m_EndedChannels.count( channel ) == 0;
+    }
+
+    /// @brief  gets how far into its sound a channel is
+    /// @param  channel the FMOD::Channel to check
+    /// @return how far into its sound the channel is, in seconds
+    float FmodVoiceBackend::GetTime( void* channel ) const
+    {
+        unsigned int time = 0;
+        ( (FMOD::Channel*)channel )->getPosition( &time, FMOD_TIMEUNIT_MS );
+        return time / 1000.0f;
+    }
+
+    /// @brief  gets how many more times a channel will loop
+    /// @param  channel the FMOD::Channel to check
+    /// @return how many more times the channel will loop - -1 loops forever
+    int FmodVoiceBackend::GetLoopCount( void* channel ) const
+    {
+        int loopCount = 0;
+        ( (FMOD::Channel*)channel )->getLoopCount( &loopCount );
+        return loopCount;
+    }
+
+
+    /// @brief  sets how far into its sound a channel is
+    /// @param  channel the FMOD::Channel to seek
+    /// @param  time    how far into the sound to seek to, in seconds
+    void FmodVoiceBackend::SetTime( void* channel, float time )
+    {
+        ( (FMOD::Channel*)channel )->setPosition( (unsigned int)( time * 1000 ), FMOD_TIMEUNIT_MS );
+    }
+
+    /// @brief  sets how many more times a channel will loop
+    /// @param  channel     the FMOD::Channel to change
+    /// @param  loopCount   how many more times the channel will loop - -1 loops forever
+    void FmodVoiceBackend::SetLoopCount( void* channel, int loopCount )
+    {
+        ( (FMOD::Channel*)channel )->setLoopCount( loopCount );
+    }
+
+    /// @brief  applies a voice's volume, pitch, pause state, and spatial mode to its channel
+    /// @param  channel the FMOD::Channel to apply to
+    /// @param  voice   the voice to apply
+    void FmodVoiceBackend::Apply( void* channel, Voice const& voice )
+    {
+        FMOD::Channel* fmodChannel = (FMOD::Channel*)channel;
+
+        // only touch the mode when it changes
+        FMOD_MODE mode = 0;
+        fmodChannel->getMode( &mode );
+        if ( ( ( mode & FMOD_3D ) != 0 ) != voice.M_IsSpatial )
+        {
+            fmodChannel->setMode( voice.M_IsSpatial ? FMOD_3D : FMOD_2D );
+        }
+        if ( voice.M_IsSpatial )
+        {
+            ApplySpatialAttributes( channel, voice );
+        }
+
+        fmodChannel->setVolume( voice.M_Volume * ( voice.M_Sound != nullptr ? voice.M_Sound->GetVolume() : 1.0f ) );
+        fmodChannel->setPitch( voice.M_Pitch );
+        fmodChannel->setPaused( voice.M_IsPaused );
+    }
+
+    /// @brief  applies a voice's position and velocity to its channel
+    /// @param  channel the FMOD::Channel to apply to
+    /// @param  voice   the voice to apply
+    void FmodVoiceBackend::ApplySpatialAttributes( void* channel, Voice const& voice )
+    {
+        FMOD_VECTOR pos3 = { voice.M_Position.x, voice.M_Position.y, 0.0f };
+        FMOD_VECTOR vel3 = { voice.M_Velocity.x, voice.M_Velocity.y, 0.0f };
+
+        ( (FMOD::Channel*)channel )->set3DAttributes( &pos3, &vel3 );
+    }
+
+
+//-----------------------------------------------------------------------------
+// FmodVoiceBackend private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  callback called when an fmod channel finishes playing
+    /// @param  channelControl  the channel the callback is from
+    /// @param  controlType     identifier to distinguish between channel and channelgroup
+    /// @param  callbackType    the type of callback
+    /// @param  commandData1    first callback parameter
+    /// @param  commandData2    second callback parameter
+    FMOD_RESULT F_CALLBACK FmodVoiceBackend::onFmodChannelCallback(
+        FMOD_CHANNELCONTROL* channelControl,
+        FMOD_CHANNELCONTROL_TYPE controlType,
+        FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType,
+        void* commandData1,
+        void* commandData2
+    )
+    {
+        if (
+            controlType != FMOD_CHANNELCONTROL_CHANNEL ||
+            callbackType != FMOD_CHANNELCONTROL_CALLBACK_END
+        ) // only handle callbacks for channels ending
+        {
+            return FMOD_OK;
+        }
+
+        FmodVoiceBackend* self = nullptr;
+        ( (FMOD::Channel*)channelControl )->getUserData( (void**)&self );
+        if ( self == nullptr )
+        {
+            return FMOD_OK;
+        }
+
+        self->m_EndedChannels.insert( (FMOD::Channel*)channelControl );
+        return FMOD_OK;
+    }
+
+
+//-----------------------------------------------------------------------------
+// NullVoiceBackend public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts "playing" a voice
+    /// @param  voice   the voice to play
+    /// @param  time    how far into the sound to start, in seconds
+    /// @return the channel the voice is playing on
+    void* NullVoiceBackend::Start( Voice const& voice, float time )
+    {
+        unsigned index;
+        if ( m_FreeChannels.empty() )
+        {
+            index = (unsigned)m_Channels.size();
+            m_Channels.emplace_back();
+        }
+        else
+        {
+            index = m_FreeChannels.back();
+            m_FreeChannels.pop_back();
+        }
+
+        Channel& channel = m_Channels[ index ];
+        channel.M_Time      = time;
+        channel.M_Length    = voice.M_Length;
+        channel.M_Pitch     = voice.M_Pitch;
+        channel.M_LoopCount = voice.M_LoopCount;
+        channel.M_IsPaused  = voice.M_IsPaused;
+        channel.M_IsPlaying = true;
+
+        ++m_StartCount;
+        return (void*)(uintptr_t)( index + 1 );
+    }
+
+    /// @brief  stops a channel
+    /// @param  channel the channel to stop
+    void NullVoiceBackend::Stop( void* channel )
+    {
+        Channel& nullChannel = getChannel( channel );
+        if ( nullChannel.M_IsPlaying == false )
+        {
+            return;
+        }
+
+        nullChannel.M_IsPlaying = false;
+        m_FreeChannels.push_back( (unsigned)( (uintptr_t)channel - 1 ) );
+    }
+
+
+    /// @brief  advances playback of every channel
+    /// @param  dt  the duration of the frame in seconds
+    void NullVoiceBackend::Update( float dt )
+    {
+        for ( unsigned i = 0; i < m_Channels.size(); ++i )
+        {
+            Channel& channel = m_Channels[ i ];
+            if ( channel.M_IsPlaying == false || channel.M_IsPaused )
+            {
+                continue;
+            }
+
+            if ( AdvancePlayback( channel.M_Length, channel.M_Pitch, &channel.M_LoopCount, &channel.M_Time, dt ) == false )
+            {
+                channel.M_IsPlaying = false;
+                m_FreeChannels.push_back( i );
+            }
+        }
+    }
+
+
+    /// @brief  gets whether a channel is still playing
+    /// @param  channel the channel to check
+    /// @return whether the channel is still playing
+    bool NullVoiceBackend::GetIsPlaying( void* channel ) const
+    {
+        return getChannel( channel ).M_IsPlaying;
+    }
+
+    /// @brief  gets how far into its sound a channel is
+    /// @param  channel the channel to check
+    /// @return how far into its sound the channel is, in seconds
+    float NullVoiceBackend::GetTime( void* channel ) const
+    {
+        return getChannel( channel ).M_Time;
+    }
+
+    /// @brief  gets how many more times a channel will loop
+    /// @param  channel the channel to check
+    /// @return how many more times the channel will loop - -1 loops forever
+    int NullVoiceBackend::GetLoopCount( void* channel ) const
+    {
+        return getChannel( channel ).M_LoopCount;
+    }
+
+
+    /// @brief  sets how far into its sound a channel is
+    /// @param  channel the channel to seek
+    /// @param  time    how far into the sound to seek to, in seconds
+    void NullVoiceBackend::SetTime( void* channel, float time )
+    {
+        getChannel( channel ).M_Time = time;
+    }
+
+    /// @brief  sets how many more times a channel will loop
+    /// @param  channel     the channel to change
+    /// @param  loopCount   how many more times the channel will loop - -1 loops forever
+    void NullVoiceBackend::SetLoopCount( void* channel, int loopCount )
+    {
+        getChannel( channel ).M_LoopCount = loopCount;
+    }
+
+    /// @brief  applies a voice's settings to its channel
+    /// @param  channel the channel to apply to
+    /// @param  voice   the voice to apply
+    void NullVoiceBackend::Apply( void* channel, Voice const& voice )
+    {
+        Channel& nullChannel = getChannel( channel );
+        nullChannel.M_Pitch    = voice.M_Pitch;
+        nullChannel.M_IsPaused = voice.M_IsPaused;
+    }
+
+    /// @brief  does nothing - position doesn't affect playback
+    /// @param  channel the channel to apply to
+    /// @param  voice   the voice to apply
+    void NullVoiceBackend::ApplySpatialAttributes( void* channel, Voice const& voice )
+    {}
+
+
+//-----------------------------------------------------------------------------
+// NullVoiceBackend private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the channel a handle refers to
+    /// @param  channel the channel handle
+    /// @return the channel
+    NullVoiceBackend::Channel& NullVoiceBackend::getChannel( void* channel )
+    {
+        return m_Channels[ (uintptr_t)channel - 1 ];
+    }
+
+    /// @brief  gets the channel a handle refers to
+    /// @param  channel the channel handle
+    /// @return the channel
+    NullVoiceBackend::Channel const& NullVoiceBackend::getChannel( void* channel ) const
+    {
+        return m_Channels[ (uintptr_t)channel - 1 ];
+    }
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,381 @@
+/// @file       VoiceBackend.h
+/// @author     Oblivion Owls Inc
+/// @brief      plays the voices the VoiceManager makes real - through FMOD, or through nothing at all
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include <fmod.hpp>
+#include <unordered_set>
+
+class Sound;
+
+
+/// @brief  everything needed to play one instance of a Sound
+struct Voice
+{
+    /// @brief  the Sound to play - also what the per-sound voice cap counts
+    Sound const* M_Sound = nullptr;
+
+    /// @brief  the channel group to play in - also what the per-group voice cap counts
+    FMOD::ChannelGroup* M_Group = nullptr;
+
+    /// @brief  higher priority voices are kept real over lower priority voices
+    int M_Priority = 0;
+
+    /// @brief  the relative volume to play at
+    float M_Volume = 1.0f;
+
+    /// @brief  the relative pitch to play at
+    float M_Pitch = 1.0f;
+
+    /// @brief  how many more times to loop - -1 loops forever
+    int M_LoopCount = 0;
+
+    /// @brief  the length of the Sound, in seconds - used to follow the voice while it isn't real
+    float M_Length = 0.0f;
+
+    /// @brief  whether the voice is paused
+    bool M_IsPaused = false;
+
+    /// @brief  whether the voice exists in 3D space
+    bool M_IsSpatial = false;
+
+    /// @brief  the position of the voice, when spatial
+    glm::vec2 M_Position = { 0.0f, 0.0f };
+
+    /// @brief  the velocity of the voice, when spatial
+    glm::vec2 M_Velocity = { 0.0f, 0.0f };
+
+    /// @brief  called once when the voice ends, whether it finished, was stopped, or was stolen
+    std::function< void() > M_OnComplete = nullptr;
+};
+
+
+/// @brief  plays the voices the VoiceManager makes real
+/// @note   channels are opaque to the VoiceManager - each backend decides what they point to
+class IVoiceBackend
+{
+//-----------------------------------------------------------------------------
+public: // constructor / destructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  virtual destructor
+    virtual ~IVoiceBackend() = default;
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts playing a voice
+    /// @param  voice   the voice to play
+    /// @param  time    how far into the sound to start, in seconds
+    /// @return the channel the voice is playing on - nullptr if it couldn't be played
+    virtual void* Start( Voice const& voice, float time ) = 0;
+
+    /// @brief  stops a channel
+    /// @param  channel the channel to stop
+    virtual void Stop( void* channel ) = 0;
+
+
+    /// @brief  advances playback of every channel
+    /// @param  dt  the duration of the frame in seconds
+    virtual void Update( float dt ) = 0;
+
+
+    /// @brief  gets whether a channel is still playing
+    /// @param  channel the channel to check
+    /// @return whether the channel is still playing
+    virtual bool GetIsPlaying( void* channel ) const = 0;
+
+    /// @brief  gets how far into its sound a channel is
+    /// @param  channel the channel to check
+    /// @return how far into its sound the channel is, in seconds
+    virtual float GetTime( void* channel ) const = 0;
+
+    /// @brief  gets how many more times a channel will loop
+    /// @param  channel the channel to check
+    /// @return how many more times the channel will loop - -1 loops forever
+    virtual int GetLoopCount( void* channel ) const = 0;
+
+
+    /// @brief  sets how far into its sound a channel is
+    /// @param  channel the channel to seek
+    /// @param  time    how far into the sound to seek to, in seconds
+    virtual void SetTime( void* channel, float time ) = 0;
+
+    /// @brief  sets how many more times a channel will loop
+    /// @param  channel     the channel to change
+    /// @param  loopCount   how many more times the channel will loop - -1 loops forever
+    virtual void SetLoopCount( void* channel, int loopCount ) = 0;
+
+    /// @brief  applies a voice's volume, pitch, pause state, and spatial mode to its channel
+    /// @param  channel the channel to apply to
+    /// @param  voice   the voice to apply
+    virtual void Apply( void* channel, Voice const& voice ) = 0;
+
+    /// @brief  applies a voice's position and velocity to its channel
+    /// @param  channel the channel to apply to
+    /// @param  voice   the voice to apply
+    virtual void ApplySpatialAttributes( void* channel, Voice const& voice ) = 0;
+
+
+//-----------------------------------------------------------------------------
+public: // static methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  advances playback of a sound that isn't backed by a real channel
+    /// @param  length      the length of the sound, in seconds
+    /// @param  pitch       the relative pitch the sound plays at
+    /// @param  loopCount   how many more times the sound will loop - counted down as it loops
+    /// @param  time        how far into the sound playback is, in seconds
+    /// @param  dt          the duration of the frame in seconds
+    /// @return whether the sound is still playing
+    static bool AdvancePlayback( float length, float pitch, int* loopCount, float* time, float dt );
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+/// @brief  plays voices through FMOD
+class FmodVoiceBackend : public IVoiceBackend
+{
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts playing a voice
+    /// @param  voice   the voice to play
+    /// @param  time    how far into the sound to start, in seconds
+    /// @return the FMOD::Channel the voice is playing on - nullptr if it couldn't be played
+    virtual void* Start( Voice const& voice, float time ) override;
+
+    /// @brief  stops a channel
+    /// @param  channel the FMOD::Channel to stop
+    virtual void Stop( void* channel ) override;
+
+
+    /// @brief  does nothing - FMOD advances its own channels in AudioSystem::OnUpdate
+    /// @param  dt  the duration of the frame in seconds
+    virtual void Update( float dt ) override;
+
+
+    /// @brief  gets whether a channel is still playing
+    /// @param  channel the FMOD::Channel to check
+    /// @return whether the channel is still playing
+    virtual bool GetIsPlaying( void* channel ) const override;
+
+    /// @brief  gets how far into its sound a channel is
+    /// @param  channel the FMOD::Channel to check
+    /// @return how far into its sound the channel is, in seconds
+    virtual float GetTime( void* channel ) const override;
+
+    /// @brief  gets how many more times a channel will loop
+    /// @param  channel the FMOD::Channel to check
+    /// @return how many more times the channel will loop - -1 loops forever
+    virtual int GetLoopCount( void* channel ) const override;
+
+
+    /// @brief  sets how far into its sound a channel is
+    /// @param  channel the FMOD::Channel to seek
+    /// @param  time    how far into the sound to seek to, in seconds
+    virtual void SetTime( void* channel, float time ) override;
+
+    /// @brief  sets how many more times a channel will loop
+    /// @param  channel     the FMOD::Channel to change
+    /// @param  loopCount   how many more times the channel will loop - -1 loops forever
+    virtual void SetLoopCount( void* channel, int loopCount ) override;
+
+    /// @brief  applies a voice's volume, pitch, pause state, and spatial mode to its channel
+    /// @param  channel the FMOD::Channel to apply to
+    /// @param  voice   the voice to apply
+    virtual void Apply( void* channel, Voice const& voice ) override;
+
+    /// @brief  applies a voice's position and velocity to its channel
+    /// @param  channel the FMOD::Channel to apply to
+    /// @param  voice   the voice to apply
+    virtual void ApplySpatialAttributes( void* channel, Voice const& voice ) override;
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  channels that ended on their own, and haven't been stopped yet
+    /// @note   polling an ended channel would report an invalid handle, so channels report when they end instead
+    std::unordered_set< void* > m_EndedChannels;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  callback called when an fmod channel finishes playing
+    /// @param  channelControl  the channel the callback is from
+    /// @param  controlType     identifier to distinguish between channel and channelgroup
+    /// @param  callbackType    the type of callback
+    /// @param  commandData1    first callback parameter
+    /// @param  commandData2    second callback parameter
+    static FMOD_RESULT F_CALLBACK onFmodChannelCallback(
+        FMOD_CHANNELCONTROL* channelControl,
+        FMOD_CHANNELCONTROL_TYPE controlType,
+        FMOD_CHANNELCONTROL_CALLBACK_TYPE callbackType,
+        void* commandData1,
+        void* commandData2
+    );
+
+
+//-----------------------------------------------------------------------------
+};
+
+
+/// @brief  plays voices nowhere, only keeping track of time
+/// @note   lets the VoiceManager's scheduling be checked and benchmarked without FMOD
+class NullVoiceBackend : public IVoiceBackend
+{
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts "playing" a voice
+    /// @param  voice   the voice to play
+    /// @param  time    how far into the sound to start, in seconds
+    /// @return the channel the voice is playing on
+    virtual void* Start( Voice const& voice, float time ) override;
+
+    /// @brief  stops a channel
+    /// @param  channel the channel to stop
+    virtual void Stop( void* channel ) override;
+
+
+    /// @brief  advances playback of every channel
+    /// @param  dt  the duration of the frame in seconds
+    virtual void Update( float dt ) override;
+
+
+    /// @brief  gets whether a channel is still playing
+    /// @param  channel the channel to check
+    /// @return whether the channel is still playing
+    virtual bool GetIsPlaying( void* channel ) const override;
+
+    /// @brief  gets how far into its sound a channel is
+    /// @param  channel the channel to check
+    /// @return how far into its sound the channel is, in seconds
+    virtual float GetTime( void* channel ) const override;
+
+    /// @brief  gets how many more times a channel will loop
+    /// @param  channel the channel to check
+    /// @return how many more times the channel will loop - -1 loops forever
+    virtual int GetLoopCount( void* channel ) const override;
+
+
+    /// @brief  sets how far into its sound a channel is
+    /// @param  channel the channel to seek
+    /// @param  time    how far into the sound to seek to, in seconds
+    virtual void SetTime( void* channel, float time ) override;
+
+    /// @brief  sets how many more times a channel will loop
+    /// @param  channel     the channel to change
+    /// @param  loopCount   how many more times the channel will loop - -1 loops forever
+    virtual void SetLoopCount( void* channel, int loopCount ) override;
+
+    /// @brief  applies a voice's settings to its channel
+    /// @param  channel the channel to apply to
+    /// @param  voice   the voice to apply
+    virtual void Apply( void* channel, Voice const& voice ) override;
+
+    /// @brief  does nothing - position doesn't affect playback
+    /// @param  channel the channel to apply to
+    /// @param  voice   the voice to apply
+    virtual void ApplySpatialAttributes( void* channel, Voice const& voice ) override;
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets how many channels are playing
+    /// @return how many channels are playing
+    int GetChannelCount() const { return (int)( m_Channels.size() - m_FreeChannels.size() ); }
+
+    /// @brief  gets how many channels have been started
+    /// @return how many channels have been started
+    long long GetStartCount() const { return m_StartCount; }
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a channel that isn't backed by anything
+    struct Channel
+    {
+        /// @brief  how far into its sound the channel is, in seconds
+        float M_Time = 0.0f;
+
+        /// @brief  the length of the sound, in seconds
+        float M_Length = 0.0f;
+
+        /// @brief  the relative pitch the channel plays at
+        float M_Pitch = 1.0f;
+
+        /// @brief  how many more times the channel will loop - -1 loops forever
+        int M_LoopCount = 0;
+
+        /// @brief  whether the channel is paused
+        bool M_IsPaused = false;
+
+        /// @brief  whether the channel is still playing
+        bool M_IsPlaying = false;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  every channel - a channel handle is its index + 1
+    std::vector< Channel > m_Channels;
+
+    /// @brief  the indices of channels that can be reused
+    std::vector< unsigned > m_FreeChannels;
+
+    /// @brief  how many channels have been started
+    long long m_StartCount = 0;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the channel a handle refers to
+    /// @param  channel the channel handle
+    /// @return the channel
+    Channel& getChannel( void* channel );
+
+    /// @brief  gets the channel a handle refers to
+    /// @param  channel the channel handle
+    /// @return the channel
+    Channel const& getChannel( void* channel ) const;
+
+
+//-----------------------------------------------------------------------------
+};
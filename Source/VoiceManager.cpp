@@ -0,0 +1,808 @@
+/// @file       VoiceManager.cpp
+/// @author     Oblivion Owls Inc
+/// @brief      decides which of the sounds asked for actually get a channel
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#include "pch.h" // precompiled header has to be included first
+#include "VoiceManager.h"
+
+#include "Sound.h"
+
+#include "DebugSystem.h"
+
+
+//-----------------------------------------------------------------------------
+// public: constructor / destructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructs a VoiceManager with a NullVoiceBackend
+    VoiceManager::VoiceManager() :
+        m_Backend( std::make_unique< NullVoiceBackend >() )
+    {}
+
+
+//-----------------------------------------------------------------------------
+// public: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts a voice
+    /// @param  voice   the voice to play
+    /// @return the handle of the new voice - 0 if a voice cap was full of more important voices
+    VoiceManager::Handle VoiceManager::Play( Voice const& voice )
+    {
+        if ( voice.M_Sound == nullptr )
+        {
+            Debug() << "WARNING: VoiceManager can't play a Voice with no Sound" << std::endl;
+            return 0;
+        }
+
+        float gain = GetGain( voice, m_HasListener ? &m_Listener : nullptr );
+
+        // a full cap makes room by ending its least important voice, or turns this voice away
+        int soundMaxVoices = voice.M_Sound->GetMaxVoices();
+        if (
+            soundMaxVoices > 0 &&
+            m_SoundVoiceCounts[ voice.M_Sound ] >= soundMaxVoices &&
+            stealVoice( voice, gain, voice.M_Sound ) == false
+        )
+        {
+            ++m_DroppedCount;
+            return 0;
+        }
+        if ( (int)m_ActiveSlots.size() >= m_MaxVoices && stealVoice( voice, gain, nullptr ) == false )
+        {
+            ++m_DroppedCount;
+            return 0;
+        }
+
+        unsigned index;
+        if ( m_FreeSlots.empty() == false )
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else if ( m_Slots.size() < ( 1u << s_IndexBits ) )
+        {
+            index = (unsigned)m_Slots.size();
+            m_Slots.emplace_back();
+        }
+        else
+        {
+            Debug() << "WARNING: VoiceManager ran out of voice handles" << std::endl;
+            ++m_DroppedCount;
+            return 0;
+        }
+
+        Slot& slot = m_Slots[ index ];
+        slot.M_Voice = voice;
+        slot.M_Channel = nullptr;
+        slot.M_Time = 0.0f;
+        slot.M_Gain = gain;
+        slot.M_ActiveIndex = (int)m_ActiveSlots.size();
+        m_ActiveSlots.push_back( index );
+        ++m_SoundVoiceCounts[ voice.M_Sound ];
+
+        // start right away if there's room, rather than waiting for the next update
+        tryRealize( &slot );
+
+        return ( slot.M_Generation << s_IndexBits ) | index;
+    }
+
+    /// @brief  stops a voice
+    /// @param  handle  the voice to stop
+    void VoiceManager::Stop( Handle handle )
+    {
+        if ( getSlot( handle ) == nullptr )
+        {
+            return;
+        }
+
+        endVoice( handle & ( ( 1u << s_IndexBits ) - 1 ), false );
+    }
+
+    /// @brief  stops every voice
+    void VoiceManager::StopAll()
+    {
+        while ( m_ActiveSlots.empty() == false )
+        {
+            endVoice( m_ActiveSlots.back(), true );
+        }
+
+        callCompletedCallbacks();
+    }
+
+
+    /// @brief  ends voices that finished, and decides which voices are real
+    /// @param  dt          the duration of the frame in seconds
+    /// @param  listener    where voices are heard from - nullptr to ignore distance
+    void VoiceManager::Update( float dt, Listener const* listener )
+    {
+        m_Backend->Update( dt );
+
+        m_HasListener = listener != nullptr;
+        if ( listener != nullptr )
+        {
+            m_Listener = *listener;
+        }
+        Listener const* heardFrom = m_HasListener ? &m_Listener : nullptr;
+
+        // end voices that finished - virtual voices keep their own time
+        for ( int i = (int)m_ActiveSlots.size() - 1; i >= 0; --i )
+        {
+            unsigned index = m_ActiveSlots[ i ];
+            Slot& slot = m_Slots[ index ];
+
+            bool isPlaying;
+            if ( slot.M_Channel != nullptr )
+            {
+                isPlaying = m_Backend->GetIsPlaying( slot.M_Channel );
+            }
+            else
+            {
+                Voice& voice = slot.M_Voice;
+                isPlaying = voice.M_IsPaused ||
+                    IVoiceBackend::AdvancePlayback( voice.M_Length, voice.M_Pitch, &voice.M_LoopCount, &slot.M_Time, dt );
+            }
+
+            if ( isPlaying == false )
+            {
+                endVoice( index, true );
+            }
+        }
+
+        // rank the voices that are left, most important first
+        m_Order.assign( m_ActiveSlots.begin(), m_ActiveSlots.end() );
+        for ( unsigned index : m_Order )
+        {
+            m_Slots[ index ].M_Gain = GetGain( m_Slots[ index ].M_Voice, heardFrom );
+        }
+        std::sort( m_Order.begin(), m_Order.end(), [ this ]( unsigned a, unsigned b ) -> bool
+        {
+            Slot const& slotA = m_Slots[ a ];
+            Slot const& slotB = m_Slots[ b ];
+            if ( slotA.M_Voice.M_Priority != slotB.M_Voice.M_Priority )
+            {
+                return slotA.M_Voice.M_Priority > slotB.M_Voice.M_Priority;
+            }
+            if ( slotA.M_Gain != slotB.M_Gain )
+            {
+                return slotA.M_Gain > slotB.M_Gain;
+            }
+
+            // on a tie, real voices keep their channels
+            return ( slotA.M_Channel != nullptr ) > ( slotB.M_Channel != nullptr );
+        } );
+
+        // the most important audible voices get channels, up to the caps
+        m_GroupAssignedCounts.clear();
+        int realCount = 0;
+        for ( unsigned& index : m_Order )
+        {
+            Slot& slot = m_Slots[ index ];
+
+            bool isReal = false;
+            if ( slot.M_Gain >= s_AudibleGain && realCount < m_MaxRealVoices )
+            {
+                int groupMaxVoices = getGroupMaxVoices( slot.M_Voice.M_Group );
+                int& groupCount = m_GroupAssignedCounts[ slot.M_Voice.M_Group ];
+                if ( groupMaxVoices <= 0 || groupCount < groupMaxVoices )
+                {
+                    ++groupCount;
+                    ++realCount;
+                    isReal = true;
+                }
+            }
+
+            if ( isReal == false )
+            {
+                if ( slot.M_Channel != nullptr )
+                {
+                    virtualize( &slot );
+                }
+                index = UINT_MAX;
+            }
+        }
+
+        // channels freed above go to the voices that became important enough
+        for ( unsigned index : m_Order )
+        {
+            if ( index != UINT_MAX && m_Slots[ index ].M_Channel == nullptr )
+            {
+                realize( &m_Slots[ index ] );
+            }
+        }
+
+        callCompletedCallbacks();
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: voice accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets whether a voice is still playing (real or virtual)
+    /// @param  handle  the voice to check
+    /// @return whether the voice is still playing
+    bool VoiceManager::GetIsPlaying( Handle handle ) const
+    {
+        return getSlot( handle ) != nullptr;
+    }
+
+    /// @brief  gets whether a voice is backed by a real channel
+    /// @param  handle  the voice to check
+    /// @return whether the voice is backed by a real channel
+    bool VoiceManager::GetIsReal( Handle handle ) const
+    {
+        Slot const* slot = getSlot( handle );
+        return slot != nullptr && slot->M_Channel != nullptr;
+    }
+
+
+    /// @brief  gets whether a voice is paused
+    /// @param  handle  the voice to check
+    /// @return whether the voice is paused - true if it isn't playing
+    bool VoiceManager::GetIsPaused( Handle handle ) const
+    {
+        Slot const* slot = getSlot( handle );
+        return slot == nullptr || slot->M_Voice.M_IsPaused;
+    }
+
+    /// @brief  sets whether a voice is paused
+    /// @param  handle      the voice to change
+    /// @param  isPaused    whether the voice is paused
+    void VoiceManager::SetIsPaused( Handle handle, bool isPaused )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Voice.M_IsPaused = isPaused;
+        if ( slot->M_Channel != nullptr )
+        {
+            m_Backend->Apply( slot->M_Channel, slot->M_Voice );
+            return;
+        }
+
+        // paused voices give up their channels at the next update, so resume right away if there's room
+        if ( isPaused == false )
+        {
+            slot->M_Gain = GetGain( slot->M_Voice, m_HasListener ? &m_Listener : nullptr );
+            tryRealize( slot );
+        }
+    }
+
+
+    /// @brief  gets how far into its sound a voice is
+    /// @param  handle  the voice to check
+    /// @return how far into its sound the voice is, in seconds
+    float VoiceManager::GetTime( Handle handle ) const
+    {
+        Slot const* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return 0.0f;
+        }
+
+        return slot->M_Channel != nullptr ? m_Backend->GetTime( slot->M_Channel ) : slot->M_Time;
+    }
+
+    /// @brief  sets how far into its sound a voice is
+    /// @param  handle  the voice to change
+    /// @param  time    how far into its sound the voice is, in seconds
+    void VoiceManager::SetTime( Handle handle, float time )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Time = time;
+        if ( slot->M_Channel != nullptr )
+        {
+            m_Backend->SetTime( slot->M_Channel, time );
+        }
+    }
+
+
+    /// @brief  gets how many more times a voice will loop
+    /// @param  handle  the voice to check
+    /// @return how many more times the voice will loop - -1 loops forever
+    int VoiceManager::GetLoopCount( Handle handle ) const
+    {
+        Slot const* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return 0;
+        }
+
+        return slot->M_Channel != nullptr ? m_Backend->GetLoopCount( slot->M_Channel ) : slot->M_Voice.M_LoopCount;
+    }
+
+    /// @brief  sets how many more times a voice will loop
+    /// @param  handle      the voice to change
+    /// @param  loopCount   how many more times the voice will loop - -1 loops forever
+    void VoiceManager::SetLoopCount( Handle handle, int loopCount )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Voice.M_LoopCount = loopCount;
+        if ( slot->M_Channel != nullptr )
+        {
+            m_Backend->SetLoopCount( slot->M_Channel, loopCount );
+        }
+    }
+
+
+    /// @brief  sets the volume of a voice
+    /// @param  handle  the voice to change
+    /// @param  volume  the relative volume of the voice
+    void VoiceManager::SetVolume( Handle handle, float volume )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Voice.M_Volume = volume;
+        if ( slot->M_Channel != nullptr )
+        {
+            m_Backend->Apply( slot->M_Channel, slot->M_Voice );
+        }
+    }
+
+    /// @brief  sets the pitch of a voice
+    /// @param  handle  the voice to change
+    /// @param  pitch   the relative pitch of the voice
+    void VoiceManager::SetPitch( Handle handle, float pitch )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Voice.M_Pitch = pitch;
+        if ( slot->M_Channel != nullptr )
+        {
+            m_Backend->Apply( slot->M_Channel, slot->M_Voice );
+        }
+    }
+
+
+    /// @brief  sets whether a voice exists in 3D space
+    /// @param  handle      the voice to change
+    /// @param  isSpatial   whether the voice exists in 3D space
+    void VoiceManager::SetIsSpatial( Handle handle, bool isSpatial )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Voice.M_IsSpatial = isSpatial;
+        if ( slot->M_Channel != nullptr )
+        {
+            m_Backend->Apply( slot->M_Channel, slot->M_Voice );
+        }
+    }
+
+    /// @brief  sets the position and velocity of a voice
+    /// @param  handle      the voice to change
+    /// @param  position    the position of the voice
+    /// @param  velocity    the velocity of the voice
+    void VoiceManager::SetSpatialAttributes( Handle handle, glm::vec2 const& position, glm::vec2 const& velocity )
+    {
+        Slot* slot = getSlot( handle );
+        if ( slot == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Voice.M_Position = position;
+        slot->M_Voice.M_Velocity = velocity;
+        if ( slot->M_Channel != nullptr && slot->M_Voice.M_IsSpatial )
+        {
+            m_Backend->ApplySpatialAttributes( slot->M_Channel, slot->M_Voice );
+        }
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  sets the backend that real voices play through, stopping every voice
+    /// @param  backend the backend to play real voices through
+    void VoiceManager::SetBackend( std::unique_ptr< IVoiceBackend > backend )
+    {
+        while ( m_ActiveSlots.empty() == false )
+        {
+            endVoice( m_ActiveSlots.back(), true );
+        }
+
+        m_Backend = std::move( backend );
+
+        // anything started by a completion callback plays through the new backend
+        callCompletedCallbacks();
+    }
+
+
+    /// @brief  sets the most voices in a channel group that can be real at once
+    /// @param  group       the channel group
+    /// @param  maxVoices   the most voices in the group that can be real at once - 0 for no limit
+    void VoiceManager::SetGroupMaxVoices( FMOD::ChannelGroup* group, int maxVoices )
+    {
+        if ( maxVoices <= 0 )
+        {
+            m_GroupMaxVoices.erase( group );
+            return;
+        }
+
+        m_GroupMaxVoices[ group ] = maxVoices;
+    }
+
+
+//-----------------------------------------------------------------------------
+// public: static methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets how loud a voice is at a listener, the way FMOD attenuates it
+    /// @param  voice       the voice
+    /// @param  listener    where the voice is heard from - nullptr to ignore distance
+    /// @return the gain of the voice - 0 when paused
+    float VoiceManager::GetGain( Voice const& voice, Listener const* listener )
+    {
+        if ( voice.M_IsPaused )
+        {
+            return 0.0f;
+        }
+
+        float gain = voice.M_Volume * ( voice.M_Sound != nullptr ? voice.M_Sound->GetVolume() : 1.0f );
+        if ( voice.M_IsSpatial == false || listener == nullptr )
+        {
+            return gain;
+        }
+
+        // FMOD's default inverse rolloff, with a min distance of 1
+        float distance = glm::length( glm::vec3( voice.M_Position, 0.0f ) - listener->M_Position );
+        return gain / ( 1.0f + listener->M_RolloffScale * std::max( distance - 1.0f, 0.0f ) );
+    }
+
+
+    /// @brief  logs how a wave of 500 enemies retriggering sounds is scheduled, compared to starting a channel each time
+    void VoiceManager::RunBenchmark()
+    {
+        int const enemyCount = 500;
+        int const frameCount = 600;
+        float const dt = 1.0f / 60.0f;
+        float const retriggerTime = 0.25f;
+        float const soundLength = 0.5f;
+        int const maxRealVoices = 64;
+        int const maxEnemyVoices = 32;
+
+        std::mt19937 random( 0 );
+        std::uniform_real_distribution< float > positionDistribution( -60.0f, 60.0f );
+        std::uniform_real_distribution< float > phaseDistribution( 0.0f, retriggerTime );
+
+        // three enemy sounds, each capped the way an audio designer would
+        Sound sounds[ 3 ];
+        for ( Sound& sound : sounds )
+        {
+            sound.SetMaxVoices( 16 );
+        }
+
+        // the null backend never touches channel groups, so any distinct pointer works as a group
+        static char enemyGroupKey = 0;
+        FMOD::ChannelGroup* enemyGroup = (FMOD::ChannelGroup*)&enemyGroupKey;
+
+        VoiceManager voices;
+        NullVoiceBackend* backend = new NullVoiceBackend();
+        voices.SetBackend( std::unique_ptr< IVoiceBackend >( backend ) );
+        voices.SetMaxRealVoices( maxRealVoices );
+        voices.SetGroupMaxVoices( enemyGroup, maxEnemyVoices );
+
+        // what AudioPlayers with AllowMultipleSounds did: a new channel every trigger
+        NullVoiceBackend unmanaged;
+
+        std::vector< Voice > enemies( enemyCount );
+        std::vector< float > timers( enemyCount );
+        for ( int i = 0; i < enemyCount; ++i )
+        {
+            Voice& voice = enemies[ i ];
+            voice.M_Sound = &sounds[ i % 3 ];
+            voice.M_Group = enemyGroup;
+            voice.M_Priority = i % 50 == 0 ? 1 : 0; // a few bosses
+            voice.M_Length = soundLength;
+            voice.M_IsSpatial = true;
+            voice.M_Position = { positionDistribution( random ), positionDistribution( random ) };
+            timers[ i ] = phaseDistribution( random );
+        }
+
+        // the listener walks through the wave
+        Listener listener;
+
+        long long playCount = 0;
+        int peakRealVoices = 0;
+        int peakVoices = 0;
+        int peakUnmanagedChannels = 0;
+        int errorCount = 0;
+        std::vector< Voice const* > triggered;
+        std::chrono::high_resolution_clock::duration duration( 0 );
+        for ( int frame = 0; frame < frameCount; ++frame )
+        {
+            listener.M_Position.x = -60.0f + 120.0f * frame / frameCount;
+
+            triggered.clear();
+            for ( int i = 0; i < enemyCount; ++i )
+            {
+                timers[ i ] -= dt;
+                if ( timers[ i ] <= 0.0f )
+                {
+                    timers[ i ] += retriggerTime;
+                    triggered.push_back( &enemies[ i ] );
+                }
+            }
+            playCount += triggered.size();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for ( Voice const* voice : triggered )
+            {
+                voices.Play( *voice );
+            }
+            voices.Update( dt, &listener );
+            duration += std::chrono::high_resolution_clock::now() - start;
+
+            for ( Voice const* voice : triggered )
+            {
+                unmanaged.Start( *voice, 0.0f );
+            }
+            unmanaged.Update( dt );
+
+            // the caps must hold, and every real voice must have exactly one channel
+            if ( voices.GetRealVoiceCount() > maxRealVoices || backend->GetChannelCount() != voices.GetRealVoiceCount() )
+            {
+                ++errorCount;
+            }
+
+            peakRealVoices = std::max( peakRealVoices, voices.GetRealVoiceCount() );
+            peakVoices = std::max( peakVoices, voices.GetVoiceCount() );
+            peakUnmanagedChannels = std::max( peakUnmanagedChannels, unmanaged.GetChannelCount() );
+        }
+
+        float ms = std::chrono::duration< float, std::milli >( duration ).count();
+
+        Debug() << "Voice manager benchmark (" << enemyCount << " enemies retriggering " << soundLength << " s sounds every "
+            << retriggerTime << " s, " << frameCount << " frames, null backend):\n"
+            << "    scheduling:        " << ms / frameCount << " ms per frame\n"
+            << "    plays:             " << playCount << "\n"
+            << "    channels started:  " << backend->GetStartCount() << " (was " << unmanaged.GetStartCount() << ")\n"
+            << "    peak channels:     " << peakRealVoices << " of " << maxRealVoices
+            << " (was " << peakUnmanagedChannels << ")\n"
+            << "    peak voices:       " << peakVoices << "\n"
+            << "    dropped / stolen:  " << voices.GetDroppedCount() << " / " << voices.GetStolenCount() << "\n"
+            << "    bookkeeping errors: " << errorCount << std::endl;
+
+        // end the voices while the sounds they point to still exist
+        voices.StopAll();
+    }
+
+
+//-----------------------------------------------------------------------------
+// private: methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the slot a handle refers to
+    /// @param  handle  the handle
+    /// @return the slot - nullptr if the voice has ended
+    VoiceManager::Slot* VoiceManager::getSlot( Handle handle )
+    {
+        return const_cast< Slot* >( static_cast< VoiceManager const* >( this )->getSlot( handle ) );
+    }
+
+    /// @brief  gets the slot a handle refers to
+    /// @param  handle  the handle
+    /// @return the slot - nullptr if the voice has ended
+    VoiceManager::Slot const* VoiceManager::getSlot( Handle handle ) const
+    {
+        unsigned index = handle & ( ( 1u << s_IndexBits ) - 1 );
+        if ( handle == 0 || index >= m_Slots.size() )
+        {
+            return nullptr;
+        }
+
+        Slot const& slot = m_Slots[ index ];
+        if ( slot.M_ActiveIndex < 0 || slot.M_Generation != ( handle >> s_IndexBits ) )
+        {
+            return nullptr;
+        }
+
+        return &slot;
+    }
+
+
+    /// @brief  makes room under a full cap by ending its least important voice, if it's no more important than voice
+    /// @param  voice   the voice that needs room
+    /// @param  gain    how loud voice is
+    /// @param  sound   only consider voices of this Sound - nullptr for all voices
+    /// @return whether room was made
+    bool VoiceManager::stealVoice( Voice const& voice, float gain, Sound const* sound )
+    {
+        int victim = -1;
+        for ( unsigned index : m_ActiveSlots )
+        {
+            Slot const& slot = m_Slots[ index ];
+            if ( sound != nullptr && slot.M_Voice.M_Sound != sound )
+            {
+                continue;
+            }
+
+            if ( victim < 0 )
+            {
+                victim = index;
+                continue;
+            }
+
+            Slot const& least = m_Slots[ victim ];
+            if (
+                slot.M_Voice.M_Priority < least.M_Voice.M_Priority ||
+                ( slot.M_Voice.M_Priority == least.M_Voice.M_Priority && slot.M_Gain < least.M_Gain )
+            )
+            {
+                victim = index;
+            }
+        }
+
+        if ( victim < 0 )
+        {
+            return false;
+        }
+
+        // a retrigger at the same priority and loudness replaces the old voice
+        Slot const& least = m_Slots[ victim ];
+        if (
+            least.M_Voice.M_Priority > voice.M_Priority ||
+            ( least.M_Voice.M_Priority == voice.M_Priority && least.M_Gain > gain )
+        )
+        {
+            return false;
+        }
+
+        ++m_StolenCount;
+        endVoice( victim, false );
+        return true;
+    }
+
+    /// @brief  ends a voice, freeing its slot
+    /// @param  index       the index of the voice's slot
+    /// @param  isDeferred  whether to call the voice's completion callback later, in callCompletedCallbacks
+    void VoiceManager::endVoice( unsigned index, bool isDeferred )
+    {
+        Slot& slot = m_Slots[ index ];
+
+        if ( slot.M_Channel != nullptr )
+        {
+            m_Backend->Stop( slot.M_Channel );
+            slot.M_Channel = nullptr;
+            --m_RealVoiceCount;
+            --m_GroupRealCounts[ slot.M_Voice.M_Group ];
+        }
+
+        unsigned last = m_ActiveSlots.back();
+        m_ActiveSlots[ slot.M_ActiveIndex ] = last;
+        m_Slots[ last ].M_ActiveIndex = slot.M_ActiveIndex;
+        m_ActiveSlots.pop_back();
+        slot.M_ActiveIndex = -1;
+
+        // old handles no longer refer to this slot
+        slot.M_Generation = slot.M_Generation % s_MaxGeneration + 1;
+        m_FreeSlots.push_back( index );
+
+        --m_SoundVoiceCounts[ slot.M_Voice.M_Sound ];
+
+        std::function< void() > onComplete = std::move( slot.M_Voice.M_OnComplete );
+        slot.M_Voice.M_OnComplete = nullptr;
+        if ( onComplete == nullptr )
+        {
+            return;
+        }
+
+        if ( isDeferred )
+        {
+            m_CompletedCallbacks.push_back( std::move( onComplete ) );
+        }
+        else
+        {
+            onComplete();
+        }
+    }
+
+    /// @brief  calls the completion callbacks of voices that ended with isDeferred
+    void VoiceManager::callCompletedCallbacks()
+    {
+        // callbacks can start and stop voices, so call them from a list endVoice no longer appends to
+        std::vector< std::function< void() > > callbacks;
+        callbacks.swap( m_CompletedCallbacks );
+        for ( std::function< void() > const& callback : callbacks )
+        {
+            callback();
+        }
+    }
+
+
+    /// @brief  gives a virtual voice a real channel, if there's room under the real voice caps
+    /// @param  slot    the voice's slot
+    void VoiceManager::tryRealize( Slot* slot )
+    {
+        if ( slot->M_Channel != nullptr || slot->M_Gain < s_AudibleGain || m_RealVoiceCount >= m_MaxRealVoices )
+        {
+            return;
+        }
+
+        int groupMaxVoices = getGroupMaxVoices( slot->M_Voice.M_Group );
+        if ( groupMaxVoices > 0 && m_GroupRealCounts[ slot->M_Voice.M_Group ] >= groupMaxVoices )
+        {
+            return;
+        }
+
+        realize( slot );
+    }
+
+    /// @brief  gives a virtual voice a real channel
+    /// @param  slot    the voice's slot
+    void VoiceManager::realize( Slot* slot )
+    {
+        void* channel = m_Backend->Start( slot->M_Voice, slot->M_Time );
+        if ( channel == nullptr )
+        {
+            return;
+        }
+
+        slot->M_Channel = channel;
+        ++m_RealVoiceCount;
+        ++m_GroupRealCounts[ slot->M_Voice.M_Group ];
+        ++m_RealizedCount;
+    }
+
+    /// @brief  takes a real voice's channel away, keeping track of where it was
+    /// @param  slot    the voice's slot
+    void VoiceManager::virtualize( Slot* slot )
+    {
+        slot->M_Time = m_Backend->GetTime( slot->M_Channel );
+        slot->M_Voice.M_LoopCount = m_Backend->GetLoopCount( slot->M_Channel );
+
+        m_Backend->Stop( slot->M_Channel );
+        slot->M_Channel = nullptr;
+        --m_RealVoiceCount;
+        --m_GroupRealCounts[ slot->M_Voice.M_Group ];
+    }
+
+
+    /// @brief  gets the most real voices a channel group can have
+    /// @param  group   the channel group
+    /// @return the most real voices the channel group can have - 0 for no limit
+    int VoiceManager::getGroupMaxVoices( FMOD::ChannelGroup* group ) const
+    {
+        auto it = m_GroupMaxVoices.find( group );
+        return it != m_GroupMaxVoices.end() ? it->second : 0;
+    }
+
+
+//-----------------------------------------------------------------------------
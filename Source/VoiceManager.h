@@ -0,0 +1,383 @@
+/// @file       VoiceManager.h
+/// @author     Oblivion Owls Inc
+/// @brief      decides which of the sounds asked for actually get a channel
+/// @version    0.1
+/// @date       2026-10-16
+///
+/// @copyright  Copyright (c) 2024 Digipen Institute of Technology
+
+#pragma once
+
+#include "pch.h"
+
+#include "VoiceBackend.h"
+
+#include <memory>
+#include <unordered_map>
+
+
+/// @brief  decides which of the sounds asked for actually get a channel
+/// @note   every sound played is a voice. Only the most important audible voices are real (backed by a channel);
+///         the rest are virtual, and only have their playback time tracked until they become audible again or end.
+/// @note   voices are ranked by priority, then by how loud they are at the active AudioListener. Real voices are
+///         capped overall and per channel group; all voices are capped overall and per Sound, with a new voice
+///         taking the place of the least important one when a cap is full.
+/// @note   scheduling never touches FMOD itself - with a NullVoiceBackend it can be checked and benchmarked without audio
+class VoiceManager
+{
+//-----------------------------------------------------------------------------
+public: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  refers to a voice - 0 refers to no voice, and handles to voices that have ended refer to nothing
+    using Handle = unsigned;
+
+
+    /// @brief  where voices are heard from
+    struct Listener
+    {
+        /// @brief  the position of the listener
+        glm::vec3 M_Position = { 0.0f, 0.0f, 0.0f };
+
+        /// @brief  how quickly sounds get quieter with distance
+        float M_RolloffScale = 1.0f;
+    };
+
+
+//-----------------------------------------------------------------------------
+public: // constructor / destructor
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  constructs a VoiceManager with a NullVoiceBackend
+    VoiceManager();
+
+
+//-----------------------------------------------------------------------------
+public: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  starts a voice
+    /// @param  voice   the voice to play
+    /// @return the handle of the new voice - 0 if a voice cap was full of more important voices
+    Handle Play( Voice const& voice );
+
+    /// @brief  stops a voice
+    /// @param  handle  the voice to stop
+    void Stop( Handle handle );
+
+    /// @brief  stops every voice
+    void StopAll();
+
+
+    /// @brief  ends voices that finished, and decides which voices are real
+    /// @param  dt          the duration of the frame in seconds
+    /// @param  listener    where voices are heard from - nullptr to ignore distance
+    void Update( float dt, Listener const* listener );
+
+
+//-----------------------------------------------------------------------------
+public: // voice accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets whether a voice is still playing (real or virtual)
+    /// @param  handle  the voice to check
+    /// @return whether the voice is still playing
+    bool GetIsPlaying( Handle handle ) const;
+
+    /// @brief  gets whether a voice is backed by a real channel
+    /// @param  handle  the voice to check
+    /// @return whether the voice is backed by a real channel
+    bool GetIsReal( Handle handle ) const;
+
+
+    /// @brief  gets whether a voice is paused
+    /// @param  handle  the voice to check
+    /// @return whether the voice is paused - true if it isn't playing
+    bool GetIsPaused( Handle handle ) const;
+
+    /// @brief  sets whether a voice is paused
+    /// @param  handle      the voice to change
+    /// @param  isPaused    whether the voice is paused
+    void SetIsPaused( Handle handle, bool isPaused );
+
+
+    /// @brief  gets how far into its sound a voice is
+    /// @param  handle  the voice to check
+    /// @return how far into its sound the voice is, in seconds
+    float GetTime( Handle handle ) const;
+
+    /// @brief  sets how far into its sound a voice is
+    /// @param  handle  the voice to change
+    /// @param  time    how far into its sound the voice is, in seconds
+    void SetTime( Handle handle, float time );
+
+
+    /// @brief  gets how many more times a voice will loop
+    /// @param  handle  the voice to check
+    /// @return how many more times the voice will loop - -1 loops forever
+    int GetLoopCount( Handle handle ) const;
+
+    /// @brief  sets how many more times a voice will loop
+    /// @param  handle      the voice to change
+    /// @param  loopCount   how many more times the voice will loop - -1 loops forever
+    void SetLoopCount( Handle handle, int loopCount );
+
+
+    /// @brief  sets the volume of a voice
+    /// @param  handle  the voice to change
+    /// @param  volume  the relative volume of the voice
+    void SetVolume( Handle handle, float volume );
+
+    /// @brief  sets the pitch of a voice
+    /// @param  handle  the voice to change
+    /// @param  pitch   the relative pitch of the voice
+    void SetPitch( Handle handle, float pitch );
+
+
+    /// @brief  sets whether a voice exists in 3D space
+    /// @param  handle      the voice to change
+    /// @param  isSpatial   whether the voice exists in 3D space
+    void SetIsSpatial( Handle handle, bool isSpatial );
+
+    /// @brief  sets the position and velocity of a voice
+    /// @param  handle      the voice to change
+    /// @param  position    the position of the voice
+    /// @param  velocity    the velocity of the voice
+    void SetSpatialAttributes( Handle handle, glm::vec2 const& position, glm::vec2 const& velocity );
+
+
+//-----------------------------------------------------------------------------
+public: // accessors
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  sets the backend that real voices play through, stopping every voice
+    /// @param  backend the backend to play real voices through
+    void SetBackend( std::unique_ptr< IVoiceBackend > backend );
+
+
+    /// @brief  gets the most voices that can be real at once
+    /// @return the most voices that can be real at once
+    int GetMaxRealVoices() const { return m_MaxRealVoices; }
+
+    /// @brief  sets the most voices that can be real at once
+    /// @param  maxRealVoices   the most voices that can be real at once
+    void SetMaxRealVoices( int maxRealVoices ) { m_MaxRealVoices = maxRealVoices; }
+
+
+    /// @brief  gets the most voices (real or virtual) that can play at once
+    /// @return the most voices that can play at once
+    int GetMaxVoices() const { return m_MaxVoices; }
+
+    /// @brief  sets the most voices (real or virtual) that can play at once
+    /// @param  maxVoices   the most voices that can play at once
+    void SetMaxVoices( int maxVoices ) { m_MaxVoices = maxVoices; }
+
+
+    /// @brief  sets the most voices in a channel group that can be real at once
+    /// @param  group       the channel group
+    /// @param  maxVoices   the most voices in the group that can be real at once - 0 for no limit
+    void SetGroupMaxVoices( FMOD::ChannelGroup* group, int maxVoices );
+
+
+    /// @brief  gets how many voices are playing
+    /// @return how many voices are playing
+    int GetVoiceCount() const { return (int)m_ActiveSlots.size(); }
+
+    /// @brief  gets how many voices are backed by real channels
+    /// @return how many voices are backed by real channels
+    int GetRealVoiceCount() const { return m_RealVoiceCount; }
+
+    /// @brief  gets how many voices were never started because their cap was full of more important voices
+    /// @return how many voices were dropped
+    long long GetDroppedCount() const { return m_DroppedCount; }
+
+    /// @brief  gets how many voices were ended early to make room for more important voices
+    /// @return how many voices were stolen
+    long long GetStolenCount() const { return m_StolenCount; }
+
+    /// @brief  gets how many times a voice was given a real channel
+    /// @return how many times a voice was given a real channel
+    long long GetRealizedCount() const { return m_RealizedCount; }
+
+
+//-----------------------------------------------------------------------------
+public: // static methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets how loud a voice is at a listener, the way FMOD attenuates it
+    /// @param  voice       the voice
+    /// @param  listener    where the voice is heard from - nullptr to ignore distance
+    /// @return the gain of the voice - 0 when paused
+    static float GetGain( Voice const& voice, Listener const* listener );
+
+
+    /// @brief  logs how a wave of 500 enemies retriggering sounds is scheduled, compared to starting a channel each time
+    static void RunBenchmark();
+
+
+//-----------------------------------------------------------------------------
+private: // types
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  a voice and where it is
+    struct Slot
+    {
+        /// @brief  the voice
+        Voice M_Voice;
+
+        /// @brief  the backend channel the voice plays on - nullptr while virtual
+        void* M_Channel = nullptr;
+
+        /// @brief  how far into its sound the voice is, in seconds - only kept up to date while virtual
+        float M_Time = 0.0f;
+
+        /// @brief  how loud the voice was last update
+        float M_Gain = 0.0f;
+
+        /// @brief  bumped each time the slot is reused, so old handles stop referring to it
+        unsigned M_Generation = 1;
+
+        /// @brief  where this slot is in m_ActiveSlots - -1 if the slot is free
+        int M_ActiveIndex = -1;
+    };
+
+
+//-----------------------------------------------------------------------------
+private: // constants
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  how many bits of a handle are the slot index - the rest are the generation
+    static constexpr int s_IndexBits = 20;
+
+    /// @brief  the largest generation that fits in a handle
+    static constexpr unsigned s_MaxGeneration = ( 1u << ( 32 - s_IndexBits ) ) - 1;
+
+    /// @brief  the quietest gain worth a real channel (-60 dB)
+    static constexpr float s_AudibleGain = 0.001f;
+
+
+//-----------------------------------------------------------------------------
+private: // members
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  plays real voices
+    std::unique_ptr< IVoiceBackend > m_Backend;
+
+    /// @brief  the most voices that can be real at once
+    int m_MaxRealVoices = 64;
+
+    /// @brief  the most voices (real or virtual) that can play at once
+    int m_MaxVoices = 1024;
+
+    /// @brief  the most voices in each channel group that can be real at once
+    std::unordered_map< FMOD::ChannelGroup*, int > m_GroupMaxVoices;
+
+
+    /// @brief  every voice slot
+    std::vector< Slot > m_Slots;
+
+    /// @brief  the indices of slots that can be reused
+    std::vector< unsigned > m_FreeSlots;
+
+    /// @brief  the indices of slots with playing voices
+    std::vector< unsigned > m_ActiveSlots;
+
+    /// @brief  how many voices of each Sound are playing
+    std::unordered_map< Sound const*, int > m_SoundVoiceCounts;
+
+    /// @brief  how many voices are backed by real channels
+    int m_RealVoiceCount = 0;
+
+    /// @brief  how many real voices each channel group has
+    std::unordered_map< FMOD::ChannelGroup*, int > m_GroupRealCounts;
+
+
+    /// @brief  where voices were heard from last update
+    Listener m_Listener;
+
+    /// @brief  whether there was a listener last update
+    bool m_HasListener = false;
+
+
+    /// @brief  active slots, most important first - kept to reuse its memory
+    std::vector< unsigned > m_Order;
+
+    /// @brief  how many real voices each channel group is given this update - kept to reuse its memory
+    std::unordered_map< FMOD::ChannelGroup*, int > m_GroupAssignedCounts;
+
+    /// @brief  callbacks of voices that ended mid-update, called once the update is done
+    std::vector< std::function< void() > > m_CompletedCallbacks;
+
+
+    /// @brief  how many voices were dropped
+    long long m_DroppedCount = 0;
+
+    /// @brief  how many voices were stolen
+    long long m_StolenCount = 0;
+
+    /// @brief  how many times a voice was given a real channel
+    long long m_RealizedCount = 0;
+
+
+//-----------------------------------------------------------------------------
+private: // methods
+//-----------------------------------------------------------------------------
+
+
+    /// @brief  gets the slot a handle refers to
+    /// @param  handle  the handle
+    /// @return the slot - nullptr if the voice has ended
+    Slot* getSlot( Handle handle );
+
+    /// @brief  gets the slot a handle refers to
+    /// @param  handle  the handle
+    /// @return the slot - nullptr if the voice has ended
+    Slot const* getSlot( Handle handle ) const;
+
+
+    /// @brief  makes room under a full cap by ending its least important voice, if it's no more important than voice
+    /// @param  voice   the voice that needs room
+    /// @param  gain    how loud voice is
+    /// @param  sound   only consider voices of this Sound - nullptr for all voices
+    /// @return whether room was made
+    bool stealVoice( Voice const& voice, float gain, Sound const* sound );
+
+    /// @brief  ends a voice, freeing its slot
+    /// @param  index       the index of the voice's slot
+    /// @param  isDeferred  whether to call the voice's completion callback later, in callCompletedCallbacks
+    void endVoice( unsigned index, bool isDeferred );
+
+    /// @brief  calls the completion callbacks of voices that ended with isDeferred
+    void callCompletedCallbacks();
+
+
+    /// @brief  gives a virtual voice a real channel, if there's room under the real voice caps
+    /// @param  slot    the voice's slot
+    void tryRealize( Slot* slot );
+
+    /// @brief  gives a virtual voice a real channel
+    /// @param  slot    the voice's slot
+    void realize( Slot* slot );
+
+    /// @brief  takes a real voice's channel away, keeping track of where it was
+    /// @param  slot    the voice's slot
+    void virtualize( Slot* slot );
+
+
+    /// @brief  gets the most real voices a channel group can have
+    /// @param  group   the channel group
+    /// @return the most real voices the channel group can have - 0 for no limit
+    int getGroupMaxVoices( FMOD::ChannelGroup* group ) const;
+
+
+//-----------------------------------------------------------------------------
+};